@@ -307,6 +307,10 @@ TfLiteStatus ParseOpDataTfLite(const Operator* op, BuiltinOperator op_type,
       return ParseGatherNd(op, error_reporter, allocator, builtin_data);
     }
 
+    case BuiltinOperator_GELU: {
+      return ParseGelu(op, error_reporter, allocator, builtin_data);
+    }
+
     case BuiltinOperator_GREATER: {
       return ParseGreater(op, error_reporter, allocator, builtin_data);
     }
@@ -863,15 +867,6 @@ TfLiteStatus ParseOpDataTfLite(const Operator* op, BuiltinOperator op_type,
       *builtin_data = params.release();
       return kTfLiteOk;
     }
-    case BuiltinOperator_GELU: {
-      auto params = safe_allocator.Allocate<TfLiteGeluParams>();
-      TF_LITE_ENSURE(error_reporter, params != nullptr);
-      if (const auto* gelu_params = op->builtin_options_as_GeluOptions()) {
-        params->approximate = gelu_params->approximate();
-      }
-      *builtin_data = params.release();
-      return kTfLiteOk;
-    }
     case BuiltinOperator_STABLEHLO_SCATTER: {
       return ParseStablehloScatter(op, error_reporter, allocator, builtin_data);
     }
@@ -1602,6 +1597,20 @@ TfLiteStatus ParseGatherNd(const Operator*, ErrorReporter*,
   return kTfLiteOk;
 }
 
+TfLiteStatus ParseGelu(const Operator* op, ErrorReporter* error_reporter,
+                       BuiltinDataAllocator* allocator, void** builtin_data) {
+  CheckParsePointerParams(op, error_reporter, allocator, builtin_data);
+
+  SafeBuiltinDataAllocator safe_allocator(allocator);
+  auto params = safe_allocator.Allocate<TfLiteGeluParams>();
+  TF_LITE_ENSURE(error_reporter, params != nullptr);
+  if (const auto* gelu_params = op->builtin_options_as_GeluOptions()) {
+    params->approximate = gelu_params->approximate();
+  }
+  *builtin_data = params.release();
+  return kTfLiteOk;
+}
+
 // We have this parse function instead of directly returning kTfLiteOk from the
 // switch-case in ParseOpData because this function is used as part of the
 // selective registration for the OpResolver implementation in micro.
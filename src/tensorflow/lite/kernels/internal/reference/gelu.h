@@ -0,0 +1,58 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_INTERNAL_REFERENCE_GELU_H_
+#define TENSORFLOW_LITE_KERNELS_INTERNAL_REFERENCE_GELU_H_
+
+#include <cmath>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+namespace reference_ops {
+
+namespace gelu_internal {
+
+constexpr float kSqrt1_2 = 0.70710678118654752440f;  // sqrt(1 / 2)
+constexpr float kSqrt2dPi = 0.79788456080286535588f;  // sqrt(2 / pi)
+
+}  // namespace gelu_internal
+
+// 0.5 * x * (1 + erf(x / sqrt(2)))
+inline float GeluTransform(float in) {
+  return 0.5f * in * (1.0f + std::erf(in * gelu_internal::kSqrt1_2));
+}
+
+// 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+inline float GeluTransformApproximate(float in) {
+  return 0.5f * in *
+         (1.0f + std::tanh(gelu_internal::kSqrt2dPi *
+                           (in + 0.044715f * in * in * in)));
+}
+
+inline void Gelu(const RuntimeShape& input_shape, const float* input_data,
+                 bool approximate, const RuntimeShape& output_shape,
+                 float* output_data) {
+  const int flat_size = MatchingFlatSize(input_shape, output_shape);
+  for (int i = 0; i < flat_size; ++i) {
+    output_data[i] = approximate ? GeluTransformApproximate(input_data[i])
+                                 : GeluTransform(input_data[i]);
+  }
+}
+
+}  // namespace reference_ops
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_REFERENCE_GELU_H_
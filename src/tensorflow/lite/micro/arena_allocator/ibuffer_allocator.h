@@ -39,6 +39,16 @@ class IPersistentBufferAllocator {
 
   // Returns the size of all persistent allocations in bytes.
   virtual size_t GetPersistentUsedBytes() const = 0;
+
+  // Releases every persistent buffer allocated after GetPersistentUsedBytes()
+  // returned `used_bytes`. Persistent buffers are handed out as a stack, so
+  // this is only valid for a value previously returned by
+  // GetPersistentUsedBytes(). Used by the MicroAllocator to unload models in a
+  // multi-tenant arena. Implementations that can not release memory return
+  // kTfLiteError.
+  virtual TfLiteStatus ReleasePersistentBuffersTo(size_t used_bytes) {
+    return kTfLiteError;
+  }
 };
 
 // Interface class for managing non-persistent buffers.
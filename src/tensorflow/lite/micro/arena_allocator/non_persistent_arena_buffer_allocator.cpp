@@ -139,7 +139,7 @@ TfLiteStatus NonPersistentArenaBufferAllocator::DeallocateResizableBuffer(
 // Returns a pointer pointing to the start of the overlay memory, which is
 // used for activation tensors and scratch buffers by kernels at Invoke stage.
 uint8_t* NonPersistentArenaBufferAllocator::GetOverlayMemoryAddress() const {
-  return buffer_head_;
+  return AlignPointerUp(buffer_head_, overlay_alignment_);
 }
 
 // Reserves the size of the overlay memory. This overlay is reserved for the
@@ -150,7 +150,9 @@ TfLiteStatus
 NonPersistentArenaBufferAllocator::ReserveNonPersistentOverlayMemory(
     size_t size, size_t alignment) {
   uint8_t* expect_resizable_buf = AlignPointerUp(buffer_head_, alignment);
-  return ResizeBuffer(expect_resizable_buf, size, alignment);
+  TF_LITE_ENSURE_STATUS(ResizeBuffer(expect_resizable_buf, size, alignment));
+  overlay_alignment_ = alignment;
+  return kTfLiteOk;
 }
 
 // Returns the size of non-persistent buffer in use.
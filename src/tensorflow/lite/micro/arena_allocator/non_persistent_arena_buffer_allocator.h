@@ -90,6 +90,10 @@ class NonPersistentArenaBufferAllocator : public INonPersistentBufferAllocator {
   // its range is between head_temp_ and buffer_tail_
   uint8_t* next_temp_;
 
+  // Alignment of the overlay memory, which starts at buffer_head_ rounded up
+  // to it.
+  size_t overlay_alignment_ = 1;
+
   // XOR Check sum for outstanding temp buffers.
   // If all temp buffers are deallocated OR no temp buffers are allocated,
   // temp_buffer_ptr_check_sum_ == nullptr.
@@ -49,4 +49,17 @@ size_t PersistentArenaBufferAllocator::GetPersistentUsedBytes() const {
   return buffer_tail_ - tail_temp_;
 }
 
+TfLiteStatus PersistentArenaBufferAllocator::ReleasePersistentBuffersTo(
+    size_t used_bytes) {
+  if (used_bytes > GetPersistentUsedBytes()) {
+    MicroPrintf(
+        "Failed to release tail memory. Requested tail size: %u, current "
+        "tail size: %u",
+        used_bytes, GetPersistentUsedBytes());
+    return kTfLiteError;
+  }
+  tail_temp_ = buffer_tail_ - used_bytes;
+  return kTfLiteOk;
+}
+
 }  // namespace tflite
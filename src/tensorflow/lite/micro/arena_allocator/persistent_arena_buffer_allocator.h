@@ -39,6 +39,10 @@ class PersistentArenaBufferAllocator : public IPersistentBufferAllocator {
   // Returns the size of all persistent allocations in bytes.
   size_t GetPersistentUsedBytes() const override;
 
+  // Releases every persistent allocation made after the allocator held
+  // `used_bytes` bytes.
+  TfLiteStatus ReleasePersistentBuffersTo(size_t used_bytes) override;
+
   TF_LITE_REMOVE_VIRTUAL_DELETE
  private:
   // The memory arena that this allocator manages.
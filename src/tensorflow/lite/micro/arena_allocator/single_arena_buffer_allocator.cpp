@@ -76,7 +76,9 @@ TfLiteStatus SingleArenaBufferAllocator::DeallocateResizableBuffer(
 TfLiteStatus SingleArenaBufferAllocator::ReserveNonPersistentOverlayMemory(
     size_t size, size_t alignment) {
   uint8_t* expect_resizable_buf = AlignPointerUp(buffer_head_, alignment);
-  return ResizeBuffer(expect_resizable_buf, size, alignment);
+  TF_LITE_ENSURE_STATUS(ResizeBuffer(expect_resizable_buf, size, alignment));
+  overlay_alignment_ = alignment;
+  return kTfLiteOk;
 }
 
 TfLiteStatus SingleArenaBufferAllocator::ResizeBuffer(uint8_t* resizable_buf,
@@ -167,7 +169,7 @@ TfLiteStatus SingleArenaBufferAllocator::ResetTempAllocations() {
 }
 
 uint8_t* SingleArenaBufferAllocator::GetOverlayMemoryAddress() const {
-  return buffer_head_;
+  return AlignPointerUp(buffer_head_, overlay_alignment_);
 }
 
 size_t SingleArenaBufferAllocator::GetNonPersistentUsedBytes() const {
@@ -178,6 +180,19 @@ size_t SingleArenaBufferAllocator::GetPersistentUsedBytes() const {
   return buffer_tail_ - tail_;
 }
 
+TfLiteStatus SingleArenaBufferAllocator::ReleasePersistentBuffersTo(
+    size_t used_bytes) {
+  if (used_bytes > GetPersistentUsedBytes()) {
+    MicroPrintf(
+        "Failed to release tail memory. Requested tail size: %u, current "
+        "tail size: %u",
+        used_bytes, GetPersistentUsedBytes());
+    return kTfLiteError;
+  }
+  tail_ = buffer_tail_ - used_bytes;
+  return kTfLiteOk;
+}
+
 size_t SingleArenaBufferAllocator::GetAvailableMemory(size_t alignment) const {
   uint8_t* const aligned_temp = AlignPointerUp(temp_, alignment);
   uint8_t* const aligned_tail = AlignPointerDown(tail_, alignment);
@@ -93,7 +93,8 @@ class SingleArenaBufferAllocator : public INonPersistentBufferAllocator,
   virtual TfLiteStatus ResetTempAllocations() override;
 
   // Returns a pointer to the buffer currently assigned to the head section.
-  // This buffer is set by calling SetHeadSize().
+  // This buffer is set by calling ReserveNonPersistentOverlayMemory() and
+  // starts at the alignment requested there.
   uint8_t* GetOverlayMemoryAddress() const override;
 
   // Returns the size of the head section in bytes.
@@ -102,6 +103,10 @@ class SingleArenaBufferAllocator : public INonPersistentBufferAllocator,
   // Returns the size of all allocations in the tail section in bytes.
   size_t GetPersistentUsedBytes() const override;
 
+  // Moves the tail back up so that the tail section holds `used_bytes` bytes,
+  // releasing every persistent allocation made after that point.
+  TfLiteStatus ReleasePersistentBuffersTo(size_t used_bytes) override;
+
   // Returns the number of bytes available with a given alignment. This number
   // takes in account any temporary allocations.
   size_t GetAvailableMemory(size_t alignment) const override;
@@ -126,6 +131,8 @@ class SingleArenaBufferAllocator : public INonPersistentBufferAllocator,
   uint8_t* head_;
   uint8_t* tail_;
   uint8_t* temp_;
+  // Alignment of the overlay memory reserved in the head section.
+  size_t overlay_alignment_ = 1;
 
   // The combination of the checksum of outstanding temporary buffer pointers
   // AND the count of outstanding temporary buffer provide a low cost mechanism
@@ -76,6 +76,12 @@ void* FakeMicroContext::AllocatePersistentBuffer(size_t bytes) {
 
 TfLiteStatus FakeMicroContext::RequestScratchBufferInArena(size_t bytes,
                                                            int* buffer_index) {
+  return RequestAlignedScratchBufferInArena(bytes, MicroArenaBufferAlignment(),
+                                            buffer_index);
+}
+
+TfLiteStatus FakeMicroContext::RequestAlignedScratchBufferInArena(
+    size_t bytes, size_t alignment, int* buffer_index) {
   TFLITE_DCHECK(buffer_index != nullptr);
 
   if (scratch_buffer_count_ == kNumScratchBuffers_) {
@@ -88,7 +94,7 @@ TfLiteStatus FakeMicroContext::RequestScratchBufferInArena(size_t bytes,
   // for the lifetime of model. This means that the arena size in the tests will
   // be more than what we would have if the scratch buffers could share memory.
   scratch_buffers_[scratch_buffer_count_] =
-      allocator_->AllocatePersistentBuffer(bytes, MicroArenaBufferAlignment());
+      allocator_->AllocatePersistentBuffer(bytes, alignment);
   TFLITE_DCHECK(scratch_buffers_[scratch_buffer_count_] != nullptr);
 
   *buffer_index = scratch_buffer_count_++;
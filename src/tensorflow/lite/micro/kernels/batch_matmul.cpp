@@ -21,11 +21,12 @@ limitations under the License.
 
 #include "tensorflow/lite/core/c/common.h"
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
-#include "tensorflow/lite/kernels/internal/reference/transpose.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/internal/types.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/batch_matmul_gemm.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/sparse_fully_connected.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
@@ -54,12 +55,11 @@ struct QuantizationOpData {
 struct OpData {
   QuantizationOpData* quantization;
 
-  // Transpose tensors and state
-  TfLiteEvalTensor* lhs_transposed_tensor;
-  TfLiteEvalTensor* rhs_transposed_tensor;
-  bool rhs_is_transposed;
-  bool lhs_is_constant_tensor;
-  bool rhs_is_constant_tensor;
+  // A constant RHS with adj_y, stored without adj_y at Prepare, or nullptr.
+  const void* rhs_transposed;
+
+  // Index arrays of a block-sparse RHS, or nullptr if the RHS is dense.
+  const BlockSparseWeights* sparse_rhs;
 };
 
 struct OpContext {
@@ -153,56 +153,14 @@ TfLiteStatus ReshapeOutputTensor(TfLiteContext* context, TfLiteNode* node,
   return kTfLiteOk;
 }
 
-TfLiteEvalTensor* AllocInitTransposeTensorFromTfLiteTensor(
-    TfLiteContext* context, const TfLiteTensor& tensor) {
-  MicroContext* micro_context = GetMicroContext(context);
-  TfLiteEvalTensor* eval_tensor = static_cast<TfLiteEvalTensor*>(
-      micro_context->AllocatePersistentBuffer(sizeof(TfLiteEvalTensor)));
-  if (eval_tensor == nullptr) {
-    return nullptr;
-  }
-
-  eval_tensor->type = tensor.type;
-
-  const int tensor_rank = NumDimensions(&tensor);
-  const size_t eval_dims_size = TfLiteIntArrayGetSizeInBytes(tensor_rank);
-  eval_tensor->dims = static_cast<TfLiteIntArray*>(
-      micro_context->AllocatePersistentBuffer(eval_dims_size));
-  if (eval_tensor->dims == nullptr) {
-    return nullptr;
-  }
-  eval_tensor->dims->size = tensor_rank;
-  for (int i = 0; i < tensor_rank - 2; ++i) {
-    eval_tensor->dims->data[i] = tensor.dims->data[i];
-  }
-  // Swap last two dimensions.
-  eval_tensor->dims->data[tensor_rank - 2] = tensor.dims->data[tensor_rank - 1];
-  eval_tensor->dims->data[tensor_rank - 1] = tensor.dims->data[tensor_rank - 2];
-
-  const size_t eval_data_size = static_cast<size_t>(NumElements(&tensor)) *
-                                TfLiteTypeGetSize(tensor.type);
-  eval_tensor->data.data =
-      micro_context->AllocatePersistentBuffer(eval_data_size);
-  if (eval_tensor->data.data == nullptr) {
-    return nullptr;
-  }
-
-  return eval_tensor;
-}
-
-// Initializes tensors to store transposed operands.
-// Allocate storage for hybrid quantization if needed.
-// Allocate normal quantization data if needed.
+// Allocates the quantization data if the operands are quantized.
 TfLiteStatus InitializeTemporaries(TfLiteContext* context, TfLiteNode* node,
                                    const PrepareOpContext& op_context) {
   OpData* op_data = op_context.op_data;
   const TfLiteTensor* lhs = op_context.lhs;
-  const TfLiteTensor* rhs = op_context.rhs;
   MicroContext* micro_context = GetMicroContext(context);
 
   op_data->quantization = nullptr;
-  op_data->lhs_transposed_tensor = nullptr;
-  op_data->rhs_transposed_tensor = nullptr;
 
   if (lhs->type == kTfLiteInt8 || lhs->type == kTfLiteInt16) {
     op_data->quantization = static_cast<decltype(op_data->quantization)>(
@@ -211,64 +169,64 @@ TfLiteStatus InitializeTemporaries(TfLiteContext* context, TfLiteNode* node,
     TF_LITE_ENSURE(context, op_data->quantization != nullptr);
   }
 
-  // tensor for Transposed LHS;
-  if (op_context.params->adj_x) {
-    op_data->lhs_transposed_tensor =
-        AllocInitTransposeTensorFromTfLiteTensor(context, *lhs);
-    TF_LITE_ENSURE(context, op_data->lhs_transposed_tensor != nullptr);
-  }
-
-  // We need a buffer for the RHS if we need to transpose the RHS. We
-  // transpose by default, so that the two inputs (LHS and RHS) are in a proper
-  // layout for our fast matrix multiplication routines. If the transpose flag
-  // is set by the caller, the data is already in the desired layout.
-  if (!op_context.params->adj_y) {
-    op_data->rhs_transposed_tensor =
-        AllocInitTransposeTensorFromTfLiteTensor(context, *rhs);
-    TF_LITE_ENSURE(context, op_data->rhs_transposed_tensor != nullptr);
-  }
-
   return kTfLiteOk;
 }
 
 template <typename Scalar>
-void TransposeRowsColumnsImpl(const TfLiteEvalTensor& tensor_in,
-                              TfLiteEvalTensor* tensor_out) {
-  const Scalar* input = tflite::micro::GetTensorData<Scalar>(&tensor_in);
-  Scalar* output = tflite::micro::GetTensorData<Scalar>(tensor_out);
-  RuntimeShape transposed_shape(tflite::micro::GetTensorShape(&tensor_in));
-  RuntimeShape shape(transposed_shape);
-  TransposeParams params;
+void TransposeRowsColumnsImpl(const RuntimeShape& shape, const Scalar* input,
+                              Scalar* output) {
   const int rank = shape.DimensionsCount();
-  params.perm_count = rank;
-  for (int i = 0; i < rank - 2; ++i) {
-    params.perm[i] = i;
+  const int rows = shape.Dims(rank - 2);
+  const int cols = shape.Dims(rank - 1);
+  const int matrix_size = rows * cols;
+  const int batches = matrix_size == 0 ? 0 : shape.FlatSize() / matrix_size;
+  for (int b = 0; b < batches; ++b) {
+    for (int r = 0; r < rows; ++r) {
+      for (int c = 0; c < cols; ++c) {
+        output[c * rows + r] = input[r * cols + c];
+      }
+    }
+    input += matrix_size;
+    output += matrix_size;
   }
-  // Transpose the last two dimensions.
-  params.perm[rank - 2] = rank - 1;
-  params.perm[rank - 1] = rank - 2;
-  transposed_shape.SetDim(rank - 1, shape.Dims(rank - 2));
-  transposed_shape.SetDim(rank - 2, shape.Dims(rank - 1));
-  reference_ops::Transpose(params, shape, input, transposed_shape, output);
 }
 
-TfLiteStatus TransposeRowsColumns(const TfLiteEvalTensor& tensor_in,
-                                  TfLiteEvalTensor* tensor_out) {
-  if (tensor_in.type == kTfLiteFloat32) {
-    TransposeRowsColumnsImpl<float>(tensor_in, tensor_out);
-    return kTfLiteOk;
-  } else if (tensor_in.type == kTfLiteInt8) {
-    TransposeRowsColumnsImpl<int8_t>(tensor_in, tensor_out);
-    return kTfLiteOk;
-  } else if (tensor_in.type == kTfLiteInt16) {
-    TransposeRowsColumnsImpl<int16_t>(tensor_in, tensor_out);
-    return kTfLiteOk;
-  } else {
-    MicroPrintf(
-        "BATCH_MATMUL can only transpose tensors with FLOAT32, INT8, INT16 "
-        "type.");
+// Stores a constant [..., cols, depth] RHS as [..., depth, cols] in the arena,
+// where the GEMM loads neighbouring output columns together instead of one
+// strided value per column.
+TfLiteStatus TransposeConstantRhs(TfLiteContext* context,
+                                  const TfLiteTensor& rhs, OpData* op_data) {
+  const size_t bytes =
+      static_cast<size_t>(NumElements(&rhs)) * TfLiteTypeGetSize(rhs.type);
+  void* transposed =
+      GetMicroContext(context)->AllocatePackedWeightBuffer(bytes);
+  if (transposed == nullptr) {
+    MicroPrintf("Failed to allocate %d bytes for the transposed RHS.",
+                static_cast<int>(bytes));
+    return kTfLiteError;
   }
-  return kTfLiteError;
+  const RuntimeShape shape = GetTensorShape(&rhs);
+  switch (rhs.type) {
+    case kTfLiteFloat32:
+      TransposeRowsColumnsImpl(shape, GetTensorData<float>(&rhs),
+                               static_cast<float*>(transposed));
+      break;
+    case kTfLiteInt8:
+      TransposeRowsColumnsImpl(shape, GetTensorData<int8_t>(&rhs),
+                               static_cast<int8_t*>(transposed));
+      break;
+    case kTfLiteInt16:
+      TransposeRowsColumnsImpl(shape, GetTensorData<int16_t>(&rhs),
+                               static_cast<int16_t*>(transposed));
+      break;
+    default:
+      MicroPrintf(
+          "BATCH_MATMUL can only transpose tensors with FLOAT32, INT8, INT16 "
+          "type.");
+      return kTfLiteError;
+  }
+  op_data->rhs_transposed = transposed;
+  return kTfLiteOk;
 }
 
 RuntimeShape SwapRowColumnDims(const RuntimeShape& shape) {
@@ -321,13 +279,32 @@ TfLiteStatus BatchMatMulPrepare(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE(context, rhs_rank >= 2);
   TF_LITE_ENSURE(context, rhs_rank <= 5);
 
+  OpData* op_data = op_context.op_data;
+  const RuntimeShape rhs_shape = GetTensorShape(rhs_data);
+  TF_LITE_ENSURE_STATUS(PrepareBlockSparseWeights(
+      context, node, kInputRhsTensor, rhs_data->type,
+      rhs_shape.Dims(rhs_rank - 2), rhs_shape.Dims(rhs_rank - 1),
+      &op_data->sparse_rhs));
+  if (op_data->sparse_rhs != nullptr) {
+    // A sparse RHS is evaluated like the filter of a fully connected layer,
+    // which is the layout the TFLite converter sparsifies: a constant
+    // [output_depth, accum_depth] matrix without batch dimensions.
+    TF_LITE_ENSURE(context, IsConstantTensor(rhs_data));
+    TF_LITE_ENSURE(context, op_context.params->adj_y);
+    TF_LITE_ENSURE(context, !op_context.params->adj_x);
+    TF_LITE_ENSURE_EQ(context, rhs_shape.FlatSize(),
+                      rhs_shape.Dims(rhs_rank - 2) *
+                          rhs_shape.Dims(rhs_rank - 1));
+  }
+
   TF_LITE_ENSURE_OK(context, InitializeTemporaries(context, node, op_context));
 
-  OpData* op_data = op_context.op_data;
-  // If the RHS is constant, we only transpose once.
-  op_data->rhs_is_transposed = false;
-  op_data->lhs_is_constant_tensor = IsConstantTensor(lhs_data);
-  op_data->rhs_is_constant_tensor = IsConstantTensor(rhs_data);
+  op_data->rhs_transposed = nullptr;
+  if (op_context.params->adj_y && op_data->sparse_rhs == nullptr &&
+      IsConstantTensor(rhs_data)) {
+    TF_LITE_ENSURE_OK(context,
+                      TransposeConstantRhs(context, *rhs_data, op_data));
+  }
 
   // Note that quantized inference requires that all tensors have their
   // parameters set. This is usually done during quantized training.
@@ -360,6 +337,9 @@ TfLiteStatus BatchMatMulPrepare(TfLiteContext* context, TfLiteNode* node) {
     op_data->quantization->lhs_zero_point = lhs_data->params.zero_point;
     op_data->quantization->rhs_zero_point = rhs_data->params.zero_point;
     op_data->quantization->output_zero_point = output->params.zero_point;
+    if (op_data->sparse_rhs != nullptr) {
+      TF_LITE_ENSURE_EQ(context, rhs_data->params.zero_point, 0);
+    }
   }
 
   const int output_rank = std::max(lhs_rank, rhs_rank);
@@ -393,13 +373,12 @@ TfLiteStatus BatchMatMulPrepare(TfLiteContext* context, TfLiteNode* node) {
   return status;
 }
 
-TfLiteStatus EvalInt8(TfLiteContext* context, const OpData& data,
-                      const RuntimeShape& lhs_shape,
-                      const TfLiteEvalTensor& lhs,
-                      const RuntimeShape& rhs_shape,
-                      const TfLiteEvalTensor& rhs,
-                      const RuntimeShape& output_shape,
-                      TfLiteEvalTensor* output) {
+template <typename T>
+TfLiteStatus EvalQuantized(TfLiteContext* context, const OpData& data,
+                           const RuntimeShape& lhs_shape,
+                           const TfLiteEvalTensor& lhs, bool adj_x,
+                           const RuntimeShape& rhs_shape, const T* rhs_data,
+                           bool adj_y, TfLiteEvalTensor* output) {
   TF_LITE_ENSURE(context, data.quantization != nullptr);
   // Reuse params struct from FullyConnected Op.
   FullyConnectedParams op_params;
@@ -411,135 +390,105 @@ TfLiteStatus EvalInt8(TfLiteContext* context, const OpData& data,
   op_params.output_shift = data.quantization->output_shift;
   op_params.quantized_activation_min = data.quantization->output_activation_min;
   op_params.quantized_activation_max = data.quantization->output_activation_max;
-  op_params.lhs_cacheable = data.lhs_is_constant_tensor;
-  op_params.rhs_cacheable = data.rhs_is_constant_tensor;
 
-  // Note we pass RHS args first, LHS args second. See note for Eval.
-  reference_ops::BatchMatMul<int8_t, int32_t>(
-      op_params, rhs_shape, tflite::micro::GetTensorData<int8_t>(&rhs),
-      lhs_shape, tflite::micro::GetTensorData<int8_t>(&lhs), output_shape,
-      tflite::micro::GetTensorData<int8_t>(output));
+  BatchMatMulGemm(op_params, lhs_shape, tflite::micro::GetTensorData<T>(&lhs),
+                  adj_x, rhs_shape, rhs_data, adj_y,
+                  tflite::micro::GetTensorData<T>(output));
 
   return kTfLiteOk;
 }
 
-TfLiteStatus EvalInt16(TfLiteContext* context, const OpData& data,
-                       const RuntimeShape& lhs_shape,
-                       const TfLiteEvalTensor& lhs,
-                       const RuntimeShape& rhs_shape,
-                       const TfLiteEvalTensor& rhs,
-                       const RuntimeShape& output_shape,
-                       TfLiteEvalTensor* output) {
-  TF_LITE_ENSURE(context, data.quantization != nullptr);
-  // Reuse params struct from FullyConnected Op.
-  FullyConnectedParams op_params;
-  op_params.input_offset = -data.quantization->lhs_zero_point;
-  op_params.weights_offset =
-      -data.quantization->rhs_zero_point;  // filter offset
-  op_params.output_offset = data.quantization->output_zero_point;
-  op_params.output_multiplier = data.quantization->output_multiplier;
-  op_params.output_shift = data.quantization->output_shift;
-  op_params.quantized_activation_min = data.quantization->output_activation_min;
-  op_params.quantized_activation_max = data.quantization->output_activation_max;
-  op_params.lhs_cacheable = data.lhs_is_constant_tensor;
-  op_params.rhs_cacheable = data.rhs_is_constant_tensor;
-
-  // Note we pass RHS args first, LHS args second. See note for Eval.
-  reference_ops::BatchMatMul<int16_t, int64_t>(
-      op_params, rhs_shape, tflite::micro::GetTensorData<int16_t>(&rhs),
-      lhs_shape, tflite::micro::GetTensorData<int16_t>(&lhs), output_shape,
-      tflite::micro::GetTensorData<int16_t>(output));
+// Multiplies every row of the LHS with a block-sparse RHS of shape
+// [output_depth, accum_depth], i.e. the transposed RHS of the product.
+TfLiteStatus EvalSparse(TfLiteContext* context, const OpData& data,
+                        const TfLiteEvalTensor& lhs,
+                        const TfLiteEvalTensor& rhs,
+                        TfLiteEvalTensor* output) {
+  const RuntimeShape rhs_shape = tflite::micro::GetTensorShape(&rhs);
+  const int rhs_rank = rhs_shape.DimensionsCount();
+  const int output_depth = rhs_shape.Dims(rhs_rank - 2);
+  const int accum_depth = rhs_shape.Dims(rhs_rank - 1);
+  const int batches =
+      tflite::micro::GetTensorShape(&lhs).FlatSize() / accum_depth;
 
-  return kTfLiteOk;
+  FullyConnectedParams op_params;
+  switch (lhs.type) {
+    case kTfLiteFloat32:
+      op_params.float_activation_min = std::numeric_limits<float>::lowest();
+      op_params.float_activation_max = std::numeric_limits<float>::max();
+      SparseFullyConnected(op_params, *data.sparse_rhs, batches, output_depth,
+                           accum_depth,
+                           tflite::micro::GetTensorData<float>(&lhs),
+                           tflite::micro::GetTensorData<float>(&rhs),
+                           /*bias_data=*/nullptr,
+                           tflite::micro::GetTensorData<float>(output));
+      return kTfLiteOk;
+    case kTfLiteInt8:
+      TF_LITE_ENSURE(context, data.quantization != nullptr);
+      op_params.input_offset = -data.quantization->lhs_zero_point;
+      op_params.weights_offset = 0;
+      op_params.output_offset = data.quantization->output_zero_point;
+      op_params.output_multiplier = data.quantization->output_multiplier;
+      op_params.output_shift = data.quantization->output_shift;
+      op_params.quantized_activation_min =
+          data.quantization->output_activation_min;
+      op_params.quantized_activation_max =
+          data.quantization->output_activation_max;
+      SparseFullyConnected(op_params, *data.sparse_rhs, batches, output_depth,
+                           accum_depth,
+                           tflite::micro::GetTensorData<int8_t>(&lhs),
+                           tflite::micro::GetTensorData<int8_t>(&rhs),
+                           /*bias_data=*/nullptr,
+                           tflite::micro::GetTensorData<int8_t>(output));
+      return kTfLiteOk;
+    default:
+      MicroPrintf("BATCH_MATMUL doesn't support sparse input type %s",
+                  TfLiteTypeGetName(lhs.type));
+      return kTfLiteError;
+  }
 }
 
 // Perform a batch matrix multiply on
 // LHS <..., A, B>  X  RHS<..., B, C>
 // where the leading dimensions of LHS and RHS obey broadcasting rules
-// (this Op will apply broadcasting rules).
-// We assume that LHS and RHS are both row oriented (adjacent values in memory
-// are in the same row) and will output in the same memory layout. However,
-// our fast GEMM libraries assume RCC layout (LHS row oriented,
-// RHS column oriented, output column oriented). Therefore, we perform
-// RHS <..., C, B> X LHS <..., B, A>
-// where output is a C X A column-oriented, which is equivalent to
-// A X C row-oriented.
+// (this Op will apply broadcasting rules). adj_x and adj_y swap the last two
+// dimensions of the LHS and the RHS; the GEMM reads either layout in place.
 TfLiteStatus BatchMatMulEval(TfLiteContext* context, TfLiteNode* node) {
   EvalOpContext op_context(context, node);
   OpData* op_data = op_context.op_data;
   const TfLiteEvalTensor* lhs = op_context.lhs;
   const TfLiteEvalTensor* rhs = op_context.rhs;
   TfLiteEvalTensor* output = op_context.output;
-  RuntimeShape orig_lhs_shape = tflite::micro::GetTensorShape(lhs);
-  RuntimeShape orig_rhs_shape = tflite::micro::GetTensorShape(rhs);
-
-  bool adj_y = op_context.params->adj_y;
-  bool adj_x = op_context.params->adj_x;
-
-  // Compress BatchMatMul when third from last RHS dimension is one.
-  int32_t rhs_dims_count = orig_rhs_shape.DimensionsCount();
-  int32_t lhs_dims_count = orig_lhs_shape.DimensionsCount();
-  // Compress ops where rhs shape is [..., 1, X, Y] and lhs shape is
-  // [..., Q, R, S] which is equivalent to rhs: [..., X, Y] and
-  // lhs: [..., Q * R, S].
-  if (rhs_dims_count > 2 && lhs_dims_count > 2) {
-    int rhs_one = orig_rhs_shape.DimsData()[rhs_dims_count - 3];
-    if (rhs_one == 1) {
-      int32_t* lhs_dims = orig_lhs_shape.DimsData();
-      int32_t* rhs_dims = orig_rhs_shape.DimsData();
-      RuntimeShape tmp_l(lhs_dims_count - 1, lhs_dims);
-      tmp_l.SetDim(lhs_dims_count - 3,
-                   lhs_dims[lhs_dims_count - 3] * lhs_dims[lhs_dims_count - 2]);
-      tmp_l.SetDim(lhs_dims_count - 2, lhs_dims[lhs_dims_count - 1]);
-      orig_lhs_shape.ReplaceWith(tmp_l.DimensionsCount(), tmp_l.DimsData());
-      RuntimeShape tmp_r(rhs_dims_count - 1, orig_rhs_shape.DimsData());
-      tmp_r.SetDim(rhs_dims_count - 3, rhs_dims[rhs_dims_count - 2]);
-      tmp_r.SetDim(rhs_dims_count - 2, rhs_dims[rhs_dims_count - 1]);
-      orig_rhs_shape.ReplaceWith(tmp_r.DimensionsCount(), tmp_r.DimsData());
-      rhs_dims_count = orig_rhs_shape.DimensionsCount();
-      lhs_dims_count = orig_lhs_shape.DimensionsCount();
-    }
+  if (op_data->sparse_rhs != nullptr) {
+    return EvalSparse(context, *op_data, *lhs, *rhs, output);
   }
 
-  TfLiteEvalTensor* rhs_tensor = adj_y ? const_cast<TfLiteEvalTensor*>(rhs)
-                                       : op_data->rhs_transposed_tensor;
-  TfLiteEvalTensor* lhs_tensor = adj_x ? op_data->lhs_transposed_tensor
-                                       : const_cast<TfLiteEvalTensor*>(lhs);
-  TF_LITE_ENSURE(context, rhs_tensor != nullptr);
-  TF_LITE_ENSURE(context, lhs_tensor != nullptr);
-  if (!adj_y) {
-    // TODO(b/154760341): Constant tensors should already be transposed, but
-    // we transpose once if necessary for now.
-    if (!(op_data->rhs_is_constant_tensor && op_data->rhs_is_transposed)) {
-      TransposeRowsColumns(*rhs, rhs_tensor);
-      op_data->rhs_is_transposed = true;
-    }
-  }
-  if (adj_x) {
-    TransposeRowsColumns(*lhs, lhs_tensor);
-  }
-  RuntimeShape rhs_shape =
-      adj_y ? orig_rhs_shape : SwapRowColumnDims(orig_rhs_shape);
-  RuntimeShape lhs_shape =
-      adj_x ? orig_lhs_shape : SwapRowColumnDims(orig_lhs_shape);
+  // A constant RHS transposed at Prepare is multiplied without adj_y.
+  const bool rhs_transposed = op_data->rhs_transposed != nullptr;
+  const RuntimeShape lhs_shape = tflite::micro::GetTensorShape(lhs);
+  const RuntimeShape rhs_shape =
+      rhs_transposed
+          ? SwapRowColumnDims(tflite::micro::GetTensorShape(rhs))
+          : tflite::micro::GetTensorShape(rhs);
+  const void* rhs_data =
+      rhs_transposed ? op_data->rhs_transposed : rhs->data.data;
+  const bool adj_x = op_context.params->adj_x;
+  const bool adj_y = op_context.params->adj_y && !rhs_transposed;
 
   switch (lhs->type) {
     case kTfLiteFloat32:
-      // Note we pass RHS args first, LHS args second. See note above.
-      reference_ops::BatchMatMul(
-          rhs_shape, tflite::micro::GetTensorData<float>(rhs_tensor), lhs_shape,
-          tflite::micro::GetTensorData<float>(lhs_tensor),
-          tflite::micro::GetTensorShape(output),
-          tflite::micro::GetTensorData<float>(output));
+      BatchMatMulGemm(lhs_shape, tflite::micro::GetTensorData<float>(lhs),
+                      adj_x, rhs_shape, static_cast<const float*>(rhs_data),
+                      adj_y, tflite::micro::GetTensorData<float>(output));
       break;
     case kTfLiteInt8:
-      return EvalInt8(context, *op_data, lhs_shape, *lhs_tensor, rhs_shape,
-                      *rhs_tensor, tflite::micro::GetTensorShape(output),
-                      output);
+      return EvalQuantized(context, *op_data, lhs_shape, *lhs, adj_x,
+                           rhs_shape, static_cast<const int8_t*>(rhs_data),
+                           adj_y, output);
     case kTfLiteInt16:
-      return EvalInt16(context, *op_data, lhs_shape, *lhs_tensor, rhs_shape,
-                       *rhs_tensor, tflite::micro::GetTensorShape(output),
-                       output);
+      return EvalQuantized(context, *op_data, lhs_shape, *lhs, adj_x,
+                           rhs_shape, static_cast<const int16_t*>(rhs_data),
+                           adj_y, output);
     default:
       MicroPrintf("BATCH_MATMUL doesn't support input type %s",
                   TfLiteTypeGetName(lhs->type));
@@ -0,0 +1,261 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/batch_matmul_gemm.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/reference/batch_matmul.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+namespace {
+
+// Output rows and columns of the register tile.
+constexpr int kTileRows = 4;
+constexpr int kTileCols = 4;
+
+// RHS bytes that the column panels try to keep in cache while the LHS rows
+// sweep over them.
+constexpr int kRhsPanelBytes = 16 * 1024;
+
+// One matrix product of BATCH_MATMUL. Element (i, k) of the LHS is at
+// lhs[i * lhs_row_stride + k * lhs_depth_stride], element (k, j) of the RHS at
+// rhs[k * rhs_depth_stride + j * rhs_col_stride], and element (i, j) of the
+// output at output[i * cols + j].
+template <typename T, typename AccumT>
+struct Product {
+  const T* lhs;
+  int lhs_row_stride;
+  int lhs_depth_stride;
+  const T* rhs;
+  int rhs_depth_stride;
+  int rhs_col_stride;
+  int depth;
+  int cols;
+  AccumT lhs_offset;
+  AccumT rhs_offset;
+  const FullyConnectedParams* params;
+  T* output;
+};
+
+template <typename T, typename AccumT>
+inline AccumT Operand(T value, AccumT offset) {
+  return static_cast<AccumT>(value) + offset;
+}
+
+// Float operands have no zero point.
+template <>
+inline float Operand<float, float>(float value, float offset) {
+  return value;
+}
+
+template <typename T, typename AccumT>
+inline T OutputValue(AccumT total, const FullyConnectedParams& params) {
+  int32_t total_scaled = MultiplyByQuantizedMultiplier(
+      total, params.output_multiplier, params.output_shift);
+  total_scaled += params.output_offset;
+  total_scaled = std::max(total_scaled, params.quantized_activation_min);
+  total_scaled = std::min(total_scaled, params.quantized_activation_max);
+  return static_cast<T>(total_scaled);
+}
+
+template <>
+inline float OutputValue<float, float>(float total,
+                                       const FullyConnectedParams& params) {
+  return total;
+}
+
+// Computes the kRows x kCols outputs starting at (`row`, `col`). Columns of
+// the RHS are adjacent in memory if kRhsColsContiguous, which lets compilers
+// load the columns of the tile as one vector. The tile loops are unrolled so
+// that the accumulators stay in registers.
+template <int kRows, int kCols, bool kRhsColsContiguous, typename T,
+          typename AccumT>
+inline void ComputeTile(const Product<T, AccumT>& p, int row, int col) {
+  const int lhs_row_stride = p.lhs_row_stride;
+  const int lhs_depth_stride = p.lhs_depth_stride;
+  const int rhs_col_stride = kRhsColsContiguous ? 1 : p.rhs_col_stride;
+  const int rhs_depth_stride = p.rhs_depth_stride;
+  const AccumT lhs_offset = p.lhs_offset;
+  const AccumT rhs_offset = p.rhs_offset;
+  const T* lhs = p.lhs + row * lhs_row_stride;
+  const T* rhs = p.rhs + col * rhs_col_stride;
+  AccumT acc[kRows][kCols] = {};
+  for (int k = 0; k < p.depth; ++k) {
+    AccumT lhs_values[kRows];
+    AccumT rhs_values[kCols];
+#pragma GCC unroll 4
+    for (int r = 0; r < kRows; ++r) {
+      lhs_values[r] = Operand(lhs[r * lhs_row_stride], lhs_offset);
+    }
+#pragma GCC unroll 4
+    for (int c = 0; c < kCols; ++c) {
+      rhs_values[c] = Operand(rhs[c * rhs_col_stride], rhs_offset);
+    }
+#pragma GCC unroll 4
+    for (int r = 0; r < kRows; ++r) {
+#pragma GCC unroll 4
+      for (int c = 0; c < kCols; ++c) {
+        acc[r][c] += lhs_values[r] * rhs_values[c];
+      }
+    }
+    lhs += lhs_depth_stride;
+    rhs += rhs_depth_stride;
+  }
+  for (int r = 0; r < kRows; ++r) {
+    T* output = p.output + (row + r) * p.cols + col;
+    for (int c = 0; c < kCols; ++c) {
+      output[c] = OutputValue<T>(acc[r][c], *p.params);
+    }
+  }
+}
+
+template <int kRows, bool kRhsColsContiguous, typename T, typename AccumT>
+inline void ComputeRows(const Product<T, AccumT>& p, int row, int col,
+                        int col_end) {
+  for (; col <= col_end - kTileCols; col += kTileCols) {
+    ComputeTile<kRows, kTileCols, kRhsColsContiguous>(p, row, col);
+  }
+  for (; col < col_end; ++col) {
+    ComputeTile<kRows, 1, kRhsColsContiguous>(p, row, col);
+  }
+}
+
+template <bool kRhsColsContiguous, typename T, typename AccumT>
+void Multiply(const Product<T, AccumT>& p, int rows) {
+  const int panel_bytes =
+      std::max(1, p.depth * static_cast<int>(sizeof(T)) * kTileCols);
+  const int panel_cols =
+      std::max(1, kRhsPanelBytes / panel_bytes) * kTileCols;
+  for (int col = 0; col < p.cols; col += panel_cols) {
+    const int col_end = std::min(p.cols, col + panel_cols);
+    int row = 0;
+    for (; row <= rows - kTileRows; row += kTileRows) {
+      ComputeRows<kTileRows, kRhsColsContiguous>(p, row, col, col_end);
+    }
+    for (; row < rows; ++row) {
+      ComputeRows<1, kRhsColsContiguous>(p, row, col, col_end);
+    }
+  }
+}
+
+template <typename T, typename AccumT>
+void BatchMatMulGemmImpl(const FullyConnectedParams& params,
+                         AccumT lhs_offset, AccumT rhs_offset,
+                         const RuntimeShape& lhs_shape, const T* lhs_data,
+                         bool adj_x, const RuntimeShape& rhs_shape,
+                         const T* rhs_data, bool adj_y, T* output_data) {
+  const RuntimeShape extended_lhs_shape =
+      RuntimeShape::ExtendedShape(5, lhs_shape);
+  const RuntimeShape extended_rhs_shape =
+      RuntimeShape::ExtendedShape(5, rhs_shape);
+
+  const int batch_dim0 = reference_ops::batch_matmul::broadcast_dim(
+      extended_lhs_shape.Dims(0), extended_rhs_shape.Dims(0));
+  const int batch_dim1 = reference_ops::batch_matmul::broadcast_dim(
+      extended_lhs_shape.Dims(1), extended_rhs_shape.Dims(1));
+  const int batch_dim2 = reference_ops::batch_matmul::broadcast_dim(
+      extended_lhs_shape.Dims(2), extended_rhs_shape.Dims(2));
+
+  using reference_ops::batch_matmul::extent;
+  const int lhs_ext0 = extent(extended_lhs_shape, 0);
+  const int lhs_ext1 = extent(extended_lhs_shape, 1);
+  const int lhs_ext2 = extent(extended_lhs_shape, 2);
+  const int rhs_ext0 = extent(extended_rhs_shape, 0);
+  const int rhs_ext1 = extent(extended_rhs_shape, 1);
+  const int rhs_ext2 = extent(extended_rhs_shape, 2);
+
+  const int rows = extended_lhs_shape.Dims(adj_x ? 4 : 3);
+  const int depth = extended_lhs_shape.Dims(adj_x ? 3 : 4);
+  const int cols = extended_rhs_shape.Dims(adj_y ? 3 : 4);
+
+  Product<T, AccumT> p;
+  p.lhs_row_stride = adj_x ? 1 : depth;
+  p.lhs_depth_stride = adj_x ? rows : 1;
+  p.rhs_depth_stride = adj_y ? 1 : cols;
+  p.rhs_col_stride = adj_y ? depth : 1;
+  p.depth = depth;
+  p.cols = cols;
+  p.lhs_offset = lhs_offset;
+  p.rhs_offset = rhs_offset;
+  p.params = &params;
+
+  auto multiply = [&p](int product_rows) {
+    if (p.rhs_col_stride == 1) {
+      Multiply<true>(p, product_rows);
+    } else {
+      Multiply<false>(p, product_rows);
+    }
+  };
+
+  // When every batch multiplies the same RHS, the LHS rows of all batches
+  // follow each other, and so do their output rows: one product covers them,
+  // and reuses each panel of the RHS for all of them.
+  if (!adj_x && rhs_ext0 == 0 && rhs_ext1 == 0 && rhs_ext2 == 0) {
+    p.lhs = lhs_data;
+    p.rhs = rhs_data;
+    p.output = output_data;
+    multiply(batch_dim0 * batch_dim1 * batch_dim2 * rows);
+    return;
+  }
+
+  for (int b0 = 0; b0 < batch_dim0; ++b0) {
+    for (int b1 = 0; b1 < batch_dim1; ++b1) {
+      for (int b2 = 0; b2 < batch_dim2; ++b2) {
+        p.lhs = lhs_data + b0 * lhs_ext0 + b1 * lhs_ext1 + b2 * lhs_ext2;
+        p.rhs = rhs_data + b0 * rhs_ext0 + b1 * rhs_ext1 + b2 * rhs_ext2;
+        p.output = output_data +
+                   ((b0 * batch_dim1 + b1) * batch_dim2 + b2) * rows * cols;
+        multiply(rows);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void BatchMatMulGemm(const RuntimeShape& lhs_shape, const float* lhs_data,
+                     bool adj_x, const RuntimeShape& rhs_shape,
+                     const float* rhs_data, bool adj_y, float* output_data) {
+  const FullyConnectedParams params = {};
+  BatchMatMulGemmImpl<float, float>(params, 0.0f, 0.0f, lhs_shape, lhs_data,
+                                    adj_x, rhs_shape, rhs_data, adj_y,
+                                    output_data);
+}
+
+void BatchMatMulGemm(const FullyConnectedParams& params,
+                     const RuntimeShape& lhs_shape, const int8_t* lhs_data,
+                     bool adj_x, const RuntimeShape& rhs_shape,
+                     const int8_t* rhs_data, bool adj_y, int8_t* output_data) {
+  BatchMatMulGemmImpl<int8_t, int32_t>(
+      params, params.input_offset, params.weights_offset, lhs_shape, lhs_data,
+      adj_x, rhs_shape, rhs_data, adj_y, output_data);
+}
+
+void BatchMatMulGemm(const FullyConnectedParams& params,
+                     const RuntimeShape& lhs_shape, const int16_t* lhs_data,
+                     bool adj_x, const RuntimeShape& rhs_shape,
+                     const int16_t* rhs_data, bool adj_y,
+                     int16_t* output_data) {
+  BatchMatMulGemmImpl<int16_t, int64_t>(
+      params, params.input_offset, params.weights_offset, lhs_shape, lhs_data,
+      adj_x, rhs_shape, rhs_data, adj_y, output_data);
+}
+
+}  // namespace tflite
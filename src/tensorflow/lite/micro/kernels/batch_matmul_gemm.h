@@ -0,0 +1,57 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_BATCH_MATMUL_GEMM_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_BATCH_MATMUL_GEMM_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// BATCH_MATMUL as matrix products that read the LHS and the RHS in place, in
+// whichever layout the adj_x and adj_y attributes give them, so that neither
+// operand is transposed. Each product keeps a tile of a few output rows by a
+// few output columns in registers, and sweeps the LHS rows over one panel of
+// RHS columns at a time, sized so that the panel stays in cache. Every output
+// is accumulated in the order of reference_ops::BatchMatMul(), so the
+// quantized results are bit-exact.
+//
+// The LHS is [..., rows, depth], or [..., depth, rows] if `adj_x`, and the
+// RHS is [..., depth, cols], or [..., cols, depth] if `adj_y`. Their batch
+// dimensions broadcast against each other, and the output is
+// [..., rows, cols].
+
+void BatchMatMulGemm(const RuntimeShape& lhs_shape, const float* lhs_data,
+                     bool adj_x, const RuntimeShape& rhs_shape,
+                     const float* rhs_data, bool adj_y, float* output_data);
+
+// `params.input_offset` is added to the LHS and `params.weights_offset` to the
+// RHS, as BATCH_MATMUL sets them for reference_ops::BatchMatMul().
+void BatchMatMulGemm(const FullyConnectedParams& params,
+                     const RuntimeShape& lhs_shape, const int8_t* lhs_data,
+                     bool adj_x, const RuntimeShape& rhs_shape,
+                     const int8_t* rhs_data, bool adj_y, int8_t* output_data);
+
+void BatchMatMulGemm(const FullyConnectedParams& params,
+                     const RuntimeShape& lhs_shape, const int16_t* lhs_data,
+                     bool adj_x, const RuntimeShape& rhs_shape,
+                     const int16_t* rhs_data, bool adj_y,
+                     int16_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_BATCH_MATMUL_GEMM_H_
@@ -0,0 +1,107 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/binary_broadcast.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+
+namespace {
+
+BroadcastPattern ClassifyBroadcast(const BinaryBroadcastShape& shape) {
+  const int32_t* stride1 = shape.input1_stride;
+  const int32_t* stride2 = shape.input2_stride;
+  if (shape.dims == 1) {
+    if (stride1[0] == 0) return BroadcastPattern::kScalarInput1;
+    if (stride2[0] == 0) return BroadcastPattern::kScalarInput2;
+    return BroadcastPattern::kElementwise;
+  }
+  if (shape.dims == 2) {
+    // Merged neighbours never broadcast the same way, so the outer dimension
+    // of a contiguous inner one repeats one of the inputs.
+    if (stride1[0] != 0 && stride2[0] != 0) {
+      return stride1[1] == 0 ? BroadcastPattern::kRowInput1
+                             : BroadcastPattern::kRowInput2;
+    }
+    if (stride1[0] == 0 && stride2[1] != 0) {
+      return BroadcastPattern::kChannelInput1;
+    }
+    if (stride2[0] == 0 && stride1[1] != 0) {
+      return BroadcastPattern::kChannelInput2;
+    }
+  }
+  return BroadcastPattern::kGeneral;
+}
+
+}  // namespace
+
+TfLiteStatus PrepareBinaryBroadcast(TfLiteContext* context,
+                                    const TfLiteTensor* input1,
+                                    const TfLiteTensor* input2,
+                                    BinaryBroadcastShape* shape) {
+  shape->dims = 1;
+  for (int i = 0; i < kMaxBroadcastDims; ++i) {
+    shape->output_shape[i] = 1;
+    shape->input1_stride[i] = 1;
+    shape->input2_stride[i] = 1;
+  }
+
+  if (HaveSameShapes(input1, input2)) {
+    const int flat_size = NumElements(input1);
+    shape->output_shape[0] = flat_size;
+    shape->pattern = flat_size == 0 ? BroadcastPattern::kEmpty
+                                    : BroadcastPattern::kElementwise;
+    return kTfLiteOk;
+  }
+
+  if (NumDimensions(input1) > kMaxBroadcastDims ||
+      NumDimensions(input2) > kMaxBroadcastDims) {
+    MicroPrintf("Broadcasting is only supported up to %d dimensions.",
+                kMaxBroadcastDims);
+    return kTfLiteError;
+  }
+
+  size_t input1_stride[kMaxBroadcastDims];
+  size_t input2_stride[kMaxBroadcastDims];
+  size_t output_shape[kMaxBroadcastDims];
+  if (!ReduceDimensionsForBroadcast<kMaxBroadcastDims>(
+          GetTensorShape(input1), GetTensorShape(input2), input1_stride,
+          input2_stride, output_shape)) {
+    shape->output_shape[0] = 0;
+    shape->pattern = BroadcastPattern::kEmpty;
+    return kTfLiteOk;
+  }
+
+  for (int i = 0; i < kMaxBroadcastDims; ++i) {
+    shape->output_shape[i] = static_cast<int32_t>(output_shape[i]);
+    shape->input1_stride[i] = static_cast<int32_t>(input1_stride[i]);
+    shape->input2_stride[i] = static_cast<int32_t>(input2_stride[i]);
+    if (output_shape[i] > 1) {
+      shape->dims = i + 1;
+    }
+  }
+  shape->pattern = ClassifyBroadcast(*shape);
+  return kTfLiteOk;
+}
+
+}  // namespace tflite
@@ -0,0 +1,177 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_BINARY_BROADCAST_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_BINARY_BROADCAST_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+
+// Maximum number of dimensions of the inputs of a broadcasting binary op.
+constexpr int kMaxBroadcastDims = 6;
+
+// How the inputs of a binary elementwise op map onto its output once adjacent
+// dimensions that broadcast the same way are merged. The inner loop of every
+// pattern walks contiguous memory.
+enum class BroadcastPattern : uint8_t {
+  // The output has no elements.
+  kEmpty,
+  // Both inputs have as many elements as the output.
+  kElementwise,
+  // One input is a single value.
+  kScalarInput1,
+  kScalarInput2,
+  // The output is [outer, inner], and one input is a single row of `inner`
+  // values repeated for every outer index, e.g. a bias over the channels.
+  kRowInput1,
+  kRowInput2,
+  // The output is [outer, inner], and one input has one value per outer index
+  // repeated over the inner dimension, e.g. a per-channel scale of NCHW data.
+  kChannelInput1,
+  kChannelInput2,
+  // Any other broadcast, iterated over all of the merged dimensions.
+  kGeneral,
+};
+
+// The merged shape of a binary elementwise op, computed at Prepare. Dimension
+// 0 is the innermost one, and a stride of 0 broadcasts that input along the
+// dimension.
+struct BinaryBroadcastShape {
+  BroadcastPattern pattern;
+  int dims;
+  int32_t output_shape[kMaxBroadcastDims];
+  int32_t input1_stride[kMaxBroadcastDims];
+  int32_t input2_stride[kMaxBroadcastDims];
+};
+
+// Merges the dimensions of `input1` and `input2`, and classifies how they
+// broadcast against each other.
+TfLiteStatus PrepareBinaryBroadcast(TfLiteContext* context,
+                                    const TfLiteTensor* input1,
+                                    const TfLiteTensor* input2,
+                                    BinaryBroadcastShape* shape);
+
+namespace binary_broadcast_internal {
+
+template <typename T1, typename T2, typename TOut, typename Op>
+inline void Elementwise(int size, const T1* input1, const T2* input2,
+                        TOut* output, const Op& op) {
+  for (int i = 0; i < size; ++i) {
+    output[i] = op(input1[i], input2[i]);
+  }
+}
+
+template <typename T1, typename T2, typename TOut, typename Op>
+inline void ScalarInput1(int size, const T1 input1, const T2* input2,
+                         TOut* output, const Op& op) {
+  for (int i = 0; i < size; ++i) {
+    output[i] = op(input1, input2[i]);
+  }
+}
+
+template <typename T1, typename T2, typename TOut, typename Op>
+inline void ScalarInput2(int size, const T1* input1, const T2 input2,
+                         TOut* output, const Op& op) {
+  for (int i = 0; i < size; ++i) {
+    output[i] = op(input1[i], input2);
+  }
+}
+
+// Computes the outputs of dimension `dim` and below, and returns the output
+// position that follows them.
+template <typename T1, typename T2, typename TOut, typename Op>
+TOut* BroadcastDims(const BinaryBroadcastShape& shape, int dim,
+                    const T1* input1, const T2* input2, TOut* output,
+                    const Op& op) {
+  const int size = shape.output_shape[dim];
+  if (dim == 0) {
+    if (shape.input1_stride[0] == 0) {
+      ScalarInput1(size, *input1, input2, output, op);
+    } else if (shape.input2_stride[0] == 0) {
+      ScalarInput2(size, input1, *input2, output, op);
+    } else {
+      Elementwise(size, input1, input2, output, op);
+    }
+    return output + size;
+  }
+  const int input1_stride = shape.input1_stride[dim];
+  const int input2_stride = shape.input2_stride[dim];
+  for (int i = 0; i < size; ++i) {
+    output = BroadcastDims(shape, dim - 1, input1 + i * input1_stride,
+                           input2 + i * input2_stride, output, op);
+  }
+  return output;
+}
+
+}  // namespace binary_broadcast_internal
+
+// Sets every output to op(x, y) of the input values that broadcast onto it.
+// `op` is a function object, so that the compiler can inline it into the
+// contiguous inner loops.
+template <typename T1, typename T2, typename TOut, typename Op>
+void BinaryBroadcast(const BinaryBroadcastShape& shape, const T1* input1,
+                     const T2* input2, TOut* output, const Op& op) {
+  using binary_broadcast_internal::Elementwise;
+  using binary_broadcast_internal::ScalarInput1;
+  using binary_broadcast_internal::ScalarInput2;
+  const int inner = shape.output_shape[0];
+  const int outer = shape.output_shape[1];
+  switch (shape.pattern) {
+    case BroadcastPattern::kEmpty:
+      break;
+    case BroadcastPattern::kElementwise:
+      Elementwise(inner, input1, input2, output, op);
+      break;
+    case BroadcastPattern::kScalarInput1:
+      ScalarInput1(inner, *input1, input2, output, op);
+      break;
+    case BroadcastPattern::kScalarInput2:
+      ScalarInput2(inner, input1, *input2, output, op);
+      break;
+    case BroadcastPattern::kRowInput1:
+      for (int i = 0; i < outer; ++i) {
+        Elementwise(inner, input1, input2 + i * inner, output + i * inner, op);
+      }
+      break;
+    case BroadcastPattern::kRowInput2:
+      for (int i = 0; i < outer; ++i) {
+        Elementwise(inner, input1 + i * inner, input2, output + i * inner, op);
+      }
+      break;
+    case BroadcastPattern::kChannelInput1:
+      for (int i = 0; i < outer; ++i) {
+        ScalarInput1(inner, input1[i], input2 + i * inner, output + i * inner,
+                     op);
+      }
+      break;
+    case BroadcastPattern::kChannelInput2:
+      for (int i = 0; i < outer; ++i) {
+        ScalarInput2(inner, input1 + i * inner, input2[i], output + i * inner,
+                     op);
+      }
+      break;
+    case BroadcastPattern::kGeneral:
+      binary_broadcast_internal::BroadcastDims(shape, shape.dims - 1, input1,
+                                               input2, output, op);
+      break;
+  }
+}
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_BINARY_BROADCAST_H_
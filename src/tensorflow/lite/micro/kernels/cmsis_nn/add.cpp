@@ -13,16 +13,14 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
-#include "tensorflow/lite/kernels/internal/reference/add.h"
-
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
 #include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/kernels/internal/common.h"
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
-#include "tensorflow/lite/kernels/internal/reference/integer_ops/add.h"
-#include "tensorflow/lite/kernels/internal/reference/process_broadcast_shapes.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/op_macros.h"
+#include "tensorflow/lite/micro/kernels/binary_broadcast.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/memory_helpers.h"
 #include "tensorflow/lite/micro/micro_log.h"
@@ -35,7 +33,7 @@ constexpr int kInputTensor2 = 1;
 constexpr int kOutputTensor = 0;
 
 struct OpData {
-  bool requires_broadcast;
+  BinaryBroadcastShape broadcast;
 
   // These fields are used in both the general 8-bit -> 8bit quantized path,
   // and the special 16-bit -> 16bit quantized path
@@ -65,7 +63,8 @@ TfLiteStatus CalculateOpData(TfLiteContext* context, TfLiteAddParams* params,
                              const TfLiteTensor* input1,
                              const TfLiteTensor* input2, TfLiteTensor* output,
                              OpData* data) {
-  data->requires_broadcast = !HaveSameShapes(input1, input2);
+  TF_LITE_ENSURE_STATUS(
+      PrepareBinaryBroadcast(context, input1, input2, &data->broadcast));
 
   if (output->type == kTfLiteInt8 || output->type == kTfLiteInt16) {
     // 8bit -> 8bit general quantized path, with general rescalings
@@ -121,6 +120,58 @@ void UpdateOpParams(tflite::ArithmeticParams* const op_params,
                       op_params);
 }
 
+// The general quantized ADD of reference_ops for one pair of int8 or int16
+// values.
+template <typename T>
+inline T QuantizedAdd(T x, T y, const ArithmeticParams& params) {
+  const int32_t shifted_input1_val =
+      (params.input1_offset + x) * (1 << params.left_shift);
+  const int32_t shifted_input2_val =
+      (params.input2_offset + y) * (1 << params.left_shift);
+  const int32_t scaled_input1_val =
+      MultiplyByQuantizedMultiplierSmallerThanOneExp(
+          shifted_input1_val, params.input1_multiplier, params.input1_shift);
+  const int32_t scaled_input2_val =
+      MultiplyByQuantizedMultiplierSmallerThanOneExp(
+          shifted_input2_val, params.input2_multiplier, params.input2_shift);
+  const int32_t raw_sum = scaled_input1_val + scaled_input2_val;
+  const int32_t raw_output =
+      MultiplyByQuantizedMultiplierSmallerThanOneExp(
+          raw_sum, params.output_multiplier, params.output_shift) +
+      params.output_offset;
+  const int32_t clamped_output =
+      std::min(params.quantized_activation_max,
+               std::max(params.quantized_activation_min, raw_output));
+  return static_cast<T>(clamped_output);
+}
+
+template <typename T>
+void BroadcastAddQuantized(const OpData* data,
+                           const tflite::ArithmeticParams& op_params,
+                           const TfLiteEvalTensor* input1,
+                           const TfLiteEvalTensor* input2,
+                           TfLiteEvalTensor* output) {
+  BinaryBroadcast(data->broadcast, tflite::micro::GetTensorData<T>(input1),
+                  tflite::micro::GetTensorData<T>(input2),
+                  tflite::micro::GetTensorData<T>(output),
+                  [op_params](T x, T y) {
+                    return QuantizedAdd(x, y, op_params);
+                  });
+}
+
+template <typename T>
+void BroadcastAdd(const OpData* data, T activation_min, T activation_max,
+                  const TfLiteEvalTensor* input1,
+                  const TfLiteEvalTensor* input2, TfLiteEvalTensor* output) {
+  BinaryBroadcast(data->broadcast, tflite::micro::GetTensorData<T>(input1),
+                  tflite::micro::GetTensorData<T>(input2),
+                  tflite::micro::GetTensorData<T>(output),
+                  [activation_min, activation_max](T x, T y) {
+                    return ActivationFunctionWithMinMax(x + y, activation_min,
+                                                        activation_max);
+                  });
+}
+
 TfLiteStatus EvalAddQuantizedInt8(TfLiteContext* context, TfLiteNode* node,
                                   TfLiteAddParams* params, const OpData* data,
                                   const TfLiteEvalTensor* input1,
@@ -129,18 +180,8 @@ TfLiteStatus EvalAddQuantizedInt8(TfLiteContext* context, TfLiteNode* node,
   tflite::ArithmeticParams op_params;
   UpdateOpParams(&op_params, data);
 
-  bool need_broadcast = reference_ops::ProcessBroadcastShapes(
-      tflite::micro::GetTensorShape(input1),
-      tflite::micro::GetTensorShape(input2), &op_params);
-
-  if (need_broadcast) {
-    reference_integer_ops::BroadcastAdd4DSlow(
-        op_params, tflite::micro::GetTensorShape(input1),
-        tflite::micro::GetTensorData<int8_t>(input1),
-        tflite::micro::GetTensorShape(input2),
-        tflite::micro::GetTensorData<int8_t>(input2),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<int8_t>(output));
+  if (data->broadcast.pattern != BroadcastPattern::kElementwise) {
+    BroadcastAddQuantized<int8_t>(data, op_params, input1, input2, output);
   } else {
     arm_elementwise_add_s8(
         tflite::micro::GetTensorData<int8_t>(input1),
@@ -168,18 +209,8 @@ TfLiteStatus EvalAddQuantizedInt16(TfLiteContext* context, TfLiteNode* node,
   tflite::ArithmeticParams op_params;
   UpdateOpParams(&op_params, data);
 
-  bool need_broadcast = reference_ops::ProcessBroadcastShapes(
-      tflite::micro::GetTensorShape(input1),
-      tflite::micro::GetTensorShape(input2), &op_params);
-
-  if (need_broadcast) {
-    reference_ops::BroadcastAdd4DSlow(
-        op_params, tflite::micro::GetTensorShape(input1),
-        tflite::micro::GetTensorData<int16_t>(input1),
-        tflite::micro::GetTensorShape(input2),
-        tflite::micro::GetTensorData<int16_t>(input2),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<int16_t>(output));
+  if (data->broadcast.pattern != BroadcastPattern::kElementwise) {
+    BroadcastAddQuantized<int16_t>(data, op_params, input1, input2, output);
   } else {
     arm_elementwise_add_s16(
         tflite::micro::GetTensorData<int16_t>(input1),
@@ -203,48 +234,16 @@ TfLiteStatus EvalAdd(TfLiteContext* context, TfLiteNode* node,
                      const TfLiteEvalTensor* input1,
                      const TfLiteEvalTensor* input2, TfLiteEvalTensor* output) {
   switch (output->type) {
-    case kTfLiteFloat32: {
-      tflite::ArithmeticParams op_params;
-      SetActivationParams(data->output_activation_min_f32,
-                          data->output_activation_max_f32, &op_params);
-      if (data->requires_broadcast) {
-        reference_ops::BroadcastAdd4DSlow(
-            op_params, tflite::micro::GetTensorShape(input1),
-            tflite::micro::GetTensorData<float>(input1),
-            tflite::micro::GetTensorShape(input2),
-            tflite::micro::GetTensorData<float>(input2),
-            tflite::micro::GetTensorShape(output),
-            tflite::micro::GetTensorData<float>(output));
-      } else {
-        reference_ops::Add(op_params, tflite::micro::GetTensorShape(input1),
-                           tflite::micro::GetTensorData<float>(input1),
-                           tflite::micro::GetTensorShape(input2),
-                           tflite::micro::GetTensorData<float>(input2),
-                           tflite::micro::GetTensorShape(output),
-                           tflite::micro::GetTensorData<float>(output));
-      }
-    } break;
-    case kTfLiteInt32: {
-      tflite::ArithmeticParams op_params;
-      SetActivationParams(std::numeric_limits<int32_t>::lowest(),
-                          std::numeric_limits<int32_t>::max(), &op_params);
-      if (data->requires_broadcast) {
-        reference_ops::BroadcastAdd4DSlow(
-            op_params, tflite::micro::GetTensorShape(input1),
-            tflite::micro::GetTensorData<int32_t>(input1),
-            tflite::micro::GetTensorShape(input2),
-            tflite::micro::GetTensorData<int32_t>(input2),
-            tflite::micro::GetTensorShape(output),
-            tflite::micro::GetTensorData<int32_t>(output));
-      } else {
-        reference_ops::Add(op_params, tflite::micro::GetTensorShape(input1),
-                           tflite::micro::GetTensorData<int32_t>(input1),
-                           tflite::micro::GetTensorShape(input2),
-                           tflite::micro::GetTensorData<int32_t>(input2),
-                           tflite::micro::GetTensorShape(output),
-                           tflite::micro::GetTensorData<int32_t>(output));
-      }
-    } break;
+    case kTfLiteFloat32:
+      BroadcastAdd<float>(data, data->output_activation_min_f32,
+                          data->output_activation_max_f32, input1, input2,
+                          output);
+      break;
+    case kTfLiteInt32:
+      BroadcastAdd<int32_t>(data, std::numeric_limits<int32_t>::lowest(),
+                            std::numeric_limits<int32_t>::max(), input1,
+                            input2, output);
+      break;
     default:
       MicroPrintf("Type %s (%d) not supported.",
                   TfLiteTypeGetName(output->type), output->type);
@@ -16,32 +16,227 @@ limitations under the License.
 #include "tensorflow/lite/micro/kernels/conv.h"
 
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/common.h"
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
 #include "tensorflow/lite/kernels/internal/reference/conv.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/conv.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/padding.h"
+#include "tensorflow/lite/micro/kernels/conv_winograd.h"
+#include "tensorflow/lite/micro/kernels/float_gemm.h"
+#include "tensorflow/lite/micro/kernels/kernel_backend.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/palettized_weights.h"
+#include "tensorflow/lite/micro/kernels/sparse_fully_connected.h"
+#include "tensorflow/lite/micro/micro_arena_constants.h"
 #include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/schema/schema_generated.h"
 
 namespace tflite {
 namespace {
 
+// Alignment of the im2col buffer. The x86 dot products of the CMSIS-NN GEMM
+// cores load up to 64 bytes of it at a time, the Arm ones need no more than the
+// default.
+#if defined(ARM_NN_X86_SIMD)
+constexpr size_t kIm2colBufferAlignment = 64;
+#else
+constexpr size_t kIm2colBufferAlignment = MicroArenaBufferAlignment();
+#endif
+
+// Output tile sizes of the Winograd backends.
+constexpr int kWinogradTileSizes[] = {2, 4};
+constexpr int kWinogradVariants =
+    sizeof(kWinogradTileSizes) / sizeof(kWinogradTileSizes[0]);
+
 struct OpData {
   OpDataConv reference_op_data;
 
   // Index to buffer for optimizations if applicable.
   int buffer_idx;
+
+  // Implementation used for int8 activations and int8 weights.
+  micro::KernelBackendSelection int8_backend;
+
+  // Implementation used for float activations and float weights.
+  micro::KernelBackendSelection float_backend;
+
+  // State of the Winograd backends, one per tile size.
+  OpDataConvWinograd winograd[kWinogradVariants];
+
+  // True if the float GEMM backend can run the node, which has a single group.
+  bool float_gemm_eligible;
+  // Index to the scratch buffer of the float GEMM backend.
+  int float_gemm_buffer_idx;
+
+  // True if the node is an ungrouped, unpadded 1x1 convolution with a
+  // constant 2:4 structured-sparse filter.
+  bool sparse_2_4_eligible;
+  // Filter packed by arm_fully_connected_s8_sparse_2_4_pack_weights(), or
+  // nullptr if the 2:4 sparse backend will not run.
+  int8_t* sparse_2_4_filter;
+
+  // True if the node is an ungrouped, unpadded 1x1 convolution, whose filter
+  // columns of zero-point input channels can be skipped.
+  bool sparse_input_eligible;
+  // Index to the scratch buffer of the sparse input backend.
+  int sparse_input_buffer_idx;
+
+  // Codebooks of a palettized filter, or nullptr if the filter is stored as
+  // is. Palettized filters are decompressed in the buffer at `buffer_idx`.
+  const PalettizedWeights* palettized_filter;
+};
+
+bool IsFloatGemmEligible(TfLiteContext* context, TfLiteNode* node) {
+  const OpData* data = static_cast<const OpData*>(node->user_data);
+  return data->float_gemm_eligible;
+}
+
+template <int kVariant>
+bool IsWinogradEligible(TfLiteContext* context, TfLiteNode* node) {
+  const OpData* data = static_cast<const OpData*>(node->user_data);
+  return data->winograd[kVariant].tile_size != 0;
+}
+
+bool IsSparse2Of4Eligible(TfLiteContext* context, TfLiteNode* node) {
+  const OpData* data = static_cast<const OpData*>(node->user_data);
+  return data->sparse_2_4_eligible;
+}
+
+bool IsSparseInputEligible(TfLiteContext* context, TfLiteNode* node) {
+  const OpData* data = static_cast<const OpData*>(node->user_data);
+  return data->sparse_input_eligible;
+}
+
+TfLiteStatus EvalInt8CmsisNn(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalInt8Reference(TfLiteContext* context, TfLiteNode* node);
+template <int kVariant>
+TfLiteStatus EvalInt8Winograd(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalInt8Sparse2Of4(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalInt8SparseInput(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalFloatGemm(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalFloatReference(TfLiteContext* context, TfLiteNode* node);
+template <int kVariant>
+TfLiteStatus EvalFloatWinograd(TfLiteContext* context, TfLiteNode* node);
+
+// Implementations for int8 activations and int8 weights. The Winograd
+// backends are bit-exact, and are picked by autotuning.
+constexpr micro::KernelBackend kInt8Backends[] = {
+    {"cmsis_nn", nullptr, EvalInt8CmsisNn},
+    {"reference", nullptr, EvalInt8Reference},
+    {"winograd_2x2", IsWinogradEligible<0>, EvalInt8Winograd<0>},
+    {"winograd_4x4", IsWinogradEligible<1>, EvalInt8Winograd<1>},
+    {"sparse_2_4", IsSparse2Of4Eligible, EvalInt8Sparse2Of4},
+    {"sparse_input", IsSparseInputEligible, EvalInt8SparseInput},
 };
+constexpr int kInt8BackendCount =
+    sizeof(kInt8Backends) / sizeof(kInt8Backends[0]);
+constexpr int kInt8CmsisNnBackend = 0;
+constexpr int kInt8ReferenceBackend = 1;
+constexpr int kInt8WinogradBackend = 2;
+constexpr int kInt8Sparse2Of4Backend = 4;
+constexpr int kInt8SparseInputBackend = 5;
+
+// Order of preference of kInt8Backends. The 2:4 sparse backend does half the
+// multiplications of the dense ones, so it is used whenever the filter allows
+// it. The sparse input backend checks each pixel in a single pass over its
+// channels, and runs the dense pixels through the cmsis_nn GEMM, so it is
+// preferred for the 1x1 convolutions it can run.
+constexpr int8_t kInt8BackendPreference[kInt8BackendCount] = {
+    kInt8Sparse2Of4Backend, kInt8SparseInputBackend, kInt8CmsisNnBackend,
+    kInt8ReferenceBackend,  kInt8WinogradBackend,    kInt8WinogradBackend + 1};
+
+// Implementations for float activations and float weights, in order of
+// preference. The Winograd backends round differently from the other
+// kernels, and need a transformed copy of the filter, so they are only used
+// when autotuning picks them.
+constexpr micro::KernelBackend kFloatBackends[] = {
+    {"gemm", IsFloatGemmEligible, EvalFloatGemm},
+    {"reference", nullptr, EvalFloatReference},
+    {"winograd_2x2", IsWinogradEligible<0>, EvalFloatWinograd<0>},
+    {"winograd_4x4", IsWinogradEligible<1>, EvalFloatWinograd<1>},
+};
+constexpr int kFloatBackendCount =
+    sizeof(kFloatBackends) / sizeof(kFloatBackends[0]);
+constexpr int kFloatGemmBackend = 0;
+constexpr int kFloatWinogradBackend = 2;
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
   TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
   return context->AllocatePersistentBuffer(context, sizeof(OpData));
 }
 
+// Selects the backend of the node from `backends`, in the order of
+// `preference` if set, and prepares the Winograd variants that may run, which
+// start at `winograd_backend`. Their int8 accumulator bound is only checked
+// then, since it scans the whole filter.
+TfLiteStatus PrepareBackends(TfLiteContext* context, TfLiteNode* node,
+                             const TfLiteConvParams& params,
+                             const TfLiteTensor* input,
+                             const TfLiteTensor* filter,
+                             const TfLiteTensor* output,
+                             const micro::KernelBackend* backends, int count,
+                             const int8_t* preference, int winograd_backend,
+                             micro::KernelBackendSelection* selection) {
+  OpData* data = static_cast<OpData*>(node->user_data);
+  for (int i = 0; i < kWinogradVariants; ++i) {
+    data->winograd[i].tile_size =
+        ConvWinogradIsEligible(params, input, filter, kWinogradTileSizes[i])
+            ? kWinogradTileSizes[i]
+            : 0;
+  }
+
+  // The filter type and the zero points decide which backends are eligible,
+  // so nodes that differ in them must not share a tuning result.
+  const int32_t config[] = {input->type,
+                            filter->type,
+                            input->params.zero_point,
+                            filter->params.zero_point,
+                            input->dims->data[0],
+                            input->dims->data[1],
+                            input->dims->data[2],
+                            input->dims->data[3],
+                            filter->dims->data[0],
+                            filter->dims->data[1],
+                            filter->dims->data[2],
+                            filter->dims->data[3],
+                            output->dims->data[1],
+                            output->dims->data[2],
+                            params.stride_height,
+                            params.stride_width,
+                            params.dilation_height_factor,
+                            params.dilation_width_factor,
+                            data->reference_op_data.padding.height,
+                            data->reference_op_data.padding.width};
+  TF_LITE_ENSURE_STATUS(micro::PrepareKernelBackends(
+      context, node, backends, count,
+      micro::KernelTuningKey(BuiltinOperator_CONV_2D, config,
+                             sizeof(config) / sizeof(config[0])),
+      selection, preference));
+
+  for (int i = 0; i < kWinogradVariants; ++i) {
+    const int backend = winograd_backend + i;
+    if (!micro::KernelBackendMayRun(*selection, backend)) {
+      continue;
+    }
+    if (!ConvWinogradAccumulatorsFit(input, filter, kWinogradTileSizes[i])) {
+      data->winograd[i].tile_size = 0;
+      TF_LITE_ENSURE_STATUS(
+          micro::DisableKernelBackend(context, backend, count, selection,
+                                      preference));
+      continue;
+    }
+    TF_LITE_ENSURE_STATUS(ConvWinogradPrepare(context, input, filter, output,
+                                              kWinogradTileSizes[i],
+                                              &data->winograd[i]));
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   TFLITE_DCHECK(node->user_data != nullptr);
   TFLITE_DCHECK(node->builtin_data != nullptr);
@@ -128,10 +323,18 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
       filter_dims.h, output_dims.w, output_dims.h, input->type,
       &data->reference_op_data));
 
-  // CMSIS_NN allows INT64 or nullptr bias data pointer
-  if (input->type == kTfLiteInt8 ||
-      (input->type == kTfLiteInt16 &&
-       (bias_type == kTfLiteInt64 || bias_type == kTfLiteNoType))) {
+  TF_LITE_ENSURE_STATUS(PreparePalettizedWeights(
+      context, node, kConvWeightsTensor, filter, &data->palettized_filter));
+
+  if (data->palettized_filter != nullptr) {
+    TF_LITE_ENSURE_TYPES_EQ(context, filter->type, input->type);
+    TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
+        context, PalettizedScratchSize(GetTensorShape(filter), 0, filter->type),
+        &data->buffer_idx));
+  } else if (input->type == kTfLiteInt8 ||
+             // CMSIS_NN allows INT64 or nullptr bias data pointer
+             (input->type == kTfLiteInt16 &&
+              (bias_type == kTfLiteInt64 || bias_type == kTfLiteNoType))) {
     // Initialize cmsis_nn convolution parameters
     cmsis_nn_conv_params conv_params;
     conv_params.input_offset = -input->params.zero_point;
@@ -156,13 +359,76 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     }
 
     if (buf_size > 0) {
-      TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
-          context, buf_size, &data->buffer_idx));
+      TF_LITE_ENSURE_STATUS(micro::RequestAlignedScratchBufferInArena(
+          context, buf_size, kIm2colBufferAlignment, &data->buffer_idx));
     } else {
       data->buffer_idx = -1;
     }
   }
 
+  if (data->palettized_filter != nullptr) {
+    // Nothing to select.
+  } else if (input->type == kTfLiteInt8 && filter->type == kTfLiteInt8) {
+    data->sparse_input_eligible =
+        filter_dims.h == 1 && filter_dims.w == 1 && groups == 1 &&
+        data->reference_op_data.padding.height == 0 &&
+        data->reference_op_data.padding.width == 0 &&
+        input_dims.c <= ARM_NN_SPARSE_LHS_MAX_COLS;
+    data->sparse_input_buffer_idx = -1;
+    data->sparse_2_4_eligible =
+        data->sparse_input_eligible && IsConstantTensor(filter) &&
+        IsSparse2Of4(GetTensorData<int8_t>(filter), output_dims.c,
+                     input_dims.c);
+    data->sparse_2_4_filter = nullptr;
+    TF_LITE_ENSURE_STATUS(PrepareBackends(
+        context, node, params, input, filter, output, kInt8Backends,
+        kInt8BackendCount, kInt8BackendPreference, kInt8WinogradBackend,
+        &data->int8_backend));
+    if (micro::KernelBackendMayRun(data->int8_backend,
+                                   kInt8Sparse2Of4Backend)) {
+      // The [C_OUT, 1, 1, C_IN] filter is packed as [C_OUT, C_IN] FC weights.
+      cmsis_nn_dims fc_filter_dims;
+      fc_filter_dims.n = input_dims.c;
+      fc_filter_dims.h = 1;
+      fc_filter_dims.w = 1;
+      fc_filter_dims.c = output_dims.c;
+      const int32_t packed_size =
+          arm_fully_connected_s8_sparse_2_4_get_buffer_size(&fc_filter_dims);
+      data->sparse_2_4_filter = static_cast<int8_t*>(
+          micro_context->AllocatePackedWeightBuffer(packed_size));
+      if (data->sparse_2_4_filter == nullptr) {
+        MicroPrintf("Failed to allocate %d bytes for the 2:4 sparse filter.",
+                    static_cast<int>(packed_size));
+        return kTfLiteError;
+      }
+      TF_LITE_ENSURE_EQ(context,
+                        arm_fully_connected_s8_sparse_2_4_pack_weights(
+                            &fc_filter_dims, GetTensorData<int8_t>(filter),
+                            data->sparse_2_4_filter),
+                        ARM_CMSIS_NN_SUCCESS);
+    }
+    if (micro::KernelBackendMayRun(data->int8_backend,
+                                   kInt8SparseInputBackend)) {
+      const int32_t sparse_input_buf_size =
+          arm_convolve_1x1_s8_sparse_input_get_buffer_size(&input_dims);
+      if (sparse_input_buf_size > 0) {
+        TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
+            context, sparse_input_buf_size, &data->sparse_input_buffer_idx));
+      }
+    }
+  } else if (input->type == kTfLiteFloat32) {
+    data->float_gemm_eligible = input->dims->data[3] == filter->dims->data[3];
+    TF_LITE_ENSURE_STATUS(PrepareBackends(
+        context, node, params, input, filter, output, kFloatBackends,
+        kFloatBackendCount, nullptr, kFloatWinogradBackend,
+        &data->float_backend));
+    if (micro::KernelBackendMayRun(data->float_backend, kFloatGemmBackend)) {
+      TF_LITE_ENSURE_STATUS(micro::RequestAlignedScratchBufferInArena(
+          context, FloatGemmConvScratchSize(GetTensorShape(input)),
+          MicroArenaVectorBufferAlignment(), &data->float_gemm_buffer_idx));
+    }
+  }
+
   micro_context->DeallocateTempTfLiteTensor(output);
   micro_context->DeallocateTempTfLiteTensor(input);
   micro_context->DeallocateTempTfLiteTensor(filter);
@@ -338,7 +604,7 @@ TfLiteStatus EvalInt4(TfLiteContext* context, TfLiteNode* node) {
       context, node, params, data, input, filter, bias, output);
 }
 
-TfLiteStatus EvalInt8(TfLiteContext* context, TfLiteNode* node) {
+TfLiteStatus EvalInt8CmsisNn(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteEvalTensor* input =
       tflite::micro::GetEvalInput(context, node, kConvInputTensor);
   const TfLiteEvalTensor* filter =
@@ -360,6 +626,366 @@ TfLiteStatus EvalInt8(TfLiteContext* context, TfLiteNode* node) {
       context, node, params, data, input, filter, bias, output);
 }
 
+TfLiteStatus EvalInt8Reference(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  reference_integer_ops::ConvPerChannel(
+      ConvParamsQuantized(params, data.reference_op_data),
+      data.reference_op_data.per_channel_output_multiplier,
+      data.reference_op_data.per_channel_output_shift,
+      tflite::micro::GetTensorShape(input),
+      tflite::micro::GetTensorData<int8_t>(input),
+      tflite::micro::GetTensorShape(filter),
+      tflite::micro::GetTensorData<int8_t>(filter),
+      tflite::micro::GetTensorShape(bias),
+      tflite::micro::GetOptionalTensorData<int32_t>(bias),
+      tflite::micro::GetTensorShape(output),
+      tflite::micro::GetTensorData<int8_t>(output));
+  return kTfLiteOk;
+}
+
+template <int kVariant>
+TfLiteStatus EvalInt8Winograd(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  return ConvWinogradEvalInt8(
+      context, ConvParamsQuantized(params, data.reference_op_data),
+      data.winograd[kVariant],
+      data.reference_op_data.per_channel_output_multiplier,
+      data.reference_op_data.per_channel_output_shift, input, bias, output);
+}
+
+TfLiteStatus EvalInt8Sparse2Of4(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+  TFLITE_DCHECK(data.sparse_2_4_filter != nullptr);
+
+  cmsis_nn_conv_params conv_params;
+  conv_params.input_offset = -data.reference_op_data.input_zero_point;
+  conv_params.output_offset = data.reference_op_data.output_zero_point;
+  conv_params.stride.h = params.stride_height;
+  conv_params.stride.w = params.stride_width;
+  conv_params.dilation.h = params.dilation_height_factor;
+  conv_params.dilation.w = params.dilation_width_factor;
+  conv_params.padding.h = data.reference_op_data.padding.height;
+  conv_params.padding.w = data.reference_op_data.padding.width;
+  conv_params.activation.min = data.reference_op_data.output_activation_min;
+  conv_params.activation.max = data.reference_op_data.output_activation_max;
+
+  cmsis_nn_per_channel_quant_params quant_params;
+  quant_params.multiplier = const_cast<int32_t*>(
+      data.reference_op_data.per_channel_output_multiplier);
+  quant_params.shift =
+      const_cast<int32_t*>(data.reference_op_data.per_channel_output_shift);
+
+  cmsis_nn_dims input_dims;
+  input_dims.n = input->dims->data[0];
+  input_dims.h = input->dims->data[1];
+  input_dims.w = input->dims->data[2];
+  input_dims.c = input->dims->data[3];
+
+  cmsis_nn_dims output_dims;
+  output_dims.n = output->dims->data[0];
+  output_dims.h = output->dims->data[1];
+  output_dims.w = output->dims->data[2];
+  output_dims.c = output->dims->data[3];
+
+  TF_LITE_ENSURE_EQ(
+      context,
+      arm_convolve_1x1_s8_sparse_2_4(
+          &conv_params, &quant_params, &input_dims,
+          tflite::micro::GetTensorData<int8_t>(input), data.sparse_2_4_filter,
+          tflite::micro::GetOptionalTensorData<int32_t>(bias), &output_dims,
+          tflite::micro::GetTensorData<int8_t>(output)),
+      ARM_CMSIS_NN_SUCCESS);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalInt8SparseInput(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  cmsis_nn_conv_params conv_params;
+  conv_params.input_offset = -data.reference_op_data.input_zero_point;
+  conv_params.output_offset = data.reference_op_data.output_zero_point;
+  conv_params.stride.h = params.stride_height;
+  conv_params.stride.w = params.stride_width;
+  conv_params.dilation.h = params.dilation_height_factor;
+  conv_params.dilation.w = params.dilation_width_factor;
+  conv_params.padding.h = data.reference_op_data.padding.height;
+  conv_params.padding.w = data.reference_op_data.padding.width;
+  conv_params.activation.min = data.reference_op_data.output_activation_min;
+  conv_params.activation.max = data.reference_op_data.output_activation_max;
+
+  cmsis_nn_per_channel_quant_params quant_params;
+  quant_params.multiplier = const_cast<int32_t*>(
+      data.reference_op_data.per_channel_output_multiplier);
+  quant_params.shift =
+      const_cast<int32_t*>(data.reference_op_data.per_channel_output_shift);
+
+  cmsis_nn_dims input_dims;
+  input_dims.n = input->dims->data[0];
+  input_dims.h = input->dims->data[1];
+  input_dims.w = input->dims->data[2];
+  input_dims.c = input->dims->data[3];
+
+  cmsis_nn_dims filter_dims;
+  filter_dims.n = filter->dims->data[0];
+  filter_dims.h = filter->dims->data[1];
+  filter_dims.w = filter->dims->data[2];
+  filter_dims.c = filter->dims->data[3];
+
+  cmsis_nn_dims output_dims;
+  output_dims.n = output->dims->data[0];
+  output_dims.h = output->dims->data[1];
+  output_dims.w = output->dims->data[2];
+  output_dims.c = output->dims->data[3];
+
+  cmsis_nn_context ctx;
+  ctx.buf = nullptr;
+  ctx.size = 0;
+  if (data.sparse_input_buffer_idx > -1) {
+    ctx.buf = context->GetScratchBuffer(context, data.sparse_input_buffer_idx);
+  }
+
+  TF_LITE_ENSURE_EQ(
+      context,
+      arm_convolve_1x1_s8_sparse_input(
+          &ctx, &conv_params, &quant_params, &input_dims,
+          tflite::micro::GetTensorData<int8_t>(input), &filter_dims,
+          tflite::micro::GetTensorData<int8_t>(filter),
+          tflite::micro::GetOptionalTensorData<int32_t>(bias), &output_dims,
+          tflite::micro::GetTensorData<int8_t>(output)),
+      ARM_CMSIS_NN_SUCCESS);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalInt8Palettized(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  void* scratch = context->GetScratchBuffer(context, data.buffer_idx);
+  TF_LITE_ENSURE(context, scratch != nullptr);
+  PalettizedConvPerChannel(
+      ConvParamsQuantized(params, data.reference_op_data),
+      data.reference_op_data.per_channel_output_multiplier,
+      data.reference_op_data.per_channel_output_shift,
+      tflite::micro::GetTensorShape(input),
+      tflite::micro::GetTensorData<int8_t>(input),
+      tflite::micro::GetTensorShape(filter), *data.palettized_filter,
+      tflite::micro::GetTensorShape(bias),
+      tflite::micro::GetOptionalTensorData<int32_t>(bias),
+      tflite::micro::GetTensorShape(output),
+      tflite::micro::GetTensorData<int8_t>(output), scratch);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalInt8(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  OpData* data = static_cast<OpData*>(node->user_data);
+  if (data->palettized_filter != nullptr) {
+    return EvalInt8Palettized(context, node);
+  }
+  return micro::InvokeKernelBackend(context, node, kInt8Backends,
+                                    kInt8BackendCount, &data->int8_backend);
+}
+
+TfLiteStatus EvalFloatGemm(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  void* scratch =
+      context->GetScratchBuffer(context, data.float_gemm_buffer_idx);
+  TF_LITE_ENSURE(context, scratch != nullptr);
+  FloatGemmConv(ConvParamsFloat(params, data.reference_op_data),
+                tflite::micro::GetTensorShape(input),
+                tflite::micro::GetTensorData<float>(input),
+                tflite::micro::GetTensorShape(filter),
+                tflite::micro::GetTensorData<float>(filter),
+                tflite::micro::GetTensorShape(bias),
+                tflite::micro::GetOptionalTensorData<float>(bias),
+                tflite::micro::GetTensorShape(output),
+                tflite::micro::GetTensorData<float>(output), scratch);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalFloatReference(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  tflite::reference_ops::Conv(
+      ConvParamsFloat(params, data.reference_op_data),
+      tflite::micro::GetTensorShape(input),
+      tflite::micro::GetTensorData<float>(input),
+      tflite::micro::GetTensorShape(filter),
+      tflite::micro::GetTensorData<float>(filter),
+      tflite::micro::GetTensorShape(bias),
+      tflite::micro::GetOptionalTensorData<float>(bias),
+      tflite::micro::GetTensorShape(output),
+      tflite::micro::GetTensorData<float>(output),
+      tflite::micro::GetTensorShape(nullptr), nullptr);
+  return kTfLiteOk;
+}
+
+template <int kVariant>
+TfLiteStatus EvalFloatWinograd(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  return ConvWinogradEvalFloat(context,
+                               ConvParamsFloat(params, data.reference_op_data),
+                               data.winograd[kVariant], input, bias, output);
+}
+
+TfLiteStatus EvalFloatPalettized(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kConvBiasTensor)
+          : nullptr;
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kConvOutputTensor);
+
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto& params =
+      *(reinterpret_cast<TfLiteConvParams*>(node->builtin_data));
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  void* scratch = context->GetScratchBuffer(context, data.buffer_idx);
+  TF_LITE_ENSURE(context, scratch != nullptr);
+  PalettizedConv(ConvParamsFloat(params, data.reference_op_data),
+                 tflite::micro::GetTensorShape(input),
+                 tflite::micro::GetTensorData<float>(input),
+                 tflite::micro::GetTensorShape(filter),
+                 *data.palettized_filter, tflite::micro::GetTensorShape(bias),
+                 tflite::micro::GetOptionalTensorData<float>(bias),
+                 tflite::micro::GetTensorShape(output),
+                 tflite::micro::GetTensorData<float>(output), scratch);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  OpData* data = static_cast<OpData*>(node->user_data);
+  if (data->palettized_filter != nullptr) {
+    return EvalFloatPalettized(context, node);
+  }
+  return micro::InvokeKernelBackend(context, node, kFloatBackends,
+                                    kFloatBackendCount, &data->float_backend);
+}
+
 TfLiteStatus EvalInt16x8(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteEvalTensor* input =
       tflite::micro::GetEvalInput(context, node, kConvInputTensor);
@@ -419,18 +1045,7 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
   switch (input->type) {  // Already know in/out types are same.
     case kTfLiteFloat32: {
-      tflite::reference_ops::Conv(
-          ConvParamsFloat(params, data.reference_op_data),
-          tflite::micro::GetTensorShape(input),
-          tflite::micro::GetTensorData<float>(input),
-          tflite::micro::GetTensorShape(filter),
-          tflite::micro::GetTensorData<float>(filter),
-          tflite::micro::GetTensorShape(bias),
-          tflite::micro::GetOptionalTensorData<float>(bias),
-          tflite::micro::GetTensorShape(output),
-          tflite::micro::GetTensorData<float>(output),
-          tflite::micro::GetTensorShape(nullptr), nullptr);
-      break;
+      return EvalFloat(context, node);
     }
     case kTfLiteInt8: {
       switch (filter->type) {
@@ -439,8 +1054,7 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
               context, node, params, data, input, filter, bias, output);
         }
         case kTfLiteInt8: {
-          return EvalQuantizedPerChannel<int8_t, int32_t, kTfLiteInt8>(
-              context, node, params, data, input, filter, bias, output);
+          return EvalInt8(context, node);
         }
         default: {
           MicroPrintf("Filter type %s (%d) not supported.",
@@ -26,8 +26,12 @@ limitations under the License.
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/padding.h"
 #include "tensorflow/lite/micro/kernels/conv.h"
+#include "tensorflow/lite/micro/kernels/float_gemm.h"
+#include "tensorflow/lite/micro/kernels/kernel_backend.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/palettized_weights.h"
 #include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/schema/schema_generated.h"
 
 namespace tflite {
 namespace {
@@ -37,7 +41,26 @@ struct OpData {
 
   // Index to buffer for optimizations if applicable.
   int buffer_idx;
+
+  // Implementation used for float activations and float weights.
+  micro::KernelBackendSelection float_backend;
+
+  // Codebooks of a palettized filter, or nullptr if the filter is stored as
+  // is. Palettized filters are decompressed in the buffer at `buffer_idx`.
+  const PalettizedWeights* palettized_filter;
+};
+
+TfLiteStatus EvalFloatVectorized(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalFloatReference(TfLiteContext* context, TfLiteNode* node);
+
+// Implementations for float activations and float weights, in order of
+// preference.
+constexpr micro::KernelBackend kFloatBackends[] = {
+    {"vectorized", nullptr, EvalFloatVectorized},
+    {"reference", nullptr, EvalFloatReference},
 };
+constexpr int kFloatBackendCount =
+    sizeof(kFloatBackends) / sizeof(kFloatBackends[0]);
 
 // Always inline for optimal code size.
 void PopulateDwConvParams(
@@ -123,7 +146,18 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
       filter_height, output_width, output_height, data_type,
       &data->reference_op_data));
 
-  if (input->type == kTfLiteInt8) {
+  TF_LITE_ENSURE_STATUS(PreparePalettizedWeights(
+      context, node, kDepthwiseConvWeightsTensor, filter,
+      &data->palettized_filter));
+
+  if (data->palettized_filter != nullptr) {
+    TF_LITE_ENSURE_TYPES_EQ(context, filter->type, input->type);
+    TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
+        context,
+        PalettizedScratchSize(GetTensorShape(filter),
+                              kDepthwiseConvQuantizedDimension, filter->type),
+        &data->buffer_idx));
+  } else if (input->type == kTfLiteInt8) {
     RuntimeShape input_shape = GetTensorShape(input);
     RuntimeShape output_shape = GetTensorShape(output);
     RuntimeShape filter_shape = GetTensorShape(filter);
@@ -178,6 +212,28 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     } else {
       data->buffer_idx = -1;
     }
+  } else if (input->type == kTfLiteFloat32) {
+    const int32_t config[] = {input->type,
+                              input->dims->data[0],
+                              input->dims->data[1],
+                              input->dims->data[2],
+                              input->dims->data[3],
+                              filter->dims->data[1],
+                              filter->dims->data[2],
+                              filter->dims->data[3],
+                              output->dims->data[1],
+                              output->dims->data[2],
+                              params.stride_height,
+                              params.stride_width,
+                              params.dilation_height_factor,
+                              params.dilation_width_factor,
+                              data->reference_op_data.padding.height,
+                              data->reference_op_data.padding.width};
+    TF_LITE_ENSURE_STATUS(micro::PrepareKernelBackends(
+        context, node, kFloatBackends, kFloatBackendCount,
+        micro::KernelTuningKey(BuiltinOperator_DEPTHWISE_CONV_2D, config,
+                               sizeof(config) / sizeof(config[0])),
+        &data->float_backend));
   }
 
   micro_context->DeallocateTempTfLiteTensor(output);
@@ -356,6 +412,123 @@ void EvalQuantizedPerChannel16x8(TfLiteContext* context, TfLiteNode* node,
       ARM_CMSIS_NN_SUCCESS);
 }
 
+TfLiteStatus EvalFloatVectorized(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+
+  const auto& params =
+      *(reinterpret_cast<TfLiteDepthwiseConvParams*>(node->builtin_data));
+  const OpData& data = *(static_cast<OpData*>(node->user_data));
+
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kDepthwiseConvOutputTensor);
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kDepthwiseConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kDepthwiseConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kDepthwiseConvBiasTensor)
+          : nullptr;
+
+  FloatDepthwiseConv(DepthwiseConvParamsFloat(params, data.reference_op_data),
+                     tflite::micro::GetTensorShape(input),
+                     tflite::micro::GetTensorData<float>(input),
+                     tflite::micro::GetTensorShape(filter),
+                     tflite::micro::GetTensorData<float>(filter),
+                     tflite::micro::GetTensorShape(bias),
+                     tflite::micro::GetOptionalTensorData<float>(bias),
+                     tflite::micro::GetTensorShape(output),
+                     tflite::micro::GetTensorData<float>(output));
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalFloatReference(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+
+  const auto& params =
+      *(reinterpret_cast<TfLiteDepthwiseConvParams*>(node->builtin_data));
+  const OpData& data = *(static_cast<OpData*>(node->user_data));
+
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kDepthwiseConvOutputTensor);
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kDepthwiseConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kDepthwiseConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kDepthwiseConvBiasTensor)
+          : nullptr;
+
+  tflite::reference_ops::DepthwiseConv(
+      DepthwiseConvParamsFloat(params, data.reference_op_data),
+      tflite::micro::GetTensorShape(input),
+      tflite::micro::GetTensorData<float>(input),
+      tflite::micro::GetTensorShape(filter),
+      tflite::micro::GetTensorData<float>(filter),
+      tflite::micro::GetTensorShape(bias),
+      tflite::micro::GetOptionalTensorData<float>(bias),
+      tflite::micro::GetTensorShape(output),
+      tflite::micro::GetTensorData<float>(output));
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalPalettized(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+
+  const auto& params =
+      *(reinterpret_cast<TfLiteDepthwiseConvParams*>(node->builtin_data));
+  const OpData& data = *(static_cast<OpData*>(node->user_data));
+
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kDepthwiseConvOutputTensor);
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kDepthwiseConvInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kDepthwiseConvWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      (NumInputs(node) == 3)
+          ? tflite::micro::GetEvalInput(context, node, kDepthwiseConvBiasTensor)
+          : nullptr;
+
+  void* scratch = context->GetScratchBuffer(context, data.buffer_idx);
+  TF_LITE_ENSURE(context, scratch != nullptr);
+  if (input->type == kTfLiteFloat32) {
+    PalettizedDepthwiseConv(
+        DepthwiseConvParamsFloat(params, data.reference_op_data),
+        tflite::micro::GetTensorShape(input),
+        tflite::micro::GetTensorData<float>(input),
+        tflite::micro::GetTensorShape(filter), *data.palettized_filter,
+        tflite::micro::GetTensorShape(bias),
+        tflite::micro::GetOptionalTensorData<float>(bias),
+        tflite::micro::GetTensorShape(output),
+        tflite::micro::GetTensorData<float>(output), scratch);
+  } else {
+    PalettizedDepthwiseConvPerChannel(
+        DepthwiseConvParamsQuantized(params, data.reference_op_data),
+        data.reference_op_data.per_channel_output_multiplier,
+        data.reference_op_data.per_channel_output_shift,
+        tflite::micro::GetTensorShape(input),
+        tflite::micro::GetTensorData<int8_t>(input),
+        tflite::micro::GetTensorShape(filter), *data.palettized_filter,
+        tflite::micro::GetTensorShape(bias),
+        tflite::micro::GetOptionalTensorData<int32_t>(bias),
+        tflite::micro::GetTensorShape(output),
+        tflite::micro::GetTensorData<int8_t>(output), scratch);
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  OpData* data = static_cast<OpData*>(node->user_data);
+  return micro::InvokeKernelBackend(context, node, kFloatBackends,
+                                    kFloatBackendCount, &data->float_backend);
+}
+
 TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   TFLITE_DCHECK(node->user_data != nullptr);
   TFLITE_DCHECK(node->builtin_data != nullptr);
@@ -375,19 +548,13 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
           ? tflite::micro::GetEvalInput(context, node, kDepthwiseConvBiasTensor)
           : nullptr;
 
+  if (data.palettized_filter != nullptr) {
+    return EvalPalettized(context, node);
+  }
+
   switch (input->type) {  // Already know in/out types are same.
     case kTfLiteFloat32: {
-      tflite::reference_ops::DepthwiseConv(
-          DepthwiseConvParamsFloat(params, data.reference_op_data),
-          tflite::micro::GetTensorShape(input),
-          tflite::micro::GetTensorData<float>(input),
-          tflite::micro::GetTensorShape(filter),
-          tflite::micro::GetTensorData<float>(filter),
-          tflite::micro::GetTensorShape(bias),
-          tflite::micro::GetOptionalTensorData<float>(bias),
-          tflite::micro::GetTensorShape(output),
-          tflite::micro::GetTensorData<float>(output));
-      break;
+      return EvalFloat(context, node);
     }
     case kTfLiteInt8:
       switch (filter->type) {
@@ -439,6 +606,10 @@ TfLiteStatus EvalInt8(TfLiteContext* context, TfLiteNode* node) {
           ? tflite::micro::GetEvalInput(context, node, kDepthwiseConvBiasTensor)
           : nullptr;
 
+  if (data.palettized_filter != nullptr) {
+    return EvalPalettized(context, node);
+  }
+
   EvalQuantizedPerChannel(context, node, params, data, input, filter, bias,
                           output);
   return kTfLiteOk;
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/kernels/fully_connected.h"
 
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/common.h"
@@ -25,13 +26,26 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/reference/integer_ops/fully_connected.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/float_gemm.h"
+#include "tensorflow/lite/micro/kernels/kernel_backend.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/palettized_weights.h"
+#include "tensorflow/lite/micro/kernels/sparse_fully_connected.h"
 #include "tensorflow/lite/micro/micro_arena_constants.h"
 #include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/schema/schema_generated.h"
 
 namespace tflite {
 namespace {
 
+// Alignment asked for the int8 input, which the CMSIS-NN GEMM cores read
+// directly. Their x86 dot products load up to 64 bytes of it at a time.
+#if defined(ARM_NN_X86_SIMD)
+constexpr size_t kInt8InputAlignment = 64;
+#else
+constexpr size_t kInt8InputAlignment = MicroArenaBufferAlignment();
+#endif
+
 struct OpData {
   OpDataFullyConnected reference_op_data;
 
@@ -48,8 +62,105 @@ struct OpData {
   int32_t batches;
   int32_t accum_depth;
   int32_t output_depth;
+
+  // True if the filter can be packed at Prepare: it is constant and
+  // symmetrically quantized.
+  bool packed_filter_eligible;
+  // Filter packed by arm_fully_connected_s8_pack_weights(), along with its row
+  // sums, or nullptr if the packed backend will not run.
+  int8_t* packed_filter;
+
+  // True if the filter could be packed and is also 2:4 structured sparse. The
+  // packed backend is then not eligible, since it would keep a dense copy of
+  // the filter for more multiplications.
+  bool sparse_2_4_filter_eligible;
+  // Filter packed by arm_fully_connected_s8_sparse_2_4_pack_weights(), or
+  // nullptr if the 2:4 sparse backend will not run.
+  int8_t* sparse_2_4_filter;
+
+  // True if the filter columns of zero-point inputs can be skipped: the filter
+  // is symmetrically quantized and its rows are short enough to be indexed.
+  bool sparse_input_eligible;
+  // Index to the scratch buffer of the sparse input backend.
+  int sparse_input_buffer_idx;
+
+  // Index arrays of a block-sparse filter, or nullptr if the filter is dense.
+  const BlockSparseWeights* sparse_filter;
+
+  // Codebooks of a palettized filter, or nullptr if the filter is stored as
+  // is. Palettized filters are decompressed in the scratch buffer.
+  const PalettizedWeights* palettized_filter;
+
+  // Implementation used for int8 activations and int8 weights.
+  micro::KernelBackendSelection int8_backend;
+
+  // Implementation used for float activations and float weights.
+  micro::KernelBackendSelection float_backend;
 };
 
+bool IsPackedFilterEligible(TfLiteContext* context, TfLiteNode* node) {
+  const OpData* data = static_cast<const OpData*>(node->user_data);
+  return data->packed_filter_eligible;
+}
+
+bool IsSparse2Of4FilterEligible(TfLiteContext* context, TfLiteNode* node) {
+  const OpData* data = static_cast<const OpData*>(node->user_data);
+  return data->sparse_2_4_filter_eligible;
+}
+
+bool IsSparseInputEligible(TfLiteContext* context, TfLiteNode* node) {
+  const OpData* data = static_cast<const OpData*>(node->user_data);
+  return data->sparse_input_eligible;
+}
+
+TfLiteStatus EvalInt8CmsisNn(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalInt8Reference(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalInt8Packed(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalInt8Sparse2Of4(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalInt8SparseInput(TfLiteContext* context, TfLiteNode* node);
+
+// Implementations for int8 activations and int8 weights. The packed backend
+// keeps a second copy of the filter in the arena, so it is only used when
+// autotuning picks it.
+constexpr micro::KernelBackend kInt8Backends[] = {
+    {"cmsis_nn", nullptr, EvalInt8CmsisNn},
+    {"reference", nullptr, EvalInt8Reference},
+    {"packed", IsPackedFilterEligible, EvalInt8Packed},
+    {"sparse_2_4", IsSparse2Of4FilterEligible, EvalInt8Sparse2Of4},
+    {"sparse_input", IsSparseInputEligible, EvalInt8SparseInput},
+};
+constexpr int kInt8BackendCount =
+    sizeof(kInt8Backends) / sizeof(kInt8Backends[0]);
+constexpr int kInt8CmsisNnBackend = 0;
+constexpr int kInt8ReferenceBackend = 1;
+constexpr int kInt8PackedBackend = 2;
+constexpr int kInt8Sparse2Of4Backend = 3;
+constexpr int kInt8SparseInputBackend = 4;
+
+// Order of preference of kInt8Backends. The 2:4 sparse backend does half the
+// multiplications of the dense ones, so it is used whenever the filter allows
+// it. Its packed filter holds the row sums, so the kernel sums of the
+// cmsis_nn backend are then not allocated. The sparse input backend checks
+// each input vector in a single pass, and runs the cmsis_nn kernel on those
+// with more than ARM_NN_SPARSE_LHS_MAX_COUNT values off the zero point, so it
+// costs little over cmsis_nn on dense inputs and skips most of the work after
+// a ReLU.
+constexpr int8_t kInt8BackendPreference[kInt8BackendCount] = {
+    kInt8Sparse2Of4Backend, kInt8SparseInputBackend, kInt8CmsisNnBackend,
+    kInt8ReferenceBackend, kInt8PackedBackend};
+
+TfLiteStatus EvalFloatGemm(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalFloatReference(TfLiteContext* context, TfLiteNode* node);
+
+// Implementations for float activations and float weights, in order of
+// preference.
+constexpr micro::KernelBackend kFloatBackends[] = {
+    {"gemm", nullptr, EvalFloatGemm},
+    {"reference", nullptr, EvalFloatReference},
+};
+constexpr int kFloatBackendCount =
+    sizeof(kFloatBackends) / sizeof(kFloatBackends[0]);
+
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
   TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
   return context->AllocatePersistentBuffer(context, sizeof(OpData));
@@ -94,13 +205,34 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
 
   // Set buffer index to a reset value
   data->buffer_idx = -1;
+  data->kernel_sums = nullptr;
   TF_LITE_ENSURE_STATUS(CalculateOpDataFullyConnected(
       context, params->activation, input->type, input, filter, bias, output,
       &(data->reference_op_data)));
 
-  int32_t buf_size = 0;
+  TF_LITE_ENSURE_STATUS(PrepareBlockSparseWeights(
+      context, node, kFullyConnectedWeightsTensor, filter->type,
+      data->output_depth, data->accum_depth, &data->sparse_filter));
+  TF_LITE_ENSURE_STATUS(PreparePalettizedWeights(
+      context, node, kFullyConnectedWeightsTensor, filter,
+      &data->palettized_filter));
 
-  if (input->type == kTfLiteInt16) {
+  int32_t buf_size = 0;
+  int32_t kernel_sums_size = 0;
+
+  if (data->sparse_filter != nullptr) {
+    // Sparse filters run on the block-sparse kernels only, which need no
+    // scratch buffer.
+    TF_LITE_ENSURE(context, IsConstantTensor(filter));
+    TF_LITE_ENSURE_TYPES_EQ(context, filter->type, input->type);
+    if (input->type == kTfLiteInt8) {
+      TF_LITE_ENSURE_EQ(context, data->reference_op_data.filter_zero_point,
+                        0);
+    }
+  } else if (data->palettized_filter != nullptr) {
+    TF_LITE_ENSURE_TYPES_EQ(context, filter->type, input->type);
+    buf_size = PalettizedScratchSize(filter_shape, 0, filter->type);
+  } else if (input->type == kTfLiteInt16) {
     TF_LITE_ENSURE_EQ(context, input->params.zero_point, 0);
     TF_LITE_ENSURE_EQ(context, output->params.zero_point, 0);
     buf_size = arm_fully_connected_s16_get_buffer_size(&filter_dims);
@@ -128,15 +260,10 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     } else {
       buf_size = arm_fully_connected_s8_get_buffer_size(&filter_dims);
 
-      int8_t* filter_data = GetTensorData<int8_t>(filter);
-      data->kernel_sums = nullptr;
-
-      if (buf_size > 0 && filter_data != nullptr) {
-        data->kernel_sums = static_cast<int32_t*>(
-            context->AllocatePersistentBuffer(context, buf_size));
-
-        arm_vector_sum_s8(data->kernel_sums, filter_dims.n, data->output_depth,
-                          filter_data, 1, nullptr);
+      if (buf_size > 0 && GetTensorData<int8_t>(filter) != nullptr) {
+        // The kernel sums of a constant filter are computed once, after the
+        // backend selection, since not every backend reads them.
+        kernel_sums_size = buf_size;
 
         // Do not request a scratch buffer since using persistent memory
         buf_size = 0;
@@ -148,6 +275,112 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
         context, buf_size, &data->buffer_idx));
   }
+  if (input->type == kTfLiteInt8) {
+    TF_LITE_ENSURE_STATUS(micro::RequestInputAlignment(
+        context, node, kFullyConnectedInputTensor, kInt8InputAlignment));
+  }
+
+  if (data->sparse_filter != nullptr || data->palettized_filter != nullptr) {
+    // Nothing to select.
+  } else if (input->type == kTfLiteInt8 && filter->type == kTfLiteInt8) {
+    data->packed_filter_eligible =
+        IsConstantTensor(filter) &&
+        data->reference_op_data.filter_zero_point == 0;
+    data->packed_filter = nullptr;
+    data->sparse_2_4_filter_eligible =
+        data->packed_filter_eligible &&
+        IsSparse2Of4(GetTensorData<int8_t>(filter), data->output_depth,
+                     data->accum_depth);
+    data->sparse_2_4_filter = nullptr;
+    if (data->sparse_2_4_filter_eligible) {
+      data->packed_filter_eligible = false;
+    }
+    // With MVE, inputs that are not sparse enough need the kernel sums.
+    data->sparse_input_eligible =
+        data->reference_op_data.filter_zero_point == 0 &&
+        data->accum_depth <= ARM_NN_SPARSE_LHS_MAX_COLS &&
+        (arm_fully_connected_s8_get_buffer_size(&filter_dims) == 0 ||
+         kernel_sums_size > 0);
+    data->sparse_input_buffer_idx = -1;
+
+    // The zero points decide which backends are eligible, so nodes that
+    // differ in them must not share a tuning result.
+    const int32_t config[] = {input->type,
+                              filter->type,
+                              input->params.zero_point,
+                              filter->params.zero_point,
+                              data->batches,
+                              data->accum_depth,
+                              data->output_depth,
+                              output_dim_count};
+    TF_LITE_ENSURE_STATUS(micro::PrepareKernelBackends(
+        context, node, kInt8Backends, kInt8BackendCount,
+        micro::KernelTuningKey(BuiltinOperator_FULLY_CONNECTED, config,
+                               sizeof(config) / sizeof(config[0])),
+        &data->int8_backend, kInt8BackendPreference));
+
+    if (kernel_sums_size > 0 &&
+        (micro::KernelBackendMayRun(data->int8_backend, kInt8CmsisNnBackend) ||
+         micro::KernelBackendMayRun(data->int8_backend,
+                                    kInt8SparseInputBackend))) {
+      data->kernel_sums = static_cast<int32_t*>(
+          micro_context->AllocatePackedWeightBuffer(kernel_sums_size));
+      TF_LITE_ENSURE(context, data->kernel_sums != nullptr);
+
+      arm_vector_sum_s8(data->kernel_sums, filter_dims.n, data->output_depth,
+                        GetTensorData<int8_t>(filter), 1, nullptr);
+    }
+    if (micro::KernelBackendMayRun(data->int8_backend, kInt8PackedBackend)) {
+      const int32_t packed_size =
+          arm_fully_connected_s8_packed_get_buffer_size(&filter_dims);
+      data->packed_filter = static_cast<int8_t*>(
+          micro_context->AllocatePackedWeightBuffer(packed_size));
+      if (data->packed_filter == nullptr) {
+        MicroPrintf("Failed to allocate %d bytes for the packed filter.",
+                    static_cast<int>(packed_size));
+        return kTfLiteError;
+      }
+      TF_LITE_ENSURE_EQ(context,
+                        arm_fully_connected_s8_pack_weights(
+                            &filter_dims, GetTensorData<int8_t>(filter),
+                            data->packed_filter),
+                        ARM_CMSIS_NN_SUCCESS);
+    }
+    if (micro::KernelBackendMayRun(data->int8_backend,
+                                   kInt8Sparse2Of4Backend)) {
+      const int32_t packed_size =
+          arm_fully_connected_s8_sparse_2_4_get_buffer_size(&filter_dims);
+      data->sparse_2_4_filter = static_cast<int8_t*>(
+          micro_context->AllocatePackedWeightBuffer(packed_size));
+      if (data->sparse_2_4_filter == nullptr) {
+        MicroPrintf("Failed to allocate %d bytes for the 2:4 sparse filter.",
+                    static_cast<int>(packed_size));
+        return kTfLiteError;
+      }
+      TF_LITE_ENSURE_EQ(context,
+                        arm_fully_connected_s8_sparse_2_4_pack_weights(
+                            &filter_dims, GetTensorData<int8_t>(filter),
+                            data->sparse_2_4_filter),
+                        ARM_CMSIS_NN_SUCCESS);
+    }
+    if (micro::KernelBackendMayRun(data->int8_backend,
+                                   kInt8SparseInputBackend)) {
+      const int32_t sparse_input_buf_size =
+          arm_fully_connected_s8_sparse_input_get_buffer_size(&filter_dims);
+      if (sparse_input_buf_size > 0) {
+        TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
+            context, sparse_input_buf_size, &data->sparse_input_buffer_idx));
+      }
+    }
+  } else if (input->type == kTfLiteFloat32) {
+    const int32_t config[] = {input->type, data->batches, data->accum_depth,
+                              data->output_depth, output_dim_count};
+    TF_LITE_ENSURE_STATUS(micro::PrepareKernelBackends(
+        context, node, kFloatBackends, kFloatBackendCount,
+        micro::KernelTuningKey(BuiltinOperator_FULLY_CONNECTED, config,
+                               sizeof(config) / sizeof(config[0])),
+        &data->float_backend));
+  }
 
   micro_context->DeallocateTempTfLiteTensor(output);
   micro_context->DeallocateTempTfLiteTensor(input);
@@ -362,11 +595,10 @@ TfLiteStatus EvalQuantizedInt16(TfLiteContext* context, TfLiteNode* node,
   return kTfLiteOk;
 }
 
-TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
-  TFLITE_DCHECK(node->builtin_data != nullptr);
-  const auto* params =
-      static_cast<const TfLiteFullyConnectedParams*>(node->builtin_data);
+TfLiteStatus EvalInt8(TfLiteContext* context, TfLiteNode* node);
+TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node);
 
+TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteEvalTensor* input =
       tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
   const TfLiteEvalTensor* filter =
@@ -382,18 +614,7 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   // Checks in Prepare ensure input, output and filter types are all the same.
   switch (input->type) {
     case kTfLiteFloat32: {
-      const float* bias_data =
-          tflite::micro::GetOptionalTensorData<float>(bias);
-      tflite::reference_ops::FullyConnected(
-          FullyConnectedParamsFloat(params->activation),
-          tflite::micro::GetTensorShape(input),
-          tflite::micro::GetTensorData<float>(input),
-          tflite::micro::GetTensorShape(filter),
-          tflite::micro::GetTensorData<float>(filter),
-          tflite::micro::GetTensorShape(bias), bias_data,
-          tflite::micro::GetTensorShape(output),
-          tflite::micro::GetTensorData<float>(output));
-      break;
+      return EvalFloat(context, node);
     }
     case kTfLiteInt8: {
       switch (filter->type) {
@@ -401,8 +622,7 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
           return EvalQuantizedInt4(context, node, data, input, filter, bias,
                                    output);
         case kTfLiteInt8:
-          return EvalQuantizedInt8(context, node, data, input, filter, bias,
-                                   output);
+          return EvalInt8(context, node);
         default:
           MicroPrintf("Filter Type %s (%d) not supported.",
                       TfLiteTypeGetName(filter->type), filter->type);
@@ -446,13 +666,7 @@ TfLiteStatus EvalInt4(TfLiteContext* context, TfLiteNode* node) {
   return EvalQuantizedInt4(context, node, data, input, filter, bias, output);
 }
 
-// Note that the current function names are not ideal at all (this EvalInt8
-// function internally calls EvalQuantizedInt8, and there is similar name
-// aliasing in the Eval function too). We will be attempting to have a more
-// descriptive naming convention but holding off on that for now, since the
-// renaming might be coupled with reducing code duplication and some additional
-// refactoring.
-TfLiteStatus EvalInt8(TfLiteContext* context, TfLiteNode* node) {
+TfLiteStatus EvalInt8CmsisNn(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteEvalTensor* input =
       tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
   const TfLiteEvalTensor* filter =
@@ -475,6 +689,338 @@ TfLiteStatus EvalInt8(TfLiteContext* context, TfLiteNode* node) {
   return EvalQuantizedInt8(context, node, data, input, filter, bias, output);
 }
 
+TfLiteStatus EvalInt8Reference(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  tflite::reference_integer_ops::FullyConnected(
+      FullyConnectedParamsQuantized(data.reference_op_data),
+      tflite::micro::GetTensorShape(input),
+      tflite::micro::GetTensorData<int8_t>(input),
+      tflite::micro::GetTensorShape(filter),
+      tflite::micro::GetTensorData<int8_t>(filter),
+      tflite::micro::GetTensorShape(bias),
+      tflite::micro::GetOptionalTensorData<int32_t>(bias),
+      tflite::micro::GetTensorShape(output),
+      tflite::micro::GetTensorData<int8_t>(output));
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalFloatGemm(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto* params =
+      static_cast<const TfLiteFullyConnectedParams*>(node->builtin_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  FloatGemmFullyConnected(FullyConnectedParamsFloat(params->activation),
+                          tflite::micro::GetTensorShape(input),
+                          tflite::micro::GetTensorData<float>(input),
+                          tflite::micro::GetTensorShape(filter),
+                          tflite::micro::GetTensorData<float>(filter),
+                          tflite::micro::GetTensorShape(bias),
+                          tflite::micro::GetOptionalTensorData<float>(bias),
+                          tflite::micro::GetTensorShape(output),
+                          tflite::micro::GetTensorData<float>(output));
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalFloatReference(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto* params =
+      static_cast<const TfLiteFullyConnectedParams*>(node->builtin_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  tflite::reference_ops::FullyConnected(
+      FullyConnectedParamsFloat(params->activation),
+      tflite::micro::GetTensorShape(input),
+      tflite::micro::GetTensorData<float>(input),
+      tflite::micro::GetTensorShape(filter),
+      tflite::micro::GetTensorData<float>(filter),
+      tflite::micro::GetTensorShape(bias),
+      tflite::micro::GetOptionalTensorData<float>(bias),
+      tflite::micro::GetTensorShape(output),
+      tflite::micro::GetTensorData<float>(output));
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalInt8Packed(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+  TFLITE_DCHECK(data.packed_filter != nullptr);
+
+  cmsis_nn_per_tensor_quant_params quant_params;
+  cmsis_nn_dims input_dims;
+  cmsis_nn_dims filter_dims;
+  cmsis_nn_dims bias_dims;
+  cmsis_nn_dims output_dims;
+  cmsis_nn_context ctx;
+
+  PopulateCommonParams(context, &quant_params, &input_dims, &filter_dims,
+                       &bias_dims, &output_dims, &ctx, data);
+
+  cmsis_nn_fc_params fc_params;
+  fc_params.input_offset = -data.reference_op_data.input_zero_point;
+  fc_params.filter_offset = 0;
+  fc_params.output_offset = data.reference_op_data.output_zero_point;
+  fc_params.activation.min = data.reference_op_data.output_activation_min;
+  fc_params.activation.max = data.reference_op_data.output_activation_max;
+
+  TF_LITE_ENSURE_EQ(
+      context,
+      arm_fully_connected_s8_packed(
+          &fc_params, &quant_params, &input_dims,
+          tflite::micro::GetTensorData<int8_t>(input), &filter_dims,
+          data.packed_filter,
+          tflite::micro::GetOptionalTensorData<int32_t>(bias), &output_dims,
+          tflite::micro::GetTensorData<int8_t>(output)),
+      ARM_CMSIS_NN_SUCCESS);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalInt8Sparse2Of4(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+  TFLITE_DCHECK(data.sparse_2_4_filter != nullptr);
+
+  cmsis_nn_per_tensor_quant_params quant_params;
+  cmsis_nn_dims input_dims;
+  cmsis_nn_dims filter_dims;
+  cmsis_nn_dims bias_dims;
+  cmsis_nn_dims output_dims;
+  cmsis_nn_context ctx;
+
+  PopulateCommonParams(context, &quant_params, &input_dims, &filter_dims,
+                       &bias_dims, &output_dims, &ctx, data);
+
+  cmsis_nn_fc_params fc_params;
+  fc_params.input_offset = -data.reference_op_data.input_zero_point;
+  fc_params.filter_offset = 0;
+  fc_params.output_offset = data.reference_op_data.output_zero_point;
+  fc_params.activation.min = data.reference_op_data.output_activation_min;
+  fc_params.activation.max = data.reference_op_data.output_activation_max;
+
+  TF_LITE_ENSURE_EQ(
+      context,
+      arm_fully_connected_s8_sparse_2_4(
+          &fc_params, &quant_params, &input_dims,
+          tflite::micro::GetTensorData<int8_t>(input), &filter_dims,
+          data.sparse_2_4_filter,
+          tflite::micro::GetOptionalTensorData<int32_t>(bias), &output_dims,
+          tflite::micro::GetTensorData<int8_t>(output)),
+      ARM_CMSIS_NN_SUCCESS);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalInt8SparseInput(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  cmsis_nn_per_tensor_quant_params quant_params;
+  cmsis_nn_dims input_dims;
+  cmsis_nn_dims filter_dims;
+  cmsis_nn_dims bias_dims;
+  cmsis_nn_dims output_dims;
+  cmsis_nn_context ctx;
+
+  PopulateCommonParams(context, &quant_params, &input_dims, &filter_dims,
+                       &bias_dims, &output_dims, &ctx, data);
+  ctx.buf = nullptr;
+  if (data.sparse_input_buffer_idx > -1) {
+    ctx.buf = context->GetScratchBuffer(context, data.sparse_input_buffer_idx);
+  }
+
+  cmsis_nn_fc_params fc_params;
+  fc_params.input_offset = -data.reference_op_data.input_zero_point;
+  fc_params.filter_offset = 0;
+  fc_params.output_offset = data.reference_op_data.output_zero_point;
+  fc_params.activation.min = data.reference_op_data.output_activation_min;
+  fc_params.activation.max = data.reference_op_data.output_activation_max;
+
+  TF_LITE_ENSURE_EQ(
+      context,
+      arm_fully_connected_s8_sparse_input(
+          &ctx, &fc_params, &quant_params, &input_dims,
+          tflite::micro::GetTensorData<int8_t>(input), &filter_dims,
+          tflite::micro::GetTensorData<int8_t>(filter), data.kernel_sums,
+          tflite::micro::GetOptionalTensorData<int32_t>(bias), &output_dims,
+          tflite::micro::GetTensorData<int8_t>(output)),
+      ARM_CMSIS_NN_SUCCESS);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalInt8Sparse(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  SparseFullyConnected(FullyConnectedParamsQuantized(data.reference_op_data),
+                       *data.sparse_filter, data.batches, data.output_depth,
+                       data.accum_depth,
+                       tflite::micro::GetTensorData<int8_t>(input),
+                       tflite::micro::GetTensorData<int8_t>(filter),
+                       tflite::micro::GetOptionalTensorData<int32_t>(bias),
+                       tflite::micro::GetTensorData<int8_t>(output));
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalFloatSparse(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto* params =
+      static_cast<const TfLiteFullyConnectedParams*>(node->builtin_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* filter =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedWeightsTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  SparseFullyConnected(FullyConnectedParamsFloat(params->activation),
+                       *data.sparse_filter, data.batches, data.output_depth,
+                       data.accum_depth,
+                       tflite::micro::GetTensorData<float>(input),
+                       tflite::micro::GetTensorData<float>(filter),
+                       tflite::micro::GetOptionalTensorData<float>(bias),
+                       tflite::micro::GetTensorData<float>(output));
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalInt8Palettized(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  void* scratch = context->GetScratchBuffer(context, data.buffer_idx);
+  TF_LITE_ENSURE(context, scratch != nullptr);
+  PalettizedFullyConnected(
+      FullyConnectedParamsQuantized(data.reference_op_data),
+      *data.palettized_filter, data.batches, data.output_depth,
+      data.accum_depth, tflite::micro::GetTensorData<int8_t>(input),
+      tflite::micro::GetOptionalTensorData<int32_t>(bias),
+      tflite::micro::GetTensorData<int8_t>(output), scratch);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalFloatPalettized(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  const auto* params =
+      static_cast<const TfLiteFullyConnectedParams*>(node->builtin_data);
+
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
+  const TfLiteEvalTensor* bias =
+      tflite::micro::GetEvalInput(context, node, kFullyConnectedBiasTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kFullyConnectedOutputTensor);
+
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData& data = *(static_cast<const OpData*>(node->user_data));
+
+  void* scratch = context->GetScratchBuffer(context, data.buffer_idx);
+  TF_LITE_ENSURE(context, scratch != nullptr);
+  PalettizedFullyConnected(FullyConnectedParamsFloat(params->activation),
+                           *data.palettized_filter, data.batches,
+                           data.output_depth, data.accum_depth,
+                           tflite::micro::GetTensorData<float>(input),
+                           tflite::micro::GetOptionalTensorData<float>(bias),
+                           tflite::micro::GetTensorData<float>(output),
+                           scratch);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalInt8(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  OpData* data = static_cast<OpData*>(node->user_data);
+  if (data->sparse_filter != nullptr) {
+    return EvalInt8Sparse(context, node);
+  }
+  if (data->palettized_filter != nullptr) {
+    return EvalInt8Palettized(context, node);
+  }
+  return micro::InvokeKernelBackend(context, node, kInt8Backends,
+                                    kInt8BackendCount, &data->int8_backend);
+}
+
+TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  OpData* data = static_cast<OpData*>(node->user_data);
+  if (data->sparse_filter != nullptr) {
+    return EvalFloatSparse(context, node);
+  }
+  if (data->palettized_filter != nullptr) {
+    return EvalFloatPalettized(context, node);
+  }
+  return micro::InvokeKernelBackend(context, node, kFloatBackends,
+                                    kFloatBackendCount, &data->float_backend);
+}
+
 TfLiteStatus EvalInt16(TfLiteContext* context, TfLiteNode* node) {
   const TfLiteEvalTensor* input =
       tflite::micro::GetEvalInput(context, node, kFullyConnectedInputTensor);
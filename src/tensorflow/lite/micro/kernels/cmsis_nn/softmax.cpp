@@ -85,11 +85,10 @@ TfLiteStatus SoftmaxEval(TfLiteContext* context, TfLiteNode* node) {
 
   switch (input->type) {
     case kTfLiteFloat32: {
-      tflite::reference_ops::Softmax(
-          op_data.softmax_params, tflite::micro::GetTensorShape(input),
-          tflite::micro::GetTensorData<float>(input),
-          tflite::micro::GetTensorShape(output),
-          tflite::micro::GetTensorData<float>(output));
+      SoftmaxFloat(op_data.softmax_params, tflite::micro::GetTensorShape(input),
+                   tflite::micro::GetTensorData<float>(input),
+                   tflite::micro::GetTensorShape(output),
+                   tflite::micro::GetTensorData<float>(output));
       return kTfLiteOk;
     }
     case kTfLiteInt8: {
@@ -18,16 +18,19 @@ limitations under the License.
 // Currently used by the 8 bits activation case only, except for fallbacks.
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
 
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/fully_connected.h"
+#include "tensorflow/lite/micro/kernels/kernel_backend.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/lstm_eval.h"
 #include "tensorflow/lite/micro/kernels/lstm_shared.h"
 #include "tensorflow/lite/micro/kernels/micro_tensor_utils.h"
+#include "tensorflow/lite/schema/schema_generated.h"
 namespace tflite {
 
 namespace {
@@ -35,6 +38,12 @@ namespace {
 struct OpData {
   OpDataLSTM params_ref;                 // Used for fallback implementation
   cmsis_nn_lstm_params params_cmsis_nn;  // Used for  CMSIS-NN implementation
+  LstmFusedGates fused_gates;            // Used for fused gates implementation
+  bool fused_gates_supported;
+  micro::KernelBackendSelection backend;
+  // Scratch buffer holding the float hidden and cell states while the
+  // backends are timed, or -1.
+  int state_buffer_index;
 };
 
 LSTMBuffers<int16_t> CMSIS_NN_CreateLSTMBuffers(TfLiteContext* context,
@@ -321,6 +330,150 @@ TfLiteStatus CMSIS_NN_EvalInteger16x8_16Lstm(
   return kTfLiteOk;
 }
 
+TfLiteStatus EvalFloatReference(TfLiteContext* context, TfLiteNode* node) {
+  const OpData& op_data = *reinterpret_cast<const OpData*>(node->user_data);
+  auto kernel_content = CreateLSTMKernelContent(context, node);
+  LSTMBuffers<float> buffers =
+      CreateLSTMBuffers<float>(context, op_data.params_ref.buffer_indices);
+  return EvalLstm<float, float, float, float>(op_data.params_ref,
+                                              kernel_content, buffers);
+}
+
+TfLiteStatus EvalFloatFusedGates(TfLiteContext* context, TfLiteNode* node) {
+  const OpData& op_data = *reinterpret_cast<const OpData*>(node->user_data);
+  auto kernel_content = CreateLSTMKernelContent(context, node);
+  return EvalLstmFusedGates<float, float, float, float>(
+      op_data.params_ref, op_data.fused_gates, kernel_content);
+}
+
+TfLiteStatus EvalInt8CmsisNn(TfLiteContext* context, TfLiteNode* node) {
+  const OpData& op_data = *reinterpret_cast<const OpData*>(node->user_data);
+  auto kernel_content = CreateLSTMKernelContent(context, node);
+  LSTMBuffers<int16_t> buffers =
+      CMSIS_NN_CreateLSTMBuffers(context, op_data.params_ref.buffer_indices);
+  return CMSIS_NN_EvalInteger8x8_16Lstm(op_data, kernel_content, buffers);
+}
+
+TfLiteStatus EvalInt16CmsisNn(TfLiteContext* context, TfLiteNode* node) {
+  const OpData& op_data = *reinterpret_cast<const OpData*>(node->user_data);
+  auto kernel_content = CreateLSTMKernelContent(context, node);
+  LSTMBuffers<int16_t> buffers =
+      CMSIS_NN_CreateLSTMBuffers(context, op_data.params_ref.buffer_indices);
+  return CMSIS_NN_EvalInteger16x8_16Lstm(op_data, kernel_content, buffers);
+}
+
+// Like arm_lstm_unidirectional_s8/s16, which keep the cell state in a scratch
+// buffer, starts every invoke from a zero cell state and a hidden state at
+// its zero point, so that the integer backends are interchangeable.
+template <typename ActivationType, typename BiasType>
+TfLiteStatus EvalIntegerFusedGates(TfLiteContext* context, TfLiteNode* node) {
+  const OpData& op_data = *reinterpret_cast<const OpData*>(node->user_data);
+  const OpDataLSTM& op_data_lstm = op_data.params_ref;
+  auto kernel_content = CreateLSTMKernelContent(context, node);
+
+  const int state_size = op_data_lstm.size_info.batch_size *
+                         op_data_lstm.size_info.state_dimension;
+  ActivationType* hidden_state = tflite::micro::GetTensorData<ActivationType>(
+      kernel_content.HiddenStateTensor());
+  std::fill_n(hidden_state, state_size,
+              static_cast<ActivationType>(
+                  op_data_lstm.inter_gate_parameters.output_mul_params
+                      .output_offset));
+  std::fill_n(
+      tflite::micro::GetTensorData<int16_t>(kernel_content.CellStateTensor()),
+      state_size, int16_t(0));
+
+  return EvalLstmFusedGates<ActivationType, int8_t, int16_t, BiasType>(
+      op_data_lstm, op_data.fused_gates, kernel_content);
+}
+
+bool IsFusedGatesEligible(TfLiteContext* context, TfLiteNode* node) {
+  return reinterpret_cast<const OpData*>(node->user_data)
+      ->fused_gates_supported;
+}
+
+// The fused gates keep a rearranged copy of the weights in the arena, in
+// place of the scratch buffers that the other backends need for the gate
+// outputs. The float reference backend also reads the input and hidden state
+// once per gate, so float LSTMs prefer the fused gates. The integer ones keep
+// the CMSIS-NN kernels unless autotuning picks otherwise.
+constexpr int kDefaultBackend = 0;
+constexpr int kFusedGatesBackend = 1;
+
+constexpr micro::KernelBackend kFloatBackends[] = {
+    {"reference", nullptr, EvalFloatReference},
+    {"fused_gates", IsFusedGatesEligible, EvalFloatFusedGates},
+};
+constexpr micro::KernelBackend kInt8Backends[] = {
+    {"cmsis_nn", nullptr, EvalInt8CmsisNn},
+    {"fused_gates", IsFusedGatesEligible,
+     EvalIntegerFusedGates<int8_t, int32_t>},
+};
+constexpr micro::KernelBackend kInt16Backends[] = {
+    {"cmsis_nn", nullptr, EvalInt16CmsisNn},
+    {"fused_gates", IsFusedGatesEligible,
+     EvalIntegerFusedGates<int16_t, int64_t>},
+};
+constexpr int kBackendCount = 2;
+constexpr int8_t kFloatBackendPreference[kBackendCount] = {kFusedGatesBackend,
+                                                           kDefaultBackend};
+
+const micro::KernelBackend* GetBackends(TfLiteType activation_type) {
+  switch (activation_type) {
+    case kTfLiteFloat32:
+      return kFloatBackends;
+    case kTfLiteInt8:
+      return kInt8Backends;
+    case kTfLiteInt16:
+      return kInt16Backends;
+    default:
+      return nullptr;
+  }
+}
+
+// Copies the float states to or from the state scratch buffer.
+void CopyFloatState(TfLiteContext* context, TfLiteNode* node, bool save) {
+  const OpData& op_data = *reinterpret_cast<const OpData*>(node->user_data);
+  auto kernel_content = CreateLSTMKernelContent(context, node);
+  const size_t state_bytes = op_data.params_ref.size_info.batch_size *
+                             op_data.params_ref.size_info.state_dimension *
+                             sizeof(float);
+  char* saved = static_cast<char*>(
+      context->GetScratchBuffer(context, op_data.state_buffer_index));
+  char* states[2] = {
+      tflite::micro::GetTensorData<char>(kernel_content.HiddenStateTensor()),
+      tflite::micro::GetTensorData<char>(kernel_content.CellStateTensor())};
+  for (int i = 0; i < 2; ++i) {
+    if (save) {
+      std::memcpy(saved + i * state_bytes, states[i], state_bytes);
+    } else {
+      std::memcpy(states[i], saved + i * state_bytes, state_bytes);
+    }
+  }
+}
+
+void RestoreFloatState(TfLiteContext* context, TfLiteNode* node) {
+  CopyFloatState(context, node, /*save=*/false);
+}
+
+TfLiteStatus InvokeBackend(TfLiteContext* context, TfLiteNode* node,
+                           TfLiteType activation_type) {
+  OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
+  const micro::KernelBackend* backends = GetBackends(activation_type);
+  if (backends == nullptr) {
+    MicroPrintf("Input type %s (%d) not supported.",
+                TfLiteTypeGetName(activation_type), activation_type);
+    return kTfLiteError;
+  }
+  if (op_data->state_buffer_index >= 0 && op_data->backend.selected < 0) {
+    CopyFloatState(context, node, /*save=*/true);
+    return micro::InvokeKernelBackend(context, node, backends, kBackendCount,
+                                      &op_data->backend, RestoreFloatState);
+  }
+  return micro::InvokeKernelBackend(context, node, backends, kBackendCount,
+                                    &op_data->backend);
+}
+
 /*Kernel functions*/
 void* UnidirectionalSequenceLstmInit(TfLiteContext* context, const char* buffer,
                                      size_t length) {
@@ -377,6 +530,49 @@ TfLiteStatus UnidirectionalSequenceLstmPrepare(TfLiteContext* context,
     return kTfLiteError;
   }
 
+  op_data->fused_gates_supported =
+      LstmFusedGatesSupported(lstm_tensors, *op_data_lstm);
+  op_data->state_buffer_index = -1;
+  const micro::KernelBackend* backends = GetBackends(activation_type);
+  TF_LITE_ENSURE(context, backends != nullptr);
+  const TfLiteType weight_type =
+      lstm_tensors.GetInternalTensor(kLstmInputToOutputWeightsTensor)->type;
+  const int32_t config[] = {activation_type,
+                            weight_type,
+                            op_data_lstm->size_info.batch_size,
+                            op_data_lstm->size_info.time_steps,
+                            op_data_lstm->size_info.input_dimension,
+                            op_data_lstm->size_info.state_dimension,
+                            op_data_lstm->size_info.time_major};
+  TF_LITE_ENSURE_STATUS(micro::PrepareKernelBackends(
+      context, node, backends, kBackendCount,
+      micro::KernelTuningKey(BuiltinOperator_UNIDIRECTIONAL_SEQUENCE_LSTM,
+                             config, sizeof(config) / sizeof(config[0])),
+      &op_data->backend,
+      activation_type == kTfLiteFloat32 ? kFloatBackendPreference : nullptr));
+
+  if (micro::KernelBackendMayRun(op_data->backend, kFusedGatesBackend)) {
+    TF_LITE_ENSURE_OK(context,
+                      PrepareLstmFusedGates(context, lstm_tensors,
+                                            *op_data_lstm,
+                                            &op_data->fused_gates));
+  }
+  // The float backends update the states, which are restored before each
+  // timed run. Without the fused gates there is nothing to time.
+  if (op_data->backend.selected < 0 &&
+      micro::KernelBackendMayRun(op_data->backend, kFusedGatesBackend) &&
+      activation_type == kTfLiteFloat32) {
+    TF_LITE_ENSURE_OK(context, context->RequestScratchBufferInArena(
+                                   context,
+                                   2 * op_data_lstm->size_info.batch_size *
+                                       op_data_lstm->size_info.state_dimension *
+                                       sizeof(float),
+                                   &op_data->state_buffer_index));
+  }
+  if (!micro::KernelBackendMayRun(op_data->backend, kDefaultBackend)) {
+    return kTfLiteOk;
+  }
+
   size_t number_of_buffers;
   if (activation_type == kTfLiteInt8 && cell_state_type == kTfLiteInt16) {
     auto kernel_content = CreateLSTMKernelContent(context, node);
@@ -408,9 +604,6 @@ TfLiteStatus UnidirectionalSequenceLstmPrepare(TfLiteContext* context,
 TfLiteStatus UnidirectionalSequenceLstmEval(TfLiteContext* context,
                                             TfLiteNode* node) {
   TFLITE_DCHECK(node->user_data != nullptr);
-  const OpData& op_data = *reinterpret_cast<const OpData*>(node->user_data);
-  const OpDataLSTM& op_data_lstm = op_data.params_ref;
-
   auto kernel_content = CreateLSTMKernelContent(context, node);
 
   const auto activation_type =
@@ -420,20 +613,13 @@ TfLiteStatus UnidirectionalSequenceLstmEval(TfLiteContext* context,
 
   switch (activation_type) {
     case kTfLiteFloat32: {
-      LSTMBuffers<float> buffers =
-          CreateLSTMBuffers<float>(context, op_data_lstm.buffer_indices);
-      EvalLstm<float, float, float, float>(op_data_lstm, kernel_content,
-                                           buffers);
-      break;
+      return InvokeBackend(context, node, activation_type);
     }
     case kTfLiteInt8: {
       switch (weight_type) {
         case kTfLiteInt8: {
           // 8(activation)x8(weight)->16(cell) LSTM with 32 bits bias
-          LSTMBuffers<int16_t> buffers =
-              CMSIS_NN_CreateLSTMBuffers(context, op_data_lstm.buffer_indices);
-          CMSIS_NN_EvalInteger8x8_16Lstm(op_data, kernel_content, buffers);
-          break;
+          return InvokeBackend(context, node, activation_type);
         }
         default: {
           MicroPrintf("Filter type %s (%d) not supported.",
@@ -447,10 +633,7 @@ TfLiteStatus UnidirectionalSequenceLstmEval(TfLiteContext* context,
       switch (weight_type) {
         case kTfLiteInt8: {
           // 16(activation)x8(weight)->16(cell) LSTM with 64 bits bias
-          LSTMBuffers<int16_t> buffers =
-              CMSIS_NN_CreateLSTMBuffers(context, op_data_lstm.buffer_indices);
-          CMSIS_NN_EvalInteger16x8_16Lstm(op_data, kernel_content, buffers);
-          break;
+          return InvokeBackend(context, node, activation_type);
         }
         default: {
           MicroPrintf("Filter type %s (%d) not supported.",
@@ -472,8 +655,6 @@ TfLiteStatus UnidirectionalSequenceLstmEval(TfLiteContext* context,
 TfLiteStatus UnidirectionalSequenceLstmEvalInt8(TfLiteContext* context,
                                                 TfLiteNode* node) {
   TFLITE_DCHECK(node->user_data != nullptr);
-  const OpData& op_data = *reinterpret_cast<const OpData*>(node->user_data);
-  const OpDataLSTM& op_data_lstm = op_data.params_ref;
   auto kernel_content = CreateLSTMKernelContent(context, node);
   const auto activation_type =
       kernel_content.internal_tensors[kLstmInputTensor]->type;
@@ -484,10 +665,7 @@ TfLiteStatus UnidirectionalSequenceLstmEvalInt8(TfLiteContext* context,
                 "Only int16 filter type supported.");
 
   if (activation_type == kTfLiteInt8) {
-    LSTMBuffers<int16_t> buffers =
-        CMSIS_NN_CreateLSTMBuffers(context, op_data_lstm.buffer_indices);
-
-    return CMSIS_NN_EvalInteger8x8_16Lstm(op_data, kernel_content, buffers);
+    return InvokeBackend(context, node, activation_type);
   } else {
     MicroPrintf("Input type %s (%d) not supported.",
                 TfLiteTypeGetName(activation_type), activation_type);
@@ -499,8 +677,6 @@ TfLiteStatus UnidirectionalSequenceLstmEvalInt8(TfLiteContext* context,
 TfLiteStatus UnidirectionalSequenceLstmEvalInt16(TfLiteContext* context,
                                                  TfLiteNode* node) {
   TFLITE_DCHECK(node->user_data != nullptr);
-  const OpData& op_data = *reinterpret_cast<const OpData*>(node->user_data);
-  const OpDataLSTM& op_data_lstm = op_data.params_ref;
   auto kernel_content = CreateLSTMKernelContent(context, node);
   const auto activation_type =
       kernel_content.internal_tensors[kLstmInputTensor]->type;
@@ -511,10 +687,7 @@ TfLiteStatus UnidirectionalSequenceLstmEvalInt16(TfLiteContext* context,
                 "Only int16 filter type supported.");
 
   if (activation_type == kTfLiteInt16) {
-    LSTMBuffers<int16_t> buffers =
-        CMSIS_NN_CreateLSTMBuffers(context, op_data_lstm.buffer_indices);
-
-    return CMSIS_NN_EvalInteger16x8_16Lstm(op_data, kernel_content, buffers);
+    return InvokeBackend(context, node, activation_type);
   } else {
     MicroPrintf("Input type %s (%d) not supported.",
                 TfLiteTypeGetName(activation_type), activation_type);
@@ -12,12 +12,14 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
+
 #include "tensorflow/lite/kernels/internal/reference/comparisons.h"
 
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/binary_broadcast.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
@@ -27,430 +29,99 @@ namespace {
 
 struct OpData {
   ComparisonParams params;
+  BinaryBroadcastShape broadcast;
 };
 
 constexpr int kInputTensor1 = 0;
 constexpr int kInputTensor2 = 1;
 constexpr int kOutputTensor = 0;
 
-TfLiteStatus EqualEval(TfLiteContext* context, TfLiteNode* node) {
-  TFLITE_DCHECK(node->user_data != nullptr);
-  const OpData* data = static_cast<const OpData*>(node->user_data);
-
-  const TfLiteEvalTensor* input1 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor1);
-  const TfLiteEvalTensor* input2 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor2);
-  TfLiteEvalTensor* output =
-      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
-
-  RuntimeShape input1_shape = tflite::micro::GetTensorShape(input1);
-  RuntimeShape input2_shape = tflite::micro::GetTensorShape(input2);
-  RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
-  bool* output_data = tflite::micro::GetTensorData<bool>(output);
-
-  bool requires_broadcast = !tflite::micro::HaveSameShapes(input1, input2);
-  switch (input1->type) {
-    case kTfLiteBool:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<bool>(input1), input2_shape,
-                tflite::micro::GetTensorData<bool>(input2), output_shape,
-                output_data)
-          : reference_ops::EqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<bool>(input1), input2_shape,
-                tflite::micro::GetTensorData<bool>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteFloat32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data)
-          : reference_ops::EqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data)
-          : reference_ops::EqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt64:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data)
-          : reference_ops::EqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt8:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowEqualWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data)
-          : reference_ops::EqualWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data);
-      break;
-    default:
-      MicroPrintf("Type %s (%d) not supported.",
-                  TfLiteTypeGetName(input1->type), input1->type);
-      return kTfLiteError;
+struct EqualOp {
+  template <typename T>
+  static bool op(T lhs, T rhs) {
+    return reference_ops::EqualFn(lhs, rhs);
   }
-  return kTfLiteOk;
-}
-
-// TODO(renjieliu): Refactor the logic to avoid duplications.
-TfLiteStatus NotEqualEval(TfLiteContext* context, TfLiteNode* node) {
-  TFLITE_DCHECK(node->user_data != nullptr);
-  const OpData* data = static_cast<const OpData*>(node->user_data);
-
-  const TfLiteEvalTensor* input1 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor1);
-  const TfLiteEvalTensor* input2 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor2);
-  TfLiteEvalTensor* output =
-      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
-
-  RuntimeShape input1_shape = tflite::micro::GetTensorShape(input1);
-  RuntimeShape input2_shape = tflite::micro::GetTensorShape(input2);
-  RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
-  bool* output_data = tflite::micro::GetTensorData<bool>(output);
+};
 
-  bool requires_broadcast = !tflite::micro::HaveSameShapes(input1, input2);
-  switch (input1->type) {
-    case kTfLiteBool:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowNotEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<bool>(input1), input2_shape,
-                tflite::micro::GetTensorData<bool>(input2), output_shape,
-                output_data)
-          : reference_ops::NotEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<bool>(input1), input2_shape,
-                tflite::micro::GetTensorData<bool>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteFloat32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowNotEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data)
-          : reference_ops::NotEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowNotEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data)
-          : reference_ops::NotEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt64:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowNotEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data)
-          : reference_ops::NotEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt8:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowNotEqualWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data)
-          : reference_ops::NotEqualWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data);
-      break;
-    default:
-      MicroPrintf("Type %s (%d) not supported.",
-                  TfLiteTypeGetName(input1->type), input1->type);
-      return kTfLiteError;
+struct NotEqualOp {
+  template <typename T>
+  static bool op(T lhs, T rhs) {
+    return reference_ops::NotEqualFn(lhs, rhs);
   }
-  return kTfLiteOk;
-}
-
-TfLiteStatus GreaterEval(TfLiteContext* context, TfLiteNode* node) {
-  TFLITE_DCHECK(node->user_data != nullptr);
-  const OpData* data = static_cast<const OpData*>(node->user_data);
-
-  const TfLiteEvalTensor* input1 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor1);
-  const TfLiteEvalTensor* input2 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor2);
-  TfLiteEvalTensor* output =
-      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
-
-  RuntimeShape input1_shape = tflite::micro::GetTensorShape(input1);
-  RuntimeShape input2_shape = tflite::micro::GetTensorShape(input2);
-  RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
-  bool* output_data = tflite::micro::GetTensorData<bool>(output);
+};
 
-  bool requires_broadcast = !tflite::micro::HaveSameShapes(input1, input2);
-  switch (input1->type) {
-    case kTfLiteFloat32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowGreaterNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data)
-          : reference_ops::GreaterNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowGreaterNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data)
-          : reference_ops::GreaterNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt64:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowGreaterNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data)
-          : reference_ops::GreaterNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt8:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowGreaterWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data)
-          : reference_ops::GreaterWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data);
-      break;
-    default:
-      MicroPrintf("Type %s (%d) not supported.",
-                  TfLiteTypeGetName(input1->type), input1->type);
-      return kTfLiteError;
+struct GreaterOp {
+  template <typename T>
+  static bool op(T lhs, T rhs) {
+    return reference_ops::GreaterFn(lhs, rhs);
   }
-  return kTfLiteOk;
-}
-
-TfLiteStatus GreaterEqualEval(TfLiteContext* context, TfLiteNode* node) {
-  TFLITE_DCHECK(node->user_data != nullptr);
-  const OpData* data = static_cast<const OpData*>(node->user_data);
-
-  const TfLiteEvalTensor* input1 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor1);
-  const TfLiteEvalTensor* input2 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor2);
-  TfLiteEvalTensor* output =
-      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
-
-  RuntimeShape input1_shape = tflite::micro::GetTensorShape(input1);
-  RuntimeShape input2_shape = tflite::micro::GetTensorShape(input2);
-  RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
-  bool* output_data = tflite::micro::GetTensorData<bool>(output);
+};
 
-  bool requires_broadcast = !tflite::micro::HaveSameShapes(input1, input2);
-  switch (input1->type) {
-    case kTfLiteFloat32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowGreaterEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data)
-          : reference_ops::GreaterEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowGreaterEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data)
-          : reference_ops::GreaterEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt64:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowGreaterEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data)
-          : reference_ops::GreaterEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt8:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowGreaterEqualWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data)
-          : reference_ops::GreaterEqualWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data);
-      break;
-    default:
-      MicroPrintf("Type %s (%d) not supported.",
-                  TfLiteTypeGetName(input1->type), input1->type);
-      return kTfLiteError;
+struct GreaterEqualOp {
+  template <typename T>
+  static bool op(T lhs, T rhs) {
+    return reference_ops::GreaterEqualFn(lhs, rhs);
   }
-  return kTfLiteOk;
-}
+};
 
-TfLiteStatus LessEval(TfLiteContext* context, TfLiteNode* node) {
-  TFLITE_DCHECK(node->user_data != nullptr);
-  const OpData* data = static_cast<const OpData*>(node->user_data);
+struct LessOp {
+  template <typename T>
+  static bool op(T lhs, T rhs) {
+    return reference_ops::LessFn(lhs, rhs);
+  }
+};
 
-  const TfLiteEvalTensor* input1 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor1);
-  const TfLiteEvalTensor* input2 =
-      tflite::micro::GetEvalInput(context, node, kInputTensor2);
-  TfLiteEvalTensor* output =
-      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+struct LessEqualOp {
+  template <typename T>
+  static bool op(T lhs, T rhs) {
+    return reference_ops::LessEqualFn(lhs, rhs);
+  }
+};
 
-  RuntimeShape input1_shape = tflite::micro::GetTensorShape(input1);
-  RuntimeShape input2_shape = tflite::micro::GetTensorShape(input2);
-  RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
-  bool* output_data = tflite::micro::GetTensorData<bool>(output);
+template <typename T, typename OpType>
+void CompareNoScaling(const OpData* data, const TfLiteEvalTensor* input1,
+                      const TfLiteEvalTensor* input2,
+                      TfLiteEvalTensor* output) {
+  BinaryBroadcast(data->broadcast, tflite::micro::GetTensorData<T>(input1),
+                  tflite::micro::GetTensorData<T>(input2),
+                  tflite::micro::GetTensorData<bool>(output),
+                  [](T lhs, T rhs) {
+                    return OpType::template op<T>(lhs, rhs);
+                  });
+}
 
-  bool requires_broadcast = !tflite::micro::HaveSameShapes(input1, input2);
-  switch (input1->type) {
-    case kTfLiteFloat32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowLessNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data)
-          : reference_ops::LessNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowLessNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data)
-          : reference_ops::LessNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt64:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowLessNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data)
-          : reference_ops::LessNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data);
-      break;
-    case kTfLiteInt8:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowLessWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data)
-          : reference_ops::LessWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data);
-      break;
-    default:
-      MicroPrintf("Type %s (%d) not supported.",
-                  TfLiteTypeGetName(input1->type), input1->type);
-      return kTfLiteError;
-  }
-  return kTfLiteOk;
+// Brings both quantized inputs to a common scale before comparing them, as
+// reference_ops::ComparisonWithScaling() does.
+template <typename T, typename OpType>
+void CompareWithScaling(const OpData* data, const TfLiteEvalTensor* input1,
+                        const TfLiteEvalTensor* input2,
+                        TfLiteEvalTensor* output) {
+  const ComparisonParams params = data->params;
+  BinaryBroadcast(
+      data->broadcast, tflite::micro::GetTensorData<T>(input1),
+      tflite::micro::GetTensorData<T>(input2),
+      tflite::micro::GetTensorData<bool>(output), [params](T lhs, T rhs) {
+        const int32_t shifted_input1_val =
+            (params.input1_offset + lhs) * (1 << params.left_shift);
+        const int32_t shifted_input2_val =
+            (params.input2_offset + rhs) * (1 << params.left_shift);
+        const int32_t scaled_input1_val =
+            MultiplyByQuantizedMultiplierSmallerThanOneExp(
+                shifted_input1_val, params.input1_multiplier,
+                params.input1_shift);
+        const int32_t scaled_input2_val =
+            MultiplyByQuantizedMultiplierSmallerThanOneExp(
+                shifted_input2_val, params.input2_multiplier,
+                params.input2_shift);
+        return OpType::template op<int32_t>(scaled_input1_val,
+                                            scaled_input2_val);
+      });
 }
 
-TfLiteStatus LessEqualEval(TfLiteContext* context, TfLiteNode* node) {
+// EQUAL and NOT_EQUAL also accept bool inputs, the ordering comparisons do
+// not.
+template <typename OpType, bool kSupportsBool>
+TfLiteStatus ComparisonEval(TfLiteContext* context, TfLiteNode* node) {
   TFLITE_DCHECK(node->user_data != nullptr);
   const OpData* data = static_cast<const OpData*>(node->user_data);
 
@@ -461,64 +132,26 @@ TfLiteStatus LessEqualEval(TfLiteContext* context, TfLiteNode* node) {
   TfLiteEvalTensor* output =
       tflite::micro::GetEvalOutput(context, node, kOutputTensor);
 
-  RuntimeShape input1_shape = tflite::micro::GetTensorShape(input1);
-  RuntimeShape input2_shape = tflite::micro::GetTensorShape(input2);
-  RuntimeShape output_shape = tflite::micro::GetTensorShape(output);
-  bool* output_data = tflite::micro::GetTensorData<bool>(output);
-
-  bool requires_broadcast = !tflite::micro::HaveSameShapes(input1, input2);
   switch (input1->type) {
+    case kTfLiteBool:
+      if (!kSupportsBool) {
+        MicroPrintf("Type %s (%d) not supported.",
+                    TfLiteTypeGetName(input1->type), input1->type);
+        return kTfLiteError;
+      }
+      CompareNoScaling<bool, OpType>(data, input1, input2, output);
+      break;
     case kTfLiteFloat32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowLessEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data)
-          : reference_ops::LessEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<float>(input1), input2_shape,
-                tflite::micro::GetTensorData<float>(input2), output_shape,
-                output_data);
+      CompareNoScaling<float, OpType>(data, input1, input2, output);
       break;
     case kTfLiteInt32:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowLessEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data)
-          : reference_ops::LessEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int32_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int32_t>(input2), output_shape,
-                output_data);
+      CompareNoScaling<int32_t, OpType>(data, input1, input2, output);
       break;
     case kTfLiteInt64:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowLessEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data)
-          : reference_ops::LessEqualNoScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int64_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int64_t>(input2), output_shape,
-                output_data);
+      CompareNoScaling<int64_t, OpType>(data, input1, input2, output);
       break;
     case kTfLiteInt8:
-      requires_broadcast
-          ? reference_ops::Broadcast4DSlowLessEqualWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data)
-          : reference_ops::LessEqualWithScaling(
-                data->params, input1_shape,
-                tflite::micro::GetTensorData<int8_t>(input1), input2_shape,
-                tflite::micro::GetTensorData<int8_t>(input2), output_shape,
-                output_data);
+      CompareWithScaling<int8_t, OpType>(data, input1, input2, output);
       break;
     default:
       MicroPrintf("Type %s (%d) not supported.",
@@ -571,6 +204,9 @@ TfLiteStatus ComparisonsPrepare(TfLiteContext* context, TfLiteNode* node) {
     data->params.input2_shift = input2_shift;
   }
 
+  TF_LITE_ENSURE_STATUS(
+      PrepareBinaryBroadcast(context, input1, input2, &data->broadcast));
+
   micro_context->DeallocateTempTfLiteTensor(input1);
   micro_context->DeallocateTempTfLiteTensor(input2);
 
@@ -580,27 +216,33 @@ TfLiteStatus ComparisonsPrepare(TfLiteContext* context, TfLiteNode* node) {
 }  // namespace
 
 TFLMRegistration Register_EQUAL() {
-  return tflite::micro::RegisterOp(Init, ComparisonsPrepare, EqualEval);
+  return tflite::micro::RegisterOp(Init, ComparisonsPrepare,
+                                   ComparisonEval<EqualOp, true>);
 }
 
 TFLMRegistration Register_NOT_EQUAL() {
-  return tflite::micro::RegisterOp(Init, ComparisonsPrepare, NotEqualEval);
+  return tflite::micro::RegisterOp(Init, ComparisonsPrepare,
+                                   ComparisonEval<NotEqualOp, true>);
 }
 
 TFLMRegistration Register_GREATER() {
-  return tflite::micro::RegisterOp(Init, ComparisonsPrepare, GreaterEval);
+  return tflite::micro::RegisterOp(Init, ComparisonsPrepare,
+                                   ComparisonEval<GreaterOp, false>);
 }
 
 TFLMRegistration Register_GREATER_EQUAL() {
-  return tflite::micro::RegisterOp(Init, ComparisonsPrepare, GreaterEqualEval);
+  return tflite::micro::RegisterOp(Init, ComparisonsPrepare,
+                                   ComparisonEval<GreaterEqualOp, false>);
 }
 
 TFLMRegistration Register_LESS() {
-  return tflite::micro::RegisterOp(Init, ComparisonsPrepare, LessEval);
+  return tflite::micro::RegisterOp(Init, ComparisonsPrepare,
+                                   ComparisonEval<LessOp, false>);
 }
 
 TFLMRegistration Register_LESS_EQUAL() {
-  return tflite::micro::RegisterOp(Init, ComparisonsPrepare, LessEqualEval);
+  return tflite::micro::RegisterOp(Init, ComparisonsPrepare,
+                                   ComparisonEval<LessEqualOp, false>);
 }
 
 }  // namespace tflite
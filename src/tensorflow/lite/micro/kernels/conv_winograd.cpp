@@ -0,0 +1,595 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/conv_winograd.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/micro_arena_constants.h"
+#include "tensorflow/lite/micro/micro_context.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+
+namespace {
+
+// F(m x m, 3x3) computes an m x m output tile from an alpha x alpha input
+// tile, alpha = m + 2, as Y = A^T [(G g G^T) * (B^T d B)] A, where * is the
+// element-wise product summed over the input channels. The filter transform
+// uses G' = s * G, which has integer coefficients, so the transforms compute
+// Y' = s^2 * Y. For float filters the transformed filter is divided by s^2
+// at Prepare. For int8 filters Y is recovered from Y' modulo 2^32, see
+// RecoverAccumulator().
+
+// Applies a 1D transform to 3 filter values: G' = [[2, 0, 0], [1, 1, 1],
+// [1, -1, 1], [0, 0, 2]], s = 2.
+struct FilterTransform2x2 {
+  static constexpr int kIn = 3;
+  static constexpr int kOut = 4;
+  template <typename T>
+  static void Apply(const T* g, int g_stride, T* u, int u_stride) {
+    const T g0 = g[0];
+    const T g1 = g[g_stride];
+    const T g2 = g[2 * g_stride];
+    u[0] = 2 * g0;
+    u[u_stride] = g0 + g1 + g2;
+    u[2 * u_stride] = g0 - g1 + g2;
+    u[3 * u_stride] = 2 * g2;
+  }
+};
+
+// B^T = [[1, 0, -1, 0], [0, 1, 1, 0], [0, -1, 1, 0], [0, 1, 0, -1]].
+struct InputTransform2x2 {
+  static constexpr int kIn = 4;
+  static constexpr int kOut = 4;
+  template <typename T>
+  static void Apply(const T* d, int d_stride, T* v, int v_stride) {
+    const T d0 = d[0];
+    const T d1 = d[d_stride];
+    const T d2 = d[2 * d_stride];
+    const T d3 = d[3 * d_stride];
+    v[0] = d0 - d2;
+    v[v_stride] = d1 + d2;
+    v[2 * v_stride] = d2 - d1;
+    v[3 * v_stride] = d1 - d3;
+  }
+};
+
+// A^T = [[1, 1, 1, 0], [0, 1, -1, -1]].
+struct OutputTransform2x2 {
+  static constexpr int kIn = 4;
+  static constexpr int kOut = 2;
+  template <typename T>
+  static void Apply(const T* m, int m_stride, T* y, int y_stride) {
+    const T m0 = m[0];
+    const T m1 = m[m_stride];
+    const T m2 = m[2 * m_stride];
+    const T m3 = m[3 * m_stride];
+    y[0] = m0 + m1 + m2;
+    y[y_stride] = m1 - m2 - m3;
+  }
+};
+
+// G' = [[6, 0, 0], [-4, -4, -4], [-4, 4, -4], [1, 2, 4], [1, -2, 4],
+// [0, 0, 24]], s = 24.
+struct FilterTransform4x4 {
+  static constexpr int kIn = 3;
+  static constexpr int kOut = 6;
+  template <typename T>
+  static void Apply(const T* g, int g_stride, T* u, int u_stride) {
+    const T g0 = g[0];
+    const T g1 = g[g_stride];
+    const T g2 = g[2 * g_stride];
+    u[0] = 6 * g0;
+    u[u_stride] = -4 * (g0 + g1 + g2);
+    u[2 * u_stride] = -4 * (g0 - g1 + g2);
+    u[3 * u_stride] = g0 + 2 * g1 + 4 * g2;
+    u[4 * u_stride] = g0 - 2 * g1 + 4 * g2;
+    u[5 * u_stride] = 24 * g2;
+  }
+};
+
+// B^T = [[4, 0, -5, 0, 1, 0], [0, -4, -4, 1, 1, 0], [0, 4, -4, -1, 1, 0],
+// [0, -2, -1, 2, 1, 0], [0, 2, -1, -2, 1, 0], [0, 4, 0, -5, 0, 1]].
+struct InputTransform4x4 {
+  static constexpr int kIn = 6;
+  static constexpr int kOut = 6;
+  template <typename T>
+  static void Apply(const T* d, int d_stride, T* v, int v_stride) {
+    const T d0 = d[0];
+    const T d1 = d[d_stride];
+    const T d2 = d[2 * d_stride];
+    const T d3 = d[3 * d_stride];
+    const T d4 = d[4 * d_stride];
+    const T d5 = d[5 * d_stride];
+    v[0] = 4 * d0 - 5 * d2 + d4;
+    v[v_stride] = d3 + d4 - 4 * (d1 + d2);
+    v[2 * v_stride] = d4 - d3 + 4 * (d1 - d2);
+    v[3 * v_stride] = d4 - d2 + 2 * (d3 - d1);
+    v[4 * v_stride] = d4 - d2 + 2 * (d1 - d3);
+    v[5 * v_stride] = 4 * d1 - 5 * d3 + d5;
+  }
+};
+
+// A^T = [[1, 1, 1, 1, 1, 0], [0, 1, -1, 2, -2, 0], [0, 1, 1, 4, 4, 0],
+// [0, 1, -1, 8, -8, 1]].
+struct OutputTransform4x4 {
+  static constexpr int kIn = 6;
+  static constexpr int kOut = 4;
+  template <typename T>
+  static void Apply(const T* m, int m_stride, T* y, int y_stride) {
+    const T m0 = m[0];
+    const T m1 = m[m_stride];
+    const T m2 = m[2 * m_stride];
+    const T m3 = m[3 * m_stride];
+    const T m4 = m[4 * m_stride];
+    const T m5 = m[5 * m_stride];
+    const T sum12 = m1 + m2;
+    const T diff12 = m1 - m2;
+    const T sum34 = m3 + m4;
+    const T diff34 = m3 - m4;
+    y[0] = m0 + sum12 + sum34;
+    y[y_stride] = diff12 + 2 * diff34;
+    y[2 * y_stride] = sum12 + 4 * sum34;
+    y[3 * y_stride] = diff12 + 8 * diff34 + m5;
+  }
+};
+
+template <int kTile>
+struct WinogradTraits;
+
+template <>
+struct WinogradTraits<2> {
+  using FilterTransform = FilterTransform2x2;
+  using InputTransform = InputTransform2x2;
+  using OutputTransform = OutputTransform2x2;
+  // s^2 = 4 = 2^2 * 1.
+  static constexpr int kScaleShift = 2;
+  static constexpr int kScaleOdd = 1;
+  // Inverse of kScaleOdd modulo 2^32.
+  static constexpr uint32_t kScaleOddInverse = 1;
+  // |G' g G'^T| <= 9 * 128 fits int16_t.
+  using Int8Filter = int16_t;
+};
+
+template <>
+struct WinogradTraits<4> {
+  using FilterTransform = FilterTransform4x4;
+  using InputTransform = InputTransform4x4;
+  using OutputTransform = OutputTransform4x4;
+  // s^2 = 576 = 2^6 * 9.
+  static constexpr int kScaleShift = 6;
+  static constexpr int kScaleOdd = 9;
+  static constexpr uint32_t kScaleOddInverse = 0x38E38E39;
+  // |G' g G'^T| <= 576 * 128 needs int32_t.
+  using Int8Filter = int32_t;
+};
+
+template <int kTile>
+constexpr int WinogradAlpha() {
+  return kTile + 2;
+}
+
+// Largest magnitude of an int8 accumulator that RecoverAccumulator() returns
+// exactly.
+template <int kTile>
+constexpr int64_t MaxInt8Accumulator() {
+  return int64_t{1} << (31 - WinogradTraits<kTile>::kScaleShift);
+}
+
+// Applies a 1D transform to the columns and then the rows of a square block.
+template <typename Transform, typename T>
+inline void Transform2D(const T* in, T* out) {
+  constexpr int kIn = Transform::kIn;
+  constexpr int kOut = Transform::kOut;
+  T temp[kOut * kIn];
+  for (int i = 0; i < kIn; ++i) {
+    Transform::Apply(in + i, kIn, temp + i, kIn);
+  }
+  for (int i = 0; i < kOut; ++i) {
+    Transform::Apply(temp + i * kIn, 1, out + i * kOut, 1);
+  }
+}
+
+// Returns the accumulator Y from Y' = s^2 * Y modulo 2^32. The low
+// kScaleShift bits of Y' are zero, the remaining ones hold the odd factor
+// of s^2 times Y modulo 2^(32 - kScaleShift), which the inverse undoes.
+template <int kTile>
+inline int32_t RecoverAccumulator(uint32_t y) {
+  using Traits = WinogradTraits<kTile>;
+  constexpr int kBits = 32 - Traits::kScaleShift;
+  const uint32_t acc =
+      ((y >> Traits::kScaleShift) * Traits::kScaleOddInverse) &
+      ((uint32_t{1} << kBits) - 1);
+  if (acc < (uint32_t{1} << (kBits - 1))) {
+    return static_cast<int32_t>(acc);
+  }
+  return static_cast<int32_t>(acc) - (int32_t{1} << kBits);
+}
+
+// Input values of the transforms, with the zero point of int8 inputs
+// removed so that padding is zero.
+inline int16_t WinogradInputValue(int8_t value, int32_t input_offset) {
+  return static_cast<int16_t>(value + input_offset);
+}
+
+inline float WinogradInputValue(float value, int32_t input_offset) {
+  return value;
+}
+
+// Type used to compute the input transform of each value type.
+template <typename T>
+struct WinogradComputeType {
+  using Type = T;
+};
+
+template <>
+struct WinogradComputeType<int16_t> {
+  using Type = int32_t;
+};
+
+template <int kTile, typename ComputeT, typename FilterT,
+          typename TransformedT>
+void TransformFilter(const FilterT* filter, int output_depth, int input_depth,
+                     ComputeT divisor, TransformedT* transformed) {
+  constexpr int kAlpha = WinogradAlpha<kTile>();
+  for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+    for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
+      ComputeT g[9];
+      for (int i = 0; i < 9; ++i) {
+        g[i] = filter[(out_channel * 9 + i) * input_depth + in_channel];
+      }
+      ComputeT u[kAlpha * kAlpha];
+      Transform2D<typename WinogradTraits<kTile>::FilterTransform>(g, u);
+      for (int i = 0; i < kAlpha * kAlpha; ++i) {
+        transformed[(i * output_depth + out_channel) * input_depth +
+                    in_channel] = static_cast<TransformedT>(u[i] / divisor);
+      }
+    }
+  }
+}
+
+template <int kTile>
+bool IsInt8AccumulatorBounded(const TfLiteTensor* input,
+                              const TfLiteTensor* filter) {
+  const int output_depth = filter->dims->data[0];
+  const int filter_size = 9 * filter->dims->data[3];
+  const int8_t* filter_data = GetTensorData<int8_t>(filter);
+  int64_t max_filter_sum = 0;
+  for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+    int64_t filter_sum = 0;
+    for (int i = 0; i < filter_size; ++i) {
+      const int32_t value = filter_data[out_channel * filter_size + i];
+      filter_sum += value < 0 ? -value : value;
+    }
+    max_filter_sum = std::max(max_filter_sum, filter_sum);
+  }
+  const int32_t zero_point = input->params.zero_point;
+  const int64_t max_input =
+      std::max(zero_point - std::numeric_limits<int8_t>::min(),
+               std::numeric_limits<int8_t>::max() - zero_point);
+  return max_filter_sum * max_input < MaxInt8Accumulator<kTile>();
+}
+
+template <int kTile>
+size_t TransformedFilterElementSize(TfLiteType type) {
+  return type == kTfLiteInt8
+             ? sizeof(typename WinogradTraits<kTile>::Int8Filter)
+             : sizeof(float);
+}
+
+template <int kTile>
+TfLiteStatus Prepare(TfLiteContext* context, const TfLiteTensor* input,
+                     const TfLiteTensor* filter, const TfLiteTensor* output,
+                     OpDataConvWinograd* data) {
+  constexpr int kAlpha = WinogradAlpha<kTile>();
+  const int input_depth = input->dims->data[3];
+  const int output_depth = output->dims->data[3];
+  const size_t transformed_size = static_cast<size_t>(kAlpha) * kAlpha *
+                                  output_depth * input_depth *
+                                  TransformedFilterElementSize<kTile>(
+                                      filter->type);
+  data->tile_size = kTile;
+  data->transformed_filter =
+      GetMicroContext(context)->AllocatePackedWeightBuffer(transformed_size);
+  if (data->transformed_filter == nullptr) {
+    MicroPrintf("Failed to allocate %u bytes for the Winograd filter.",
+                static_cast<unsigned>(transformed_size));
+    return kTfLiteError;
+  }
+
+  // Accumulators of one tile, followed by its transformed input.
+  size_t scratch_size = kAlpha * kAlpha * output_depth * sizeof(uint32_t);
+  if (filter->type == kTfLiteInt8) {
+    TransformFilter<kTile, int32_t>(
+        GetTensorData<int8_t>(filter), output_depth, input_depth, 1,
+        static_cast<typename WinogradTraits<kTile>::Int8Filter*>(
+            data->transformed_filter));
+    scratch_size += kAlpha * kAlpha * input_depth * sizeof(int16_t);
+  } else {
+    constexpr int kScale = (1 << WinogradTraits<kTile>::kScaleShift) *
+                           WinogradTraits<kTile>::kScaleOdd;
+    TransformFilter<kTile, double>(
+        GetTensorData<float>(filter), output_depth, input_depth,
+        static_cast<double>(kScale),
+        static_cast<float*>(data->transformed_filter));
+    scratch_size += kAlpha * kAlpha * input_depth * sizeof(float);
+  }
+  // Both parts are streamed through with vector loads for every tile.
+  return micro::RequestAlignedScratchBufferInArena(
+      context, scratch_size, MicroArenaVectorBufferAlignment(),
+      &data->scratch_buffer_index);
+}
+
+// Computes the convolution tile by tile. `output_stage` converts the
+// transformed accumulator of an output channel to an output value.
+template <int kTile, typename ActT, typename ValueT, typename FilterT,
+          typename AccT, typename OutputStage>
+void Conv(const ConvParams& params, const RuntimeShape& input_shape,
+          const ActT* input_data, const FilterT* transformed_filter,
+          const RuntimeShape& output_shape, ActT* output_data, AccT* accs,
+          ValueT* values, const OutputStage& output_stage) {
+  using Traits = WinogradTraits<kTile>;
+  using ComputeT = typename WinogradComputeType<ValueT>::Type;
+  constexpr int kAlpha = WinogradAlpha<kTile>();
+
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int input_depth = input_shape.Dims(3);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  const int output_depth = output_shape.Dims(3);
+  const int pad_height = params.padding_values.height;
+  const int pad_width = params.padding_values.width;
+
+  for (int batch = 0; batch < batches; ++batch) {
+    for (int tile_y = 0; tile_y < output_height; tile_y += kTile) {
+      for (int tile_x = 0; tile_x < output_width; tile_x += kTile) {
+        // Gather the input tile, zero outside of the input.
+        for (int y = 0; y < kAlpha; ++y) {
+          const int in_y = tile_y - pad_height + y;
+          for (int x = 0; x < kAlpha; ++x) {
+            const int in_x = tile_x - pad_width + x;
+            ValueT* tile_values = values + (y * kAlpha + x) * input_depth;
+            if (in_y < 0 || in_y >= input_height || in_x < 0 ||
+                in_x >= input_width) {
+              std::fill(tile_values, tile_values + input_depth, ValueT{0});
+              continue;
+            }
+            const ActT* in =
+                input_data + Offset(input_shape, batch, in_y, in_x, 0);
+            for (int c = 0; c < input_depth; ++c) {
+              tile_values[c] = WinogradInputValue(in[c], params.input_offset);
+            }
+          }
+        }
+
+        // Transform the input tile of each channel in place.
+        for (int c = 0; c < input_depth; ++c) {
+          ComputeT d[kAlpha * kAlpha];
+          ComputeT v[kAlpha * kAlpha];
+          for (int i = 0; i < kAlpha * kAlpha; ++i) {
+            d[i] = values[i * input_depth + c];
+          }
+          Transform2D<typename Traits::InputTransform>(d, v);
+          for (int i = 0; i < kAlpha * kAlpha; ++i) {
+            values[i * input_depth + c] = static_cast<ValueT>(v[i]);
+          }
+        }
+
+        // Element-wise products, summed over the input channels.
+        for (int i = 0; i < kAlpha * kAlpha; ++i) {
+          const ValueT* v = values + i * input_depth;
+          const FilterT* u =
+              transformed_filter + i * output_depth * input_depth;
+          AccT* m = accs + i * output_depth;
+          for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+            AccT acc = 0;
+            for (int c = 0; c < input_depth; ++c) {
+              acc += static_cast<AccT>(u[c] * v[c]);
+            }
+            m[out_channel] = acc;
+            u += input_depth;
+          }
+        }
+
+        const int tile_height = std::min(kTile, output_height - tile_y);
+        const int tile_width = std::min(kTile, output_width - tile_x);
+        for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+          AccT m[kAlpha * kAlpha];
+          AccT y[kTile * kTile];
+          for (int i = 0; i < kAlpha * kAlpha; ++i) {
+            m[i] = accs[i * output_depth + out_channel];
+          }
+          Transform2D<typename Traits::OutputTransform>(m, y);
+          for (int out_y = 0; out_y < tile_height; ++out_y) {
+            for (int out_x = 0; out_x < tile_width; ++out_x) {
+              output_data[Offset(output_shape, batch, tile_y + out_y,
+                                 tile_x + out_x, out_channel)] =
+                  output_stage(out_channel, y[out_y * kTile + out_x]);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+template <int kTile>
+void EvalFloat(const ConvParams& params, const OpDataConvWinograd& data,
+               const TfLiteEvalTensor* input, const TfLiteEvalTensor* bias,
+               TfLiteEvalTensor* output, void* scratch) {
+  constexpr int kAlpha = WinogradAlpha<kTile>();
+  const int output_depth = output->dims->data[3];
+  const float* bias_data = micro::GetOptionalTensorData<float>(bias);
+  const float activation_min = params.float_activation_min;
+  const float activation_max = params.float_activation_max;
+  float* accs = static_cast<float*>(scratch);
+  Conv<kTile>(
+      params, micro::GetTensorShape(input), micro::GetTensorData<float>(input),
+      static_cast<const float*>(data.transformed_filter),
+      micro::GetTensorShape(output), micro::GetTensorData<float>(output), accs,
+      accs + kAlpha * kAlpha * output_depth,
+      [=](int out_channel, float acc) {
+        if (bias_data != nullptr) {
+          acc += bias_data[out_channel];
+        }
+        return ActivationFunctionWithMinMax(acc, activation_min,
+                                            activation_max);
+      });
+}
+
+template <int kTile>
+void EvalInt8(const ConvParams& params, const OpDataConvWinograd& data,
+              const int32_t* output_multiplier, const int32_t* output_shift,
+              const TfLiteEvalTensor* input, const TfLiteEvalTensor* bias,
+              TfLiteEvalTensor* output, void* scratch) {
+  constexpr int kAlpha = WinogradAlpha<kTile>();
+  const int output_depth = output->dims->data[3];
+  const int32_t* bias_data = micro::GetOptionalTensorData<int32_t>(bias);
+  const int32_t output_offset = params.output_offset;
+  const int32_t activation_min = params.quantized_activation_min;
+  const int32_t activation_max = params.quantized_activation_max;
+  uint32_t* accs = static_cast<uint32_t*>(scratch);
+  Conv<kTile>(
+      params, micro::GetTensorShape(input), micro::GetTensorData<int8_t>(input),
+      static_cast<const typename WinogradTraits<kTile>::Int8Filter*>(
+          data.transformed_filter),
+      micro::GetTensorShape(output), micro::GetTensorData<int8_t>(output),
+      accs,
+      reinterpret_cast<int16_t*>(accs + kAlpha * kAlpha * output_depth),
+      [=](int out_channel, uint32_t transformed_acc) {
+        int32_t acc = RecoverAccumulator<kTile>(transformed_acc);
+        if (bias_data != nullptr) {
+          acc += bias_data[out_channel];
+        }
+        acc = MultiplyByQuantizedMultiplier(
+            acc, output_multiplier[out_channel], output_shift[out_channel]);
+        acc += output_offset;
+        acc = std::max(acc, activation_min);
+        acc = std::min(acc, activation_max);
+        return static_cast<int8_t>(acc);
+      });
+}
+
+}  // namespace
+
+bool ConvWinogradIsEligible(const TfLiteConvParams& params,
+                            const TfLiteTensor* input,
+                            const TfLiteTensor* filter, int tile_size) {
+  if (filter->dims->data[1] != 3 || filter->dims->data[2] != 3 ||
+      params.stride_height != 1 || params.stride_width != 1 ||
+      params.dilation_height_factor != 1 ||
+      params.dilation_width_factor != 1 ||
+      filter->dims->data[3] != input->dims->data[3] ||
+      !IsConstantTensor(filter)) {
+    return false;
+  }
+  if ((input->type == kTfLiteFloat32 && filter->type == kTfLiteFloat32) ||
+      (input->type == kTfLiteInt8 && filter->type == kTfLiteInt8)) {
+    return tile_size == 2 || tile_size == 4;
+  }
+  return false;
+}
+
+bool ConvWinogradAccumulatorsFit(const TfLiteTensor* input,
+                                 const TfLiteTensor* filter, int tile_size) {
+  if (input->type != kTfLiteInt8) {
+    return true;
+  }
+  switch (tile_size) {
+    case 2:
+      return IsInt8AccumulatorBounded<2>(input, filter);
+    case 4:
+      return IsInt8AccumulatorBounded<4>(input, filter);
+    default:
+      return false;
+  }
+}
+
+TfLiteStatus ConvWinogradPrepare(TfLiteContext* context,
+                                 const TfLiteTensor* input,
+                                 const TfLiteTensor* filter,
+                                 const TfLiteTensor* output, int tile_size,
+                                 OpDataConvWinograd* data) {
+  switch (tile_size) {
+    case 2:
+      return Prepare<2>(context, input, filter, output, data);
+    case 4:
+      return Prepare<4>(context, input, filter, output, data);
+    default:
+      MicroPrintf("Winograd tile size %d not supported.", tile_size);
+      return kTfLiteError;
+  }
+}
+
+TfLiteStatus ConvWinogradEvalFloat(TfLiteContext* context,
+                                   const ConvParams& params,
+                                   const OpDataConvWinograd& data,
+                                   const TfLiteEvalTensor* input,
+                                   const TfLiteEvalTensor* bias,
+                                   TfLiteEvalTensor* output) {
+  void* scratch =
+      context->GetScratchBuffer(context, data.scratch_buffer_index);
+  TF_LITE_ENSURE(context, scratch != nullptr);
+  switch (data.tile_size) {
+    case 2:
+      EvalFloat<2>(params, data, input, bias, output, scratch);
+      return kTfLiteOk;
+    case 4:
+      EvalFloat<4>(params, data, input, bias, output, scratch);
+      return kTfLiteOk;
+    default:
+      MicroPrintf("Winograd tile size %d not supported.", data.tile_size);
+      return kTfLiteError;
+  }
+}
+
+TfLiteStatus ConvWinogradEvalInt8(TfLiteContext* context,
+                                  const ConvParams& params,
+                                  const OpDataConvWinograd& data,
+                                  const int32_t* output_multiplier,
+                                  const int32_t* output_shift,
+                                  const TfLiteEvalTensor* input,
+                                  const TfLiteEvalTensor* bias,
+                                  TfLiteEvalTensor* output) {
+  void* scratch =
+      context->GetScratchBuffer(context, data.scratch_buffer_index);
+  TF_LITE_ENSURE(context, scratch != nullptr);
+  switch (data.tile_size) {
+    case 2:
+      EvalInt8<2>(params, data, output_multiplier, output_shift, input, bias,
+                  output, scratch);
+      return kTfLiteOk;
+    case 4:
+      EvalInt8<4>(params, data, output_multiplier, output_shift, input, bias,
+                  output, scratch);
+      return kTfLiteOk;
+    default:
+      MicroPrintf("Winograd tile size %d not supported.", data.tile_size);
+      return kTfLiteError;
+  }
+}
+
+}  // namespace tflite
@@ -0,0 +1,87 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_CONV_WINOGRAD_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_CONV_WINOGRAD_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Winograd F(m x m, 3x3) convolution for CONV_2D with 3x3 filters, unit
+// strides and dilations and a single group. Output tiles of m = 2 and m = 4
+// are supported, which need 16 and 36 multiplications per tile and channel
+// pair instead of 36 and 144.
+//
+// The int8 variant transforms the filter with integer coefficients and
+// accumulates modulo 2^32, so its results are bit-exact with the reference
+// kernel as long as the accumulators stay within the range checked by
+// ConvWinogradAccumulatorsFit().
+struct OpDataConvWinograd {
+  // Output tile size m, or 0 if the node can not use this variant.
+  int tile_size;
+
+  // Filter transformed at Prepare into [alpha * alpha][output_depth]
+  // [input_depth] layout, where alpha = m + 2. Elements are int16_t for int8
+  // F(2x2, 3x3), int32_t for int8 F(4x4, 3x3) and float for float filters.
+  void* transformed_filter;
+
+  // Index to the buffer holding the transforms of one tile.
+  int scratch_buffer_index;
+};
+
+// Returns true if F(tile_size x tile_size, 3x3) supports the shape, strides
+// and types of the convolution. Requires a constant filter.
+bool ConvWinogradIsEligible(const TfLiteConvParams& params,
+                            const TfLiteTensor* input,
+                            const TfLiteTensor* filter, int tile_size);
+
+// Returns true if no accumulator of an eligible int8 convolution can exceed
+// the range recovered from the modular arithmetic, and always for float. Scans
+// the whole filter, so only call it for a variant that may run.
+bool ConvWinogradAccumulatorsFit(const TfLiteTensor* input,
+                                 const TfLiteTensor* filter, int tile_size);
+
+// Transforms the filter into a packed weight buffer and requests the scratch
+// buffer. Must be called from Prepare for an eligible node.
+TfLiteStatus ConvWinogradPrepare(TfLiteContext* context,
+                                 const TfLiteTensor* input,
+                                 const TfLiteTensor* filter,
+                                 const TfLiteTensor* output, int tile_size,
+                                 OpDataConvWinograd* data);
+
+TfLiteStatus ConvWinogradEvalFloat(TfLiteContext* context,
+                                   const ConvParams& params,
+                                   const OpDataConvWinograd& data,
+                                   const TfLiteEvalTensor* input,
+                                   const TfLiteEvalTensor* bias,
+                                   TfLiteEvalTensor* output);
+
+TfLiteStatus ConvWinogradEvalInt8(TfLiteContext* context,
+                                  const ConvParams& params,
+                                  const OpDataConvWinograd& data,
+                                  const int32_t* output_multiplier,
+                                  const int32_t* output_shift,
+                                  const TfLiteEvalTensor* input,
+                                  const TfLiteEvalTensor* bias,
+                                  TfLiteEvalTensor* output);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_CONV_WINOGRAD_H_
@@ -14,6 +14,8 @@ limitations under the License.
 ==============================================================================*/
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <numeric>
 #include <tuple>
 
@@ -56,6 +58,12 @@ constexpr int kBatchSize = 1;
 
 constexpr int kNumDetectionsPerClass = 100;
 
+// Non-max suppression bins the selected boxes in a grid of kNmsGridSize x
+// kNmsGridSize cells spanning the candidate boxes, so that a box is only
+// compared with selected boxes sharing a cell with it.
+constexpr int kNmsGridSize = 8;
+constexpr int kNmsGridCells = kNmsGridSize * kNmsGridSize;
+
 // Object Detection model produces axis-aligned boxes in two formats:
 // BoxCorner represents the lower left corner (xmin, ymin) and
 // the upper right corner (xmax, ymax).
@@ -99,7 +107,7 @@ struct OpData {
   CenterSizeEncoding scale_values;
 
   // Scratch buffers indexes
-  int active_candidate_idx;
+  int candidates_idx;
   int decoded_boxes_idx;
   int scores_idx;
   int score_buffer_idx;
@@ -110,11 +118,29 @@ struct OpData {
   int sorted_indices_idx;
   int buffer_idx;
   int selected_idx;
+  int nms_grid_idx;
 
   // Cached tensor scale and zero point values for quantized operations
   TfLiteQuantizationParams input_box_encodings;
   TfLiteQuantizationParams input_class_predictions;
   TfLiteQuantizationParams input_anchors;
+
+  // Smallest quantized class prediction that dequantizes to at least
+  // non_max_suppression_score_threshold, for int8 and uint8 predictions.
+  int quantized_score_threshold;
+};
+
+// Anchors whose score passes non_max_suppression_score_threshold for at least
+// one class, in increasing order. Only these boxes are decoded, and only
+// their rows of the scores are read.
+struct CandidateBoxes {
+  const int* indices;
+  int size;
+  // Origin and inverse cell size of the non-max suppression grid.
+  float grid_ymin;
+  float grid_xmin;
+  float grid_inv_cell_h;
+  float grid_inv_cell_w;
 };
 
 void* DetectionPostProcessInit(TfLiteContext* context, const char* buffer,
@@ -150,6 +176,41 @@ void* DetectionPostProcessInit(TfLiteContext* context, const char* buffer,
   return op_data;
 }
 
+class Dequantizer {
+ public:
+  Dequantizer(int zero_point, float scale)
+      : zero_point_(zero_point), scale_(scale) {}
+  explicit Dequantizer(const TfLiteQuantizationParams& params)
+      : Dequantizer(params.zero_point, params.scale) {}
+  template <typename T>
+  float operator()(T x) const {
+    return (static_cast<float>(x) - zero_point_) * scale_;
+  }
+
+ private:
+  int zero_point_;
+  float scale_;
+};
+
+bool IsSupportedType(TfLiteType type) {
+  return type == kTfLiteFloat32 || type == kTfLiteInt8 || type == kTfLiteUInt8;
+}
+
+// Returns the smallest value of T that dequantizes to at least `threshold`,
+// or one past the largest value of T if there is none.
+template <typename T>
+int QuantizeScoreThreshold(const TfLiteQuantizationParams& params,
+                           float threshold) {
+  const Dequantizer dequantize(params);
+  for (int q = std::numeric_limits<T>::min();
+       q <= std::numeric_limits<T>::max(); ++q) {
+    if (dequantize(q) >= threshold) {
+      return q;
+    }
+  }
+  return std::numeric_limits<T>::max() + 1;
+}
+
 TfLiteStatus DetectionPostProcessPrepare(TfLiteContext* context,
                                          TfLiteNode* node) {
   auto* op_data = static_cast<OpData*>(node->user_data);
@@ -168,6 +229,9 @@ TfLiteStatus DetectionPostProcessPrepare(TfLiteContext* context,
   TF_LITE_ENSURE_EQ(context, NumDimensions(input_box_encodings), 3);
   TF_LITE_ENSURE_EQ(context, NumDimensions(input_class_predictions), 3);
   TF_LITE_ENSURE_EQ(context, NumDimensions(input_anchors), 2);
+  TF_LITE_ENSURE(context, IsSupportedType(input_box_encodings->type));
+  TF_LITE_ENSURE(context, IsSupportedType(input_class_predictions->type));
+  TF_LITE_ENSURE(context, IsSupportedType(input_anchors->type));
 
   TF_LITE_ENSURE_EQ(context, NumOutputs(node), 4);
   const int num_boxes = input_box_encodings->dims->data[1];
@@ -182,18 +246,30 @@ TfLiteStatus DetectionPostProcessPrepare(TfLiteContext* context,
       input_class_predictions->params.zero_point;
   op_data->input_anchors.scale = input_anchors->params.scale;
   op_data->input_anchors.zero_point = input_anchors->params.zero_point;
+  if (input_class_predictions->type == kTfLiteInt8) {
+    op_data->quantized_score_threshold = QuantizeScoreThreshold<int8_t>(
+        op_data->input_class_predictions,
+        op_data->non_max_suppression_score_threshold);
+  } else if (input_class_predictions->type == kTfLiteUInt8) {
+    op_data->quantized_score_threshold = QuantizeScoreThreshold<uint8_t>(
+        op_data->input_class_predictions,
+        op_data->non_max_suppression_score_threshold);
+  }
 
   // Scratch tensors
-  context->RequestScratchBufferInArena(context, num_boxes,
-                                       &op_data->active_candidate_idx);
+  context->RequestScratchBufferInArena(context, num_boxes * sizeof(int),
+                                       &op_data->candidates_idx);
   context->RequestScratchBufferInArena(context,
                                        num_boxes * kNumCoordBox * sizeof(float),
                                        &op_data->decoded_boxes_idx);
-  context->RequestScratchBufferInArena(
-      context,
-      input_class_predictions->dims->data[1] *
-          input_class_predictions->dims->data[2] * sizeof(float),
-      &op_data->scores_idx);
+  // Dequantized scores, float predictions are read in place.
+  if (input_class_predictions->type != kTfLiteFloat32) {
+    context->RequestScratchBufferInArena(
+        context,
+        input_class_predictions->dims->data[1] *
+            input_class_predictions->dims->data[2] * sizeof(float),
+        &op_data->scores_idx);
+  }
 
   // Additional buffers
   context->RequestScratchBufferInArena(context, num_boxes * sizeof(float),
@@ -217,6 +293,13 @@ TfLiteStatus DetectionPostProcessPrepare(TfLiteContext* context,
   buffer_size = std::min(num_boxes, op_data->max_detections);
   context->RequestScratchBufferInArena(
       context, buffer_size * num_boxes * sizeof(int), &op_data->selected_idx);
+  // One bit per selected box in each cell of the non-max suppression grid.
+  const int max_selected =
+      std::min(num_boxes, std::max(op_data->max_detections,
+                                   op_data->detections_per_class));
+  context->RequestScratchBufferInArena(
+      context, kNmsGridCells * ((max_selected + 31) / 32) * sizeof(uint32_t),
+      &op_data->nms_grid_idx);
 
   // Outputs: detection_boxes, detection_scores, detection_classes,
   // num_detections
@@ -229,19 +312,6 @@ TfLiteStatus DetectionPostProcessPrepare(TfLiteContext* context,
   return kTfLiteOk;
 }
 
-class Dequantizer {
- public:
-  Dequantizer(int zero_point, float scale)
-      : zero_point_(zero_point), scale_(scale) {}
-  float operator()(uint8_t x) {
-    return (static_cast<float>(x) - zero_point_) * scale_;
-  }
-
- private:
-  int zero_point_;
-  float scale_;
-};
-
 template <class T>
 T ReInterpretTensor(const TfLiteEvalTensor* tensor) {
   const float* tensor_base = tflite::micro::GetTensorData<float>(tensor);
@@ -254,38 +324,64 @@ T ReInterpretTensor(TfLiteEvalTensor* tensor) {
   return reinterpret_cast<T>(tensor_base);
 }
 
+// Reads the center-size encoding at `offset` in `tensor`, dequantizing it with
+// `params` if needed.
+CenterSizeEncoding ReadCenterSize(const TfLiteEvalTensor* tensor, int offset,
+                                  const TfLiteQuantizationParams& params) {
+  switch (tensor->type) {
+    case kTfLiteInt8: {
+      const int8_t* data = tflite::micro::GetTensorData<int8_t>(tensor);
+      const Dequantizer dequantize(params);
+      return {dequantize(data[offset]), dequantize(data[offset + 1]),
+              dequantize(data[offset + 2]), dequantize(data[offset + 3])};
+    }
+    case kTfLiteUInt8: {
+      const uint8_t* data = tflite::micro::GetTensorData<uint8_t>(tensor);
+      const Dequantizer dequantize(params);
+      return {dequantize(data[offset]), dequantize(data[offset + 1]),
+              dequantize(data[offset + 2]), dequantize(data[offset + 3])};
+    }
+    default:
+      return *reinterpret_cast<const CenterSizeEncoding*>(
+          &tflite::micro::GetTensorData<float>(tensor)[offset]);
+  }
+}
+
+bool ValidateBox(const BoxCornerEncoding& box) {
+  // ymax>=ymin, xmax>=xmin
+  return box.ymin < box.ymax && box.xmin < box.xmax;
+}
+
+// Decodes the candidate boxes, and sets the non-max suppression grid to span
+// them.
 TfLiteStatus DecodeCenterSizeBoxes(TfLiteContext* context, TfLiteNode* node,
-                                   OpData* op_data) {
+                                   OpData* op_data,
+                                   CandidateBoxes* candidates) {
   // Parse input tensor boxencodings
   const TfLiteEvalTensor* input_box_encodings =
       tflite::micro::GetEvalInput(context, node, kInputTensorBoxEncodings);
   TF_LITE_ENSURE_EQ(context, input_box_encodings->dims->data[0], kBatchSize);
-  const int num_boxes = input_box_encodings->dims->data[1];
-  TF_LITE_ENSURE(context, input_box_encodings->dims->data[2] >= kNumCoordBox);
+  const int box_encoding_size = input_box_encodings->dims->data[2];
+  TF_LITE_ENSURE(context, box_encoding_size >= kNumCoordBox);
   const TfLiteEvalTensor* input_anchors =
       tflite::micro::GetEvalInput(context, node, kInputTensorAnchors);
+  float* decoded_boxes = reinterpret_cast<float*>(
+      context->GetScratchBuffer(context, op_data->decoded_boxes_idx));
 
   // Decode the boxes to get (ymin, xmin, ymax, xmax) based on the anchors
-  CenterSizeEncoding box_centersize;
-  CenterSizeEncoding scale_values = op_data->scale_values;
-  CenterSizeEncoding anchor;
-  for (int idx = 0; idx < num_boxes; ++idx) {
-    switch (input_box_encodings->type) {
-        // Float
-      case kTfLiteFloat32: {
-        // Please see DequantizeBoxEncodings function for the support detail.
-        const int box_encoding_idx = idx * input_box_encodings->dims->data[2];
-        const float* boxes = &(tflite::micro::GetTensorData<float>(
-            input_box_encodings)[box_encoding_idx]);
-        box_centersize = *reinterpret_cast<const CenterSizeEncoding*>(boxes);
-        anchor =
-            ReInterpretTensor<const CenterSizeEncoding*>(input_anchors)[idx];
-        break;
-      }
-      default:
-        // Unsupported type.
-        return kTfLiteError;
-    }
+  const CenterSizeEncoding scale_values = op_data->scale_values;
+  float ymin = std::numeric_limits<float>::max();
+  float xmin = std::numeric_limits<float>::max();
+  float ymax = std::numeric_limits<float>::lowest();
+  float xmax = std::numeric_limits<float>::lowest();
+  for (int i = 0; i < candidates->size; ++i) {
+    const int idx = candidates->indices[i];
+    // Please see DequantizeBoxEncodings function for the support detail.
+    const CenterSizeEncoding box_centersize =
+        ReadCenterSize(input_box_encodings, idx * box_encoding_size,
+                       op_data->input_box_encodings);
+    const CenterSizeEncoding anchor = ReadCenterSize(
+        input_anchors, idx * kNumCoordBox, op_data->input_anchors);
 
     float ycenter = static_cast<float>(static_cast<double>(box_centersize.y) /
                                            static_cast<double>(scale_values.y) *
@@ -308,19 +404,33 @@ TfLiteStatus DecodeCenterSizeBoxes(TfLiteContext* context, TfLiteNode* node,
                                      static_cast<double>(scale_values.w))) *
                            static_cast<double>(anchor.w));
 
-    float* decoded_boxes = reinterpret_cast<float*>(
-        context->GetScratchBuffer(context, op_data->decoded_boxes_idx));
     auto& box = reinterpret_cast<BoxCornerEncoding*>(decoded_boxes)[idx];
     box.ymin = ycenter - half_h;
     box.xmin = xcenter - half_w;
     box.ymax = ycenter + half_h;
     box.xmax = xcenter + half_w;
+    TF_LITE_ENSURE(context, ValidateBox(box));
+
+    ymin = std::min(ymin, box.ymin);
+    xmin = std::min(xmin, box.xmin);
+    ymax = std::max(ymax, box.ymax);
+    xmax = std::max(xmax, box.xmax);
   }
+
+  candidates->grid_ymin = ymin;
+  candidates->grid_xmin = xmin;
+  candidates->grid_inv_cell_h = ymax > ymin ? kNmsGridSize / (ymax - ymin) : 0;
+  candidates->grid_inv_cell_w = xmax > xmin ? kNmsGridSize / (xmax - xmin) : 0;
   return kTfLiteOk;
 }
 
 void DecreasingPartialArgSort(const float* values, int num_values,
                               int num_to_sort, int* indices) {
+  // Only the first num_to_sort indices are set when that is a single one.
+  if (num_to_sort == 1) {
+    indices[0] = std::max_element(values, values + num_values) - values;
+    return;
+  }
   std::iota(indices, indices + num_values, 0);
   std::partial_sort(indices, indices + num_to_sort, indices + num_values,
                     [&values](const int i, const int j) {
@@ -328,82 +438,24 @@ void DecreasingPartialArgSort(const float* values, int num_values,
                     });
 }
 
-template <typename Compare>
-void InsertionSort(int* start, int* end, Compare compare) {
-  for (int* i = start; i != end; ++i) {
-    std::rotate(std::upper_bound(start, i, *i, compare), i, i + 1);
-  }
-}
-
-template <typename Compare>
-void TopDownMerge(int* values, int* scratch, const int half_num_values,
-                  int num_values, Compare compare) {
-  int left = 0;
-  int right = half_num_values;
-
-  for (int i = 0; i < num_values; i++) {
-    if (left >= half_num_values ||
-        (right < num_values && compare(values[right], values[left]))) {
-      scratch[i] = values[right++];
-    } else {
-      scratch[i] = values[left++];
-    }
-  }
-  memcpy(values, scratch, num_values * sizeof(int));
-}
-
-template <typename Compare>
-void MergeSort(int* values, int* scratch, const int num_values,
-               Compare compare) {
-  constexpr int threshold = 20;
-
-  if (num_values < threshold) {
-    InsertionSort(values, values + num_values, compare);
-    return;
-  }
-
-  const int half_num_values = num_values / 2;
-
-  MergeSort(values, scratch, half_num_values, compare);
-  MergeSort(values + half_num_values, scratch, num_values - half_num_values,
-            compare);
-  TopDownMerge(values, scratch, half_num_values, num_values, compare);
-}
-
-void DecreasingArgSort(const float* values, int num_values, int* indices,
-                       int* scratch) {
-  std::iota(indices, indices + num_values, 0);
-
-  MergeSort(indices, scratch, num_values, [&values](const int i, const int j) {
-    return values[i] > values[j];
-  });
-}
-
-int SelectDetectionsAboveScoreThreshold(const float* values, int size,
+// Keeps the candidate boxes scoring at least `threshold`, in increasing order
+// of their anchors.
+int SelectDetectionsAboveScoreThreshold(const float* values,
+                                        const CandidateBoxes& candidates,
                                         const float threshold,
                                         float* keep_values, int* keep_indices) {
   int counter = 0;
-  for (int i = 0; i < size; i++) {
-    if (values[i] >= threshold) {
-      keep_values[counter] = values[i];
-      keep_indices[counter] = i;
+  for (int i = 0; i < candidates.size; i++) {
+    const int box = candidates.indices[i];
+    if (values[box] >= threshold) {
+      keep_values[counter] = values[box];
+      keep_indices[counter] = box;
       counter++;
     }
   }
   return counter;
 }
 
-bool ValidateBoxes(const float* decoded_boxes, const int num_boxes) {
-  for (int i = 0; i < num_boxes; ++i) {
-    // ymax>=ymin, xmax>=xmin
-    auto& box = reinterpret_cast<const BoxCornerEncoding*>(decoded_boxes)[i];
-    if (box.ymin >= box.ymax || box.xmin >= box.xmax) {
-      return false;
-    }
-  }
-  return true;
-}
-
 float ComputeIntersectionOverUnion(const float* decoded_boxes, const int i,
                                    const int j) {
   auto& box_i = reinterpret_cast<const BoxCornerEncoding*>(decoded_boxes)[i];
@@ -421,19 +473,32 @@ float ComputeIntersectionOverUnion(const float* decoded_boxes, const int i,
   return intersection_area / (area_i + area_j - intersection_area);
 }
 
+// Returns the range of non-max suppression grid cells covering [lo, hi].
+void NmsGridRange(float lo, float hi, float origin, float inv_cell_size,
+                  int* first, int* last) {
+  auto cell = [&](float v) {
+    const int c = static_cast<int>((v - origin) * inv_cell_size);
+    return std::min(std::max(c, 0), kNmsGridSize - 1);
+  };
+  *first = cell(lo);
+  *last = cell(hi);
+}
+
 // NonMaxSuppressionSingleClass() prunes out the box locations with high overlap
 // before selecting the highest scoring boxes (max_detections in number)
-// It assumes all boxes are good in beginning and sorts based on the scores.
-// If lower-scoring box has too much overlap with a higher-scoring box,
-// we get rid of the lower-scoring box.
-// Complexity is O(N^2) pairwise comparison between boxes
+// It assumes all boxes are good in beginning and visits them in decreasing
+// score order. A box is selected unless it overlaps too much with a box
+// selected before it, which is the same as having every selected box get rid
+// of the lower-scoring boxes it overlaps.
+// The boxes are taken from a max-heap, so that only the visited ones are
+// ordered, and the selected boxes are binned in a grid, so that a box is only
+// compared with the selected boxes sharing a grid cell with it.
+// Complexity is O(N + M log N) for visiting M of the N boxes, plus the overlap
+// checks, which are bounded by O(M * max_detections).
 TfLiteStatus NonMaxSuppressionSingleClassHelper(
     TfLiteContext* context, TfLiteNode* node, OpData* op_data,
-    const float* scores, int* selected, int* selected_size,
-    int max_detections) {
-  const TfLiteEvalTensor* input_box_encodings =
-      tflite::micro::GetEvalInput(context, node, kInputTensorBoxEncodings);
-  const int num_boxes = input_box_encodings->dims->data[1];
+    const float* scores, const CandidateBoxes& candidates, int* selected,
+    int* selected_size, int max_detections) {
   const float non_max_suppression_score_threshold =
       op_data->non_max_suppression_score_threshold;
   const float intersection_over_union_threshold =
@@ -444,65 +509,77 @@ TfLiteStatus NonMaxSuppressionSingleClassHelper(
   // and should be less than 1.
   TF_LITE_ENSURE(context, (intersection_over_union_threshold > 0.0f) &&
                               (intersection_over_union_threshold <= 1.0f));
-  // Validate boxes
-  float* decoded_boxes = reinterpret_cast<float*>(
+  // Boxes have been validated when they were decoded.
+  const float* decoded_boxes = reinterpret_cast<const float*>(
       context->GetScratchBuffer(context, op_data->decoded_boxes_idx));
 
-  TF_LITE_ENSURE(context, ValidateBoxes(decoded_boxes, num_boxes));
-
   // threshold scores
   int* keep_indices = reinterpret_cast<int*>(
       context->GetScratchBuffer(context, op_data->keep_indices_idx));
   float* keep_scores = reinterpret_cast<float*>(
       context->GetScratchBuffer(context, op_data->keep_scores_idx));
-  int num_scores_kept = SelectDetectionsAboveScoreThreshold(
-      scores, num_boxes, non_max_suppression_score_threshold, keep_scores,
+  const int num_boxes_kept = SelectDetectionsAboveScoreThreshold(
+      scores, candidates, non_max_suppression_score_threshold, keep_scores,
       keep_indices);
-  int* sorted_indices = reinterpret_cast<int*>(
-      context->GetScratchBuffer(context, op_data->sorted_indices_idx));
 
-  // Reusing keep_indices for scratch buffer and write back its values
-  // after the sorting is done.
-  DecreasingArgSort(keep_scores, num_scores_kept, sorted_indices, keep_indices);
-  int counter = 0;
-  for (int i = 0; i < num_boxes; i++) {
-    if (scores[i] >= non_max_suppression_score_threshold) {
-      keep_indices[counter] = i;
-      counter++;
-    }
-  }
+  // Heap of positions in keep_indices, ties go to the lower anchor.
+  int* heap = reinterpret_cast<int*>(
+      context->GetScratchBuffer(context, op_data->sorted_indices_idx));
+  const auto lower_score = [keep_scores](const int i, const int j) {
+    return keep_scores[i] < keep_scores[j] ||
+           (keep_scores[i] == keep_scores[j] && i > j);
+  };
+  std::iota(heap, heap + num_boxes_kept, 0);
+  std::make_heap(heap, heap + num_boxes_kept, lower_score);
 
-  const int num_boxes_kept = num_scores_kept;
   const int output_size = std::min(num_boxes_kept, max_detections);
   *selected_size = 0;
 
-  int num_active_candidate = num_boxes_kept;
-  uint8_t* active_box_candidate = reinterpret_cast<uint8_t*>(
-      context->GetScratchBuffer(context, op_data->active_candidate_idx));
-
-  for (int row = 0; row < num_boxes_kept; row++) {
-    active_box_candidate[row] = 1;
-  }
-  for (int i = 0; i < num_boxes_kept; ++i) {
-    if (num_active_candidate == 0 || *selected_size >= output_size) break;
-    if (active_box_candidate[i] == 1) {
-      selected[(*selected_size)++] = keep_indices[sorted_indices[i]];
-      active_box_candidate[i] = 0;
-      num_active_candidate--;
-    } else {
-      continue;
-    }
-    for (int j = i + 1; j < num_boxes_kept; ++j) {
-      if (active_box_candidate[j] == 1) {
-        float intersection_over_union = ComputeIntersectionOverUnion(
-            decoded_boxes, keep_indices[sorted_indices[i]],
-            keep_indices[sorted_indices[j]]);
-
-        if (intersection_over_union > intersection_over_union_threshold) {
-          active_box_candidate[j] = 0;
-          num_active_candidate--;
+  // Bit s of a cell word is set if selected[s] covers the cell.
+  const int grid_words = (output_size + 31) / 32;
+  uint32_t* grid = reinterpret_cast<uint32_t*>(
+      context->GetScratchBuffer(context, op_data->nms_grid_idx));
+  std::memset(grid, 0, kNmsGridCells * grid_words * sizeof(uint32_t));
+
+  int heap_size = num_boxes_kept;
+  while (heap_size > 0 && *selected_size < output_size) {
+    std::pop_heap(heap, heap + heap_size, lower_score);
+    const int box_index = keep_indices[heap[--heap_size]];
+    const auto& box =
+        reinterpret_cast<const BoxCornerEncoding*>(decoded_boxes)[box_index];
+    int row_first, row_last, col_first, col_last;
+    NmsGridRange(box.ymin, box.ymax, candidates.grid_ymin,
+                 candidates.grid_inv_cell_h, &row_first, &row_last);
+    NmsGridRange(box.xmin, box.xmax, candidates.grid_xmin,
+                 candidates.grid_inv_cell_w, &col_first, &col_last);
+
+    bool suppressed = false;
+    const int active_words = (*selected_size + 31) / 32;
+    for (int w = 0; w < active_words && !suppressed; ++w) {
+      uint32_t overlapping = 0;
+      for (int row = row_first; row <= row_last; ++row) {
+        for (int col = col_first; col <= col_last; ++col) {
+          overlapping |= grid[(row * kNmsGridSize + col) * grid_words + w];
         }
       }
+      for (int bit = 0; overlapping != 0 && !suppressed; ++bit) {
+        if (overlapping & (1u << bit)) {
+          overlapping &= ~(1u << bit);
+          suppressed = ComputeIntersectionOverUnion(
+                           decoded_boxes, selected[w * 32 + bit], box_index) >
+                       intersection_over_union_threshold;
+        }
+      }
+    }
+    if (suppressed) continue;
+
+    const int slot = (*selected_size)++;
+    selected[slot] = box_index;
+    for (int row = row_first; row <= row_last; ++row) {
+      for (int col = col_first; col <= col_last; ++col) {
+        grid[(row * kNmsGridSize + col) * grid_words + slot / 32] |=
+            1u << (slot % 32);
+      }
     }
   }
 
@@ -516,12 +593,9 @@ TfLiteStatus NonMaxSuppressionSingleClassHelper(
 // 3) The worst runtime of the regular NMS is O(K*N^2)
 // where N is the number of anchors and K the number of
 // classes.
-TfLiteStatus NonMaxSuppressionMultiClassRegularHelper(TfLiteContext* context,
-                                                      TfLiteNode* node,
-                                                      OpData* op_data,
-                                                      const float* scores) {
-  const TfLiteEvalTensor* input_box_encodings =
-      tflite::micro::GetEvalInput(context, node, kInputTensorBoxEncodings);
+TfLiteStatus NonMaxSuppressionMultiClassRegularHelper(
+    TfLiteContext* context, TfLiteNode* node, OpData* op_data,
+    const float* scores, const CandidateBoxes& candidates) {
   const TfLiteEvalTensor* input_class_predictions =
       tflite::micro::GetEvalInput(context, node, kInputTensorClassPredictions);
   TfLiteEvalTensor* detection_boxes =
@@ -533,7 +607,6 @@ TfLiteStatus NonMaxSuppressionMultiClassRegularHelper(TfLiteContext* context,
   TfLiteEvalTensor* num_detections =
       tflite::micro::GetEvalOutput(context, node, kOutputTensorNumDetections);
 
-  const int num_boxes = input_box_encodings->dims->data[1];
   const int num_classes = op_data->num_classes;
   const int num_detections_per_class = op_data->detections_per_class;
   const int max_detections = op_data->max_detections;
@@ -559,8 +632,9 @@ TfLiteStatus NonMaxSuppressionMultiClassRegularHelper(TfLiteContext* context,
       context->GetScratchBuffer(context, op_data->sorted_values_idx));
 
   for (int col = 0; col < num_classes; col++) {
-    for (int row = 0; row < num_boxes; row++) {
-      // Get scores of boxes corresponding to all anchors for single class
+    for (int i = 0; i < candidates.size; i++) {
+      // Get scores of boxes corresponding to candidate anchors for single class
+      const int row = candidates.indices[i];
       class_scores[row] =
           *(scores + row * num_classes_with_background + col + label_offset);
     }
@@ -569,8 +643,8 @@ TfLiteStatus NonMaxSuppressionMultiClassRegularHelper(TfLiteContext* context,
     int* selected = reinterpret_cast<int*>(
         context->GetScratchBuffer(context, op_data->selected_idx));
     TF_LITE_ENSURE_STATUS(NonMaxSuppressionSingleClassHelper(
-        context, node, op_data, class_scores, selected, &selected_size,
-        num_detections_per_class));
+        context, node, op_data, class_scores, candidates, selected,
+        &selected_size, num_detections_per_class));
     // Add selected indices from non-max suppression of boxes in this class
     int output_index = size_of_sorted_indices;
     for (int i = 0; i < selected_size; i++) {
@@ -649,12 +723,9 @@ TfLiteStatus NonMaxSuppressionMultiClassRegularHelper(TfLiteContext* context,
 // 3) Compared to standard NMS, the worst runtime of this version is O(N^2)
 // instead of O(KN^2) where N is the number of anchors and K the number of
 // classes.
-TfLiteStatus NonMaxSuppressionMultiClassFastHelper(TfLiteContext* context,
-                                                   TfLiteNode* node,
-                                                   OpData* op_data,
-                                                   const float* scores) {
-  const TfLiteEvalTensor* input_box_encodings =
-      tflite::micro::GetEvalInput(context, node, kInputTensorBoxEncodings);
+TfLiteStatus NonMaxSuppressionMultiClassFastHelper(
+    TfLiteContext* context, TfLiteNode* node, OpData* op_data,
+    const float* scores, const CandidateBoxes& candidates) {
   const TfLiteEvalTensor* input_class_predictions =
       tflite::micro::GetEvalInput(context, node, kInputTensorClassPredictions);
   TfLiteEvalTensor* detection_boxes =
@@ -667,7 +738,6 @@ TfLiteStatus NonMaxSuppressionMultiClassFastHelper(TfLiteContext* context,
   TfLiteEvalTensor* num_detections =
       tflite::micro::GetEvalOutput(context, node, kOutputTensorNumDetections);
 
-  const int num_boxes = input_box_encodings->dims->data[1];
   const int num_classes = op_data->num_classes;
   const int max_categories_per_anchor = op_data->max_classes_per_detection;
   const int num_classes_with_background =
@@ -683,7 +753,8 @@ TfLiteStatus NonMaxSuppressionMultiClassFastHelper(TfLiteContext* context,
   int* sorted_class_indices = reinterpret_cast<int*>(
       context->GetScratchBuffer(context, op_data->buffer_idx));
 
-  for (int row = 0; row < num_boxes; row++) {
+  for (int i = 0; i < candidates.size; i++) {
+    const int row = candidates.indices[i];
     const float* box_scores =
         scores + row * num_classes_with_background + label_offset;
     int* class_indices = sorted_class_indices + row * num_classes;
@@ -697,7 +768,7 @@ TfLiteStatus NonMaxSuppressionMultiClassFastHelper(TfLiteContext* context,
   int* selected = reinterpret_cast<int*>(
       context->GetScratchBuffer(context, op_data->selected_idx));
   TF_LITE_ENSURE_STATUS(NonMaxSuppressionSingleClassHelper(
-      context, node, op_data, max_scores, selected, &selected_size,
+      context, node, op_data, max_scores, candidates, selected, &selected_size,
       op_data->max_detections));
 
   // Allocate output tensors
@@ -736,9 +807,21 @@ TfLiteStatus NonMaxSuppressionMultiClassFastHelper(TfLiteContext* context,
   return kTfLiteOk;
 }
 
-TfLiteStatus NonMaxSuppressionMultiClass(TfLiteContext* context,
-                                         TfLiteNode* node, OpData* op_data) {
-  // Get the input tensors
+// Returns whether any class of a row of quantized scores reaches `threshold`.
+template <typename T>
+bool AnyQuantizedScoreAbove(const T* scores, int num_classes, int threshold) {
+  for (int c = 0; c < num_classes; ++c) {
+    if (scores[c] >= threshold) return true;
+  }
+  return false;
+}
+
+// Fills in the candidate anchors, comparing quantized scores with the
+// threshold without dequantizing them, and sets `scores` to the float scores.
+// Quantized scores are only dequantized for the candidate anchors.
+TfLiteStatus SelectCandidateBoxes(TfLiteContext* context, TfLiteNode* node,
+                                  OpData* op_data, CandidateBoxes* candidates,
+                                  const float** scores) {
   const TfLiteEvalTensor* input_box_encodings =
       tflite::micro::GetEvalInput(context, node, kInputTensorBoxEncodings);
   const TfLiteEvalTensor* input_class_predictions =
@@ -754,23 +837,82 @@ TfLiteStatus NonMaxSuppressionMultiClass(TfLiteContext* context,
 
   TF_LITE_ENSURE(context, (num_classes_with_background - num_classes <= 1));
   TF_LITE_ENSURE(context, (num_classes_with_background >= num_classes));
+  // The row index offset is 1 if background class is included and 0 otherwise.
+  const int label_offset = num_classes_with_background - num_classes;
 
-  const float* scores;
+  int* indices = reinterpret_cast<int*>(
+      context->GetScratchBuffer(context, op_data->candidates_idx));
+  int size = 0;
   switch (input_class_predictions->type) {
-    case kTfLiteFloat32:
-      scores = tflite::micro::GetTensorData<float>(input_class_predictions);
+    case kTfLiteFloat32: {
+      const float* data =
+          tflite::micro::GetTensorData<float>(input_class_predictions);
+      const float threshold = op_data->non_max_suppression_score_threshold;
+      for (int row = 0; row < num_boxes; ++row) {
+        const float* box_scores =
+            data + row * num_classes_with_background + label_offset;
+        for (int c = 0; c < num_classes; ++c) {
+          if (box_scores[c] >= threshold) {
+            indices[size++] = row;
+            break;
+          }
+        }
+      }
+      *scores = data;
+      break;
+    }
+    case kTfLiteInt8:
+    case kTfLiteUInt8: {
+      const bool is_int8 = input_class_predictions->type == kTfLiteInt8;
+      const int8_t* data_int8 =
+          tflite::micro::GetTensorData<int8_t>(input_class_predictions);
+      const uint8_t* data_uint8 =
+          tflite::micro::GetTensorData<uint8_t>(input_class_predictions);
+      for (int row = 0; row < num_boxes; ++row) {
+        const int offset = row * num_classes_with_background + label_offset;
+        if (is_int8 ? AnyQuantizedScoreAbove(
+                          data_int8 + offset, num_classes,
+                          op_data->quantized_score_threshold)
+                    : AnyQuantizedScoreAbove(
+                          data_uint8 + offset, num_classes,
+                          op_data->quantized_score_threshold)) {
+          indices[size++] = row;
+        }
+      }
+
+      float* dequantized = reinterpret_cast<float*>(
+          context->GetScratchBuffer(context, op_data->scores_idx));
+      const Dequantizer dequantize(op_data->input_class_predictions);
+      for (int i = 0; i < size; ++i) {
+        const int begin = indices[i] * num_classes_with_background;
+        for (int k = begin; k < begin + num_classes_with_background; ++k) {
+          dequantized[k] =
+              is_int8 ? dequantize(data_int8[k]) : dequantize(data_uint8[k]);
+        }
+      }
+      *scores = dequantized;
       break;
+    }
     default:
       // Unsupported type.
       return kTfLiteError;
   }
 
+  candidates->indices = indices;
+  candidates->size = size;
+  return kTfLiteOk;
+}
+
+TfLiteStatus NonMaxSuppressionMultiClass(TfLiteContext* context,
+                                         TfLiteNode* node, OpData* op_data,
+                                         const float* scores,
+                                         const CandidateBoxes& candidates) {
   if (op_data->use_regular_non_max_suppression) {
     TF_LITE_ENSURE_STATUS(NonMaxSuppressionMultiClassRegularHelper(
-        context, node, op_data, scores));
+        context, node, op_data, scores, candidates));
   } else {
-    TF_LITE_ENSURE_STATUS(
-        NonMaxSuppressionMultiClassFastHelper(context, node, op_data, scores));
+    TF_LITE_ENSURE_STATUS(NonMaxSuppressionMultiClassFastHelper(
+        context, node, op_data, scores, candidates));
   }
 
   return kTfLiteOk;
@@ -787,16 +929,25 @@ TfLiteStatus DetectionPostProcessEval(TfLiteContext* context,
   // and do all calculations in float. Mixed quantized/float calculations are
   // currently not supported in TFLite.
 
+  // This picks the anchors with a score above the threshold, the other boxes
+  // can not be detected and are neither decoded nor dequantized.
+  CandidateBoxes candidates;
+  const float* scores = nullptr;
+  TF_LITE_ENSURE_STATUS(
+      SelectCandidateBoxes(context, node, op_data, &candidates, &scores));
+
   // This fills in temporary decoded_boxes
   // by transforming input_box_encodings and input_anchors from
   // CenterSizeEncodings to BoxCornerEncoding
-  TF_LITE_ENSURE_STATUS(DecodeCenterSizeBoxes(context, node, op_data));
+  TF_LITE_ENSURE_STATUS(
+      DecodeCenterSizeBoxes(context, node, op_data, &candidates));
 
   // This fills in the output tensors
   // by choosing effective set of decoded boxes
   // based on Non Maximal Suppression, i.e. selecting
   // highest scoring non-overlapping boxes.
-  TF_LITE_ENSURE_STATUS(NonMaxSuppressionMultiClass(context, node, op_data));
+  TF_LITE_ENSURE_STATUS(
+      NonMaxSuppressionMultiClass(context, node, op_data, scores, candidates));
 
   return kTfLiteOk;
 }
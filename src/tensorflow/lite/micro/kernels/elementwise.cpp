@@ -20,6 +20,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/float_math.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
 #include "tensorflow/lite/micro/micro_utils.h"
@@ -217,6 +218,19 @@ inline TfLiteStatus EvalNumeric(TfLiteContext* context, TfLiteNode* node,
                          /*validate_input_func=*/nullptr, kTfLiteFloat32);
 }
 
+// Float ops whose whole tensor is computed by one vectorized call.
+inline TfLiteStatus EvalNumericVector(
+    TfLiteContext* context, TfLiteNode* node,
+    void vector_func(const float* vector, int v_size, float* result)) {
+  const TfLiteEvalTensor* input = tflite::micro::GetEvalInput(context, node, 0);
+  TfLiteEvalTensor* output = tflite::micro::GetEvalOutput(context, node, 0);
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteFloat32);
+  vector_func(tflite::micro::GetTensorData<float>(input),
+              ElementCount(*input->dims),
+              tflite::micro::GetTensorData<float>(output));
+  return kTfLiteOk;
+}
+
 inline TfLiteStatus EvalLogical(TfLiteContext* context, TfLiteNode* node,
 
                                 bool bool_func(bool)) {
@@ -324,15 +338,27 @@ TfLiteStatus AbsEval(TfLiteContext* context, TfLiteNode* node) {
 }
 
 TfLiteStatus SinEval(TfLiteContext* context, TfLiteNode* node) {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+  return EvalNumericVector(context, node, float_math::ApplySinToVector);
+#else
   return EvalNumeric(context, node, std::sin);
+#endif
 }
 
 TfLiteStatus CosEval(TfLiteContext* context, TfLiteNode* node) {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+  return EvalNumericVector(context, node, float_math::ApplyCosToVector);
+#else
   return EvalNumeric(context, node, std::cos);
+#endif
 }
 
 TfLiteStatus LogEval(TfLiteContext* context, TfLiteNode* node) {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+  return EvalNumericVector(context, node, float_math::ApplyLogToVector);
+#else
   return EvalNumeric(context, node, std::log);
+#endif
 }
 
 TfLiteStatus SqrtEval(TfLiteContext* context, TfLiteNode* node) {
@@ -344,9 +370,14 @@ TfLiteStatus RsqrtEval(TfLiteContext* context, TfLiteNode* node) {
   TfLiteType type = op_data->input_type;
   switch (type) {
     case kTfLiteFloat32:
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+      return EvalNumericVector(context, node,
+                               float_math::ApplyRsqrtToVector);
+#else
       return EvalImpl<float>(
           context, node, [](float f) { return 1.f / std::sqrt(f); },
           /*validate_input_func=*/nullptr, type);
+#endif
     case kTfLiteInt8:
       return EvalImplQuantized<int8_t>(context, node, RsqrtEvalQuantized,
                                        validate_input_func, type);
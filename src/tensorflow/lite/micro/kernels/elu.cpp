@@ -25,6 +25,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/types.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/unary_lut.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
@@ -38,47 +39,10 @@ constexpr int kOutputTensor = 0;
 // of the activation ops below.
 
 struct OpData {
-  int8_t table[256];
+  // Outputs for every int8 input, indexed as by LUTLookup.
+  int8_t* table;
 };
 
-using TransformFunc = float (*)(float);
-
-template <typename T>
-void PopulateLookupTable(const TfLiteTensor* input, const TfLiteTensor* output,
-                         const TransformFunc transform, OpData* data) {
-  if (sizeof(T) != 1) {
-    MicroPrintf("Lookup table valid only for 8bit");
-    TFLITE_ABORT;
-  }
-
-  const float inverse_scale = 1 / output->params.scale;
-  int32_t maxval = std::numeric_limits<T>::max();
-  int32_t minval = std::numeric_limits<T>::min();
-  for (int32_t val = minval; val <= maxval; ++val) {
-    const float dequantized =
-        input->params.scale * (val - input->params.zero_point);
-    const float transformed = transform(dequantized);
-    const float rescaled = TfLiteRound(transformed * inverse_scale);
-    const int32_t quantized =
-        static_cast<int32_t>(rescaled + output->params.zero_point);
-    data->table[static_cast<uint8_t>(static_cast<T>(val))] =
-        static_cast<T>(std::max(std::min(maxval, quantized), minval));
-  }
-}
-
-// OLD-TODO(b/143696793): move this to optimized_ops.
-void EvalUsingLookupTable(const OpData* data, const TfLiteEvalTensor* input,
-                          TfLiteEvalTensor* output) {
-  const int size = MatchingFlatSize(tflite::micro::GetTensorShape(input),
-                                    tflite::micro::GetTensorShape(output));
-  int8_t* output_data = tflite::micro::GetTensorData<int8_t>(output);
-  const int8_t* input_data = tflite::micro::GetTensorData<int8_t>(input);
-
-  for (int i = 0; i < size; ++i) {
-    output_data[i] = data->table[static_cast<uint8_t>(input_data[i])];
-  }
-}
-
 TfLiteStatus CalculateOpData(TfLiteContext* context, TfLiteNode* node) {
   MicroContext* micro_context = GetMicroContext(context);
 
@@ -95,10 +59,11 @@ TfLiteStatus CalculateOpData(TfLiteContext* context, TfLiteNode* node) {
   // Use LUT to handle quantized elu path.
   if (input->type == kTfLiteInt8) {
     OpData* data = static_cast<OpData*>(node->user_data);
-    TransformFunc transform = [](float value) {
-      return value < 0.0f ? std::exp(value) - 1.0f : value;
-    };
-    PopulateLookupTable<int8_t>(input, output, transform, data);
+    data->table =
+        BuildUnaryLut<int8_t>(context, input, output, [](float value) {
+          return value < 0.0f ? std::exp(value) - 1.0f : value;
+        });
+    TF_LITE_ENSURE(context, data->table != nullptr);
   }
   micro_context->DeallocateTempTfLiteTensor(input);
   micro_context->DeallocateTempTfLiteTensor(output);
@@ -132,7 +97,7 @@ TfLiteStatus EluEval(TfLiteContext* context, TfLiteNode* node) {
     }
     case kTfLiteInt8: {
       const OpData* data = static_cast<OpData*>(node->user_data);
-      EvalUsingLookupTable(data, input, output);
+      EvalUnaryLut(data->table, input, output);
       return kTfLiteOk;
     }
     default:
@@ -18,14 +18,17 @@ limitations under the License.
 // Input:
 //     Tensor[0]: Row numbers to lookup, dim.size == 1, int32
 //     Tensor[1]: 2-dimensional matrix of multi-dimensional items
-//                dim.size >= 2, all items are INT8 or FLOAT32.
+//                dim.size >= 2, all items are INT4, INT8 or FLOAT32.
 //                first dimension is row, second dimension is column.
+//                INT4 items are packed two per byte, low nibble first, and
+//                quantized INT4 and INT8 matrices can have one scale per row.
 //
 // Output:
 //   Output.dim[0] == Tensor[0].dim[0], num of lookups
 //   Output.dim[1] == Tensor[1].dim[1],  num of items per row
 //   Each item in output is a raw bytes copy of the corresponding item in input,
-//   or a dequantized value in the case of a INT8 input.
+//   an unpacked INT8 value in the case of a INT4 input, or a dequantized value
+//   in the case of a INT4 or INT8 input with a FLOAT32 output.
 //   When indices are out of bound, the ops will not succeed.
 //
 
@@ -45,6 +48,9 @@ constexpr int kOutputTensor = 0;
 
 struct OpData {
   float scale;         // quantization scale for tensor 1
+  // Quantization scale of every row of tensor 1, or nullptr if it has a
+  // single scale. Points into the model, which outlives the kernel.
+  const float* row_scales;
   size_t num_columns;  // number of columns after flattening tensor 1 into 2D
 };
 
@@ -55,9 +61,26 @@ TfLiteStatus CalculateOpData(TfLiteContext* context, TfLiteNode* node,
   OpData* op_data = static_cast<OpData*>(node->user_data);
   TF_LITE_ENSURE(context, op_data != nullptr);
 
-  if (tensor_1->type == kTfLiteInt8 && output->type == kTfLiteFloat32) {
+  op_data->row_scales = nullptr;
+  if ((tensor_1->type == kTfLiteInt8 || tensor_1->type == kTfLiteInt4) &&
+      output->type == kTfLiteFloat32) {
     TF_LITE_ENSURE_EQ(context, tensor_1->params.zero_point, 0);
     op_data->scale = tensor_1->params.scale;
+
+    const auto* affine_quantization =
+        static_cast<const TfLiteAffineQuantization*>(
+            tensor_1->quantization.params);
+    if (tensor_1->quantization.type == kTfLiteAffineQuantization &&
+        affine_quantization != nullptr &&
+        affine_quantization->scale->size > 1) {
+      TF_LITE_ENSURE_EQ(context, affine_quantization->quantized_dimension, 0);
+      TF_LITE_ENSURE_EQ(context, affine_quantization->scale->size,
+                        tensor_1->dims->data[0]);
+      for (int i = 0; i < affine_quantization->zero_point->size; ++i) {
+        TF_LITE_ENSURE_EQ(context, affine_quantization->zero_point->data[i], 0);
+      }
+      op_data->row_scales = affine_quantization->scale->data;
+    }
   }
 
   op_data->num_columns = NumElements(tensor_1) / tensor_1->dims->data[0];
@@ -81,8 +104,13 @@ TfLiteStatus EmbeddingLookUpPrepare(TfLiteContext* context, TfLiteNode* node) {
       micro_context->AllocateTempInputTensor(node, kInputTensor_1);
   TF_LITE_ENSURE(context, value != nullptr);
   TF_LITE_ENSURE(context, NumDimensions(value) >= 2);
-  TF_LITE_ENSURE(context,
-                 value->type == kTfLiteFloat32 || value->type == kTfLiteInt8);
+  TF_LITE_ENSURE(context, value->type == kTfLiteFloat32 ||
+                              value->type == kTfLiteInt8 ||
+                              value->type == kTfLiteInt4);
+  // Only constant INT4 tensors are stored packed.
+  if (value->type == kTfLiteInt4) {
+    TF_LITE_ENSURE(context, IsConstantTensor(value));
+  }
 
   TfLiteTensor* output =
       micro_context->AllocateTempOutputTensor(node, kOutputTensor);
@@ -120,6 +148,55 @@ TfLiteStatus EmbeddingLookUpPrepare(TfLiteContext* context, TfLiteNode* node) {
   return kTfLiteOk;
 }
 
+// Checks all the lookups up front, so that the copies need no checks and
+// nothing is written for an invalid lookup.
+TfLiteStatus CheckLookups(const TfLiteEvalTensor* lookup, int num_rows) {
+  const int32_t* lookup_data = tflite::micro::GetTensorData<int32_t>(lookup);
+  for (int i = 0; i < lookup->dims->data[0]; i++) {
+    int32_t idx = lookup_data[i];
+    if (idx >= num_rows || idx < 0) {
+      MicroPrintf(
+          "EMBEDDING_LOOKUP: index out of bounds. "
+          "Got %d, and bounds are [0, %d]",
+          idx, num_rows - 1);
+      return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
+inline void StoreUnpacked(int8_t value, float scale, int8_t* output) {
+  *output = value;
+}
+
+inline void StoreUnpacked(int8_t value, float scale, float* output) {
+  *output = value * scale;
+}
+
+// Unpacks `count` INT4 values from value `first` on of a matrix packed as for
+// tensor_utils::UnpackDenseInt4IntoInt8(), scaling them by `scale` for a
+// FLOAT32 output. A row starts in the middle of a byte if the number of
+// columns is odd.
+template <typename OutputT>
+void UnpackInt4Row(const int8_t* packed, size_t first, size_t count,
+                   float scale, OutputT* output) {
+  packed += first / 2;
+  size_t i = 0;
+  if (first % 2 != 0 && count > 0) {
+    StoreUnpacked(static_cast<int8_t>(*packed++ >> 4), scale, &output[i++]);
+  }
+  for (; i + 1 < count; i += 2) {
+    const int8_t byte = *packed++;
+    StoreUnpacked(static_cast<int8_t>(static_cast<int8_t>(byte << 4) >> 4),
+                  scale, &output[i]);
+    StoreUnpacked(static_cast<int8_t>(byte >> 4), scale, &output[i + 1]);
+  }
+  if (i < count) {
+    StoreUnpacked(static_cast<int8_t>(static_cast<int8_t>(*packed << 4) >> 4),
+                  scale, &output[i]);
+  }
+}
+
 TfLiteStatus EvalSimple(const OpData& op_data, const TfLiteEvalTensor* lookup,
                         const TfLiteEvalTensor* value,
                         TfLiteEvalTensor* output) {
@@ -128,23 +205,53 @@ TfLiteStatus EvalSimple(const OpData& op_data, const TfLiteEvalTensor* lookup,
     // Propagate empty tensor if input is empty
     return kTfLiteOk;
   }
+  if (CheckLookups(lookup, num_rows) != kTfLiteOk) {
+    return kTfLiteError;
+  }
   const size_t row_bytes = op_data.num_columns * TfLiteTypeGetSize(value->type);
 
   int8_t* output_raw = tflite::micro::GetTensorData<int8_t>(output);
   const int8_t* value_raw = tflite::micro::GetTensorData<int8_t>(value);
   const int32_t* lookup_data = tflite::micro::GetTensorData<int32_t>(lookup);
+  const int num_lookups = lookup->dims->data[0];
+  // Consecutive lookups of consecutive rows are copied at once.
+  int i = 0;
+  while (i < num_lookups) {
+    const int32_t idx = lookup_data[i];
+    int run = 1;
+    while (i + run < num_lookups && lookup_data[i + run] == idx + run) {
+      ++run;
+    }
+    std::memcpy(output_raw + i * row_bytes, value_raw + idx * row_bytes,
+                run * row_bytes);
+    i += run;
+  }
+
+  return kTfLiteOk;
+}
+
+// Looks up rows of an INT4 matrix into INT8 rows, or into FLOAT32 rows when
+// dequantizing.
+template <typename OutputT>
+TfLiteStatus EvalInt4(const OpData& op_data, const TfLiteEvalTensor* lookup,
+                      const TfLiteEvalTensor* value,
+                      TfLiteEvalTensor* output) {
+  const int num_rows = value->dims->data[0];
+  if (CheckLookups(lookup, num_rows) != kTfLiteOk) {
+    return kTfLiteError;
+  }
+  const size_t num_colums = op_data.num_columns;
+
+  OutputT* output_ptr = tflite::micro::GetTensorData<OutputT>(output);
+  const int8_t* value_ptr = tflite::micro::GetTensorData<int8_t>(value);
+  const int32_t* lookup_data = tflite::micro::GetTensorData<int32_t>(lookup);
+
   for (int i = 0; i < lookup->dims->data[0]; i++) {
     int32_t idx = lookup_data[i];
-    if (idx >= num_rows || idx < 0) {
-      MicroPrintf(
-          "EMBEDDING_LOOKUP: index out of bounds. "
-          "Got %d, and bounds are [0, %d]",
-          idx, num_rows - 1);
-      return kTfLiteError;
-    } else {
-      std::memcpy(output_raw + i * row_bytes, value_raw + idx * row_bytes,
-                  row_bytes);
-    }
+    const float scale =
+        op_data.row_scales != nullptr ? op_data.row_scales[idx] : op_data.scale;
+    UnpackInt4Row(value_ptr, idx * num_colums, num_colums, scale,
+                  &output_ptr[i * num_colums]);
   }
 
   return kTfLiteOk;
@@ -154,6 +261,9 @@ TfLiteStatus EvalHybrid(const OpData& op_data, const TfLiteEvalTensor* lookup,
                         const TfLiteEvalTensor* value,
                         TfLiteEvalTensor* output) {
   const int num_rows = value->dims->data[0];
+  if (CheckLookups(lookup, num_rows) != kTfLiteOk) {
+    return kTfLiteError;
+  }
   const size_t num_colums = op_data.num_columns;
 
   float* output_ptr = tflite::micro::GetTensorData<float>(output);
@@ -162,16 +272,13 @@ TfLiteStatus EvalHybrid(const OpData& op_data, const TfLiteEvalTensor* lookup,
 
   for (int i = 0; i < lookup->dims->data[0]; i++) {
     int32_t idx = lookup_data[i];
-    if (idx >= num_rows || idx < 0) {
-      MicroPrintf(
-          "EMBEDDING_LOOKUP: index out of bounds. "
-          "Got %d, and bounds are [0, %d]",
-          idx, num_rows - 1);
-      return kTfLiteError;
-    } else {
-      // Dequantize embedding values.
-      Dequantize(&value_ptr[idx * num_colums], num_colums, op_data.scale, 0,
-                 &output_ptr[i * num_colums]);
+    const float scale =
+        op_data.row_scales != nullptr ? op_data.row_scales[idx] : op_data.scale;
+    // Dequantize embedding values.
+    const int8_t* row = &value_ptr[idx * num_colums];
+    float* output_row = &output_ptr[i * num_colums];
+    for (size_t j = 0; j < num_colums; ++j) {
+      output_row[j] = row[j] * scale;
     }
   }
 
@@ -197,8 +304,15 @@ TfLiteStatus EmbeddingLookUpEval(TfLiteContext* context, TfLiteNode* node) {
       } else {
         return EvalSimple(op_data, lookup, value, output);
       }
+    case kTfLiteInt4:
+      if (output->type == kTfLiteFloat32) {
+        return EvalInt4<float>(op_data, lookup, value, output);
+      } else {
+        return EvalInt4<int8_t>(op_data, lookup, value, output);
+      }
     default:
-      MicroPrintf("EMBEDDING_LOOKUP only supports FLOAT32 and INT8, got %s.",
+      MicroPrintf(
+          "EMBEDDING_LOOKUP only supports FLOAT32, INT8 and INT4, got %s.",
                   TfLiteTypeGetName(output->type));
       return kTfLiteError;
   }
@@ -18,6 +18,7 @@ limitations under the License.
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/float_math.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
@@ -60,9 +61,15 @@ TfLiteStatus ExpEval(TfLiteContext* context, TfLiteNode* node) {
                                    tflite::micro::GetTensorShape(output));
 
   if (input->type == kTfLiteFloat32) {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+    float_math::ApplyExpToVector(tflite::micro::GetTensorData<float>(input),
+                                 flat_size,
+                                 tflite::micro::GetTensorData<float>(output));
+#else
     reference_ops::Exp(tflite::micro::GetTensorData<float>(input),
                        static_cast<size_t>(flat_size),
                        tflite::micro::GetTensorData<float>(output));
+#endif
   } else {
     MicroPrintf("Type %s (%d) currently not supported by Exp.",
                 TfLiteTypeGetName(input->type), input->type);
@@ -0,0 +1,417 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/float_gemm.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+namespace {
+
+// Independent partial sums kept by each dot product, one 128-bit vector.
+constexpr int kLanes = 4;
+
+// Rows and output channels of the register tile used for several rows, and
+// output channels of the tile used for a single row.
+constexpr int kTileRows = 4;
+constexpr int kTileCols = 2;
+constexpr int kSingleRowTileCols = 4;
+
+// Filter bytes that the blocked loops try to keep in cache while they sweep
+// over the input rows.
+constexpr int kFilterBlockBytes = 32 * 1024;
+
+// Adds the dot products of the kRows rows `lhs` with the kCols filter rows
+// starting at `rhs`, over `depth` elements, to `acc`. The tile loops are
+// unrolled so that the accumulators stay in registers.
+template <int kRows, int kCols>
+inline void AccumulateTile(const float* const* lhs, const float* rhs,
+                           int rhs_stride, int depth,
+                           float (&acc)[kRows][kCols][kLanes]) {
+  // Works on local copies, which the compiler can prove are not aliased by
+  // the input and filter reads.
+  const float* lhs_rows[kRows];
+  float sum[kRows][kCols][kLanes];
+  for (int r = 0; r < kRows; ++r) {
+    lhs_rows[r] = lhs[r];
+    for (int c = 0; c < kCols; ++c) {
+      for (int l = 0; l < kLanes; ++l) {
+        sum[r][c][l] = acc[r][c][l];
+      }
+    }
+  }
+  int k = 0;
+  for (; k <= depth - kLanes; k += kLanes) {
+#pragma GCC unroll 4
+    for (int r = 0; r < kRows; ++r) {
+      const float* lhs_row = lhs_rows[r] + k;
+#pragma GCC unroll 4
+      for (int c = 0; c < kCols; ++c) {
+        const float* rhs_row = rhs + c * rhs_stride + k;
+#pragma GCC unroll 4
+        for (int l = 0; l < kLanes; ++l) {
+          sum[r][c][l] += lhs_row[l] * rhs_row[l];
+        }
+      }
+    }
+  }
+  for (; k < depth; ++k) {
+    for (int r = 0; r < kRows; ++r) {
+      for (int c = 0; c < kCols; ++c) {
+        sum[r][c][0] += lhs_rows[r][k] * rhs[c * rhs_stride + k];
+      }
+    }
+  }
+  for (int r = 0; r < kRows; ++r) {
+    for (int c = 0; c < kCols; ++c) {
+      for (int l = 0; l < kLanes; ++l) {
+        acc[r][c][l] = sum[r][c][l];
+      }
+    }
+  }
+}
+
+// Reduces the partial sums of a tile and writes it, with bias and activation,
+// to output rows `output` at output channel `col`.
+template <int kRows, int kCols>
+inline void StoreTile(const float (&acc)[kRows][kCols][kLanes],
+                      const float* bias_data, int col, float activation_min,
+                      float activation_max, float* const* output) {
+  for (int r = 0; r < kRows; ++r) {
+    for (int c = 0; c < kCols; ++c) {
+      float total = 0.0f;
+      for (int l = 0; l < kLanes; ++l) {
+        total += acc[r][c][l];
+      }
+      if (bias_data != nullptr) {
+        total += bias_data[col + c];
+      }
+      output[r][col + c] =
+          ActivationFunctionWithMinMax(total, activation_min, activation_max);
+    }
+  }
+}
+
+// Input rows of the matrix product. For a fully connected layer every row is
+// a batch. For a convolution every row is an output pixel, and Get() returns
+// its input pixel under one filter tap. Locate() does the divisions needed to
+// find a row once per tile, instead of once per tap.
+struct FullyConnectedRows {
+  struct Origin {
+    const float* data;
+  };
+
+  const float* input_data;
+  int accum_depth;
+
+  int TapHeight() const { return 1; }
+  int TapWidth() const { return 1; }
+  int TapDepth() const { return accum_depth; }
+  Origin Locate(int row) const { return {input_data + row * accum_depth}; }
+  const float* Get(const Origin& origin, int filter_y, int filter_x) const {
+    return origin.data;
+  }
+};
+
+struct ConvRows {
+  struct Origin {
+    const float* batch_data;
+    int in_y;
+    int in_x;
+  };
+
+  const float* input_data;
+  const float* zero_row;
+  int input_height;
+  int input_width;
+  int input_depth;
+  int filter_height;
+  int filter_width;
+  int output_width;
+  int output_pixels;
+  int stride_height;
+  int stride_width;
+  int dilation_height;
+  int dilation_width;
+  int pad_height;
+  int pad_width;
+
+  int TapHeight() const { return filter_height; }
+  int TapWidth() const { return filter_width; }
+  int TapDepth() const { return input_depth; }
+  Origin Locate(int row) const {
+    const int batch = row / output_pixels;
+    const int pixel = row - batch * output_pixels;
+    const int out_y = pixel / output_width;
+    const int out_x = pixel - out_y * output_width;
+    return {input_data + batch * input_height * input_width * input_depth,
+            out_y * stride_height - pad_height,
+            out_x * stride_width - pad_width};
+  }
+  const float* Get(const Origin& origin, int filter_y, int filter_x) const {
+    const int in_y = origin.in_y + filter_y * dilation_height;
+    const int in_x = origin.in_x + filter_x * dilation_width;
+    if (in_y < 0 || in_y >= input_height || in_x < 0 || in_x >= input_width) {
+      return zero_row;
+    }
+    return origin.batch_data + (in_y * input_width + in_x) * input_depth;
+  }
+};
+
+// Computes a kRows x kCols tile of the product for the rows at `origins`,
+// starting at output channel `col`.
+template <int kRows, int kCols, typename Rows>
+inline void ComputeTile(const Rows& rows,
+                        const typename Rows::Origin* origins, int col,
+                        const float* filter_data, int filter_stride,
+                        const float* bias_data, float activation_min,
+                        float activation_max, float* const* output) {
+  float acc[kRows][kCols][kLanes] = {};
+  const float* lhs[kRows];
+  const float* rhs = filter_data + col * filter_stride;
+  for (int filter_y = 0; filter_y < rows.TapHeight(); ++filter_y) {
+    for (int filter_x = 0; filter_x < rows.TapWidth(); ++filter_x) {
+      for (int r = 0; r < kRows; ++r) {
+        lhs[r] = rows.Get(origins[r], filter_y, filter_x);
+      }
+      AccumulateTile<kRows, kCols>(lhs, rhs, filter_stride, rows.TapDepth(),
+                                   acc);
+      rhs += rows.TapDepth();
+    }
+  }
+  StoreTile<kRows, kCols>(acc, bias_data, col, activation_min, activation_max,
+                          output);
+}
+
+// Computes kRows rows of the product, over output channels `col` to
+// `col_end`.
+template <int kRows, int kCols, typename Rows>
+inline void ComputeRows(const Rows& rows, int row, int col, int col_end,
+                        const float* filter_data, const float* bias_data,
+                        float activation_min, float activation_max,
+                        float* output_data, int output_depth) {
+  const int filter_stride =
+      rows.TapHeight() * rows.TapWidth() * rows.TapDepth();
+  typename Rows::Origin origins[kRows];
+  float* output[kRows];
+  for (int r = 0; r < kRows; ++r) {
+    origins[r] = rows.Locate(row + r);
+    output[r] = output_data + (row + r) * output_depth;
+  }
+  for (; col <= col_end - kCols; col += kCols) {
+    ComputeTile<kRows, kCols>(rows, origins, col, filter_data, filter_stride,
+                              bias_data, activation_min, activation_max,
+                              output);
+  }
+  for (; col < col_end; ++col) {
+    ComputeTile<kRows, 1>(rows, origins, col, filter_data, filter_stride,
+                          bias_data, activation_min, activation_max, output);
+  }
+}
+
+// Computes output[row][col] = activation(bias[col] + sum_k rows[row][k] *
+// filter[col][k]). Output channels are processed in blocks whose filter rows
+// fit in kFilterBlockBytes, and each block is swept over all rows.
+template <typename Rows>
+void MatMul(const Rows& rows, int row_count, const float* filter_data,
+            const float* bias_data, int output_depth, float activation_min,
+            float activation_max, float* output_data) {
+  const int row_bytes = std::max<int>(
+      rows.TapHeight() * rows.TapWidth() * rows.TapDepth() * sizeof(float), 1);
+  const int block_cols =
+      std::max(kTileCols * kSingleRowTileCols,
+               kFilterBlockBytes / row_bytes / kSingleRowTileCols *
+                   kSingleRowTileCols);
+
+  for (int block = 0; block < output_depth; block += block_cols) {
+    const int block_end = std::min(block + block_cols, output_depth);
+    int row = 0;
+    for (; row <= row_count - kTileRows; row += kTileRows) {
+      ComputeRows<kTileRows, kTileCols>(rows, row, block, block_end,
+                                        filter_data, bias_data,
+                                        activation_min, activation_max,
+                                        output_data, output_depth);
+    }
+    for (; row < row_count; ++row) {
+      ComputeRows<1, kSingleRowTileCols>(rows, row, block, block_end,
+                                         filter_data, bias_data,
+                                         activation_min, activation_max,
+                                         output_data, output_depth);
+    }
+  }
+}
+
+}  // namespace
+
+size_t FloatGemmConvScratchSize(const RuntimeShape& input_shape) {
+  return input_shape.Dims(3) * sizeof(float);
+}
+
+void FloatGemmConv(const ConvParams& params, const RuntimeShape& input_shape,
+                   const float* input_data, const RuntimeShape& filter_shape,
+                   const float* filter_data, const RuntimeShape& bias_shape,
+                   const float* bias_data, const RuntimeShape& output_shape,
+                   float* output_data, void* scratch) {
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 4);
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int input_depth = MatchingDim(input_shape, 3, filter_shape, 3);
+  const int output_depth = MatchingDim(filter_shape, 0, output_shape, 3);
+  if (bias_data) {
+    TFLITE_DCHECK_EQ(bias_shape.FlatSize(), output_depth);
+  }
+
+  float* zero_row = static_cast<float*>(scratch);
+  std::memset(zero_row, 0, input_depth * sizeof(float));
+
+  ConvRows rows;
+  rows.input_data = input_data;
+  rows.zero_row = zero_row;
+  rows.input_height = input_shape.Dims(1);
+  rows.input_width = input_shape.Dims(2);
+  rows.input_depth = input_depth;
+  rows.filter_height = filter_shape.Dims(1);
+  rows.filter_width = filter_shape.Dims(2);
+  rows.output_width = output_shape.Dims(2);
+  rows.output_pixels = output_shape.Dims(1) * output_shape.Dims(2);
+  rows.stride_height = params.stride_height;
+  rows.stride_width = params.stride_width;
+  rows.dilation_height = params.dilation_height_factor;
+  rows.dilation_width = params.dilation_width_factor;
+  rows.pad_height = params.padding_values.height;
+  rows.pad_width = params.padding_values.width;
+
+  MatMul(rows, batches * rows.output_pixels, filter_data, bias_data,
+         output_depth, params.float_activation_min,
+         params.float_activation_max, output_data);
+}
+
+void FloatGemmFullyConnected(const FullyConnectedParams& params,
+                             const RuntimeShape& input_shape,
+                             const float* input_data,
+                             const RuntimeShape& filter_shape,
+                             const float* filter_data,
+                             const RuntimeShape& bias_shape,
+                             const float* bias_data,
+                             const RuntimeShape& output_shape,
+                             float* output_data) {
+  const int output_dims_count = output_shape.DimensionsCount();
+  const int filter_dims_count = filter_shape.DimensionsCount();
+  const int batches = FlatSizeSkipDim(output_shape, output_dims_count - 1);
+  const int output_depth = MatchingDim(filter_shape, filter_dims_count - 2,
+                                       output_shape, output_dims_count - 1);
+
+  FullyConnectedRows rows;
+  rows.input_data = input_data;
+  rows.accum_depth = filter_shape.Dims(filter_dims_count - 1);
+
+  MatMul(rows, batches, filter_data, bias_data, output_depth,
+         params.float_activation_min, params.float_activation_max,
+         output_data);
+}
+
+void FloatDepthwiseConv(const DepthwiseParams& params,
+                        const RuntimeShape& input_shape,
+                        const float* input_data,
+                        const RuntimeShape& filter_shape,
+                        const float* filter_data,
+                        const RuntimeShape& bias_shape, const float* bias_data,
+                        const RuntimeShape& output_shape, float* output_data) {
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 4);
+  const int stride_width = params.stride_width;
+  const int stride_height = params.stride_height;
+  const int dilation_width_factor = params.dilation_width_factor;
+  const int dilation_height_factor = params.dilation_height_factor;
+  const int pad_width = params.padding_values.width;
+  const int pad_height = params.padding_values.height;
+  const int depth_multiplier = params.depth_multiplier;
+  const float output_activation_min = params.float_activation_min;
+  const float output_activation_max = params.float_activation_max;
+
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int output_depth = MatchingDim(filter_shape, 3, output_shape, 3);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int input_depth = input_shape.Dims(3);
+  const int filter_height = filter_shape.Dims(1);
+  const int filter_width = filter_shape.Dims(2);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  TFLITE_DCHECK_EQ(output_depth, input_depth * depth_multiplier);
+  if (bias_data) {
+    TFLITE_DCHECK_EQ(bias_shape.FlatSize(), output_depth);
+  }
+
+  for (int b = 0; b < batches; ++b) {
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      for (int out_x = 0; out_x < output_width; ++out_x) {
+        float* output = output_data + Offset(output_shape, b, out_y, out_x, 0);
+        if (bias_data != nullptr) {
+          std::memcpy(output, bias_data, output_depth * sizeof(float));
+        } else {
+          std::memset(output, 0, output_depth * sizeof(float));
+        }
+
+        const int in_y_origin = (out_y * stride_height) - pad_height;
+        const int in_x_origin = (out_x * stride_width) - pad_width;
+        for (int filter_y = 0; filter_y < filter_height; ++filter_y) {
+          const int in_y = in_y_origin + dilation_height_factor * filter_y;
+          if (in_y < 0 || in_y >= input_height) {
+            continue;
+          }
+          for (int filter_x = 0; filter_x < filter_width; ++filter_x) {
+            const int in_x = in_x_origin + dilation_width_factor * filter_x;
+            if (in_x < 0 || in_x >= input_width) {
+              continue;
+            }
+            const float* input =
+                input_data + Offset(input_shape, b, in_y, in_x, 0);
+            const float* filter =
+                filter_data + Offset(filter_shape, 0, filter_y, filter_x, 0);
+            if (depth_multiplier == 1) {
+              for (int c = 0; c < output_depth; ++c) {
+                output[c] += input[c] * filter[c];
+              }
+            } else {
+              for (int ic = 0; ic < input_depth; ++ic) {
+                const float input_value = input[ic];
+                float* output_channels = output + ic * depth_multiplier;
+                const float* filter_channels = filter + ic * depth_multiplier;
+                for (int m = 0; m < depth_multiplier; ++m) {
+                  output_channels[m] += input_value * filter_channels[m];
+                }
+              }
+            }
+          }
+        }
+
+        for (int c = 0; c < output_depth; ++c) {
+          output[c] = ActivationFunctionWithMinMax(
+              output[c], output_activation_min, output_activation_max);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace tflite
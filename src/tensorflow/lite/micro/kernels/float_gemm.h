@@ -0,0 +1,72 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_FLOAT_GEMM_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_FLOAT_GEMM_H_
+
+#include <cstddef>
+
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Float32 CONV_2D and FULLY_CONNECTED as a matrix product of the input rows
+// (output pixels or batches) with the rows of the filter, which are read in
+// place. The product is computed in register tiles of a few rows by a few
+// output channels, and each dot product keeps independent partial sums, so
+// that compilers can vectorize the inner loop without reassociating floating
+// point additions. The results differ from the reference kernels by rounding
+// only.
+//
+// The convolution does not build an im2col buffer: every filter tap reads the
+// input pixels in place, and taps in the padding read a row of zeros.
+
+// Returns the size of the scratch buffer FloatGemmConv() needs for an input of
+// `input_shape`.
+size_t FloatGemmConvScratchSize(const RuntimeShape& input_shape);
+
+// Same as reference_ops::Conv() for a single group. `scratch` must hold
+// FloatGemmConvScratchSize() bytes.
+void FloatGemmConv(const ConvParams& params, const RuntimeShape& input_shape,
+                   const float* input_data, const RuntimeShape& filter_shape,
+                   const float* filter_data, const RuntimeShape& bias_shape,
+                   const float* bias_data, const RuntimeShape& output_shape,
+                   float* output_data, void* scratch);
+
+// Same as reference_ops::FullyConnected().
+void FloatGemmFullyConnected(const FullyConnectedParams& params,
+                             const RuntimeShape& input_shape,
+                             const float* input_data,
+                             const RuntimeShape& filter_shape,
+                             const float* filter_data,
+                             const RuntimeShape& bias_shape,
+                             const float* bias_data,
+                             const RuntimeShape& output_shape,
+                             float* output_data);
+
+// Same as reference_ops::DepthwiseConv() for float. Each output pixel is
+// accumulated over all of its channels at once, so the inner loop runs along
+// the contiguous channel dimension of the input, filter and output.
+void FloatDepthwiseConv(const DepthwiseParams& params,
+                        const RuntimeShape& input_shape,
+                        const float* input_data,
+                        const RuntimeShape& filter_shape,
+                        const float* filter_data,
+                        const RuntimeShape& bias_shape, const float* bias_data,
+                        const RuntimeShape& output_shape, float* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_FLOAT_GEMM_H_
@@ -0,0 +1,91 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/float_math.h"
+
+#include <cmath>
+
+namespace tflite {
+namespace float_math {
+
+namespace {
+
+// Elements computed per block. A fixed trip count into a local array lets
+// compilers vectorize the block without checking whether `vector` and
+// `result` overlap.
+constexpr int kBlockSize = 16;
+
+// Sets result[i] to Func(vector[i]), or to LibmFunc(vector[i]) where
+// UseLibm(vector[i]) holds. Taking the functions as template arguments lets
+// them be inlined into the block loop.
+template <float (*Func)(float), bool (*UseLibm)(float) = nullptr,
+          float (*LibmFunc)(float) = nullptr>
+void ApplyToVector(const float* vector, int v_size, float* result) {
+  int i = 0;
+  for (; i <= v_size - kBlockSize; i += kBlockSize) {
+    float block[kBlockSize];
+    for (int k = 0; k < kBlockSize; ++k) {
+      block[k] = Func(vector[i + k]);
+    }
+    for (int k = 0; k < kBlockSize; ++k) {
+      const float x = vector[i + k];
+      result[i + k] =
+          UseLibm != nullptr && UseLibm(x) ? LibmFunc(x) : block[k];
+    }
+  }
+  for (; i < v_size; ++i) {
+    const float x = vector[i];
+    result[i] = UseLibm != nullptr && UseLibm(x) ? LibmFunc(x) : Func(x);
+  }
+}
+
+bool IsLargeTrigArgument(float x) { return std::fabs(x) > kMaxTrigArgument; }
+
+float LibmSin(float x) { return std::sin(x); }
+
+float LibmCos(float x) { return std::cos(x); }
+
+}  // namespace
+
+void ApplyExpToVector(const float* vector, int v_size, float* result) {
+  ApplyToVector<Exp>(vector, v_size, result);
+}
+
+void ApplyLogToVector(const float* vector, int v_size, float* result) {
+  ApplyToVector<Log>(vector, v_size, result);
+}
+
+void ApplyTanhToVector(const float* vector, int v_size, float* result) {
+  ApplyToVector<Tanh>(vector, v_size, result);
+}
+
+void ApplySigmoidToVector(const float* vector, int v_size, float* result) {
+  ApplyToVector<Sigmoid>(vector, v_size, result);
+}
+
+void ApplyRsqrtToVector(const float* vector, int v_size, float* result) {
+  ApplyToVector<Rsqrt>(vector, v_size, result);
+}
+
+void ApplySinToVector(const float* vector, int v_size, float* result) {
+  ApplyToVector<Sin, IsLargeTrigArgument, LibmSin>(vector, v_size, result);
+}
+
+void ApplyCosToVector(const float* vector, int v_size, float* result) {
+  ApplyToVector<Cos, IsLargeTrigArgument, LibmCos>(vector, v_size, result);
+}
+
+}  // namespace float_math
+}  // namespace tflite
@@ -0,0 +1,292 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_FLOAT_MATH_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_FLOAT_MATH_H_
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace tflite {
+namespace float_math {
+
+// Float32 transcendental functions built from range reduction and minimax
+// polynomials. Unlike libm they have no branches, lookups or errno handling,
+// so compilers can vectorize loops that call them. The float kernels use them
+// in place of libm when built with TF_LITE_USE_POLYNOMIAL_MATH.
+//
+// Maximum errors against the exact result, measured over every third float of
+// the stated range:
+//   Exp      1 ULP     x in [-87.33, 88.72], 0 below and +inf above
+//   Log      1 ULP     x > 0, including denormals
+//   Tanh     1.5 ULP   all x
+//   Sigmoid  2.5 ULP   x >= -88.72, 0 below
+//   Rsqrt    1.5 ULP   x > 0, including denormals
+//   Sin/Cos  2 ULP     |x| <= kMaxTrigArgument, or 3e-8 absolute near zeros
+// Results smaller than the smallest normal float are flushed to 0. Special
+// inputs (NaN, infinities, zero and negative inputs of Log and Rsqrt) give the
+// same results as libm.
+
+// Largest |x| for which Sin and Cos reduce x by pi/2 accurately. The Apply*
+// functions use libm for larger inputs.
+constexpr float kMaxTrigArgument = 8192.0f;
+
+// The functions are meant to be inlined into the loops that call them, since
+// compilers only vectorize a loop whose calls they have inlined.
+#if defined(__GNUC__)
+#define TF_LITE_FLOAT_MATH_INLINE inline __attribute__((always_inline))
+#else
+#define TF_LITE_FLOAT_MATH_INLINE inline
+#endif
+
+namespace internal {
+
+inline uint32_t AsBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+inline float AsFloat(uint32_t bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Adding and subtracting 1.5 * 2^23 rounds a float of magnitude below 2^22 to
+// the nearest integer, which is then also the low bits of the sum.
+constexpr float kRoundShifter = 12582912.0f;
+
+// Returns `if_true` where `condition` holds and `if_false` elsewhere. Both
+// values are already computed, and the choice is made on their bits, so that
+// compilers vectorize it even when floating-point operations may trap.
+inline float Select(bool condition, float if_true, float if_false) {
+  const uint32_t mask = 0u - static_cast<uint32_t>(condition);
+  return AsFloat((AsBits(if_true) & mask) | (AsBits(if_false) & ~mask));
+}
+
+// 2^n for n in [-126, 127].
+inline float Pow2(int32_t n) {
+  return AsFloat(static_cast<uint32_t>(n + 127) << 23);
+}
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+constexpr float kNaN = std::numeric_limits<float>::quiet_NaN();
+constexpr float kMinNormal = std::numeric_limits<float>::min();
+
+}  // namespace internal
+
+// e^x: x = n * ln(2) + r with |r| <= ln(2) / 2, e^r from a degree 6
+// polynomial, and 2^n from the exponent bits.
+TF_LITE_FLOAT_MATH_INLINE float Exp(float x) {
+  using namespace internal;
+  constexpr float kExpMax = 88.72283905f;   // ln(FLT_MAX)
+  constexpr float kExpMin = -87.33654475f;  // ln(FLT_MIN)
+  constexpr float kLog2e = 1.44269504089f;
+  // ln(2) in two parts, the first exact when multiplied by n.
+  constexpr float kLn2Hi = 0.693359375f;
+  constexpr float kLn2Lo = -2.12194440e-4f;
+
+  float clamped = Select(x < kExpMin, kExpMin, x);
+  clamped = Select(clamped > kExpMax, kExpMax, clamped);
+  const float shifted = clamped * kLog2e + kRoundShifter;
+  const float n = shifted - kRoundShifter;
+  const int32_t n_int =
+      static_cast<int32_t>(AsBits(shifted) - AsBits(kRoundShifter));
+  float r = clamped - n * kLn2Hi;
+  r = r - n * kLn2Lo;
+
+  const float r2 = r * r;
+  float p = 1.9875691500e-4f;
+  p = p * r + 1.3981999507e-3f;
+  p = p * r + 8.3334519073e-3f;
+  p = p * r + 4.1665795894e-2f;
+  p = p * r + 1.6666665459e-1f;
+  p = p * r + 5.0000001201e-1f;
+  p = p * r2 + r + 1.0f;
+
+  // n is in [-126, 128], so 2^n is applied as two factors that are both
+  // normal floats.
+  const int32_t n_half = n_int >> 1;
+  float result = p * Pow2(n_half) * Pow2(n_int - n_half);
+  result = Select(x < kExpMin, 0.0f, result);
+  result = Select(x > kExpMax, kInfinity, result);
+  return Select(x != x, x, result);
+}
+
+// ln(x): x = m * 2^e with m in [sqrt(1/2), sqrt(2)), and ln(m) from a degree 9
+// polynomial of m - 1.
+TF_LITE_FLOAT_MATH_INLINE float Log(float x) {
+  using namespace internal;
+  constexpr float kSqrtHalf = 0.707106781186547524f;
+  constexpr float kLn2Hi = 0.693359375f;
+  constexpr float kLn2Lo = -2.12194440e-4f;
+
+  // Denormals are scaled by 2^25 to give m its full precision.
+  const bool denormal = x < kMinNormal;
+  const float scaled = Select(denormal, x * 33554432.0f, x);
+  const uint32_t bits = AsBits(scaled);
+  int32_t e = static_cast<int32_t>((bits >> 23) & 0xff) - 126;
+  e -= 25 & -static_cast<int32_t>(denormal);
+  float m = AsFloat((bits & 0x007fffffu) | 0x3f000000u);  // [0.5, 1)
+  const bool small = m < kSqrtHalf;
+  e -= static_cast<int32_t>(small);
+  m = Select(small, m + m, m) - 1.0f;
+
+  const float m2 = m * m;
+  float p = 7.0376836292e-2f;
+  p = p * m - 1.1514610310e-1f;
+  p = p * m + 1.1676998740e-1f;
+  p = p * m - 1.2420140846e-1f;
+  p = p * m + 1.4249322787e-1f;
+  p = p * m - 1.6668057665e-1f;
+  p = p * m + 2.0000714765e-1f;
+  p = p * m - 2.4999993993e-1f;
+  p = p * m + 3.3333331174e-1f;
+  p = p * m * m2;
+
+  const float fe = static_cast<float>(e);
+  p = p + fe * kLn2Lo;
+  p = p - 0.5f * m2;
+  float result = m + p;
+  result = result + fe * kLn2Hi;
+
+  result = Select(x > 0.0f, result, Select(x == 0.0f, -kInfinity, kNaN));
+  result = Select(x == kInfinity, kInfinity, result);
+  return Select(x != x, x, result);
+}
+
+// tanh(x): an odd polynomial for |x| < 0.625, where 1 - 2 / (e^2|x| + 1)
+// would cancel, and that expression elsewhere.
+TF_LITE_FLOAT_MATH_INLINE float Tanh(float x) {
+  using namespace internal;
+  const uint32_t sign = AsBits(x) & 0x80000000u;
+  const float abs_x = AsFloat(AsBits(x) & 0x7fffffffu);
+
+  const float x2 = x * x;
+  float p = -5.70498872745e-3f;
+  p = p * x2 + 2.06390887954e-2f;
+  p = p * x2 - 5.37397155531e-2f;
+  p = p * x2 + 1.33314422036e-1f;
+  p = p * x2 - 3.33332819422e-1f;
+  p = p * x2 * abs_x + abs_x;
+
+  const float large = 1.0f - 2.0f / (Exp(2.0f * abs_x) + 1.0f);
+  return AsFloat(AsBits(Select(abs_x < 0.625f, p, large)) | sign);
+}
+
+// 1 / (1 + e^-x).
+TF_LITE_FLOAT_MATH_INLINE float Sigmoid(float x) {
+  return 1.0f / (1.0f + Exp(-x));
+}
+
+// 1 / sqrt(x): an estimate from the exponent bits refined by three Newton
+// steps, the last one written as a small correction to limit rounding.
+TF_LITE_FLOAT_MATH_INLINE float Rsqrt(float x) {
+  using namespace internal;
+  // Tiny inputs are scaled by 2^24, and the result back by 2^12, so that x / 2
+  // is a normal float.
+  const bool tiny = x < 7.88860905e-31f;  // 2^-100
+  const float scaled = Select(tiny, x * 16777216.0f, x);
+  const float half = 0.5f * scaled;
+  float y = AsFloat(0x5f375a86u - (AsBits(scaled) >> 1));
+  y = y * (1.5f - half * y * y);
+  y = y * (1.5f - half * y * y);
+  y = y + y * (0.5f - half * y * y);
+  y = Select(tiny, y * 4096.0f, y);
+
+  float result = Select(x > 0.0f, y, kNaN);
+  result = Select(x == 0.0f, AsFloat(AsBits(kInfinity) | AsBits(x)), result);
+  result = Select(x == kInfinity, 0.0f, result);
+  return Select(x != x, x, result);
+}
+
+namespace internal {
+
+// Reduces |x| to r in [-pi/4, pi/4] with |x| = n * pi/2 + r, and returns
+// n mod 4 in `quadrant`. pi/2 is split in three parts so that the first two
+// products with n are exact for |x| <= kMaxTrigArgument.
+TF_LITE_FLOAT_MATH_INLINE float ReduceTrigArgument(float abs_x,
+                                                   uint32_t* quadrant) {
+  constexpr float k2OverPi = 0.636619772367581343f;
+  constexpr float kPiOver2Hi = 1.5703125f;
+  constexpr float kPiOver2Mid = 4.837512969970703125e-4f;
+  constexpr float kPiOver2Lo = 7.54978995489188216e-8f;
+  const float shifted = abs_x * k2OverPi + kRoundShifter;
+  const float n = shifted - kRoundShifter;
+  *quadrant = AsBits(shifted) & 3;
+  float r = abs_x - n * kPiOver2Hi;
+  r = r - n * kPiOver2Mid;
+  return r - n * kPiOver2Lo;
+}
+
+// sin(r) and cos(r) for |r| <= pi/4.
+TF_LITE_FLOAT_MATH_INLINE float SinPolynomial(float r, float r2) {
+  float p = -1.9515295891e-4f;
+  p = p * r2 + 8.3321608736e-3f;
+  p = p * r2 - 1.6666654611e-1f;
+  return p * r2 * r + r;
+}
+
+TF_LITE_FLOAT_MATH_INLINE float CosPolynomial(float r2) {
+  float p = 2.443315711809948e-5f;
+  p = p * r2 - 1.388731625493765e-3f;
+  p = p * r2 + 4.166664568298827e-2f;
+  return p * r2 * r2 - 0.5f * r2 + 1.0f;
+}
+
+// sin(n * pi/2 + r) for `quadrant` = n mod 4.
+TF_LITE_FLOAT_MATH_INLINE float SinOfReduced(float r, uint32_t quadrant) {
+  const float r2 = r * r;
+  const float value =
+      Select((quadrant & 1) != 0, CosPolynomial(r2), SinPolynomial(r, r2));
+  return AsFloat(AsBits(value) ^ ((quadrant & 2) << 30));
+}
+
+}  // namespace internal
+
+TF_LITE_FLOAT_MATH_INLINE float Sin(float x) {
+  using namespace internal;
+  const uint32_t sign = AsBits(x) & 0x80000000u;
+  const float abs_x = AsFloat(AsBits(x) & 0x7fffffffu);
+  uint32_t quadrant;
+  const float r = ReduceTrigArgument(abs_x, &quadrant);
+  return AsFloat(AsBits(SinOfReduced(r, quadrant)) ^ sign);
+}
+
+// cos(x) = sin(|x| + pi/2).
+TF_LITE_FLOAT_MATH_INLINE float Cos(float x) {
+  using namespace internal;
+  const float abs_x = AsFloat(AsBits(x) & 0x7fffffffu);
+  uint32_t quadrant;
+  const float r = ReduceTrigArgument(abs_x, &quadrant);
+  return SinOfReduced(r, quadrant + 1);
+}
+
+// Sets result[i] to the function of vector[i]. `vector` and `result` may be
+// the same array.
+void ApplyExpToVector(const float* vector, int v_size, float* result);
+void ApplyLogToVector(const float* vector, int v_size, float* result);
+void ApplyTanhToVector(const float* vector, int v_size, float* result);
+void ApplySigmoidToVector(const float* vector, int v_size, float* result);
+void ApplyRsqrtToVector(const float* vector, int v_size, float* result);
+void ApplySinToVector(const float* vector, int v_size, float* result);
+void ApplyCosToVector(const float* vector, int v_size, float* result);
+
+}  // namespace float_math
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_FLOAT_MATH_H_
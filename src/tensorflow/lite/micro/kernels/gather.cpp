@@ -28,13 +28,43 @@ constexpr int kInputTensor = 0;
 constexpr int kInputPositions = 1;
 constexpr int kOutputTensor = 0;
 
-template <typename InputT, typename CoordsT = int32_t>
+// Copies `count` rows of `row_bytes` bytes from the rows of `input` at
+// `coords` into consecutive rows of `output`, with one copy per run of
+// consecutive coordinates.
+template <typename CoordsT>
+void GatherRows(const uint8_t* input, const CoordsT* coords, int count,
+                size_t row_bytes, uint8_t* output) {
+  int coord = 0;
+  while (coord < count) {
+    const CoordsT first = coords[coord];
+    int run = 1;
+    while (coord + run < count && coords[coord + run] == first + run) {
+      ++run;
+    }
+    std::memcpy(output, input + first * row_bytes, run * row_bytes);
+    output += run * row_bytes;
+    coord += run;
+  }
+}
+
+// Single element rows, where a copy per element is cheaper than a memcpy.
+template <typename T, typename CoordsT>
+void GatherElements(const uint8_t* input, const CoordsT* coords, int count,
+                    uint8_t* output) {
+  const T* input_data = reinterpret_cast<const T*>(input);
+  T* output_data = reinterpret_cast<T*>(output);
+  for (int coord = 0; coord < count; ++coord) {
+    output_data[coord] = input_data[coords[coord]];
+  }
+}
+
+template <typename CoordsT = int32_t>
 TfLiteStatus Gather(const TfLiteGatherParams* params,
                     const TfLiteEvalTensor* input,
                     const TfLiteEvalTensor* coords, TfLiteEvalTensor* output) {
-  const InputT* input_data = tflite::micro::GetTensorData<InputT>(input);
+  const uint8_t* input_data = tflite::micro::GetTensorData<uint8_t>(input);
   const CoordsT* coords_data = tflite::micro::GetTensorData<CoordsT>(coords);
-  InputT* output_data = tflite::micro::GetTensorData<InputT>(output);
+  uint8_t* output_data = tflite::micro::GetTensorData<uint8_t>(output);
   const TfLiteIntArray* input_dims = input->dims;
   const int input_dims_size = input_dims->size;
   int axis = params->axis;
@@ -79,19 +109,30 @@ TfLiteStatus Gather(const TfLiteGatherParams* params,
     coord_size *= coords_dims->data[i];
   }
 
+  const size_t element_size = TfLiteTypeGetSize(input->type);
+  const size_t row_bytes = element_size * inner_size;
   for (int batch = 0; batch < batch_size; ++batch) {
+    const CoordsT* batch_coords = coords_data + batch * coord_size;
+    for (int coord = 0; coord < coord_size; ++coord) {
+      TFLITE_DCHECK_GE(batch_coords[coord], 0);
+      TFLITE_DCHECK_LT(batch_coords[coord], axis_size);
+    }
     for (int outer = 0; outer < outer_size; ++outer) {
-      for (int coord = 0; coord < coord_size; ++coord) {
-        TFLITE_DCHECK_GE(coords_data[coord], 0);
-        TFLITE_DCHECK_LT(coords_data[coord], axis_size);
-        std::memcpy(output_data +
-                        (((batch * outer_size) + outer) * coord_size + coord) *
-                            inner_size,
-                    input_data + (((batch * outer_size) + outer) * axis_size +
-                                  coords_data[batch * coord_size + coord]) *
-                                     inner_size,
-                    sizeof(InputT) * inner_size);
+      if (inner_size != 1) {
+        GatherRows(input_data, batch_coords, coord_size, row_bytes,
+                   output_data);
+      } else if (element_size == 1) {
+        GatherElements<int8_t>(input_data, batch_coords, coord_size,
+                               output_data);
+      } else if (element_size == 2) {
+        GatherElements<int16_t>(input_data, batch_coords, coord_size,
+                                output_data);
+      } else {
+        GatherElements<int32_t>(input_data, batch_coords, coord_size,
+                                output_data);
       }
+      input_data += axis_size * row_bytes;
+      output_data += coord_size * row_bytes;
     }
   }
   return kTfLiteOk;
@@ -132,6 +173,8 @@ TfLiteStatus GatherPrepare(TfLiteContext* context, TfLiteNode* node) {
   switch (input->type) {
     case kTfLiteFloat32:
     case kTfLiteInt8:
+    case kTfLiteInt16:
+    case kTfLiteInt32:
       break;
     default:
       MicroPrintf("Type '%s' is not supported by gather.",
@@ -201,10 +244,10 @@ TfLiteStatus GatherEval(TfLiteContext* context, TfLiteNode* node) {
   if (coords->type == kTfLiteInt32) {
     switch (input->type) {
       case kTfLiteFloat32:
-        return Gather<float, int32_t>(params, input, coords, output);
-        break;
       case kTfLiteInt8:
-        return Gather<int8_t, int32_t>(params, input, coords, output);
+      case kTfLiteInt16:
+      case kTfLiteInt32:
+        return Gather<int32_t>(params, input, coords, output);
         break;
       default:
         MicroPrintf("Type '%s' is not supported by gather.",
@@ -0,0 +1,126 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/kernels/internal/reference/gelu.h"
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/unary_lut.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+namespace {
+
+constexpr int kInputTensor = 0;
+constexpr int kOutputTensor = 0;
+
+struct OpData {
+  // Quantized outputs for every int8 input, or the interpolated table of the
+  // int16 ones.
+  int8_t* int8_table;
+  int16_t* int16_table;
+};
+
+void* GeluInit(TfLiteContext* context, const char* buffer, size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return context->AllocatePersistentBuffer(context, sizeof(OpData));
+}
+
+TfLiteStatus GeluPrepare(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  TFLITE_DCHECK(node->builtin_data != nullptr);
+  OpData* data = static_cast<OpData*>(node->user_data);
+  const auto* params = static_cast<const TfLiteGeluParams*>(node->builtin_data);
+
+  MicroContext* micro_context = GetMicroContext(context);
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 1);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+  TfLiteTensor* input =
+      micro_context->AllocateTempInputTensor(node, kInputTensor);
+  TF_LITE_ENSURE(context, input != nullptr);
+  TfLiteTensor* output =
+      micro_context->AllocateTempOutputTensor(node, kOutputTensor);
+  TF_LITE_ENSURE(context, output != nullptr);
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, output->type);
+
+  float (*transform)(float) = params->approximate
+                                  ? reference_ops::GeluTransformApproximate
+                                  : reference_ops::GeluTransform;
+  data->int8_table = nullptr;
+  data->int16_table = nullptr;
+  switch (input->type) {
+    case kTfLiteFloat32:
+      break;
+    case kTfLiteInt8:
+      data->int8_table =
+          BuildUnaryLut<int8_t>(context, input, output, transform);
+      TF_LITE_ENSURE(context, data->int8_table != nullptr);
+      break;
+    case kTfLiteInt16:
+      data->int16_table =
+          BuildUnaryLut<int16_t>(context, input, output, transform);
+      TF_LITE_ENSURE(context, data->int16_table != nullptr);
+      break;
+    default:
+      MicroPrintf("GELU only supports float32, int8 and int16, got %s.",
+                  TfLiteTypeGetName(input->type));
+      return kTfLiteError;
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return kTfLiteOk;
+}
+
+TfLiteStatus GeluEval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteEvalTensor* input =
+      tflite::micro::GetEvalInput(context, node, kInputTensor);
+  TfLiteEvalTensor* output =
+      tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+  const OpData* data = static_cast<const OpData*>(node->user_data);
+  const auto* params = static_cast<const TfLiteGeluParams*>(node->builtin_data);
+
+  switch (input->type) {
+    case kTfLiteFloat32:
+      reference_ops::Gelu(tflite::micro::GetTensorShape(input),
+                          tflite::micro::GetTensorData<float>(input),
+                          params->approximate,
+                          tflite::micro::GetTensorShape(output),
+                          tflite::micro::GetTensorData<float>(output));
+      return kTfLiteOk;
+    case kTfLiteInt8:
+      EvalUnaryLut(data->int8_table, input, output);
+      return kTfLiteOk;
+    case kTfLiteInt16:
+      EvalUnaryLut(data->int16_table, input, output);
+      return kTfLiteOk;
+    default:
+      MicroPrintf("GELU only supports float32, int8 and int16, got %s.",
+                  TfLiteTypeGetName(input->type));
+      return kTfLiteError;
+  }
+}
+
+}  // namespace
+
+TFLMRegistration Register_GELU() {
+  return tflite::micro::RegisterOp(GeluInit, GeluPrepare, GeluEval);
+}
+
+}  // namespace tflite
@@ -16,14 +16,23 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_MICRO_KERNELS_HARD_SWISH_H_
 #define TENSORFLOW_LITE_MICRO_KERNELS_HARD_SWISH_H_
 
+#include <cstdint>
+
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
 
 namespace tflite {
 
 extern const int kHardSwishInputTensor;
 extern const int kHardSwishOutputTensor;
 
+struct OpDataHardSwish {
+  HardSwishParams params;
+  // int8 hard-swish table, see BuildUnaryLutFromKernel().
+  int8_t* table;
+};
+
 TfLiteStatus HardSwishPrepare(TfLiteContext* context, TfLiteNode* node);
 }  // namespace tflite
 
@@ -0,0 +1,181 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/kernel_backend.h"
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/micro_context.h"
+#include "tensorflow/lite/micro/micro_kernel_tuning.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_time.h"
+
+namespace tflite {
+namespace micro {
+
+namespace {
+
+// Number of timed runs per backend. The fastest run is used to filter out
+// interrupts and cold caches.
+constexpr int kKernelTuningRuns = 3;
+
+int FirstEligibleBackend(uint32_t eligible_mask, int count,
+                         const int8_t* preference) {
+  for (int i = 0; i < count; ++i) {
+    const int index = preference != nullptr ? preference[i] : i;
+    if (eligible_mask & (1u << index)) {
+      return index;
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
+uint32_t KernelTuningKey(uint32_t seed, const int32_t* values, int count) {
+  // FNV-1a over the bytes of the seed and the values.
+  uint32_t hash = 2166136261u;
+  auto mix = [&hash](uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      hash ^= (value >> (8 * i)) & 0xFF;
+      hash *= 16777619u;
+    }
+  };
+  mix(seed);
+  for (int i = 0; i < count; ++i) {
+    mix(static_cast<uint32_t>(values[i]));
+  }
+  return hash;
+}
+
+TfLiteStatus PrepareKernelBackends(TfLiteContext* context, TfLiteNode* node,
+                                   const KernelBackend* backends, int count,
+                                   uint32_t key,
+                                   KernelBackendSelection* selection,
+                                   const int8_t* preference) {
+  TF_LITE_ENSURE(context, count > 0 && count <= kMaxKernelBackends);
+
+  selection->key = key;
+  selection->eligible_mask = 0;
+  for (int i = 0; i < count; ++i) {
+    if (backends[i].is_eligible == nullptr ||
+        backends[i].is_eligible(context, node)) {
+      selection->eligible_mask |= 1u << i;
+    }
+  }
+  selection->selected =
+      FirstEligibleBackend(selection->eligible_mask, count, preference);
+  if (selection->selected < 0) {
+    MicroPrintf("No eligible kernel backend.");
+    return kTfLiteError;
+  }
+
+  MicroKernelTuningTable* table =
+      GetMicroContext(context)->kernel_tuning_table();
+  // Only one backend to pick from, or no way to measure time.
+  if (table == nullptr || ticks_per_second() == 0 ||
+      (selection->eligible_mask & (selection->eligible_mask - 1)) == 0) {
+    return kTfLiteOk;
+  }
+
+  const int tuned = table->Lookup(key);
+  if (tuned < 0) {
+    selection->selected = -1;
+  } else if (tuned < count && (selection->eligible_mask & (1u << tuned))) {
+    selection->selected = tuned;
+  }
+  // Otherwise the result was recorded by a node with the same key that could
+  // run a backend this one cannot. Keep the default rather than retuning,
+  // which would overwrite the other node's result.
+  return kTfLiteOk;
+}
+
+TfLiteStatus DisableKernelBackend(TfLiteContext* context, int index,
+                                  int count,
+                                  KernelBackendSelection* selection,
+                                  const int8_t* preference) {
+  selection->eligible_mask &= ~(1u << index);
+  if (selection->selected == index ||
+      (selection->selected < 0 &&
+       (selection->eligible_mask & (selection->eligible_mask - 1)) == 0)) {
+    selection->selected =
+        FirstEligibleBackend(selection->eligible_mask, count, preference);
+    if (selection->selected < 0) {
+      MicroPrintf("No eligible kernel backend.");
+      return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus InvokeKernelBackend(
+    TfLiteContext* context, TfLiteNode* node, const KernelBackend* backends,
+    int count, KernelBackendSelection* selection,
+    void (*reset)(TfLiteContext* context, TfLiteNode* node)) {
+  if (selection->selected >= 0) {
+    return backends[selection->selected].invoke(context, node);
+  }
+
+  int fastest = -1;
+  uint32_t fastest_ticks = UINT32_MAX;
+  int last_run = -1;
+  for (int i = 0; i < count; ++i) {
+    if ((selection->eligible_mask & (1u << i)) == 0) {
+      continue;
+    }
+    uint32_t ticks = UINT32_MAX;
+    for (int run = 0; run < kKernelTuningRuns; ++run) {
+      if (reset != nullptr) {
+        reset(context, node);
+      }
+      const uint32_t start = GetCurrentTimeTicks();
+      TF_LITE_ENSURE_OK(context, backends[i].invoke(context, node));
+      const uint32_t elapsed = GetCurrentTimeTicks() - start;
+      if (elapsed < ticks) {
+        ticks = elapsed;
+      }
+    }
+    last_run = i;
+    // Ties keep the earlier, preferred backend.
+    if (ticks < fastest_ticks) {
+      fastest = i;
+      fastest_ticks = ticks;
+    }
+  }
+  TF_LITE_ENSURE(context, fastest >= 0);
+  selection->selected = fastest;
+
+  MicroKernelTuningTable* table =
+      GetMicroContext(context)->kernel_tuning_table();
+  if (table != nullptr && table->Insert(selection->key, fastest) != kTfLiteOk) {
+    MicroPrintf("Kernel tuning table is full, %s is not recorded.",
+                backends[fastest].name);
+  }
+
+  // Leave the outputs of the selected backend in place. A stateful node must
+  // also run once more from its original state, since every timed run
+  // advanced it.
+  if (last_run != fastest || reset != nullptr) {
+    if (reset != nullptr) {
+      reset(context, node);
+    }
+    return backends[fastest].invoke(context, node);
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace micro
+}  // namespace tflite
@@ -0,0 +1,104 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_KERNEL_BACKEND_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_KERNEL_BACKEND_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace micro {
+
+// Maximum number of implementations of one operator.
+constexpr int kMaxKernelBackends = 8;
+
+// One implementation of an operator. Kernels list their backends in order of
+// preference; without autotuning the first eligible backend is used. Tuning
+// results refer to backends by index, so new backends are appended, and a
+// kernel that prefers them passes its order to PrepareKernelBackends().
+struct KernelBackend {
+  const char* name;
+  // Returns true if the backend can run the node. Called at the end of the
+  // kernel's Prepare, so it can rely on the kernel data in node->user_data.
+  // A null predicate accepts every node.
+  bool (*is_eligible)(TfLiteContext* context, TfLiteNode* node);
+  TfLiteStatus (*invoke)(TfLiteContext* context, TfLiteNode* node);
+};
+
+// Per-node dispatch state, kept in the kernel data.
+struct KernelBackendSelection {
+  // Identifies the operator configuration in the MicroKernelTuningTable.
+  uint32_t key;
+  // Bit i is set if backend i is eligible.
+  uint32_t eligible_mask;
+  // Index of the backend to invoke, or -1 while autotuning is pending.
+  int32_t selected;
+};
+
+// Hashes `count` values describing an operator configuration (e.g. shapes,
+// strides and types) into a tuning key. `seed` should identify the operator.
+uint32_t KernelTuningKey(uint32_t seed, const int32_t* values, int count);
+
+// Selects the backend of a node from its Prepare. Results recorded in the
+// MicroKernelTuningTable are reused if they name an eligible backend, and the
+// first eligible backend is used if they do not. Without a recorded result,
+// the selection is deferred to the first Invoke if a table is set, or the
+// first eligible backend is used. `preference`, if set, lists the `count`
+// backend indices in order of preference in place of the table order.
+// The kernel must prepare every backend for which KernelBackendMayRun()
+// returns true afterwards.
+TfLiteStatus PrepareKernelBackends(TfLiteContext* context, TfLiteNode* node,
+                                   const KernelBackend* backends, int count,
+                                   uint32_t key,
+                                   KernelBackendSelection* selection,
+                                   const int8_t* preference = nullptr);
+
+// Returns true if backend `index` is selected, or if it is eligible and the
+// selection is pending. Lets kernels skip the persistent buffers and scratch
+// buffers of backends that will never run.
+inline bool KernelBackendMayRun(const KernelBackendSelection& selection,
+                                int index) {
+  return selection.selected == index ||
+         (selection.selected < 0 &&
+          (selection.eligible_mask & (1u << index)) != 0);
+}
+
+// Removes backend `index` from the eligible backends of a prepared node, for
+// conditions that are only worth checking once KernelBackendMayRun() is true.
+// Selects the first eligible backend if the removed one was selected, or if
+// no other backend is left to tune. `preference` is the one the node was
+// prepared with.
+TfLiteStatus DisableKernelBackend(TfLiteContext* context, int index,
+                                  int count,
+                                  KernelBackendSelection* selection,
+                                  const int8_t* preference = nullptr);
+
+// Runs the selected backend. If the selection is pending, every eligible
+// backend is timed on the node's actual tensors, and the fastest one is
+// recorded in the MicroKernelTuningTable and used from then on.
+// Kernels that update state tensors pass `reset`, which is called before every
+// run while timing so that each run, and the final one, starts from the state
+// the node was invoked with.
+TfLiteStatus InvokeKernelBackend(
+    TfLiteContext* context, TfLiteNode* node, const KernelBackend* backends,
+    int count, KernelBackendSelection* selection,
+    void (*reset)(TfLiteContext* context, TfLiteNode* node) = nullptr);
+
+}  // namespace micro
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_KERNEL_BACKEND_H_
@@ -18,6 +18,7 @@ limitations under the License.
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/portable_tensor_utils.h"
 #include "tensorflow/lite/micro/memory_helpers.h"
+#include "tensorflow/lite/micro/micro_arena_constants.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
@@ -146,6 +147,27 @@ TfLiteStatus CreateWritableTensorDimsWithCopy(TfLiteContext* context,
   return kTfLiteOk;
 }
 
+TfLiteStatus RequestAlignedScratchBufferInArena(TfLiteContext* context,
+                                                size_t bytes, size_t alignment,
+                                                int* buffer_idx) {
+  if (alignment <= static_cast<size_t>(MicroArenaBufferAlignment())) {
+    return context->RequestScratchBufferInArena(context, bytes, buffer_idx);
+  }
+  return GetMicroContext(context)->RequestAlignedScratchBufferInArena(
+      bytes, alignment, buffer_idx);
+}
+
+TfLiteStatus RequestInputAlignment(TfLiteContext* context,
+                                   const TfLiteNode* node, int index,
+                                   size_t alignment) {
+  if (alignment <= static_cast<size_t>(MicroArenaBufferAlignment())) {
+    return kTfLiteOk;
+  }
+  TF_LITE_ENSURE(context, index >= 0 && index < node->inputs->size);
+  return GetMicroContext(context)->RequestTensorAlignment(
+      node->inputs->data[index], alignment);
+}
+
 // Verify that both tensors have the same type and size, then return the size
 // of both tensors in bytes if they are the same, or -1 if they are different.
 size_t ValidateAndGetTensorSizes(const TfLiteEvalTensor* tensor1,
@@ -108,6 +108,21 @@ TfLiteStatus CreateWritableTensorDimsWithCopy(TfLiteContext* context,
                                               TfLiteTensor* tensor,
                                               TfLiteEvalTensor* eval_tensor);
 
+// Requests a scratch buffer that starts at a multiple of `alignment` bytes.
+// Alignments up to MicroArenaBufferAlignment() are requested as plain scratch
+// buffers, which already meet them. Only use during Prepare phase.
+TfLiteStatus RequestAlignedScratchBufferInArena(TfLiteContext* context,
+                                                size_t bytes, size_t alignment,
+                                                int* buffer_idx);
+
+// Asks the memory planner to start the data of input `index` of `node` at a
+// multiple of `alignment` bytes, see MicroContext::RequestTensorAlignment().
+// Alignments up to MicroArenaBufferAlignment() are already met and are not
+// recorded. Only use during Prepare phase.
+TfLiteStatus RequestInputAlignment(TfLiteContext* context,
+                                   const TfLiteNode* node, int index,
+                                   size_t alignment);
+
 // Copy all op input tensors to op output tensors. Requires all op input tensor
 // shapes and types to be identical to op output tensor shapes and types.
 TfLiteStatus CopyOpInputsToOpOutputs(TfLiteContext* context, TfLiteNode* node);
@@ -23,8 +23,10 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/op_macros.h"
+#include "tensorflow/lite/micro/kernels/float_math.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/logistic.h"
+#include "tensorflow/lite/micro/kernels/unary_lut.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
@@ -47,10 +49,18 @@ TfLiteStatus LogisticEval(TfLiteContext* context, TfLiteNode* node) {
   if (input->type == kTfLiteFloat32) {
     switch (output->type) {
       case kTfLiteFloat32: {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+        float_math::ApplySigmoidToVector(
+            tflite::micro::GetTensorData<float>(input),
+            MatchingFlatSize(tflite::micro::GetTensorShape(input),
+                             tflite::micro::GetTensorShape(output)),
+            tflite::micro::GetTensorData<float>(output));
+#else
         reference_ops::Logistic(tflite::micro::GetTensorShape(input),
                                 tflite::micro::GetTensorData<float>(input),
                                 tflite::micro::GetTensorShape(output),
                                 tflite::micro::GetTensorData<float>(output));
+#endif
         return kTfLiteOk;
       }
       default:
@@ -78,12 +88,7 @@ TfLiteStatus LogisticEval(TfLiteContext* context, TfLiteNode* node) {
   } else if (input->type == kTfLiteInt8) {
     switch (output->type) {
       case kTfLiteInt8: {
-        reference_integer_ops::Logistic(
-            data->input_zero_point, data->input_range_radius,
-            data->input_multiplier, data->input_left_shift,
-            NumElements(input->dims),
-            tflite::micro::GetTensorData<int8_t>(input),
-            tflite::micro::GetTensorData<int8_t>(output));
+        EvalUnaryLut(data->table, input, output);
         return kTfLiteOk;
       }
       default:
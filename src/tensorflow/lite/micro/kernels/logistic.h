@@ -30,6 +30,8 @@ struct OpDataLogistic {
   int32_t input_range_radius;
   int32_t input_multiplier;
   int input_left_shift;
+  // int8 sigmoid table, see BuildUnaryLutFromKernel().
+  int8_t* table;
 };
 
 TfLiteStatus CalculateArithmeticOpDataLogistic(TfLiteContext* context,
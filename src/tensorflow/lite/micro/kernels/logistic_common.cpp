@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/op_macros.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/logistic.h"
+#include "tensorflow/lite/micro/kernels/unary_lut.h"
 
 namespace tflite {
 const int kLogisticInputTensor = 0;
@@ -58,6 +59,14 @@ TfLiteStatus CalculateArithmeticOpDataLogistic(TfLiteContext* context,
 
     data->input_range_radius =
         CalculateInputRadius(kInputIntegerBits, data->input_left_shift, 31);
+
+    data->table = BuildUnaryLutFromKernel(
+        context, [data](const int8_t* in, int8_t* out, int size) {
+          reference_integer_ops::Logistic(
+              data->input_zero_point, data->input_range_radius,
+              data->input_multiplier, data->input_left_shift, size, in, out);
+        });
+    TF_LITE_ENSURE(context, data->table != nullptr);
   }
 
   if (input->type == kTfLiteInt16) {
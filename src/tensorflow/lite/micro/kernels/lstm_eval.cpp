@@ -25,6 +25,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/reference/mul.h"
 #include "tensorflow/lite/kernels/internal/reference/tanh.h"
 #include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/kernels/float_math.h"
 
 namespace tflite {
 
@@ -138,7 +139,11 @@ void Sigmoid(const RuntimeShape& data_shape, int16_t* data) {
 }
 
 void Sigmoid(const RuntimeShape& data_shape, float* data) {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+  float_math::ApplySigmoidToVector(data, data_shape.FlatSize(), data);
+#else
   reference_ops::Logistic(data_shape, data, data_shape, data);
+#endif
 }
 
 void Tanh(int32_t cell_state_scale_power, const RuntimeShape& input_data_shape,
@@ -159,8 +164,14 @@ void Tanh(int32_t cell_state_scale_power, const RuntimeShape& input_data_shape,
 void Tanh(int32_t cell_state_scale_power, const RuntimeShape& input_data_shape,
           float* input_data, const RuntimeShape& output_data_shape,
           float* output_data) {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+  float_math::ApplyTanhToVector(
+      input_data, MatchingFlatSize(input_data_shape, output_data_shape),
+      output_data);
+#else
   reference_ops::Tanh(input_data_shape, input_data, output_data_shape,
                       output_data);
+#endif
 }
 
 // Input and output have the same shape in LSTM
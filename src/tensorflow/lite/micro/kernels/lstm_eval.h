@@ -21,9 +21,12 @@ limitations under the License.
 #define TENSORFLOW_LITE_MICRO_KERNELS_LSTM_EVAL_GENERAL_H_
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/lstm_shared.h"
 #include "tensorflow/lite/micro/micro_log.h"
@@ -138,6 +141,19 @@ TfLiteStatus PrepareGateParametersInteger(TfLiteContext* context,
 LSTMKernelContents CreateLSTMKernelContent(TfLiteContext* context,
                                            TfLiteNode* node);
 
+// Returns true if PrepareLstmFusedGates supports the LSTM: float, 8x8->16 or
+// 16x8->16 with constant weights and biases, weights quantized without a
+// zero point, and a tanh or sigmoid cell gate.
+bool LstmFusedGatesSupported(const LstmTensors& lstm_tensors,
+                             const OpDataLSTM& op_data_lstm);
+
+// Rearranges the gate weights for EvalLstmFusedGates. The weights and biases
+// are packed in a single buffer allocated with AllocatePackedWeightBuffer.
+TfLiteStatus PrepareLstmFusedGates(TfLiteContext* context,
+                                   const LstmTensors& lstm_tensors,
+                                   const OpDataLSTM& op_data_lstm,
+                                   LstmFusedGates* fused_gates);
+
 template <typename CellType>
 LSTMBuffers<CellType> CreateLSTMBuffers(TfLiteContext* context,
                                         const int* buffer_indices) {
@@ -501,22 +517,176 @@ void LstmStep(const LstmStepManager& step_info, const OpDataLSTM& op_data,
               step_info.StateShape().FlatSize() * sizeof(ActivationType));
 }
 
-}  // namespace lstm_internal
+// Output of the input or recurrent product of a gate, computed from the
+// accumulated products and the bias as FullyConnected does.
+inline float GateProductOutput(const FullyConnectedParams& params, float acc,
+                               float bias) {
+  return ActivationFunctionWithMinMax(acc + bias, params.float_activation_min,
+                                      params.float_activation_max);
+}
 
-// Evaulate the LSTM kernel with (potential) multi-steps and multi-batch input
-// Since
+template <typename AccType>
+int16_t GateProductOutput(const FullyConnectedParams& params, AccType acc,
+                          AccType bias) {
+  int32_t acc_scaled = MultiplyByQuantizedMultiplier(
+      acc + bias, params.output_multiplier, params.output_shift);
+  acc_scaled += params.output_offset;
+  acc_scaled = std::max(acc_scaled, params.quantized_activation_min);
+  acc_scaled = std::min(acc_scaled, params.quantized_activation_max);
+  return static_cast<int16_t>(acc_scaled);
+}
+
+// Same as LstmStep, but with the input and recurrent products of the four
+// gates computed in one pass over the weights from PrepareLstmFusedGates, and
+// the activations and state updates applied to each block of units while its
+// gates are still in local arrays. Every gate row accumulates in the order of
+// FullyConnected and the elementwise operations are the same, so the results
+// match LstmStep exactly.
 template <typename ActivationType, typename WeightType, typename CellType,
           typename BiasType>
-TfLiteStatus EvalLstm(const OpDataLSTM& op_data,
-                      LSTMKernelContents& kernel_content,
-                      const LSTMBuffers<CellType>& buffers) {
-  lstm_internal::LstmStepManager step_info(&op_data.size_info);
+void LstmStepFusedGates(const LstmStepManager& step_info,
+                        const OpDataLSTM& op_data,
+                        const LstmFusedGates& fused_gates,
+                        LSTMKernelContents& kernel_content) {
+  // Products of two activations or weights, before they are accumulated.
+  using ProductType =
+      typename std::conditional<std::is_floating_point<BiasType>::value,
+                                float, int32_t>::type;
+  constexpr int kUnits = kLstmFusedGateUnits;
+  constexpr int kRows = 4 * kUnits;
+  const int n_batch = step_info.StateShape().Dims(0);
+  const int n_input = op_data.size_info.input_dimension;
+  const int n_state = op_data.size_info.state_dimension;
+  const GateParameters* gate_params[4] = {
+      &op_data.input_gate_parameters, &op_data.forget_gate_parameters,
+      &op_data.cell_gate_parameters, &op_data.output_gate_parameters};
+  const InterGateParameters& inter_gate_params = op_data.inter_gate_parameters;
+  const CellStateInfo& cell_state_info = op_data.cell_state_info;
+
+  // Check offset validity to avoid memory overflow
+  TFLITE_DCHECK_LE(
+      step_info.InputOffset() + step_info.InputShape().FlatSize(),
+      tflite::micro::GetTensorShape(
+          kernel_content.GetInternalTensor(tflite::kLstmInputTensor))
+          .FlatSize());
+  TFLITE_DCHECK_LE(
+      step_info.OutputOffset() + step_info.StateShape().FlatSize(),
+      tflite::micro::GetTensorShape(kernel_content.output_tensor).FlatSize());
+
+  const ActivationType* input =
+      tflite::micro::GetTensorData<ActivationType>(
+          kernel_content.GetInternalTensor(tflite::kLstmInputTensor)) +
+      step_info.InputOffset();
+  ActivationType* hidden_state = tflite::micro::GetTensorData<ActivationType>(
+                                     kernel_content.HiddenStateTensor()) +
+                                 step_info.HiddenStateOffset();
+  CellType* cell_state =
+      tflite::micro::GetTensorData<CellType>(kernel_content.CellStateTensor()) +
+      step_info.CellStateOffset();
+  // The new hidden state goes to the output first, since the products of
+  // every block read the previous one.
+  ActivationType* output = tflite::micro::GetTensorData<ActivationType>(
+                               kernel_content.output_tensor) +
+                           step_info.OutputOffset();
+
+  for (int b = 0; b < n_batch; ++b) {
+    const ActivationType* batch_input = input + b * n_input;
+    const ActivationType* batch_hidden_state = hidden_state + b * n_state;
+    const WeightType* weights =
+        static_cast<const WeightType*>(fused_gates.weights);
+    const BiasType* input_biases =
+        static_cast<const BiasType*>(fused_gates.input_biases);
+    const BiasType* recurrent_biases =
+        static_cast<const BiasType*>(fused_gates.recurrent_biases);
+
+    for (int unit = 0; unit < n_state; unit += kUnits) {
+      BiasType input_acc[kRows] = {};
+      for (int d = 0; d < n_input; ++d) {
+        const ProductType value = batch_input[d];
+        for (int r = 0; r < kRows; ++r) {
+          input_acc[r] += static_cast<ProductType>(weights[r]) * value;
+        }
+        weights += kRows;
+      }
+      BiasType recurrent_acc[kRows] = {};
+      for (int d = 0; d < n_state; ++d) {
+        const ProductType value = batch_hidden_state[d];
+        for (int r = 0; r < kRows; ++r) {
+          recurrent_acc[r] += static_cast<ProductType>(weights[r]) * value;
+        }
+        weights += kRows;
+      }
+
+      CellType gates[kRows];
+      CellType recurrent_products[kRows];
+      for (int r = 0; r < kRows; ++r) {
+        const GateParameters& params = *gate_params[r / kUnits];
+        gates[r] = GateProductOutput(params.input_fc_params, input_acc[r],
+                                     input_biases[r]);
+        recurrent_products[r] = GateProductOutput(
+            params.recurrent_fc_params, recurrent_acc[r], recurrent_biases[r]);
+      }
+      input_biases += kRows;
+      recurrent_biases += kRows;
+      AddElementWise(gates, recurrent_products, /*n_batch=*/1,
+                     /*n_input=*/kRows, gates);
+
+      const int n_units = std::min(kUnits, n_state - unit);
+      const int32_t dims[2] = {1, n_units};
+      const RuntimeShape shape(2, dims);
+      CellType* input_gate = gates;
+      CellType* forget_gate = gates + kUnits;
+      CellType* cell_gate = gates + 2 * kUnits;
+      CellType* output_gate = gates + 3 * kUnits;
+      Sigmoid(shape, input_gate);
+      Sigmoid(shape, forget_gate);
+      switch (op_data.cell_gate_nonlinear_type) {
+        case kTfLiteActSigmoid:
+          Sigmoid(shape, cell_gate);
+          break;
+        case kTfLiteActTanh:
+          // Set the scale power to -12 to avoid shift
+          Tanh(/*cell_state_scale_power=*/-12, shape, cell_gate, shape,
+               cell_gate);
+          break;
+        default:
+          // Only Sigmoid or Tanh is used.
+          TFLITE_ASSERT_FALSE;
+      }
+      Sigmoid(shape, output_gate);
+
+      // Same updates as UpdateLstmCell and UpdateLstmHidden.
+      CellType* unit_cell_state = cell_state + b * n_state + unit;
+      Mul(shape, inter_gate_params.forget_cell_mul_params, forget_gate,
+          unit_cell_state, unit_cell_state);
+      Mul(shape, inter_gate_params.input_mul_params, input_gate, cell_gate,
+          input_gate);
+      AddElementWise(unit_cell_state, input_gate, /*n_batch=*/1,
+                     /*n_input=*/n_units, unit_cell_state);
+      if (cell_state_info.cell_clip > 0) {
+        Clipping(n_units, cell_state_info, unit_cell_state);
+      }
+      Tanh(cell_state_info.cell_state_scale_power, shape, unit_cell_state,
+           shape, forget_gate);
+      Mul(shape, inter_gate_params.output_mul_params, forget_gate, output_gate,
+          output + b * n_state + unit);
+    }
+  }
+
+  std::memcpy(hidden_state, output,
+              step_info.StateShape().FlatSize() * sizeof(ActivationType));
+}
+
+// Runs `step(step_info)` for every time step, and for every batch unless the
+// input is time major.
+template <typename StepFunction>
+void ForEachLstmStep(const OpDataLSTM& op_data, const StepFunction& step) {
+  LstmStepManager step_info(&op_data.size_info);
   const auto& size_info = op_data.size_info;
   // time is the first dimention, enable batch computation
   if (size_info.time_major) {
     for (int t = 0; t < size_info.time_steps; t++) {
-      lstm_internal::LstmStep<ActivationType, WeightType, CellType, BiasType>(
-          step_info, op_data, kernel_content, buffers);
+      step(step_info);
       // prepare for the next time step
       step_info.UpdateTime();
     }
@@ -524,8 +694,7 @@ TfLiteStatus EvalLstm(const OpDataLSTM& op_data,
     // batch first, unable to size the input data. single batch inference
     for (int b = 0; b < size_info.batch_size; b++) {
       for (int t = 0; t < size_info.time_steps; t++) {
-        lstm_internal::LstmStep<ActivationType, WeightType, CellType, BiasType>(
-            step_info, op_data, kernel_content, buffers);
+        step(step_info);
         // prepare for the next time step
         step_info.UpdateTime();
       }
@@ -534,6 +703,39 @@ TfLiteStatus EvalLstm(const OpDataLSTM& op_data,
       step_info.ResetTime();
     }
   }
+}
+
+}  // namespace lstm_internal
+
+// Evaulate the LSTM kernel with (potential) multi-steps and multi-batch input
+// Since
+template <typename ActivationType, typename WeightType, typename CellType,
+          typename BiasType>
+TfLiteStatus EvalLstm(const OpDataLSTM& op_data,
+                      LSTMKernelContents& kernel_content,
+                      const LSTMBuffers<CellType>& buffers) {
+  lstm_internal::ForEachLstmStep(
+      op_data, [&](const lstm_internal::LstmStepManager& step_info) {
+        lstm_internal::LstmStep<ActivationType, WeightType, CellType,
+                                BiasType>(step_info, op_data, kernel_content,
+                                          buffers);
+      });
+  return kTfLiteOk;
+}
+
+// Same as EvalLstm, with the gates fused as prepared by PrepareLstmFusedGates.
+// Needs no scratch buffers.
+template <typename ActivationType, typename WeightType, typename CellType,
+          typename BiasType>
+TfLiteStatus EvalLstmFusedGates(const OpDataLSTM& op_data,
+                                const LstmFusedGates& fused_gates,
+                                LSTMKernelContents& kernel_content) {
+  lstm_internal::ForEachLstmStep(
+      op_data, [&](const lstm_internal::LstmStepManager& step_info) {
+        lstm_internal::LstmStepFusedGates<ActivationType, WeightType, CellType,
+                                          BiasType>(
+            step_info, op_data, fused_gates, kernel_content);
+      });
   return kTfLiteOk;
 }
 }  // namespace tflite
@@ -13,13 +13,130 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <type_traits>
+
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/fully_connected.h"
 #include "tensorflow/lite/micro/kernels/lstm_eval.h"
+#include "tensorflow/lite/micro/micro_context.h"
+#include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
 
+namespace {
+
+// Tensors of each gate, in the order the gates are packed by
+// PrepareLstmFusedGates.
+struct FusedGateTensors {
+  int input_weights;
+  int recurrent_weights;
+  int bias;
+};
+
+constexpr FusedGateTensors kFusedGateTensors[4] = {
+    {kLstmInputToInputWeightsTensor, kLstmRecurrentToInputWeightsTensor,
+     kLstmInputGateBiasTensor},
+    {kLstmInputToForgetWeightsTensor, kLstmRecurrentToForgetWeightsTensor,
+     kLstmForgetGateBiasTensor},
+    {kLstmInputToCellWeightsTensor, kLstmRecurrentToCellWeightsTensor,
+     kLstmCellGateBiasTensor},
+    {kLstmInputToOutputWeightsTensor, kLstmRecurrentToOutputWeightsTensor,
+     kLstmOutputGateBiasTensor},
+};
+
+template <typename WeightType, typename BiasType>
+TfLiteStatus PackLstmFusedGates(TfLiteContext* context,
+                                const LstmTensors& lstm_tensors,
+                                const OpDataLSTM& op_data_lstm,
+                                LstmFusedGates* fused_gates) {
+  constexpr int kUnits = kLstmFusedGateUnits;
+  constexpr int kRows = 4 * kUnits;
+  constexpr bool kQuantized = !std::is_floating_point<BiasType>::value;
+  const int n_input = op_data_lstm.size_info.input_dimension;
+  const int n_state = op_data_lstm.size_info.state_dimension;
+  const int n_blocks = (n_state + kUnits - 1) / kUnits;
+  const size_t weights_size =
+      static_cast<size_t>(n_blocks) * (n_input + n_state) * kRows;
+  const size_t biases_size = static_cast<size_t>(n_blocks) * kRows;
+
+  // One buffer holds the input biases, the recurrent biases and the weights,
+  // in that order, so that the biases keep the alignment of the buffer.
+  const size_t packed_bytes = 2 * biases_size * sizeof(BiasType) +
+                              weights_size * sizeof(WeightType);
+  BiasType* biases = static_cast<BiasType*>(
+      GetMicroContext(context)->AllocatePackedWeightBuffer(packed_bytes));
+  if (biases == nullptr) {
+    MicroPrintf("Failed to allocate %d bytes for the fused LSTM gates.",
+                static_cast<int>(packed_bytes));
+    return kTfLiteError;
+  }
+  BiasType* input_biases = biases;
+  BiasType* recurrent_biases = biases + biases_size;
+  WeightType* weights =
+      reinterpret_cast<WeightType*>(recurrent_biases + biases_size);
+
+  // The products are accumulated without the input zero points, which are
+  // folded into the biases instead. Float parameters leave them unset.
+  BiasType input_offset = 0;
+  BiasType recurrent_offset = 0;
+  if (kQuantized) {
+    const GateParameters& params = op_data_lstm.forget_gate_parameters;
+    input_offset = params.input_fc_params.input_offset;
+    recurrent_offset = params.recurrent_fc_params.input_offset;
+  }
+
+  for (int block = 0; block < n_blocks; ++block) {
+    WeightType* block_weights = weights + block * (n_input + n_state) * kRows;
+    for (int gate = 0; gate < 4; ++gate) {
+      const FusedGateTensors& tensors = kFusedGateTensors[gate];
+      const WeightType* input_weights = GetTensorData<WeightType>(
+          lstm_tensors.GetInternalTensor(tensors.input_weights));
+      const WeightType* recurrent_weights = GetTensorData<WeightType>(
+          lstm_tensors.GetInternalTensor(tensors.recurrent_weights));
+      const TfLiteTensor* bias_tensor =
+          lstm_tensors.GetInternalTensor(tensors.bias);
+      for (int u = 0; u < kUnits; ++u) {
+        const int unit = block * kUnits + u;
+        const int row = gate * kUnits + u;
+        const bool padding = unit >= n_state;
+        BiasType input_sum = 0;
+        for (int d = 0; d < n_input; ++d) {
+          const WeightType w =
+              padding ? WeightType(0) : input_weights[unit * n_input + d];
+          block_weights[d * kRows + row] = w;
+          input_sum += w;
+        }
+        BiasType recurrent_sum = 0;
+        for (int d = 0; d < n_state; ++d) {
+          const WeightType w =
+              padding ? WeightType(0) : recurrent_weights[unit * n_state + d];
+          block_weights[(n_input + d) * kRows + row] = w;
+          recurrent_sum += w;
+        }
+        BiasType input_bias = 0;
+        if (!padding && bias_tensor != nullptr) {
+          input_bias = GetTensorData<BiasType>(bias_tensor)[unit];
+        }
+        if (kQuantized) {
+          input_bias += input_offset * input_sum;
+        }
+        input_biases[block * kRows + row] = input_bias;
+        recurrent_biases[block * kRows + row] =
+            kQuantized ? recurrent_offset * recurrent_sum : BiasType(0);
+      }
+    }
+  }
+
+  fused_gates->weights = weights;
+  fused_gates->input_biases = input_biases;
+  fused_gates->recurrent_biases = recurrent_biases;
+  return kTfLiteOk;
+}
+
+}  // namespace
+
 // Deduce the size information (Batch (B), Time Steps (T), Input dimension (I),
 // State dimension (S)) that defines the LSTM using the input and hidden state
 // tensor
@@ -323,4 +440,80 @@ LSTMKernelContents CreateLSTMKernelContent(TfLiteContext* context,
   return kernel_content;
 }
 
+bool LstmFusedGatesSupported(const LstmTensors& lstm_tensors,
+                             const OpDataLSTM& op_data_lstm) {
+  if (op_data_lstm.cell_gate_nonlinear_type != kTfLiteActTanh &&
+      op_data_lstm.cell_gate_nonlinear_type != kTfLiteActSigmoid) {
+    return false;
+  }
+  const TfLiteType activation_type =
+      lstm_tensors.GetInternalTensor(kLstmInputTensor)->type;
+  const TfLiteType weight_type =
+      lstm_tensors.GetInternalTensor(kLstmInputToOutputWeightsTensor)->type;
+  const TfLiteType cell_type = lstm_tensors.CellStateTensor()->type;
+  const TfLiteType bias_type =
+      lstm_tensors.GetInternalTensor(kLstmForgetGateBiasTensor)->type;
+  if (activation_type == kTfLiteFloat32) {
+    if (weight_type != kTfLiteFloat32 || cell_type != kTfLiteFloat32 ||
+        bias_type != kTfLiteFloat32) {
+      return false;
+    }
+  } else {
+    if ((activation_type != kTfLiteInt8 && activation_type != kTfLiteInt16) ||
+        weight_type != kTfLiteInt8 || cell_type != kTfLiteInt16 ||
+        bias_type !=
+            (activation_type == kTfLiteInt8 ? kTfLiteInt32 : kTfLiteInt64)) {
+      return false;
+    }
+    // The packed products do not subtract a weight zero point.
+    const GateParameters* gates[4] = {&op_data_lstm.input_gate_parameters,
+                                      &op_data_lstm.forget_gate_parameters,
+                                      &op_data_lstm.cell_gate_parameters,
+                                      &op_data_lstm.output_gate_parameters};
+    for (const GateParameters* gate : gates) {
+      if (gate->input_fc_params.weights_offset != 0 ||
+          gate->recurrent_fc_params.weights_offset != 0) {
+        return false;
+      }
+    }
+  }
+  // The weights and biases are packed at Prepare, so none of them may change
+  // afterwards. Omitted biases are packed as zeros.
+  for (const FusedGateTensors& tensors : kFusedGateTensors) {
+    const TfLiteTensor* bias = lstm_tensors.GetInternalTensor(tensors.bias);
+    if (!IsConstantTensor(
+            lstm_tensors.GetInternalTensor(tensors.input_weights)) ||
+        !IsConstantTensor(
+            lstm_tensors.GetInternalTensor(tensors.recurrent_weights)) ||
+        (bias != nullptr && !IsConstantTensor(bias))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TfLiteStatus PrepareLstmFusedGates(TfLiteContext* context,
+                                   const LstmTensors& lstm_tensors,
+                                   const OpDataLSTM& op_data_lstm,
+                                   LstmFusedGates* fused_gates) {
+  TF_LITE_ENSURE(context,
+                 LstmFusedGatesSupported(lstm_tensors, op_data_lstm));
+  switch (lstm_tensors.GetInternalTensor(kLstmInputTensor)->type) {
+    case kTfLiteFloat32:
+      return PackLstmFusedGates<float, float>(context, lstm_tensors,
+                                              op_data_lstm, fused_gates);
+    case kTfLiteInt8:
+      return PackLstmFusedGates<int8_t, int32_t>(context, lstm_tensors,
+                                                 op_data_lstm, fused_gates);
+    case kTfLiteInt16:
+      return PackLstmFusedGates<int8_t, int64_t>(context, lstm_tensors,
+                                                 op_data_lstm, fused_gates);
+    default:
+      MicroPrintf("Fused LSTM gates do not support type %s.",
+                  TfLiteTypeGetName(
+                      lstm_tensors.GetInternalTensor(kLstmInputTensor)->type));
+      return kTfLiteError;
+  }
+}
+
 }  // namespace tflite
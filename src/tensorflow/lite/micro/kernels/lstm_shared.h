@@ -117,6 +117,25 @@ struct OpDataLSTM {
   int buffer_indices[4];  // TFLM only
 };
 
+// Number of hidden units whose four gates are computed together when the gates
+// are fused (see PrepareLstmFusedGates in lstm_eval.h).
+constexpr int kLstmFusedGateUnits = 8;
+
+// Weights of the four gates rearranged for fused evaluation. The hidden units
+// are split in blocks of kLstmFusedGateUnits. A block holds one column per
+// input element followed by one column per hidden state element; each column
+// holds the input, forget, cell and output gate weights of the block's units,
+// in that order. Units past the state dimension have zero weights.
+struct LstmFusedGates {
+  // Weights, of the same type as the weight tensors.
+  const void* weights;
+  // Per row of a block, in the same order as a column: the bias of the input
+  // product and that of the recurrent product, with the products' input
+  // offsets folded in. Of the same type as the bias tensors.
+  const void* input_biases;
+  const void* recurrent_biases;
+};
+
 // Provide an interface to access the internal tensors and buffers used for LSTM
 // invocation. Constructed during the invocation phase
 struct LSTMKernelContents {
@@ -13,8 +13,6 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
-#include "tensorflow/lite/kernels/internal/reference/maximum_minimum.h"
-
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/common.h"
@@ -22,6 +20,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/op_macros.h"
+#include "tensorflow/lite/micro/kernels/binary_broadcast.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
@@ -38,6 +37,10 @@ constexpr int kInputTensor1 = 0;
 constexpr int kInputTensor2 = 1;
 constexpr int kOutputTensor = 0;
 
+struct OpData {
+  BinaryBroadcastShape broadcast;
+};
+
 struct OpContext {
   OpContext(TfLiteContext* context, TfLiteNode* node) {
     input1 = tflite::micro::GetEvalInput(context, node, kInputTensor1);
@@ -63,17 +66,48 @@ struct MinimumOp {
   }
 };
 
+void* MaximumMinimumInit(TfLiteContext* context, const char* buffer,
+                         size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return context->AllocatePersistentBuffer(context, sizeof(OpData));
+}
+
+TfLiteStatus MaximumMinimumPrepare(TfLiteContext* context, TfLiteNode* node) {
+  TFLITE_DCHECK(node->user_data != nullptr);
+  OpData* data = static_cast<OpData*>(node->user_data);
+
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 2);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+
+  MicroContext* micro_context = GetMicroContext(context);
+
+  TfLiteTensor* input1 =
+      micro_context->AllocateTempInputTensor(node, kInputTensor1);
+  TF_LITE_ENSURE(context, input1 != nullptr);
+  TfLiteTensor* input2 =
+      micro_context->AllocateTempInputTensor(node, kInputTensor2);
+  TF_LITE_ENSURE(context, input2 != nullptr);
+
+  TF_LITE_ENSURE_STATUS(
+      PrepareBinaryBroadcast(context, input1, input2, &data->broadcast));
+
+  micro_context->DeallocateTempTfLiteTensor(input1);
+  micro_context->DeallocateTempTfLiteTensor(input2);
+  return kTfLiteOk;
+}
+
 template <typename data_type, typename op_type>
 void TFLiteOperation(TfLiteContext* context, TfLiteNode* node,
                      const OpContext& op_context) {
-  reference_ops::MaximumMinimumBroadcastSlow(
-      tflite::micro::GetTensorShape(op_context.input1),
-      tflite::micro::GetTensorData<data_type>(op_context.input1),
-      tflite::micro::GetTensorShape(op_context.input2),
-      tflite::micro::GetTensorData<data_type>(op_context.input2),
-      tflite::micro::GetTensorShape(op_context.output),
-      tflite::micro::GetTensorData<data_type>(op_context.output),
-      op_type::template op<data_type>);
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const OpData* data = static_cast<const OpData*>(node->user_data);
+  BinaryBroadcast(data->broadcast,
+                  tflite::micro::GetTensorData<data_type>(op_context.input1),
+                  tflite::micro::GetTensorData<data_type>(op_context.input2),
+                  tflite::micro::GetTensorData<data_type>(op_context.output),
+                  [](data_type el1, data_type el2) {
+                    return op_type::template op<data_type>(el1, el2);
+                  });
 }
 
 template <KernelType kernel_type, typename OpType>
@@ -110,12 +144,12 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 }  // namespace
 
 TFLMRegistration Register_MAXIMUM() {
-  return tflite::micro::RegisterOp(nullptr, nullptr,
+  return tflite::micro::RegisterOp(MaximumMinimumInit, MaximumMinimumPrepare,
                                    Eval<kReference, MaximumOp>);
 }
 
 TFLMRegistration Register_MINIMUM() {
-  return tflite::micro::RegisterOp(nullptr, nullptr,
+  return tflite::micro::RegisterOp(MaximumMinimumInit, MaximumMinimumPrepare,
                                    Eval<kReference, MinimumOp>);
 }
 
@@ -26,21 +26,30 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/compatibility.h"
 #include "tensorflow/lite/kernels/internal/cppmath.h"
 #include "tensorflow/lite/kernels/op_macros.h"
+#include "tensorflow/lite/micro/kernels/float_math.h"
 
 namespace tflite {
 
 // Apply sigmoid to elements of a vector.
 void PortableApplySigmoidToVector(const float* vector, int v_size,
                                   float* result) {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+  float_math::ApplySigmoidToVector(vector, v_size, result);
+#else
   for (int v = 0; v < v_size; v++) {
     result[v] = 1.0f / (1.0f + std::exp(-vector[v]));
   }
+#endif
 }
 
 void PortableApplyTanhToVector(const float* vector, int v_size, float* result) {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+  float_math::ApplyTanhToVector(vector, v_size, result);
+#else
   for (int v = 0; v < v_size; v++) {
     result[v] = std::tanh(vector[v]);
   }
+#endif
 }
 
 void PortableApplyActivationToVector(const float* vector, int v_size,
@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstdint>
 
 #include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/micro/kernels/binary_broadcast.h"
 #include "tensorflow/lite/micro/micro_common.h"
 
 namespace tflite {
@@ -39,6 +40,8 @@ struct OpDataMul {
 
   float output_activation_min_f32;
   float output_activation_max_f32;
+
+  BinaryBroadcastShape broadcast;
 };
 
 void* MulInit(TfLiteContext* context, const char* buffer, size_t length);
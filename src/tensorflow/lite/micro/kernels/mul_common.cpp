@@ -14,12 +14,11 @@ limitations under the License.
 ==============================================================================*/
 
 #include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
-#include "tensorflow/lite/kernels/internal/reference/integer_ops/mul.h"
-#include "tensorflow/lite/kernels/internal/reference/mul.h"
-#include "tensorflow/lite/kernels/internal/reference/process_broadcast_shapes.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/binary_broadcast.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/mul.h"
 #include "tensorflow/lite/micro/memory_helpers.h"
@@ -53,6 +52,8 @@ TfLiteStatus CalculateOpDataMul(TfLiteContext* context, TfLiteNode* node,
   TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
 
   TF_LITE_ENSURE_TYPES_EQ(context, input1->type, input2->type);
+  TF_LITE_ENSURE_STATUS(
+      PrepareBinaryBroadcast(context, input1, input2, &data->broadcast));
 
   if (output->type == kTfLiteInt8 || output->type == kTfLiteInt16) {
     TF_LITE_ENSURE_STATUS(CalculateActivationRangeQuantized(
@@ -99,6 +100,54 @@ TfLiteStatus MulPrepare(TfLiteContext* context, TfLiteNode* node) {
   return CalculateOpDataMul(context, node, params, data);
 }
 
+namespace {
+
+// The quantized MUL of reference_integer_ops for one pair of int8 or int16
+// values.
+template <typename T>
+inline T QuantizedMul(T x, T y, const ArithmeticParams& params) {
+  const int32_t input1_val = params.input1_offset + x;
+  const int32_t input2_val = params.input2_offset + y;
+  const int32_t unclamped_result =
+      params.output_offset +
+      MultiplyByQuantizedMultiplier(input1_val * input2_val,
+                                    params.output_multiplier,
+                                    params.output_shift);
+  const int32_t clamped_output =
+      std::min(params.quantized_activation_max,
+               std::max(params.quantized_activation_min, unclamped_result));
+  return static_cast<T>(clamped_output);
+}
+
+template <typename T>
+void BroadcastMulQuantized(const OpDataMul* data,
+                           const tflite::ArithmeticParams& op_params,
+                           const TfLiteEvalTensor* input1,
+                           const TfLiteEvalTensor* input2,
+                           TfLiteEvalTensor* output) {
+  BinaryBroadcast(data->broadcast, tflite::micro::GetTensorData<T>(input1),
+                  tflite::micro::GetTensorData<T>(input2),
+                  tflite::micro::GetTensorData<T>(output),
+                  [op_params](T x, T y) {
+                    return QuantizedMul(x, y, op_params);
+                  });
+}
+
+template <typename T>
+void BroadcastMul(const OpDataMul* data, T activation_min, T activation_max,
+                  const TfLiteEvalTensor* input1,
+                  const TfLiteEvalTensor* input2, TfLiteEvalTensor* output) {
+  BinaryBroadcast(data->broadcast, tflite::micro::GetTensorData<T>(input1),
+                  tflite::micro::GetTensorData<T>(input2),
+                  tflite::micro::GetTensorData<T>(output),
+                  [activation_min, activation_max](T x, T y) {
+                    return ActivationFunctionWithMinMax(x * y, activation_min,
+                                                        activation_max);
+                  });
+}
+
+}  // namespace
+
 TfLiteStatus EvalMulQuantizedReference(TfLiteContext* context, TfLiteNode* node,
                                        const OpDataMul* data,
                                        const TfLiteEvalTensor* input1,
@@ -107,74 +156,23 @@ TfLiteStatus EvalMulQuantizedReference(TfLiteContext* context, TfLiteNode* node,
   tflite::ArithmeticParams op_params = {};
   op_params.quantized_activation_min = data->output_activation_min;
   op_params.quantized_activation_max = data->output_activation_max;
-  op_params.float_activation_max = data->output_activation_max_f32;
   op_params.input1_offset = -data->input1_zero_point;
   op_params.input2_offset = -data->input2_zero_point;
   op_params.output_offset = data->output_zero_point;
   op_params.output_multiplier = data->output_multiplier;
   op_params.output_shift = data->output_shift;
 
-  bool need_broadcast = reference_ops::ProcessBroadcastShapes(
-      tflite::micro::GetTensorShape(input1),
-      tflite::micro::GetTensorShape(input2), &op_params);
-
   if (input1->type == kTfLiteInt8) {
-    if (need_broadcast) {
-      reference_integer_ops::BroadcastMul4DSlow(
-          op_params, tflite::micro::GetTensorShape(input1),
-          tflite::micro::GetTensorData<int8_t>(input1),
-          tflite::micro::GetTensorShape(input2),
-          tflite::micro::GetTensorData<int8_t>(input2),
-          tflite::micro::GetTensorShape(output),
-          tflite::micro::GetTensorData<int8_t>(output));
-    } else {
-      reference_integer_ops::Mul(op_params,
-                                 tflite::micro::GetTensorShape(input1),
-                                 tflite::micro::GetTensorData<int8_t>(input1),
-                                 tflite::micro::GetTensorShape(input2),
-                                 tflite::micro::GetTensorData<int8_t>(input2),
-                                 tflite::micro::GetTensorShape(output),
-                                 tflite::micro::GetTensorData<int8_t>(output));
-    }
+    BroadcastMulQuantized<int8_t>(data, op_params, input1, input2, output);
   } else if (input1->type == kTfLiteInt32) {
-    if (need_broadcast) {
-      reference_ops::BroadcastMul4DSlow(
-          op_params, tflite::micro::GetTensorShape(input1),
-          tflite::micro::GetTensorData<int32_t>(input1),
-          tflite::micro::GetTensorShape(input2),
-          tflite::micro::GetTensorData<int32_t>(input2),
-          tflite::micro::GetTensorShape(output),
-          tflite::micro::GetTensorData<int32_t>(output));
-    } else {
-      reference_ops::Mul(op_params, tflite::micro::GetTensorShape(input1),
-                         tflite::micro::GetTensorData<int32_t>(input1),
-                         tflite::micro::GetTensorShape(input2),
-                         tflite::micro::GetTensorData<int32_t>(input2),
-                         tflite::micro::GetTensorShape(output),
-                         tflite::micro::GetTensorData<int32_t>(output));
-    }
+    BroadcastMul<int32_t>(data, data->output_activation_min,
+                          data->output_activation_max, input1, input2, output);
   } else if (input1->type == kTfLiteInt16) {
     TF_LITE_ENSURE_EQ(context, op_params.input1_offset, 0);
     TF_LITE_ENSURE_EQ(context, op_params.input2_offset, 0);
     TF_LITE_ENSURE_EQ(context, op_params.output_offset, 0);
 
-    if (need_broadcast) {
-      reference_integer_ops::BroadcastMul4DSlow(
-          op_params, tflite::micro::GetTensorShape(input1),
-          tflite::micro::GetTensorData<int16_t>(input1),
-          tflite::micro::GetTensorShape(input2),
-          tflite::micro::GetTensorData<int16_t>(input2),
-          tflite::micro::GetTensorShape(output),
-          tflite::micro::GetTensorData<int16_t>(output));
-    } else {
-      reference_integer_ops::Mul(op_params,
-                                 tflite::micro::GetTensorShape(input1),
-                                 tflite::micro::GetTensorData<int16_t>(input1),
-                                 tflite::micro::GetTensorShape(input2),
-                                 tflite::micro::GetTensorData<int16_t>(input2),
-                                 tflite::micro::GetTensorShape(output),
-                                 tflite::micro::GetTensorData<int16_t>(output));
-    }
+    BroadcastMulQuantized<int16_t>(data, op_params, input1, input2, output);
   }
   return kTfLiteOk;
 }
@@ -184,30 +182,8 @@ void EvalMulFloatReference(TfLiteContext* context, TfLiteNode* node,
                            const TfLiteEvalTensor* input1,
                            const TfLiteEvalTensor* input2,
                            TfLiteEvalTensor* output) {
-  tflite::ArithmeticParams op_params = {};
-  op_params.float_activation_min = data->output_activation_min_f32;
-  op_params.float_activation_max = data->output_activation_max_f32;
-
-  bool need_broadcast = reference_ops::ProcessBroadcastShapes(
-      tflite::micro::GetTensorShape(input1),
-      tflite::micro::GetTensorShape(input2), &op_params);
-
-  if (need_broadcast) {
-    reference_ops::BroadcastMul4DSlow(
-        op_params, tflite::micro::GetTensorShape(input1),
-        tflite::micro::GetTensorData<float>(input1),
-        tflite::micro::GetTensorShape(input2),
-        tflite::micro::GetTensorData<float>(input2),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<float>(output));
-  } else {
-    reference_ops::Mul(op_params, tflite::micro::GetTensorShape(input1),
-                       tflite::micro::GetTensorData<float>(input1),
-                       tflite::micro::GetTensorShape(input2),
-                       tflite::micro::GetTensorData<float>(input2),
-                       tflite::micro::GetTensorShape(output),
-                       tflite::micro::GetTensorData<float>(output));
-  }
+  BroadcastMul<float>(data, data->output_activation_min_f32,
+                      data->output_activation_max_f32, input1, input2, output);
 }
 
 }  // namespace tflite
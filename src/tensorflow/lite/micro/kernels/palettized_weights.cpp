@@ -0,0 +1,524 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/palettized_weights.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/memory_helpers.h"
+#include "tensorflow/lite/micro/micro_context.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+
+namespace {
+
+constexpr int kPalettizedHeaderBytes = 4;
+constexpr int kMinIndexBits = 2;
+constexpr int kMaxIndexBits = 4;
+
+// Copies the `count` codebooks of `codebook_size` little-endian values of T
+// from `source`, padding each with zeros to 1 << `index_bits` values.
+template <typename T>
+void CopyCodebooks(const uint8_t* source, int count, int codebook_size,
+                   int index_bits, T* codebooks) {
+  const int stride = 1 << index_bits;
+  for (int i = 0; i < count; ++i) {
+    T* codebook = codebooks + i * stride;
+    for (int j = 0; j < stride; ++j) {
+      codebook[j] = 0;
+    }
+    std::memcpy(codebook, source + i * codebook_size * sizeof(T),
+                codebook_size * sizeof(T));
+  }
+}
+
+// Returns the number of output channels to decompress at a time, for
+// `channels` channels of `channel_elements` values of `type_size` bytes.
+int TileChannels(int channels, int channel_elements, size_t type_size) {
+  const size_t channel_bytes = channel_elements * type_size;
+  const int tile_channels =
+      channel_bytes > 0 ? kPalettizedTileBytes / channel_bytes : channels;
+  return std::max(1, std::min(tile_channels, channels));
+}
+
+template <typename T>
+void Decompress(const PalettizedWeights& weights, int start, int count,
+                T* output) {
+  if (count <= 0) {
+    return;
+  }
+  const T* codebooks = static_cast<const T*>(weights.codebooks);
+  const int bits = weights.index_bits;
+  const int stride = 1 << bits;
+  const uint32_t mask = stride - 1;
+
+  int channel = (start / weights.channel_elements) % weights.codebook_count;
+  int channel_left =
+      weights.channel_elements - start % weights.channel_elements;
+  const T* codebook = codebooks + channel * stride;
+
+  // Reads the indices through a window of at most 11 bits that is refilled
+  // one byte at a time, which handles indices that straddle two bytes.
+  const uint32_t bit_offset = static_cast<uint32_t>(start) * bits;
+  const uint8_t* source = weights.indices + bit_offset / 8;
+  uint32_t window = *source++ >> (bit_offset % 8);
+  int window_bits = 8 - bit_offset % 8;
+  for (int i = 0; i < count; ++i) {
+    if (window_bits < bits) {
+      window |= static_cast<uint32_t>(*source++) << window_bits;
+      window_bits += 8;
+    }
+    output[i] = codebook[window & mask];
+    window >>= bits;
+    window_bits -= bits;
+    if (--channel_left == 0) {
+      channel_left = weights.channel_elements;
+      channel = channel + 1 == weights.codebook_count ? 0 : channel + 1;
+      codebook = codebooks + channel * stride;
+    }
+  }
+}
+
+// Output stage of the float kernels.
+struct FloatStage {
+  float Input(float value) const { return value; }
+  float Filter(float value) const { return value; }
+  float Output(float total, int channel) const {
+    const float bias_value = bias_data != nullptr ? bias_data[channel] : 0.0f;
+    return ActivationFunctionWithMinMax(total + bias_value, activation_min,
+                                        activation_max);
+  }
+
+  const float* bias_data;
+  float activation_min;
+  float activation_max;
+};
+
+// Output stage of the int8 kernels, with per-channel multipliers and shifts
+// unless `per_channel` is false.
+struct Int8Stage {
+  int32_t Input(int8_t value) const { return value + input_offset; }
+  int32_t Filter(int8_t value) const { return value + filter_offset; }
+  int8_t Output(int32_t acc, int channel) const {
+    if (bias_data != nullptr) {
+      acc += bias_data[channel];
+    }
+    const int quantization_channel = per_channel ? channel : 0;
+    acc = MultiplyByQuantizedMultiplier(acc,
+                                        output_multiplier[quantization_channel],
+                                        output_shift[quantization_channel]);
+    acc += output_offset;
+    acc = std::max(acc, activation_min);
+    acc = std::min(acc, activation_max);
+    return static_cast<int8_t>(acc);
+  }
+
+  const int32_t* bias_data;
+  const int32_t* output_multiplier;
+  const int32_t* output_shift;
+  bool per_channel;
+  int32_t input_offset;
+  int32_t filter_offset;
+  int32_t output_offset;
+  int32_t activation_min;
+  int32_t activation_max;
+};
+
+template <typename T, typename AccType, typename Stage>
+void Conv(const ConvParams& params, const Stage& stage,
+          const RuntimeShape& input_shape, const T* input_data,
+          const RuntimeShape& filter_shape, const PalettizedWeights& filter,
+          const RuntimeShape& output_shape, T* output_data, T* filter_tile) {
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 4);
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int input_depth = input_shape.Dims(3);
+  const int output_depth = MatchingDim(filter_shape, 0, output_shape, 3);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  const int filter_height = filter_shape.Dims(1);
+  const int filter_width = filter_shape.Dims(2);
+  const int filter_input_depth = filter_shape.Dims(3);
+  const int filter_size = filter_height * filter_width * filter_input_depth;
+  const int groups = input_depth / filter_input_depth;
+  TFLITE_DCHECK_NE(groups, 0);
+  const int filters_per_group = output_depth / groups;
+  TFLITE_DCHECK_NE(filters_per_group, 0);
+  const int tile_channels =
+      TileChannels(output_depth, filter_size, sizeof(T));
+
+  for (int tile_start = 0; tile_start < output_depth;
+       tile_start += tile_channels) {
+    const int tile_depth = std::min(tile_channels, output_depth - tile_start);
+    DecompressPalettizedWeights(filter, tile_start * filter_size,
+                                tile_depth * filter_size, filter_tile);
+    for (int batch = 0; batch < batches; ++batch) {
+      for (int out_y = 0; out_y < output_height; ++out_y) {
+        const int in_y_origin =
+            (out_y * params.stride_height) - params.padding_values.height;
+        for (int out_x = 0; out_x < output_width; ++out_x) {
+          const int in_x_origin =
+              (out_x * params.stride_width) - params.padding_values.width;
+          for (int c = 0; c < tile_depth; ++c) {
+            const int out_channel = tile_start + c;
+            const int group = out_channel / filters_per_group;
+            const T* channel_filter = filter_tile + c * filter_size;
+            AccType acc = 0;
+            for (int filter_y = 0; filter_y < filter_height; ++filter_y) {
+              const int in_y =
+                  in_y_origin + params.dilation_height_factor * filter_y;
+              for (int filter_x = 0; filter_x < filter_width; ++filter_x) {
+                const int in_x =
+                    in_x_origin + params.dilation_width_factor * filter_x;
+                if (in_x < 0 || in_x >= input_width || in_y < 0 ||
+                    in_y >= input_height) {
+                  continue;
+                }
+                const T* input =
+                    input_data + Offset(input_shape, batch, in_y, in_x,
+                                        group * filter_input_depth);
+                const T* filter_values =
+                    channel_filter +
+                    (filter_y * filter_width + filter_x) * filter_input_depth;
+                for (int in_channel = 0; in_channel < filter_input_depth;
+                     ++in_channel) {
+                  acc += stage.Filter(filter_values[in_channel]) *
+                         stage.Input(input[in_channel]);
+                }
+              }
+            }
+            output_data[Offset(output_shape, batch, out_y, out_x,
+                               out_channel)] = stage.Output(acc, out_channel);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T, typename AccType, typename Stage>
+void DepthwiseConv(const DepthwiseParams& params, const Stage& stage,
+                   const RuntimeShape& input_shape, const T* input_data,
+                   const RuntimeShape& filter_shape,
+                   const PalettizedWeights& filter,
+                   const RuntimeShape& output_shape, T* output_data,
+                   T* filter_tile) {
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 4);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 4);
+  const int batches = MatchingDim(input_shape, 0, output_shape, 0);
+  const int input_height = input_shape.Dims(1);
+  const int input_width = input_shape.Dims(2);
+  const int output_depth = MatchingDim(filter_shape, 3, output_shape, 3);
+  const int output_height = output_shape.Dims(1);
+  const int output_width = output_shape.Dims(2);
+  const int filter_height = filter_shape.Dims(1);
+  const int filter_width = filter_shape.Dims(2);
+  const int depth_multiplier = params.depth_multiplier;
+  TFLITE_DCHECK_EQ(output_depth, input_shape.Dims(3) * depth_multiplier);
+  const int tile_channels =
+      TileChannels(output_depth, filter_height * filter_width, sizeof(T));
+
+  for (int tile_start = 0; tile_start < output_depth;
+       tile_start += tile_channels) {
+    const int tile_depth = std::min(tile_channels, output_depth - tile_start);
+    // The tile holds the [filter_height, filter_width, tile_depth] weights of
+    // the channels.
+    for (int tap = 0; tap < filter_height * filter_width; ++tap) {
+      DecompressPalettizedWeights(filter, tap * output_depth + tile_start,
+                                  tile_depth, filter_tile + tap * tile_depth);
+    }
+    for (int batch = 0; batch < batches; ++batch) {
+      for (int out_y = 0; out_y < output_height; ++out_y) {
+        const int in_y_origin =
+            (out_y * params.stride_height) - params.padding_values.height;
+        for (int out_x = 0; out_x < output_width; ++out_x) {
+          const int in_x_origin =
+              (out_x * params.stride_width) - params.padding_values.width;
+          for (int c = 0; c < tile_depth; ++c) {
+            const int out_channel = tile_start + c;
+            const int in_channel = out_channel / depth_multiplier;
+            AccType acc = 0;
+            for (int filter_y = 0; filter_y < filter_height; ++filter_y) {
+              const int in_y =
+                  in_y_origin + params.dilation_height_factor * filter_y;
+              for (int filter_x = 0; filter_x < filter_width; ++filter_x) {
+                const int in_x =
+                    in_x_origin + params.dilation_width_factor * filter_x;
+                if (in_x < 0 || in_x >= input_width || in_y < 0 ||
+                    in_y >= input_height) {
+                  continue;
+                }
+                const T input_value = input_data[Offset(
+                    input_shape, batch, in_y, in_x, in_channel)];
+                const T filter_value =
+                    filter_tile[(filter_y * filter_width + filter_x) *
+                                    tile_depth +
+                                c];
+                acc += stage.Filter(filter_value) * stage.Input(input_value);
+              }
+            }
+            output_data[Offset(output_shape, batch, out_y, out_x,
+                               out_channel)] = stage.Output(acc, out_channel);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T, typename AccType, typename Stage>
+void FullyConnected(const Stage& stage, const PalettizedWeights& filter,
+                    int batches, int output_depth, int accum_depth,
+                    const T* input_data, T* output_data, T* filter_tile) {
+  const int tile_channels = TileChannels(output_depth, accum_depth, sizeof(T));
+  for (int tile_start = 0; tile_start < output_depth;
+       tile_start += tile_channels) {
+    const int tile_depth = std::min(tile_channels, output_depth - tile_start);
+    DecompressPalettizedWeights(filter, tile_start * accum_depth,
+                                tile_depth * accum_depth, filter_tile);
+    for (int b = 0; b < batches; ++b) {
+      const T* input = input_data + b * accum_depth;
+      for (int c = 0; c < tile_depth; ++c) {
+        const T* filter_values = filter_tile + c * accum_depth;
+        AccType acc = 0;
+        for (int d = 0; d < accum_depth; ++d) {
+          acc += stage.Filter(filter_values[d]) * stage.Input(input[d]);
+        }
+        output_data[b * output_depth + tile_start + c] =
+            stage.Output(acc, tile_start + c);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TfLiteStatus PreparePalettizedWeights(TfLiteContext* context,
+                                      const TfLiteNode* node, int index,
+                                      const TfLiteTensor* tensor,
+                                      const PalettizedWeights** weights) {
+  MicroContext* micro_context = GetMicroContext(context);
+  *weights = nullptr;
+  const QuantizationParameters* quantization =
+      micro_context->GetTensorQuantization(node->inputs->data[index]);
+  if (quantization == nullptr ||
+      quantization->details_type() != QuantizationDetails_CustomQuantization) {
+    return kTfLiteOk;
+  }
+  const auto* custom = quantization->details_as_CustomQuantization()->custom();
+  TF_LITE_ENSURE(context, custom != nullptr);
+  TF_LITE_ENSURE(context, custom->size() >= kPalettizedHeaderBytes);
+
+  if (tensor->type != kTfLiteFloat32 && tensor->type != kTfLiteInt8) {
+    MicroPrintf("Palettized weights are not supported for type %s.",
+                TfLiteTypeGetName(tensor->type));
+    return kTfLiteError;
+  }
+  TF_LITE_ENSURE(context, IsConstantTensor(tensor));
+
+  const uint8_t* header = custom->data();
+  const int index_bits = header[0];
+  const int codebook_size = header[1];
+  const int codebook_count = header[2] | (header[3] << 8);
+  if (index_bits < kMinIndexBits || index_bits > kMaxIndexBits ||
+      codebook_size < 1 || codebook_size > (1 << index_bits)) {
+    MicroPrintf("Palettized weights with %d values of %d bits per codebook are "
+                "not supported.",
+                codebook_size, index_bits);
+    return kTfLiteError;
+  }
+
+  const RuntimeShape shape = GetTensorShape(tensor);
+  int channel_elements = shape.FlatSize();
+  if (codebook_count != 1) {
+    const int quantized_dimension = quantization->quantized_dimension();
+    TF_LITE_ENSURE(context, quantized_dimension >= 0 &&
+                                quantized_dimension < shape.DimensionsCount());
+    TF_LITE_ENSURE_EQ(context, codebook_count,
+                      shape.Dims(quantized_dimension));
+    channel_elements = 1;
+    for (int i = quantized_dimension + 1; i < shape.DimensionsCount(); ++i) {
+      channel_elements *= shape.Dims(i);
+    }
+  }
+  TF_LITE_ENSURE(context, channel_elements > 0);
+
+  size_t type_size;
+  TF_LITE_ENSURE_STATUS(TfLiteTypeSizeOf(tensor->type, &type_size));
+  TF_LITE_ENSURE_EQ(
+      context, custom->size(),
+      kPalettizedHeaderBytes + codebook_count * codebook_size * type_size);
+
+  PalettizedWeights* palettized = static_cast<PalettizedWeights*>(
+      micro_context->AllocatePersistentBuffer(sizeof(PalettizedWeights)));
+  TF_LITE_ENSURE(context, palettized != nullptr);
+  void* codebooks = micro_context->AllocatePersistentBuffer(
+      codebook_count * (1 << index_bits) * type_size);
+  TF_LITE_ENSURE(context, codebooks != nullptr);
+  if (tensor->type == kTfLiteFloat32) {
+    CopyCodebooks(header + kPalettizedHeaderBytes, codebook_count,
+                  codebook_size, index_bits, static_cast<float*>(codebooks));
+  } else {
+    CopyCodebooks(header + kPalettizedHeaderBytes, codebook_count,
+                  codebook_size, index_bits, static_cast<int8_t*>(codebooks));
+  }
+
+  palettized->indices = GetTensorData<uint8_t>(tensor);
+  palettized->codebooks = codebooks;
+  palettized->index_bits = index_bits;
+  palettized->codebook_count = codebook_count;
+  palettized->channel_elements = channel_elements;
+  *weights = palettized;
+  return kTfLiteOk;
+}
+
+size_t PalettizedScratchSize(const RuntimeShape& filter_shape, int channel_dim,
+                             TfLiteType type) {
+  size_t type_size = 0;
+  TfLiteTypeSizeOf(type, &type_size);
+  const int channels = filter_shape.Dims(channel_dim);
+  const int channel_elements = filter_shape.FlatSize() / std::max(channels, 1);
+  return TileChannels(channels, channel_elements, type_size) * type_size *
+         channel_elements;
+}
+
+void DecompressPalettizedWeights(const PalettizedWeights& weights, int start,
+                                 int count, float* output) {
+  Decompress(weights, start, count, output);
+}
+
+void DecompressPalettizedWeights(const PalettizedWeights& weights, int start,
+                                 int count, int8_t* output) {
+  Decompress(weights, start, count, output);
+}
+
+void PalettizedConv(const ConvParams& params, const RuntimeShape& input_shape,
+                    const float* input_data, const RuntimeShape& filter_shape,
+                    const PalettizedWeights& filter,
+                    const RuntimeShape& bias_shape, const float* bias_data,
+                    const RuntimeShape& output_shape, float* output_data,
+                    void* scratch) {
+  const FloatStage stage = {bias_data, params.float_activation_min,
+                            params.float_activation_max};
+  Conv<float, float>(params, stage, input_shape, input_data, filter_shape,
+                     filter, output_shape, output_data,
+                     static_cast<float*>(scratch));
+}
+
+void PalettizedConvPerChannel(
+    const ConvParams& params, const int32_t* output_multiplier,
+    const int32_t* output_shift, const RuntimeShape& input_shape,
+    const int8_t* input_data, const RuntimeShape& filter_shape,
+    const PalettizedWeights& filter, const RuntimeShape& bias_shape,
+    const int32_t* bias_data, const RuntimeShape& output_shape,
+    int8_t* output_data, void* scratch) {
+  const Int8Stage stage = {bias_data,
+                           output_multiplier,
+                           output_shift,
+                           /*per_channel=*/true,
+                           params.input_offset,
+                           /*filter_offset=*/0,
+                           params.output_offset,
+                           params.quantized_activation_min,
+                           params.quantized_activation_max};
+  Conv<int8_t, int32_t>(params, stage, input_shape, input_data, filter_shape,
+                        filter, output_shape, output_data,
+                        static_cast<int8_t*>(scratch));
+}
+
+void PalettizedDepthwiseConv(const DepthwiseParams& params,
+                             const RuntimeShape& input_shape,
+                             const float* input_data,
+                             const RuntimeShape& filter_shape,
+                             const PalettizedWeights& filter,
+                             const RuntimeShape& bias_shape,
+                             const float* bias_data,
+                             const RuntimeShape& output_shape,
+                             float* output_data, void* scratch) {
+  const FloatStage stage = {bias_data, params.float_activation_min,
+                            params.float_activation_max};
+  DepthwiseConv<float, float>(params, stage, input_shape, input_data,
+                              filter_shape, filter, output_shape, output_data,
+                              static_cast<float*>(scratch));
+}
+
+void PalettizedDepthwiseConvPerChannel(
+    const DepthwiseParams& params, const int32_t* output_multiplier,
+    const int32_t* output_shift, const RuntimeShape& input_shape,
+    const int8_t* input_data, const RuntimeShape& filter_shape,
+    const PalettizedWeights& filter, const RuntimeShape& bias_shape,
+    const int32_t* bias_data, const RuntimeShape& output_shape,
+    int8_t* output_data, void* scratch) {
+  const Int8Stage stage = {bias_data,
+                           output_multiplier,
+                           output_shift,
+                           /*per_channel=*/true,
+                           params.input_offset,
+                           /*filter_offset=*/0,
+                           params.output_offset,
+                           params.quantized_activation_min,
+                           params.quantized_activation_max};
+  DepthwiseConv<int8_t, int32_t>(params, stage, input_shape, input_data,
+                                 filter_shape, filter, output_shape,
+                                 output_data, static_cast<int8_t*>(scratch));
+}
+
+void PalettizedFullyConnected(const FullyConnectedParams& params,
+                              const PalettizedWeights& filter, int batches,
+                              int output_depth, int accum_depth,
+                              const float* input_data, const float* bias_data,
+                              float* output_data, void* scratch) {
+  const FloatStage stage = {bias_data, params.float_activation_min,
+                            params.float_activation_max};
+  FullyConnected<float, float>(stage, filter, batches, output_depth,
+                               accum_depth, input_data, output_data,
+                               static_cast<float*>(scratch));
+}
+
+void PalettizedFullyConnected(const FullyConnectedParams& params,
+                              const PalettizedWeights& filter, int batches,
+                              int output_depth, int accum_depth,
+                              const int8_t* input_data,
+                              const int32_t* bias_data, int8_t* output_data,
+                              void* scratch) {
+  const int32_t output_shift = params.output_shift;
+  const Int8Stage stage = {bias_data,
+                           &params.output_multiplier,
+                           &output_shift,
+                           /*per_channel=*/false,
+                           params.input_offset,
+                           params.weights_offset,
+                           params.output_offset,
+                           params.quantized_activation_min,
+                           params.quantized_activation_max};
+  FullyConnected<int8_t, int32_t>(stage, filter, batches, output_depth,
+                                  accum_depth, input_data, output_data,
+                                  static_cast<int8_t*>(scratch));
+}
+
+}  // namespace tflite
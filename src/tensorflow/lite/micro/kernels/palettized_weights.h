@@ -0,0 +1,136 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_PALETTIZED_WEIGHTS_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_PALETTIZED_WEIGHTS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Constant float32 or int8 weights stored as 2 to 4 bit indices into small
+// codebooks of values. The dims and type of the tensor are those of the
+// decompressed weights, and its data holds the indices of all elements in
+// row-major order, packed least significant bit first.
+//
+// The codebooks are stored in the CustomQuantization details of the tensor:
+//   byte 0: number of bits per index, from 2 to 4.
+//   byte 1: number of values in each codebook, at most 1 << bits.
+//   bytes 2-3: number of codebooks as a little-endian uint16. Either 1, or
+//       the size of the quantized dimension, with a codebook per channel.
+//   bytes 4-: the values of the codebooks, one after the other, in the
+//       little-endian encoding of the tensor type.
+// The scale and zero point of int8 weights are stored as usual.
+//
+// The kernels never decompress the whole tensor: they decompress the weights
+// of a few output channels at a time into a scratch buffer of at most
+// kPalettizedTileBytes, unless a single channel is larger, and compute those
+// channels before moving on. They give the same results as the reference
+// kernels on the decompressed weights.
+struct PalettizedWeights {
+  const uint8_t* indices;
+  // Codebooks in the persistent arena, each padded to 1 << index_bits values
+  // so that any index is in range.
+  const void* codebooks;
+  int index_bits;
+  int codebook_count;
+  // Number of consecutive elements that share a codebook.
+  int channel_elements;
+};
+
+constexpr size_t kPalettizedTileBytes = 2048;
+
+// Reads the codebooks of the constant weights `tensor` at input `index` of
+// `node`. Sets `*weights` to nullptr if the weights are not palettized, and
+// otherwise to PalettizedWeights allocated in the persistent arena. Returns an
+// error if the palettization is not supported.
+TfLiteStatus PreparePalettizedWeights(TfLiteContext* context,
+                                      const TfLiteNode* node, int index,
+                                      const TfLiteTensor* tensor,
+                                      const PalettizedWeights** weights);
+
+// Returns the size of the scratch buffer that the kernels need for weights of
+// `filter_shape` and `type`, whose output channels are along `channel_dim`.
+size_t PalettizedScratchSize(const RuntimeShape& filter_shape, int channel_dim,
+                             TfLiteType type);
+
+// Decompresses the `count` weights starting at element `start`.
+void DecompressPalettizedWeights(const PalettizedWeights& weights, int start,
+                                 int count, float* output);
+void DecompressPalettizedWeights(const PalettizedWeights& weights, int start,
+                                 int count, int8_t* output);
+
+// Same as reference_ops::Conv().
+void PalettizedConv(const ConvParams& params, const RuntimeShape& input_shape,
+                    const float* input_data, const RuntimeShape& filter_shape,
+                    const PalettizedWeights& filter,
+                    const RuntimeShape& bias_shape, const float* bias_data,
+                    const RuntimeShape& output_shape, float* output_data,
+                    void* scratch);
+
+// Same as reference_integer_ops::ConvPerChannel() for int8 activations.
+void PalettizedConvPerChannel(
+    const ConvParams& params, const int32_t* output_multiplier,
+    const int32_t* output_shift, const RuntimeShape& input_shape,
+    const int8_t* input_data, const RuntimeShape& filter_shape,
+    const PalettizedWeights& filter, const RuntimeShape& bias_shape,
+    const int32_t* bias_data, const RuntimeShape& output_shape,
+    int8_t* output_data, void* scratch);
+
+// Same as reference_ops::DepthwiseConv() for float.
+void PalettizedDepthwiseConv(const DepthwiseParams& params,
+                             const RuntimeShape& input_shape,
+                             const float* input_data,
+                             const RuntimeShape& filter_shape,
+                             const PalettizedWeights& filter,
+                             const RuntimeShape& bias_shape,
+                             const float* bias_data,
+                             const RuntimeShape& output_shape,
+                             float* output_data, void* scratch);
+
+// Same as reference_integer_ops::DepthwiseConvPerChannel() for int8
+// activations.
+void PalettizedDepthwiseConvPerChannel(
+    const DepthwiseParams& params, const int32_t* output_multiplier,
+    const int32_t* output_shift, const RuntimeShape& input_shape,
+    const int8_t* input_data, const RuntimeShape& filter_shape,
+    const PalettizedWeights& filter, const RuntimeShape& bias_shape,
+    const int32_t* bias_data, const RuntimeShape& output_shape,
+    int8_t* output_data, void* scratch);
+
+// Same as reference_ops::FullyConnected() for a float filter of shape
+// [output_depth, accum_depth].
+void PalettizedFullyConnected(const FullyConnectedParams& params,
+                              const PalettizedWeights& filter, int batches,
+                              int output_depth, int accum_depth,
+                              const float* input_data, const float* bias_data,
+                              float* output_data, void* scratch);
+
+// Same as reference_integer_ops::FullyConnected() for an int8 filter of shape
+// [output_depth, accum_depth].
+void PalettizedFullyConnected(const FullyConnectedParams& params,
+                              const PalettizedWeights& filter, int batches,
+                              int output_depth, int accum_depth,
+                              const int8_t* input_data,
+                              const int32_t* bias_data, int8_t* output_data,
+                              void* scratch);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_PALETTIZED_WEIGHTS_H_
@@ -0,0 +1,88 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_RESIZE_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_RESIZE_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+
+// Source rows or columns of one output row or column of RESIZE_BILINEAR, as
+// computed by reference_ops::ComputeInterpolationValues() for float and by
+// reference_ops::ComputeInterpolationValuesInteger() for int8.
+struct ResizeBilinearTap {
+  int32_t lower;
+  int32_t upper;
+  // Distance of the sampling point from `lower`, in 1/1024 for int8.
+  union {
+    float fraction;
+    int32_t fraction_q10;
+  };
+};
+
+struct OpDataResizeBilinear {
+  // Taps of every output row and column, computed at Prepare.
+  const ResizeBilinearTap* row_taps;
+  const ResizeBilinearTap* col_taps;
+  // Both axes are upsampled 2x with the taps of a plain 2x resize, every
+  // other output then being a source pixel or the mean of two or four.
+  bool upsample_2x;
+};
+
+// Source row or column of every output row and column of
+// RESIZE_NEAREST_NEIGHBOR, computed at Prepare.
+struct OpDataResizeNearestNeighbor {
+  const int32_t* input_rows;
+  const int32_t* input_cols;
+};
+
+// Fills in `data` for resizing `input` to `output`, whose height and width
+// must match the constant `size` tensor.
+TfLiteStatus PrepareResizeBilinear(TfLiteContext* context,
+                                   const TfLiteTensor* input,
+                                   const TfLiteTensor* size,
+                                   const TfLiteTensor* output,
+                                   bool align_corners, bool half_pixel_centers,
+                                   OpDataResizeBilinear* data);
+
+TfLiteStatus PrepareResizeNearestNeighbor(TfLiteContext* context,
+                                          const TfLiteTensor* input,
+                                          const TfLiteTensor* size,
+                                          const TfLiteTensor* output,
+                                          bool align_corners,
+                                          bool half_pixel_centers,
+                                          OpDataResizeNearestNeighbor* data);
+
+// Same results as reference_ops::ResizeBilinear() for float and
+// reference_ops::ResizeBilinearInteger() for int8.
+void EvalResizeBilinearFloat(const OpDataResizeBilinear& data,
+                             const TfLiteEvalTensor* input,
+                             TfLiteEvalTensor* output);
+
+void EvalResizeBilinearInt8(const OpDataResizeBilinear& data,
+                            const TfLiteEvalTensor* input,
+                            TfLiteEvalTensor* output);
+
+// Copies the source pixel of every output pixel, for any element type.
+void EvalResizeNearestNeighbor(const OpDataResizeNearestNeighbor& data,
+                               const TfLiteEvalTensor* input,
+                               TfLiteEvalTensor* output);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_RESIZE_H_
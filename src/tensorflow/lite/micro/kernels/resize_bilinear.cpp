@@ -12,14 +12,13 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
-#include "tensorflow/lite/kernels/internal/reference/resize_bilinear.h"
-
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/op_macros.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/resize.h"
 #include "tensorflow/lite/micro/micro_log.h"
 #include "tensorflow/lite/micro/micro_utils.h"
 
@@ -30,6 +29,13 @@ constexpr int kInputTensor = 0;
 constexpr int kSizeTensor = 1;
 constexpr int kOutputTensor = 0;
 
+void* ResizeBilinearInit(TfLiteContext* context, const char* buffer,
+                         size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return context->AllocatePersistentBuffer(context,
+                                           sizeof(OpDataResizeBilinear));
+}
+
 TfLiteStatus ResizeBilinearPrepare(TfLiteContext* context, TfLiteNode* node) {
   MicroContext* micro_context = GetMicroContext(context);
 
@@ -60,6 +66,16 @@ TfLiteStatus ResizeBilinearPrepare(TfLiteContext* context, TfLiteNode* node) {
     return kTfLiteError;
   }
 
+  TF_LITE_ENSURE(context, input->type == kTfLiteFloat32 ||
+                              input->type == kTfLiteInt8);
+  TFLITE_DCHECK(node->user_data != nullptr);
+  TF_LITE_ENSURE_OK(
+      context,
+      PrepareResizeBilinear(
+          context, input, size, output, params->align_corners,
+          params->half_pixel_centers,
+          static_cast<OpDataResizeBilinear*>(node->user_data)));
+
   micro_context->DeallocateTempTfLiteTensor(input);
   micro_context->DeallocateTempTfLiteTensor(size);
   micro_context->DeallocateTempTfLiteTensor(output);
@@ -67,38 +83,18 @@ TfLiteStatus ResizeBilinearPrepare(TfLiteContext* context, TfLiteNode* node) {
 }
 
 TfLiteStatus ResizeBilinearEval(TfLiteContext* context, TfLiteNode* node) {
-  auto* params =
-      reinterpret_cast<TfLiteResizeBilinearParams*>(node->builtin_data);
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data = *static_cast<const OpDataResizeBilinear*>(node->user_data);
 
   const TfLiteEvalTensor* input =
       tflite::micro::GetEvalInput(context, node, kInputTensor);
-  const TfLiteEvalTensor* size =
-      tflite::micro::GetEvalInput(context, node, kSizeTensor);
   TfLiteEvalTensor* output =
       tflite::micro::GetEvalOutput(context, node, kOutputTensor);
 
   if (output->type == kTfLiteFloat32) {
-    tflite::ResizeBilinearParams op_params;
-    op_params.align_corners = params->align_corners;
-    op_params.half_pixel_centers = params->half_pixel_centers;
-    reference_ops::ResizeBilinear(op_params,
-                                  tflite::micro::GetTensorShape(input),
-                                  tflite::micro::GetTensorData<float>(input),
-                                  tflite::micro::GetTensorShape(size),
-                                  tflite::micro::GetTensorData<int32_t>(size),
-                                  tflite::micro::GetTensorShape(output),
-                                  tflite::micro::GetTensorData<float>(output));
+    EvalResizeBilinearFloat(data, input, output);
   } else if (output->type == kTfLiteInt8) {
-    tflite::ResizeBilinearParams op_params;
-    op_params.align_corners = params->align_corners;
-    op_params.half_pixel_centers = params->half_pixel_centers;
-    reference_ops::ResizeBilinearInteger(
-        op_params, tflite::micro::GetTensorShape(input),
-        tflite::micro::GetTensorData<int8_t>(input),
-        tflite::micro::GetTensorShape(size),
-        tflite::micro::GetTensorData<int32_t>(size),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<int8_t>(output));
+    EvalResizeBilinearInt8(data, input, output);
   } else {
     MicroPrintf("Output type is %d, requires float or int8.", output->type);
     return kTfLiteError;
@@ -110,7 +106,7 @@ TfLiteStatus ResizeBilinearEval(TfLiteContext* context, TfLiteNode* node) {
 }  // namespace
 
 TFLMRegistration Register_RESIZE_BILINEAR() {
-  return tflite::micro::RegisterOp(nullptr, ResizeBilinearPrepare,
+  return tflite::micro::RegisterOp(ResizeBilinearInit, ResizeBilinearPrepare,
                                    ResizeBilinearEval);
 }
 
@@ -0,0 +1,385 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/reference/resize_bilinear.h"
+#include "tensorflow/lite/kernels/internal/reference/resize_nearest_neighbor.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/resize.h"
+
+namespace tflite {
+
+namespace {
+
+// Checks that `output` is `input` resized to the constant `size`, and returns
+// its height and width.
+TfLiteStatus GetResizeOutputSize(TfLiteContext* context,
+                                 const TfLiteTensor* input,
+                                 const TfLiteTensor* size,
+                                 const TfLiteTensor* output, int32_t* height,
+                                 int32_t* width) {
+  TF_LITE_ENSURE_EQ(context, NumDimensions(input), 4);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(output), 4);
+  TF_LITE_ENSURE_EQ(context, NumElements(size), 2);
+  const int32_t* size_data = GetTensorData<int32_t>(size);
+  TF_LITE_ENSURE(context, size_data != nullptr);
+  *height = size_data[0];
+  *width = size_data[1];
+  TF_LITE_ENSURE(context, *height > 0 && *width > 0);
+  TF_LITE_ENSURE_EQ(context, output->dims->data[0], input->dims->data[0]);
+  TF_LITE_ENSURE_EQ(context, output->dims->data[1], *height);
+  TF_LITE_ENSURE_EQ(context, output->dims->data[2], *width);
+  TF_LITE_ENSURE_EQ(context, output->dims->data[3], input->dims->data[3]);
+  return kTfLiteOk;
+}
+
+// Taps of `output_size` positions sampling `input_size` ones, with the scales
+// of reference_ops::ResizeBilinear(), or of
+// reference_ops::ResizeBilinearInteger() if `integer`.
+void ComputeBilinearTaps(int32_t input_size, int32_t output_size,
+                         bool align_corners, bool half_pixel_centers,
+                         bool integer, ResizeBilinearTap* taps) {
+  if (integer) {
+    int32_t scale_10 =
+        ((1 << 10) * input_size + output_size / 2) / output_size;
+    if (align_corners && output_size > 1) {
+      scale_10 = ((1 << 10) * (input_size - 1) + (output_size - 1) / 2) /
+                 (output_size - 1);
+    }
+    for (int i = 0; i < output_size; ++i) {
+      int32_t input_value;
+      reference_ops::ComputeInterpolationValuesInteger(
+          i, scale_10, half_pixel_centers, input_size, &input_value,
+          &taps[i].lower, &taps[i].upper);
+      taps[i].fraction_q10 = input_value - (1 << 10) * taps[i].lower;
+    }
+  } else {
+    float scale = static_cast<float>(input_size) / output_size;
+    if (align_corners && output_size > 1) {
+      scale = static_cast<float>(input_size - 1) / (output_size - 1);
+    }
+    for (int i = 0; i < output_size; ++i) {
+      float input_value;
+      reference_ops::ComputeInterpolationValues(
+          i, scale, half_pixel_centers, input_size, &input_value,
+          &taps[i].lower, &taps[i].upper);
+      taps[i].fraction = input_value - taps[i].lower;
+    }
+  }
+}
+
+// Whether the integer taps are those of a plain 2x upsample: even outputs are
+// source positions, and odd ones are halfway to the next source position.
+bool IsUpsample2x(const ResizeBilinearTap* taps, int32_t input_size,
+                  int32_t output_size) {
+  if (output_size != 2 * input_size) return false;
+  for (int i = 0; i < output_size; ++i) {
+    if (taps[i].lower != i / 2 ||
+        taps[i].upper != std::min(i / 2 + 1, input_size - 1) ||
+        taps[i].fraction_q10 != (i % 2) * (1 << 9)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Divides `x` by 2^shift with the rounding of
+// reference_ops::ResizeBilinearInteger().
+inline int32_t ResizeRoundingShift(int32_t x, int shift) {
+#if TFLITE_SINGLE_ROUNDING
+  return (x + (1 << (shift - 1))) >> shift;
+#else
+  const int32_t round = x > 0 ? (1 << (shift - 1)) : -(1 << (shift - 1));
+  return (x + round) / (1 << shift);
+#endif  // TFLITE_SINGLE_ROUNDING
+}
+
+// A plain 2x upsample, where every output is a source pixel or the rounded
+// mean of two or four of them.
+void ResizeBilinearUpsample2xInt8(const OpDataResizeBilinear& data,
+                                  int32_t batches, int32_t input_height,
+                                  int32_t input_width, int32_t depth,
+                                  const int8_t* input, int8_t* output) {
+  const int32_t input_row_size = input_width * depth;
+  for (int b = 0; b < batches; ++b) {
+    for (int y = 0; y < 2 * input_height; ++y) {
+      const ResizeBilinearTap& row = data.row_taps[y];
+      const int8_t* top = input + row.lower * input_row_size;
+      const int8_t* bottom = input + row.upper * input_row_size;
+      for (int x = 0; x < input_width; ++x) {
+        const int8_t* left_top = top + x * depth;
+        const int8_t* left_bottom = bottom + x * depth;
+        const int32_t right_offset = data.col_taps[2 * x + 1].upper * depth;
+        const int8_t* right_top = top + right_offset;
+        const int8_t* right_bottom = bottom + right_offset;
+        int8_t* even = output;
+        int8_t* odd = output + depth;
+        if (y % 2 == 0) {
+          for (int c = 0; c < depth; ++c) {
+            even[c] = left_top[c];
+            odd[c] = static_cast<int8_t>(
+                ResizeRoundingShift(left_top[c] + right_top[c], 1));
+          }
+        } else {
+          for (int c = 0; c < depth; ++c) {
+            const int32_t left = left_top[c] + left_bottom[c];
+            const int32_t right = right_top[c] + right_bottom[c];
+            even[c] = static_cast<int8_t>(ResizeRoundingShift(left, 1));
+            odd[c] =
+                static_cast<int8_t>(ResizeRoundingShift(left + right, 2));
+          }
+        }
+        output += 2 * depth;
+      }
+    }
+    input += input_height * input_row_size;
+  }
+}
+
+// Copies the source pixel of `count` output pixels, for pixels of the size of
+// PixelType.
+template <typename PixelType>
+void CopyPixels(const uint8_t* input, const int32_t* input_offsets,
+                int32_t count, uint8_t* output) {
+  const PixelType* in = reinterpret_cast<const PixelType*>(input);
+  PixelType* out = reinterpret_cast<PixelType*>(output);
+  for (int x = 0; x < count; ++x) {
+    out[x] = in[input_offsets[x]];
+  }
+}
+
+}  // namespace
+
+TfLiteStatus PrepareResizeBilinear(TfLiteContext* context,
+                                   const TfLiteTensor* input,
+                                   const TfLiteTensor* size,
+                                   const TfLiteTensor* output,
+                                   bool align_corners, bool half_pixel_centers,
+                                   OpDataResizeBilinear* data) {
+  int32_t output_height, output_width;
+  TF_LITE_ENSURE_OK(context,
+                    GetResizeOutputSize(context, input, size, output,
+                                        &output_height, &output_width));
+  const int32_t input_height = input->dims->data[1];
+  const int32_t input_width = input->dims->data[2];
+  const bool integer = input->type != kTfLiteFloat32;
+
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  ResizeBilinearTap* row_taps =
+      static_cast<ResizeBilinearTap*>(context->AllocatePersistentBuffer(
+          context, output_height * sizeof(ResizeBilinearTap)));
+  ResizeBilinearTap* col_taps =
+      static_cast<ResizeBilinearTap*>(context->AllocatePersistentBuffer(
+          context, output_width * sizeof(ResizeBilinearTap)));
+  TF_LITE_ENSURE(context, row_taps != nullptr && col_taps != nullptr);
+  ComputeBilinearTaps(input_height, output_height, align_corners,
+                      half_pixel_centers, integer, row_taps);
+  ComputeBilinearTaps(input_width, output_width, align_corners,
+                      half_pixel_centers, integer, col_taps);
+
+  data->row_taps = row_taps;
+  data->col_taps = col_taps;
+  data->upsample_2x =
+      integer && IsUpsample2x(row_taps, input_height, output_height) &&
+      IsUpsample2x(col_taps, input_width, output_width);
+  return kTfLiteOk;
+}
+
+TfLiteStatus PrepareResizeNearestNeighbor(TfLiteContext* context,
+                                          const TfLiteTensor* input,
+                                          const TfLiteTensor* size,
+                                          const TfLiteTensor* output,
+                                          bool align_corners,
+                                          bool half_pixel_centers,
+                                          OpDataResizeNearestNeighbor* data) {
+  int32_t output_height, output_width;
+  TF_LITE_ENSURE_OK(context,
+                    GetResizeOutputSize(context, input, size, output,
+                                        &output_height, &output_width));
+  const int32_t input_height = input->dims->data[1];
+  const int32_t input_width = input->dims->data[2];
+
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  int32_t* input_rows = static_cast<int32_t*>(context->AllocatePersistentBuffer(
+      context, output_height * sizeof(int32_t)));
+  int32_t* input_cols = static_cast<int32_t*>(context->AllocatePersistentBuffer(
+      context, output_width * sizeof(int32_t)));
+  TF_LITE_ENSURE(context, input_rows != nullptr && input_cols != nullptr);
+  for (int y = 0; y < output_height; ++y) {
+    input_rows[y] = reference_ops::GetNearestNeighbor(
+        y, input_height, output_height, align_corners, half_pixel_centers);
+  }
+  for (int x = 0; x < output_width; ++x) {
+    input_cols[x] = reference_ops::GetNearestNeighbor(
+        x, input_width, output_width, align_corners, half_pixel_centers);
+  }
+
+  data->input_rows = input_rows;
+  data->input_cols = input_cols;
+  return kTfLiteOk;
+}
+
+void EvalResizeBilinearFloat(const OpDataResizeBilinear& data,
+                             const TfLiteEvalTensor* input,
+                             TfLiteEvalTensor* output) {
+  const int32_t batches = input->dims->data[0];
+  const int32_t input_height = input->dims->data[1];
+  const int32_t input_width = input->dims->data[2];
+  const int32_t depth = input->dims->data[3];
+  const int32_t output_height = output->dims->data[1];
+  const int32_t output_width = output->dims->data[2];
+  const int32_t input_row_size = input_width * depth;
+
+  const float* input_data = tflite::micro::GetTensorData<float>(input);
+  float* output_data = tflite::micro::GetTensorData<float>(output);
+  for (int b = 0; b < batches; ++b) {
+    for (int y = 0; y < output_height; ++y) {
+      const ResizeBilinearTap& row = data.row_taps[y];
+      const float* top = input_data + row.lower * input_row_size;
+      const float* bottom = input_data + row.upper * input_row_size;
+      const float dy = row.fraction;
+      const float one_minus_dy = 1 - dy;
+      for (int x = 0; x < output_width; ++x) {
+        const ResizeBilinearTap& col = data.col_taps[x];
+        const float* left_top = top + col.lower * depth;
+        const float* left_bottom = bottom + col.lower * depth;
+        const float* right_top = top + col.upper * depth;
+        const float* right_bottom = bottom + col.upper * depth;
+        const float dx = col.fraction;
+        const float one_minus_dx = 1 - dx;
+        // Same expression as the reference, for the same rounding.
+        for (int c = 0; c < depth; ++c) {
+          output_data[c] = left_top[c] * one_minus_dy * one_minus_dx +
+                           left_bottom[c] * dy * one_minus_dx +
+                           right_top[c] * one_minus_dy * dx +
+                           right_bottom[c] * dy * dx + 0.0f;
+        }
+        output_data += depth;
+      }
+    }
+    input_data += input_height * input_row_size;
+  }
+}
+
+void EvalResizeBilinearInt8(const OpDataResizeBilinear& data,
+                            const TfLiteEvalTensor* input,
+                            TfLiteEvalTensor* output) {
+  const int32_t batches = input->dims->data[0];
+  const int32_t input_height = input->dims->data[1];
+  const int32_t input_width = input->dims->data[2];
+  const int32_t depth = input->dims->data[3];
+  const int32_t output_height = output->dims->data[1];
+  const int32_t output_width = output->dims->data[2];
+  const int32_t input_row_size = input_width * depth;
+
+  const int8_t* input_data = tflite::micro::GetTensorData<int8_t>(input);
+  int8_t* output_data = tflite::micro::GetTensorData<int8_t>(output);
+  if (data.upsample_2x) {
+    ResizeBilinearUpsample2xInt8(data, batches, input_height, input_width,
+                                 depth, input_data, output_data);
+    return;
+  }
+
+  // The weights of the four source pixels sum to 2^20, and a fraction is at
+  // least -2^9 with half-pixel centers, so the sums fit in 32 bits.
+  for (int b = 0; b < batches; ++b) {
+    for (int y = 0; y < output_height; ++y) {
+      const ResizeBilinearTap& row = data.row_taps[y];
+      const int8_t* top = input_data + row.lower * input_row_size;
+      const int8_t* bottom = input_data + row.upper * input_row_size;
+      const int32_t dy = row.fraction_q10;
+      for (int x = 0; x < output_width; ++x) {
+        const ResizeBilinearTap& col = data.col_taps[x];
+        const int8_t* left_top = top + col.lower * depth;
+        const int8_t* left_bottom = bottom + col.lower * depth;
+        const int8_t* right_top = top + col.upper * depth;
+        const int8_t* right_bottom = bottom + col.upper * depth;
+        const int32_t dx = col.fraction_q10;
+        const int32_t w_left_top = ((1 << 10) - dy) * ((1 << 10) - dx);
+        const int32_t w_left_bottom = dy * ((1 << 10) - dx);
+        const int32_t w_right_top = ((1 << 10) - dy) * dx;
+        const int32_t w_right_bottom = dy * dx;
+        for (int c = 0; c < depth; ++c) {
+          const int32_t output_20 =
+              left_top[c] * w_left_top + left_bottom[c] * w_left_bottom +
+              right_top[c] * w_right_top + right_bottom[c] * w_right_bottom;
+          output_data[c] =
+              static_cast<int8_t>(ResizeRoundingShift(output_20, 20));
+        }
+        output_data += depth;
+      }
+    }
+    input_data += input_height * input_row_size;
+  }
+}
+
+void EvalResizeNearestNeighbor(const OpDataResizeNearestNeighbor& data,
+                               const TfLiteEvalTensor* input,
+                               TfLiteEvalTensor* output) {
+  const int32_t batches = input->dims->data[0];
+  const int32_t input_height = input->dims->data[1];
+  const int32_t input_width = input->dims->data[2];
+  const int32_t depth = input->dims->data[3];
+  const int32_t output_height = output->dims->data[1];
+  const int32_t output_width = output->dims->data[2];
+  const size_t pixel_bytes = depth * TfLiteTypeGetSize(input->type);
+  const size_t input_row_bytes = input_width * pixel_bytes;
+  const size_t output_row_bytes = output_width * pixel_bytes;
+
+  const uint8_t* input_data = tflite::micro::GetTensorData<uint8_t>(input);
+  uint8_t* output_data = tflite::micro::GetTensorData<uint8_t>(output);
+  for (int b = 0; b < batches; ++b) {
+    for (int y = 0; y < output_height; ++y) {
+      // Upsampled rows repeat the output row above them.
+      if (y > 0 && data.input_rows[y] == data.input_rows[y - 1]) {
+        std::memcpy(output_data, output_data - output_row_bytes,
+                    output_row_bytes);
+        output_data += output_row_bytes;
+        continue;
+      }
+      const uint8_t* row = input_data + data.input_rows[y] * input_row_bytes;
+      switch (pixel_bytes) {
+        case 1:
+          CopyPixels<uint8_t>(row, data.input_cols, output_width,
+                              output_data);
+          break;
+        case 2:
+          CopyPixels<uint16_t>(row, data.input_cols, output_width,
+                               output_data);
+          break;
+        case 4:
+          CopyPixels<uint32_t>(row, data.input_cols, output_width,
+                               output_data);
+          break;
+        default:
+          for (int x = 0; x < output_width; ++x) {
+            std::memcpy(output_data + x * pixel_bytes,
+                        row + data.input_cols[x] * pixel_bytes, pixel_bytes);
+          }
+          break;
+      }
+      output_data += output_row_bytes;
+    }
+    input_data += input_height * input_row_bytes;
+  }
+}
+
+}  // namespace tflite
@@ -13,14 +13,13 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
-#include "tensorflow/lite/kernels/internal/reference/resize_nearest_neighbor.h"
-
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/op_macros.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/resize.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
@@ -31,6 +30,13 @@ constexpr int kInputTensor = 0;
 constexpr int kSizeTensor = 1;
 constexpr int kOutputTensor = 0;
 
+void* ResizeNearestNeighborInit(TfLiteContext* context, const char* buffer,
+                                size_t length) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return context->AllocatePersistentBuffer(
+      context, sizeof(OpDataResizeNearestNeighbor));
+}
+
 TfLiteStatus ResizeNearestNeighborPrepare(TfLiteContext* context,
                                           TfLiteNode* node) {
   MicroContext* micro_context = GetMicroContext(context);
@@ -59,6 +65,22 @@ TfLiteStatus ResizeNearestNeighborPrepare(TfLiteContext* context,
     return kTfLiteError;
   }
 
+  if (output->type != kTfLiteFloat32 && output->type != kTfLiteInt8 &&
+      output->type != kTfLiteInt16) {
+    MicroPrintf("Output tensor type %s (%d) not supported.",
+                TfLiteTypeGetName(output->type), output->type);
+    return kTfLiteError;
+  }
+
+  auto* params =
+      reinterpret_cast<TfLiteResizeNearestNeighborParams*>(node->builtin_data);
+  TFLITE_DCHECK(node->user_data != nullptr);
+  TF_LITE_ENSURE_OK(
+      context, PrepareResizeNearestNeighbor(
+                   context, input, size, output, params->align_corners,
+                   /*half_pixel_centers=*/false,
+                   static_cast<OpDataResizeNearestNeighbor*>(node->user_data)));
+
   micro_context->DeallocateTempTfLiteTensor(input);
   micro_context->DeallocateTempTfLiteTensor(size);
   micro_context->DeallocateTempTfLiteTensor(output);
@@ -68,58 +90,25 @@ TfLiteStatus ResizeNearestNeighborPrepare(TfLiteContext* context,
 
 TfLiteStatus ResizeNearestNeighborEval(TfLiteContext* context,
                                        TfLiteNode* node) {
-  auto* params =
-      reinterpret_cast<TfLiteResizeNearestNeighborParams*>(node->builtin_data);
+  TFLITE_DCHECK(node->user_data != nullptr);
+  const auto& data =
+      *static_cast<const OpDataResizeNearestNeighbor*>(node->user_data);
 
   const TfLiteEvalTensor* input =
       tflite::micro::GetEvalInput(context, node, kInputTensor);
-  const TfLiteEvalTensor* size =
-      tflite::micro::GetEvalInput(context, node, kSizeTensor);
   TfLiteEvalTensor* output =
       tflite::micro::GetEvalOutput(context, node, kOutputTensor);
 
-  tflite::ResizeNearestNeighborParams op_params;
-  op_params.align_corners = params->align_corners;
-  op_params.half_pixel_centers = false;
-
-  if (output->type == kTfLiteFloat32) {
-    reference_ops::ResizeNearestNeighbor(
-        op_params, tflite::micro::GetTensorShape(input),
-        tflite::micro::GetTensorData<int32_t>(input),
-        tflite::micro::GetTensorShape(size),
-        tflite::micro::GetTensorData<int32_t>(size),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<int32_t>(output));
-  } else if (output->type == kTfLiteInt8) {
-    reference_ops::ResizeNearestNeighbor(
-        op_params, tflite::micro::GetTensorShape(input),
-        tflite::micro::GetTensorData<int8_t>(input),
-        tflite::micro::GetTensorShape(size),
-        tflite::micro::GetTensorData<int32_t>(size),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<int8_t>(output));
-  } else if (output->type == kTfLiteInt16) {
-    reference_ops::ResizeNearestNeighbor(
-        op_params, tflite::micro::GetTensorShape(input),
-        tflite::micro::GetTensorData<int16_t>(input),
-        tflite::micro::GetTensorShape(size),
-        tflite::micro::GetTensorData<int32_t>(size),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<int16_t>(output));
-  } else {
-    MicroPrintf("Output tensor type %s (%d) not supported.",
-                TfLiteTypeGetName(output->type), output->type);
-
-    return kTfLiteError;
-  }
-
+  // Float, int8 and int16 are all copied as raw pixels.
+  EvalResizeNearestNeighbor(data, input, output);
   return kTfLiteOk;
 }
 
 }  // namespace
 
 TFLMRegistration Register_RESIZE_NEAREST_NEIGHBOR() {
-  return tflite::micro::RegisterOp(nullptr, ResizeNearestNeighborPrepare,
+  return tflite::micro::RegisterOp(ResizeNearestNeighborInit,
+                                   ResizeNearestNeighborPrepare,
                                    ResizeNearestNeighborEval);
 }
 
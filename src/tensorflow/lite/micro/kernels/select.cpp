@@ -17,9 +17,13 @@ limitations under the License.
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
+#include <cstring>
+
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/binary_broadcast.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
@@ -33,6 +37,10 @@ constexpr int kOutputTensor = 0;
 
 struct OpData {
   bool requires_broadcast;
+  // Whether 'x' and 'y' have the same shape. They then broadcast against
+  // 'condition' together, as the second input of `broadcast`.
+  bool same_shape_branches;
+  BinaryBroadcastShape broadcast;
 };
 
 void* SelectInit(TfLiteContext* context, const char* buffer, size_t length) {
@@ -40,6 +48,7 @@ void* SelectInit(TfLiteContext* context, const char* buffer, size_t length) {
   auto* data = static_cast<OpData*>(
       context->AllocatePersistentBuffer(context, sizeof(OpData)));
   data->requires_broadcast = false;
+  data->same_shape_branches = false;
   return data;
 }
 
@@ -113,6 +122,12 @@ TfLiteStatus SelectPrepare(TfLiteContext* context, TfLiteNode* node) {
     data->requires_broadcast = true;
   }
 
+  data->same_shape_branches = HaveSameShapes(input_x, input_y);
+  if (data->same_shape_branches) {
+    TF_LITE_ENSURE_STATUS(PrepareBinaryBroadcast(context, input_condition,
+                                                 input_x, &data->broadcast));
+  }
+
   micro_context->DeallocateTempTfLiteTensor(input_condition);
   micro_context->DeallocateTempTfLiteTensor(input_x);
   micro_context->DeallocateTempTfLiteTensor(input_y);
@@ -121,14 +136,67 @@ TfLiteStatus SelectPrepare(TfLiteContext* context, TfLiteNode* node) {
   return kTfLiteOk;
 }
 
+// Selects `size` contiguous outputs. A stride of 0 repeats the first value of
+// `condition`, or of both `x` and `y`.
 template <typename T>
-void CallSelect(const TfLiteEvalTensor* input_condition,
+void SelectRow(int size, const bool* condition, int condition_stride,
+               const T* x, const T* y, int branch_stride, T* output) {
+  if (condition_stride == 0) {
+    const T* selected = *condition ? x : y;
+    if (branch_stride == 0) {
+      std::fill(output, output + size, *selected);
+    } else {
+      std::memcpy(output, selected, size * sizeof(T));
+    }
+  } else if (branch_stride == 0) {
+    const T x_value = *x;
+    const T y_value = *y;
+    for (int i = 0; i < size; ++i) {
+      output[i] = condition[i] ? x_value : y_value;
+    }
+  } else {
+    for (int i = 0; i < size; ++i) {
+      output[i] = condition[i] ? x[i] : y[i];
+    }
+  }
+}
+
+template <typename T>
+T* SelectDims(const BinaryBroadcastShape& shape, int dim,
+              const bool* condition, const T* x, const T* y, T* output) {
+  const int size = shape.output_shape[dim];
+  if (dim == 0) {
+    SelectRow(size, condition, shape.input1_stride[0], x, y,
+              shape.input2_stride[0], output);
+    return output + size;
+  }
+  const int condition_stride = shape.input1_stride[dim];
+  const int branch_stride = shape.input2_stride[dim];
+  for (int i = 0; i < size; ++i) {
+    output = SelectDims(shape, dim - 1, condition + i * condition_stride,
+                        x + i * branch_stride, y + i * branch_stride, output);
+  }
+  return output;
+}
+
+template <typename T>
+void CallSelect(const OpData* data, const TfLiteEvalTensor* input_condition,
                 const TfLiteEvalTensor* input_x,
-                const TfLiteEvalTensor* input_y, TfLiteEvalTensor* output,
-                bool need_broadcast) {
+                const TfLiteEvalTensor* input_y, TfLiteEvalTensor* output) {
+  if (data->same_shape_branches) {
+    if (data->broadcast.pattern != BroadcastPattern::kEmpty) {
+      SelectDims(data->broadcast, data->broadcast.dims - 1,
+                 tflite::micro::GetTensorData<bool>(input_condition),
+                 tflite::micro::GetTensorData<T>(input_x),
+                 tflite::micro::GetTensorData<T>(input_y),
+                 tflite::micro::GetTensorData<T>(output));
+    }
+    return;
+  }
+
   using Func = decltype(reference_ops::Select<bool, T>)*;
   Func select_func;
-  if (need_broadcast) {
+  if (data->requires_broadcast) {
     select_func = reference_ops::BroadcastSelect5DSlow<bool, T>;
   } else {
     select_func = reference_ops::Select<bool, T>;
@@ -161,16 +229,13 @@ TfLiteStatus SelectEval(TfLiteContext* context, TfLiteNode* node) {
 
   switch (input_x->type) {
     case kTfLiteFloat32:
-      CallSelect<float>(input_condition, input_x, input_y, output,
-                        data->requires_broadcast);
+      CallSelect<float>(data, input_condition, input_x, input_y, output);
       break;
     case kTfLiteInt8:
-      CallSelect<int8_t>(input_condition, input_x, input_y, output,
-                         data->requires_broadcast);
+      CallSelect<int8_t>(data, input_condition, input_x, input_y, output);
       break;
     case kTfLiteInt16:
-      CallSelect<int16_t>(input_condition, input_x, input_y, output,
-                          data->requires_broadcast);
+      CallSelect<int16_t>(data, input_condition, input_x, input_y, output);
       break;
     default:
       MicroPrintf("Does not support type other than %s, but got %s",
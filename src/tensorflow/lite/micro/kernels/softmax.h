@@ -32,6 +32,12 @@ TfLiteStatus CalculateSoftmaxParams(TfLiteContext* context,
 
 TfLiteStatus SoftmaxPrepare(TfLiteContext* context, TfLiteNode* node);
 
+// Float softmax over the last dimension. With TF_LITE_USE_POLYNOMIAL_MATH the
+// exponentials of each row are computed by one vectorized call.
+void SoftmaxFloat(const SoftmaxParams& params, const RuntimeShape& input_shape,
+                  const float* input_data, const RuntimeShape& output_shape,
+                  float* output_data);
+
 // This is the most generic TFLMRegistration. The actual supported types
 // may still be target dependent. The only requirement is that every
 // implementation (reference or optimized) must define this function.
@@ -13,12 +13,17 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
+#include <limits>
+
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/common.h"
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
+#include "tensorflow/lite/kernels/internal/reference/softmax.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/op_macros.h"
+#include "tensorflow/lite/micro/kernels/float_math.h"
 #include "tensorflow/lite/micro/kernels/softmax.h"
 #include "tensorflow/lite/micro/micro_context.h"
 
@@ -137,6 +142,42 @@ TfLiteStatus CalculateSoftmaxParams(TfLiteContext* context,
   return kTfLiteOk;
 }
 
+void SoftmaxFloat(const SoftmaxParams& params, const RuntimeShape& input_shape,
+                  const float* input_data, const RuntimeShape& output_shape,
+                  float* output_data) {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+  const int trailing_dim = input_shape.DimensionsCount() - 1;
+  const int outer_size =
+      MatchingFlatSizeSkipDim(input_shape, trailing_dim, output_shape);
+  const int depth =
+      MatchingDim(input_shape, trailing_dim, output_shape, trailing_dim);
+  const float beta = static_cast<float>(params.beta);
+
+  for (int i = 0; i < outer_size; ++i) {
+    const float* input_row = input_data + i * depth;
+    float* output_row = output_data + i * depth;
+    float max = std::numeric_limits<float>::lowest();
+    for (int c = 0; c < depth; ++c) {
+      max = std::max(max, input_row[c]);
+    }
+    for (int c = 0; c < depth; ++c) {
+      output_row[c] = (input_row[c] - max) * beta;
+    }
+    float_math::ApplyExpToVector(output_row, depth, output_row);
+    float sum = 0.f;
+    for (int c = 0; c < depth; ++c) {
+      sum += output_row[c];
+    }
+    for (int c = 0; c < depth; ++c) {
+      output_row[c] = output_row[c] / sum;
+    }
+  }
+#else
+  reference_ops::Softmax(params, input_shape, input_data, output_shape,
+                         output_data);
+#endif
+}
+
 void* SoftmaxInit(TfLiteContext* context, const char* buffer, size_t length) {
   TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
   return context->AllocatePersistentBuffer(context, sizeof(SoftmaxParams));
@@ -0,0 +1,261 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/sparse_fully_connected.h"
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/micro/micro_context.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+
+namespace {
+
+// Dimensions of the sparsity metadata of a 2D tensor with 2D blocks: rows and
+// block columns, then the rows and columns within a block.
+constexpr int kBlockSparseDims = 4;
+
+// Copies a sparse index array stored as uint8 or uint16 to int32 values in
+// the persistent arena.
+template <typename T>
+const int32_t* WidenSparseIndices(MicroContext* micro_context,
+                                  const flatbuffers::Vector<T>* values) {
+  int32_t* widened =
+      static_cast<int32_t*>(micro_context->AllocatePersistentBuffer(
+          values->size() * sizeof(int32_t)));
+  if (widened == nullptr) {
+    return nullptr;
+  }
+  for (uint32_t i = 0; i < values->size(); ++i) {
+    widened[i] = values->Get(i);
+  }
+  return widened;
+}
+
+// Returns the sparse index array `vector` of `type` as int32 values and sets
+// `size` to its length, or returns nullptr on failure.
+const int32_t* GetSparseIndices(MicroContext* micro_context,
+                                SparseIndexVector type, const void* vector,
+                                int* size) {
+  switch (type) {
+    case SparseIndexVector_Int32Vector: {
+      const auto* values = static_cast<const Int32Vector*>(vector)->values();
+      if (values == nullptr) {
+        return nullptr;
+      }
+      *size = values->size();
+      return values->data();
+    }
+    case SparseIndexVector_Uint16Vector: {
+      const auto* values = static_cast<const Uint16Vector*>(vector)->values();
+      if (values == nullptr) {
+        return nullptr;
+      }
+      *size = values->size();
+      return WidenSparseIndices(micro_context, values);
+    }
+    case SparseIndexVector_Uint8Vector: {
+      const auto* values = static_cast<const Uint8Vector*>(vector)->values();
+      if (values == nullptr) {
+        return nullptr;
+      }
+      *size = values->size();
+      return WidenSparseIndices(micro_context, values);
+    }
+    default:
+      return nullptr;
+  }
+}
+
+bool IsDenseDimension(const DimensionMetadata* metadata, int dense_size) {
+  return metadata->format() == DimensionType_DENSE &&
+         metadata->dense_size() == dense_size;
+}
+
+}  // namespace
+
+TfLiteStatus PrepareBlockSparseWeights(TfLiteContext* context,
+                                       const TfLiteNode* node, int index,
+                                       TfLiteType type, int rows, int cols,
+                                       const BlockSparseWeights** weights) {
+  MicroContext* micro_context = GetMicroContext(context);
+  *weights = nullptr;
+  const SparsityParameters* sparsity =
+      micro_context->GetTensorSparsity(node->inputs->data[index]);
+  if (sparsity == nullptr) {
+    return kTfLiteOk;
+  }
+
+  if (type != kTfLiteFloat32 && type != kTfLiteInt8) {
+    MicroPrintf("Sparse weights are not supported for type %s.",
+                TfLiteTypeGetName(type));
+    return kTfLiteError;
+  }
+  const auto* dim_metadata = sparsity->dim_metadata();
+  if (dim_metadata == nullptr || dim_metadata->size() != kBlockSparseDims) {
+    MicroPrintf("Only block-sparse 2D weights are supported.");
+    return kTfLiteError;
+  }
+  const auto* traversal_order = sparsity->traversal_order();
+  if (traversal_order != nullptr) {
+    for (uint32_t i = 0; i < traversal_order->size(); ++i) {
+      TF_LITE_ENSURE_EQ(context, traversal_order->Get(i),
+                        static_cast<int32_t>(i));
+    }
+  }
+
+  const int block_cols = type == kTfLiteInt8 ? kSparseInt8BlockCols
+                                             : kSparseFloatBlockCols;
+  if (!IsDenseDimension(dim_metadata->Get(2), 1) ||
+      !IsDenseDimension(dim_metadata->Get(3), block_cols) ||
+      cols % block_cols != 0) {
+    MicroPrintf("Sparse %s weights must use 1x%d blocks.",
+                TfLiteTypeGetName(type), block_cols);
+    return kTfLiteError;
+  }
+  const DimensionMetadata* row_metadata = dim_metadata->Get(0);
+  const DimensionMetadata* block_metadata = dim_metadata->Get(1);
+  TF_LITE_ENSURE(context, IsDenseDimension(row_metadata, rows));
+  TF_LITE_ENSURE_EQ(context, block_metadata->format(),
+                    DimensionType_SPARSE_CSR);
+
+  BlockSparseWeights* sparse_weights = static_cast<BlockSparseWeights*>(
+      micro_context->AllocatePersistentBuffer(sizeof(BlockSparseWeights)));
+  TF_LITE_ENSURE(context, sparse_weights != nullptr);
+  int segment_count = 0;
+  int block_count = 0;
+  sparse_weights->segments = GetSparseIndices(
+      micro_context, block_metadata->array_segments_type(),
+      block_metadata->array_segments(), &segment_count);
+  sparse_weights->indices = GetSparseIndices(
+      micro_context, block_metadata->array_indices_type(),
+      block_metadata->array_indices(), &block_count);
+  sparse_weights->block_cols = block_cols;
+  TF_LITE_ENSURE(context, sparse_weights->segments != nullptr);
+  TF_LITE_ENSURE(context, sparse_weights->indices != nullptr);
+
+  // The kernels trust the indices, so check them once here.
+  TF_LITE_ENSURE_EQ(context, segment_count, rows + 1);
+  TF_LITE_ENSURE_EQ(context, sparse_weights->segments[0], 0);
+  TF_LITE_ENSURE_EQ(context, sparse_weights->segments[rows], block_count);
+  for (int row = 0; row < rows; ++row) {
+    TF_LITE_ENSURE(context, sparse_weights->segments[row] <=
+                                sparse_weights->segments[row + 1]);
+  }
+  for (int i = 0; i < block_count; ++i) {
+    TF_LITE_ENSURE(context, sparse_weights->indices[i] >= 0 &&
+                                sparse_weights->indices[i] < cols / block_cols);
+  }
+
+  *weights = sparse_weights;
+  return kTfLiteOk;
+}
+
+bool IsSparse2Of4(const int8_t* weights, int rows, int cols) {
+  if (weights == nullptr || cols % kSparse2Of4Group != 0) {
+    return false;
+  }
+  for (int i = 0; i < rows * cols; i += kSparse2Of4Group) {
+    int non_zeros = 0;
+    for (int j = 0; j < kSparse2Of4Group; ++j) {
+      non_zeros += weights[i + j] != 0;
+    }
+    if (non_zeros > 2) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SparseFullyConnected(const FullyConnectedParams& params,
+                          const BlockSparseWeights& weights, int batches,
+                          int output_depth, int accum_depth,
+                          const float* input_data, const float* filter_data,
+                          const float* bias_data, float* output_data) {
+  TFLITE_DCHECK_EQ(weights.block_cols, kSparseFloatBlockCols);
+  constexpr int kBlockCols = kSparseFloatBlockCols;
+  for (int b = 0; b < batches; ++b) {
+    const float* input = input_data + b * accum_depth;
+    const float* filter = filter_data;
+    for (int out_c = 0; out_c < output_depth; ++out_c) {
+      // One partial sum per column of the block, so that the products of a
+      // block can be computed as a single vector operation.
+      float block_sum[kBlockCols] = {};
+      for (int i = weights.segments[out_c]; i < weights.segments[out_c + 1];
+           ++i) {
+        const float* input_block = input + weights.indices[i] * kBlockCols;
+        for (int c = 0; c < kBlockCols; ++c) {
+          block_sum[c] += filter[c] * input_block[c];
+        }
+        filter += kBlockCols;
+      }
+      float total =
+          (block_sum[0] + block_sum[1]) + (block_sum[2] + block_sum[3]);
+      if (bias_data != nullptr) {
+        total += bias_data[out_c];
+      }
+      output_data[b * output_depth + out_c] = ActivationFunctionWithMinMax(
+          total, params.float_activation_min, params.float_activation_max);
+    }
+  }
+}
+
+void SparseFullyConnected(const FullyConnectedParams& params,
+                          const BlockSparseWeights& weights, int batches,
+                          int output_depth, int accum_depth,
+                          const int8_t* input_data, const int8_t* filter_data,
+                          const int32_t* bias_data, int8_t* output_data) {
+  TFLITE_DCHECK_EQ(weights.block_cols, kSparseInt8BlockCols);
+  TFLITE_DCHECK_EQ(params.weights_offset, 0);
+  constexpr int kBlockCols = kSparseInt8BlockCols;
+  for (int b = 0; b < batches; ++b) {
+    const int8_t* input = input_data + b * accum_depth;
+    const int8_t* filter = filter_data;
+    for (int out_c = 0; out_c < output_depth; ++out_c) {
+      // One partial sum per column of the block, reduced once per row. The
+      // input offset is applied to the weight sums, which keeps the products
+      // within 16 bits.
+      int32_t block_sum[kBlockCols] = {};
+      int32_t weight_sum[kBlockCols] = {};
+      for (int i = weights.segments[out_c]; i < weights.segments[out_c + 1];
+           ++i) {
+        const int8_t* input_block = input + weights.indices[i] * kBlockCols;
+        for (int c = 0; c < kBlockCols; ++c) {
+          block_sum[c] += filter[c] * input_block[c];
+          weight_sum[c] += filter[c];
+        }
+        filter += kBlockCols;
+      }
+      int32_t acc = bias_data != nullptr ? bias_data[out_c] : 0;
+      for (int c = 0; c < kBlockCols; ++c) {
+        acc += block_sum[c] + weight_sum[c] * params.input_offset;
+      }
+      acc = MultiplyByQuantizedMultiplier(acc, params.output_multiplier,
+                                          params.output_shift) +
+            params.output_offset;
+      output_data[b * output_depth + out_c] =
+          static_cast<int8_t>(ActivationFunctionWithMinMax(
+              acc, params.quantized_activation_min,
+              params.quantized_activation_max));
+    }
+  }
+}
+
+}  // namespace tflite
@@ -0,0 +1,84 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_SPARSE_FULLY_CONNECTED_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_SPARSE_FULLY_CONNECTED_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/types.h"
+
+namespace tflite {
+
+// Constant [rows, cols] weights in the block compressed sparse row format that
+// the TFLite converter writes: the dense dimension 0 holds the rows, the
+// sparse dimension 1 the blocks of 1 x block_cols values, and the tensor data
+// holds the values of the non-zero blocks, row by row. The blocks of `row` are
+// segments[row] to segments[row + 1] - 1, and indices[i] is the block column
+// of block i.
+struct BlockSparseWeights {
+  const int32_t* segments;
+  const int32_t* indices;
+  int block_cols;
+};
+
+// Block sizes of the block-sparse kernels, which are those the TFLite
+// converter uses for float and int8 weights.
+constexpr int kSparseFloatBlockCols = 4;
+constexpr int kSparseInt8BlockCols = 16;
+
+// Number of consecutive weights of a row in which 2:4 structured-sparse weights
+// have at most 2 non-zero values.
+constexpr int kSparse2Of4Group = 4;
+
+// Reads the sparsity parameters of the [rows, cols] constant weights at input
+// `index` of `node`. Sets `*weights` to nullptr if the weights are dense, and
+// otherwise to a BlockSparseWeights allocated in the persistent arena. Sparse
+// index arrays stored as uint8 or uint16 are widened to int32 there. Returns
+// an error if the weights use a sparse format that the kernels for `type`
+// do not support.
+TfLiteStatus PrepareBlockSparseWeights(TfLiteContext* context,
+                                       const TfLiteNode* node, int index,
+                                       TfLiteType type, int rows, int cols,
+                                       const BlockSparseWeights** weights);
+
+// Returns true if the dense int8 [rows, cols] `weights` are 2:4 structured
+// sparse, as produced by N:M pruning: `cols` is a multiple of kSparse2Of4Group
+// and every group of kSparse2Of4Group consecutive weights of a row has at most
+// 2 non-zero values.
+bool IsSparse2Of4(const int8_t* weights, int rows, int cols);
+
+// Same as reference_ops::FullyConnected() for a float filter of shape
+// [output_depth, accum_depth] with block-sparse `weights`, up to rounding: the
+// products are summed per block column first.
+void SparseFullyConnected(const FullyConnectedParams& params,
+                          const BlockSparseWeights& weights, int batches,
+                          int output_depth, int accum_depth,
+                          const float* input_data, const float* filter_data,
+                          const float* bias_data, float* output_data);
+
+// Same as reference_integer_ops::FullyConnected() for an int8 filter of shape
+// [output_depth, accum_depth] with block-sparse `weights`. The filter must be
+// symmetrically quantized.
+void SparseFullyConnected(const FullyConnectedParams& params,
+                          const BlockSparseWeights& weights, int batches,
+                          int output_depth, int accum_depth,
+                          const int8_t* input_data, const int8_t* filter_data,
+                          const int32_t* bias_data, int8_t* output_data);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_SPARSE_FULLY_CONNECTED_H_
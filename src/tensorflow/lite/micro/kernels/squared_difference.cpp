@@ -13,10 +13,10 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
 #include "tensorflow/lite/kernels/internal/quantization_util.h"
-#include "tensorflow/lite/kernels/internal/reference/binary_function.h"
-#include "tensorflow/lite/kernels/internal/reference/integer_ops/add.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/binary_broadcast.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_context.h"
 #include "tensorflow/lite/micro/micro_log.h"
@@ -28,7 +28,7 @@ constexpr int kInputTensor2 = 1;
 constexpr int kOutputTensor = 0;
 
 struct OpData {
-  bool requires_broadcast;
+  BinaryBroadcastShape broadcast;
   ArithmeticParams arithmetic_params;
 };
 
@@ -86,7 +86,6 @@ TfLiteStatus SquaredDifferencePrepare(TfLiteContext* context,
                                       TfLiteNode* node) {
   TFLITE_DCHECK(node->user_data != nullptr);
   OpData* data = reinterpret_cast<OpData*>(node->user_data);
-  data->requires_broadcast = false;
 
   TF_LITE_ENSURE_EQ(context, NumInputs(node), 2);
   TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
@@ -145,7 +144,8 @@ TfLiteStatus SquaredDifferencePrepare(TfLiteContext* context,
                      /*quantized_activation_max*/ integer_type_max, data);
   }
 
-  data->requires_broadcast = !HaveSameShapes(input1, input2);
+  TF_LITE_ENSURE_STATUS(
+      PrepareBinaryBroadcast(context, input1, input2, &data->broadcast));
 
   micro_context->DeallocateTempTfLiteTensor(input1);
   micro_context->DeallocateTempTfLiteTensor(input2);
@@ -185,25 +185,13 @@ void EvalQuantizedSquaredDifference(TfLiteContext* context, TfLiteNode* node,
                                     const TfLiteEvalTensor* input1,
                                     const TfLiteEvalTensor* input2,
                                     TfLiteEvalTensor* output) {
-  const auto* op_data = static_cast<const OpData*>(node->user_data);
-  if (data->requires_broadcast) {
-    reference_integer_ops::BroadcastBinaryFunction4DSlow(
-        op_data->arithmetic_params, tflite::micro::GetTensorShape(input1),
-        tflite::micro::GetTensorData<T>(input1),
-        tflite::micro::GetTensorShape(input2),
-        tflite::micro::GetTensorData<T>(input2),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<T>(output),
-        reference_integer_ops::CheckArithmeticParams, SquaredDifference);
-  } else {
-    const int flat_size = tflite::micro::GetTensorShape(input1).FlatSize();
-    reference_integer_ops::ElementWise(
-        flat_size, op_data->arithmetic_params,
-        tflite::micro::GetTensorData<T>(input1),
-        tflite::micro::GetTensorData<T>(input2),
-        tflite::micro::GetTensorData<T>(output),
-        reference_integer_ops::CheckArithmeticParams, SquaredDifference);
-  }
+  const ArithmeticParams params = data->arithmetic_params;
+  BinaryBroadcast(data->broadcast, tflite::micro::GetTensorData<T>(input1),
+                  tflite::micro::GetTensorData<T>(input2),
+                  tflite::micro::GetTensorData<T>(output),
+                  [params](T x, T y) {
+                    return SquaredDifference(x, y, params);
+                  });
 }
 
 template <typename T>
@@ -211,23 +199,10 @@ void EvalSquaredDifference(TfLiteContext* context, TfLiteNode* node,
                            const OpData* data, const TfLiteEvalTensor* input1,
                            const TfLiteEvalTensor* input2,
                            TfLiteEvalTensor* output) {
-  if (data->requires_broadcast) {
-    reference_ops::BroadcastBinaryFunction4DSlow<T, T, T>(
-        tflite::micro::GetTensorShape(input1),
-        tflite::micro::GetTensorData<T>(input1),
-        tflite::micro::GetTensorShape(input2),
-        tflite::micro::GetTensorData<T>(input2),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<T>(output), SquaredDifference<T>);
-  } else {
-    reference_ops::BinaryFunction<T, T, T>(
-        tflite::micro::GetTensorShape(input1),
-        tflite::micro::GetTensorData<T>(input1),
-        tflite::micro::GetTensorShape(input2),
-        tflite::micro::GetTensorData<T>(input2),
-        tflite::micro::GetTensorShape(output),
-        tflite::micro::GetTensorData<T>(output), SquaredDifference<T>);
-  }
+  BinaryBroadcast(data->broadcast, tflite::micro::GetTensorData<T>(input1),
+                  tflite::micro::GetTensorData<T>(input2),
+                  tflite::micro::GetTensorData<T>(output),
+                  [](T x, T y) { return SquaredDifference(x, y); });
 }
 
 TfLiteStatus SquaredDifferenceEval(TfLiteContext* context, TfLiteNode* node) {
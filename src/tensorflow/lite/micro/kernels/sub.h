@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/kernels/binary_broadcast.h"
 
 namespace tflite {
 
@@ -28,7 +29,7 @@ extern const int kSubInputTensor2;
 extern const int kSubOutputTensor;
 
 struct OpDataSub {
-  bool requires_broadcast;
+  BinaryBroadcastShape broadcast;
 
   // These fields are used in both the general 8-bit -> 8bit quantized path,
   // and the special 16-bit -> 16bit quantized path
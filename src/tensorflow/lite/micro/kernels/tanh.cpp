@@ -23,7 +23,9 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/op_macros.h"
+#include "tensorflow/lite/micro/kernels/float_math.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/kernels/unary_lut.h"
 #include "tensorflow/lite/micro/micro_log.h"
 #include "tensorflow/lite/micro/micro_utils.h"
 
@@ -39,6 +41,8 @@ struct OpData {
   int32_t input_range_radius;
   int32_t input_multiplier;
   int input_left_shift;
+  // int8 tanh table, see BuildUnaryLutFromKernel().
+  int8_t* table;
 };
 
 void* TanhInit(TfLiteContext* context, const char* buffer, size_t length) {
@@ -71,6 +75,16 @@ TfLiteStatus CalculateArithmeticOpData(TfLiteContext* context, TfLiteNode* node,
 
     data->input_range_radius =
         CalculateInputRadius(kInputIntegerBits, data->input_left_shift, 31);
+
+    data->table = BuildUnaryLutFromKernel(
+        context, [data](const int8_t* in, int8_t* out, int size) {
+          const RuntimeShape shape(1, size);
+          reference_integer_ops::Tanh(
+              data->input_zero_point, data->input_range_radius,
+              data->input_multiplier, data->input_left_shift, shape, in, shape,
+              out);
+        });
+    TF_LITE_ENSURE(context, data->table != nullptr);
   }
 
   if (input->type == kTfLiteInt16) {
@@ -158,10 +172,18 @@ TfLiteStatus TanhEval(TfLiteContext* context, TfLiteNode* node) {
 
   switch (input->type) {
     case kTfLiteFloat32: {
+#if defined(TF_LITE_USE_POLYNOMIAL_MATH)
+      float_math::ApplyTanhToVector(
+          tflite::micro::GetTensorData<float>(input),
+          MatchingFlatSize(tflite::micro::GetTensorShape(input),
+                           tflite::micro::GetTensorShape(output)),
+          tflite::micro::GetTensorData<float>(output));
+#else
       reference_ops::Tanh(tflite::micro::GetTensorShape(input),
                           tflite::micro::GetTensorData<float>(input),
                           tflite::micro::GetTensorShape(output),
                           tflite::micro::GetTensorData<float>(output));
+#endif
       return kTfLiteOk;
     } break;
     case kTfLiteInt16: {
@@ -174,12 +196,7 @@ TfLiteStatus TanhEval(TfLiteContext* context, TfLiteNode* node) {
       return kTfLiteOk;
     } break;
     case kTfLiteInt8: {
-      reference_integer_ops::Tanh(
-          data.input_zero_point, data.input_range_radius, data.input_multiplier,
-          data.input_left_shift, tflite::micro::GetTensorShape(input),
-          tflite::micro::GetTensorData<int8_t>(input),
-          tflite::micro::GetTensorShape(output),
-          tflite::micro::GetTensorData<int8_t>(output));
+      EvalUnaryLut(data.table, input, output);
       return kTfLiteOk;
     } break;
     default:
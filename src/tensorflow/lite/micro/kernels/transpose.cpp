@@ -12,7 +12,9 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
-#include "tensorflow/lite/kernels/internal/reference/transpose.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
@@ -28,6 +30,183 @@ constexpr int kInputTensor = 0;
 constexpr int kPermTensor = 1;
 constexpr int kOutputTensor = 0;
 
+// Side of the square blocks in which the remaining 2-D transposes are done.
+// The input rows of a block and the output rows it writes stay in cache.
+constexpr int kTransposeBlock = 16;
+
+// A transpose with the dimensions of size 1 removed and the dimensions that
+// stay adjacent and in order merged into one. Output dimension i is input
+// dimension perm[i]; the input shape is `shape`.
+struct CollapsedTranspose {
+  int dims;
+  int32_t shape[kTransposeMaxDimensions];
+  int32_t perm[kTransposeMaxDimensions];
+};
+
+void CollapseTranspose(const RuntimeShape& input_shape,
+                       const TransposeParams& params,
+                       CollapsedTranspose* collapsed) {
+  // Numbers the input dimensions that are not of size 1 and lists them in
+  // output order.
+  const int dims = input_shape.DimensionsCount();
+  int32_t kept_index[kTransposeMaxDimensions];
+  int32_t kept_shape[kTransposeMaxDimensions];
+  int kept = 0;
+  for (int i = 0; i < dims; ++i) {
+    kept_index[i] = input_shape.Dims(i) == 1 ? -1 : kept;
+    if (input_shape.Dims(i) != 1) {
+      kept_shape[kept++] = input_shape.Dims(i);
+    }
+  }
+  int32_t order[kTransposeMaxDimensions];
+  int count = 0;
+  for (int i = 0; i < params.perm_count; ++i) {
+    if (kept_index[params.perm[i]] >= 0) {
+      order[count++] = kept_index[params.perm[i]];
+    }
+  }
+
+  // Runs of consecutive input dimensions in the output become one dimension.
+  int32_t group_first[kTransposeMaxDimensions];
+  int32_t group_size[kTransposeMaxDimensions];
+  int groups = 0;
+  for (int i = 0; i < count; ++i) {
+    if (i > 0 && order[i] == order[i - 1] + 1) {
+      group_size[groups - 1] *= kept_shape[order[i]];
+    } else {
+      group_first[groups] = order[i];
+      group_size[groups] = kept_shape[order[i]];
+      ++groups;
+    }
+  }
+
+  // The input order of the groups is the order of their first dimensions.
+  collapsed->dims = groups;
+  for (int g = 0; g < groups; ++g) {
+    int input_dim = 0;
+    for (int other = 0; other < groups; ++other) {
+      if (group_first[other] < group_first[g]) {
+        ++input_dim;
+      }
+    }
+    collapsed->perm[g] = input_dim;
+    collapsed->shape[input_dim] = group_size[g];
+  }
+}
+
+// Calls `copy(input_offset, output_offset)` for every index of the `count`
+// outer loops, with the offsets of their first elements.
+template <typename CopyFn>
+void ForEachOuterIndex(const int* extents, const int* input_strides,
+                       const int* output_strides, int count, int input_offset,
+                       int output_offset, const CopyFn& copy) {
+  if (count == 0) {
+    copy(input_offset, output_offset);
+    return;
+  }
+  for (int i = 0; i < extents[0]; ++i) {
+    ForEachOuterIndex(extents + 1, input_strides + 1, output_strides + 1,
+                      count - 1, input_offset + i * input_strides[0],
+                      output_offset + i * output_strides[0], copy);
+  }
+}
+
+// Writes the `cols` x `rows` transpose of the `rows` x `cols` input, whose
+// rows are `input_stride` elements apart, to output rows `output_stride`
+// elements apart.
+template <typename T>
+void Transpose2D(const T* input, int input_stride, int rows, int cols,
+                 T* output, int output_stride) {
+  for (int row_block = 0; row_block < rows; row_block += kTransposeBlock) {
+    const int row_end = std::min(rows, row_block + kTransposeBlock);
+    for (int col_block = 0; col_block < cols; col_block += kTransposeBlock) {
+      const int col_end = std::min(cols, col_block + kTransposeBlock);
+      for (int col = col_block; col < col_end; ++col) {
+        T* output_row = output + col * output_stride + row_block;
+        const T* input_col = input + row_block * input_stride + col;
+        if (row_end - row_block == kTransposeBlock) {
+          // Full blocks have a constant trip count, which compilers unroll.
+#pragma GCC unroll 16
+          for (int row = 0; row < kTransposeBlock; ++row) {
+            output_row[row] = input_col[row * input_stride];
+          }
+        } else {
+          for (int row = 0; row < row_end - row_block; ++row) {
+            output_row[row] = input_col[row * input_stride];
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void TransposeCollapsed(const CollapsedTranspose& t, const T* input_data,
+                        T* output_data) {
+  const int dims = t.dims;
+  int input_strides[kTransposeMaxDimensions];
+  int output_strides[kTransposeMaxDimensions];
+  int flat_size = 1;
+  for (int i = dims - 1; i >= 0; --i) {
+    input_strides[i] = flat_size;
+    flat_size *= t.shape[i];
+  }
+  int output_stride = 1;
+  for (int i = dims - 1; i >= 0; --i) {
+    output_strides[i] = output_stride;
+    output_stride *= t.shape[t.perm[i]];
+  }
+
+  // Nothing moves: one copy.
+  if (dims <= 1) {
+    std::memcpy(output_data, input_data, flat_size * sizeof(T));
+    return;
+  }
+
+  // The outer loops run over the output dimensions that are neither the
+  // innermost input nor the innermost output dimension.
+  int extents[kTransposeMaxDimensions];
+  int outer_input_strides[kTransposeMaxDimensions];
+  int outer_output_strides[kTransposeMaxDimensions];
+  int outer = 0;
+  int inner_output_dim = dims - 1;
+  for (int i = 0; i < dims; ++i) {
+    if (t.perm[i] == dims - 1) {
+      inner_output_dim = i;
+    } else if (i != dims - 1) {
+      extents[outer] = t.shape[t.perm[i]];
+      outer_input_strides[outer] = input_strides[t.perm[i]];
+      outer_output_strides[outer] = output_strides[i];
+      ++outer;
+    }
+  }
+
+  const int row_size = t.shape[dims - 1];
+  if (inner_output_dim == dims - 1) {
+    // The innermost dimension stays innermost: its rows are copied whole.
+    ForEachOuterIndex(extents, outer_input_strides, outer_output_strides,
+                      outer, 0, 0,
+                      [&](int input_offset, int output_offset) {
+                        std::memcpy(output_data + output_offset,
+                                    input_data + input_offset,
+                                    row_size * sizeof(T));
+                      });
+    return;
+  }
+
+  // Otherwise the innermost input dimension and the input dimension that
+  // becomes innermost in the output form a 2-D transpose.
+  const int swapped_dim = t.perm[dims - 1];
+  ForEachOuterIndex(extents, outer_input_strides, outer_output_strides, outer,
+                    0, 0, [&](int input_offset, int output_offset) {
+                      Transpose2D(input_data + input_offset,
+                                  input_strides[swapped_dim],
+                                  t.shape[swapped_dim], row_size,
+                                  output_data + output_offset,
+                                  output_strides[inner_output_dim]);
+                    });
+}
+
 struct TransposeContext {
   TransposeContext(TfLiteContext* context, TfLiteNode* node) {
     micro_context = GetMicroContext(context);
@@ -83,30 +262,31 @@ TfLiteStatus TransposeEval(TfLiteContext* context, TfLiteNode* node) {
     params.perm[i] = perm_data[i];
   }
 
-  // Transpose kernel only does rearranging values not numeric evaluations
-  // on each cell. It's safe to implement per size of scalar type and this
-  // trick keeps the total code size in a reasonable range.
   const TfLiteEvalTensor* input =
       tflite::micro::GetEvalInput(context, node, kInputTensor);
   TfLiteEvalTensor* output =
       tflite::micro::GetEvalOutput(context, node, kOutputTensor);
+  CollapsedTranspose collapsed;
+  CollapseTranspose(tflite::micro::GetTensorShape(input), params, &collapsed);
   switch (input->type) {
     case kTfLiteFloat32:
-      reference_ops::Transpose(params, tflite::micro::GetTensorShape(input),
-                               tflite::micro::GetTensorData<float>(input),
-                               tflite::micro::GetTensorShape(output),
-                               tflite::micro::GetTensorData<float>(output));
+      TransposeCollapsed(collapsed, tflite::micro::GetTensorData<float>(input),
+                         tflite::micro::GetTensorData<float>(output));
       break;
     case kTfLiteInt8:
-      reference_ops::Transpose(params, tflite::micro::GetTensorShape(input),
-                               tflite::micro::GetTensorData<int8_t>(input),
-                               tflite::micro::GetTensorShape(output),
-                               tflite::micro::GetTensorData<int8_t>(output));
+      TransposeCollapsed(collapsed,
+                         tflite::micro::GetTensorData<int8_t>(input),
+                         tflite::micro::GetTensorData<int8_t>(output));
+      break;
+    case kTfLiteInt16:
+      TransposeCollapsed(collapsed,
+                         tflite::micro::GetTensorData<int16_t>(input),
+                         tflite::micro::GetTensorData<int16_t>(output));
       break;
     default:
       MicroPrintf(
           "Type %s is currently not supported by Transpose. "
-          "Only float32 and int8 is supported",
+          "Only float32, int8 and int16 are supported",
           TfLiteTypeGetName(input->type));
       return kTfLiteError;
   }
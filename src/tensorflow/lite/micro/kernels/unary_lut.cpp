@@ -0,0 +1,52 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/kernels/unary_lut.h"
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+
+namespace tflite {
+
+namespace {
+
+template <typename T>
+void EvalUnaryLutImpl(const T* lut, const TfLiteEvalTensor* input,
+                      TfLiteEvalTensor* output) {
+  const int size = MatchingFlatSize(tflite::micro::GetTensorShape(input),
+                                    tflite::micro::GetTensorShape(output));
+  const T* input_data = tflite::micro::GetTensorData<T>(input);
+  T* output_data = tflite::micro::GetTensorData<T>(output);
+  for (int i = 0; i < size; ++i) {
+    output_data[i] = LUTLookup(input_data[i], lut);
+  }
+}
+
+}  // namespace
+
+void EvalUnaryLut(const int8_t* lut, const TfLiteEvalTensor* input,
+                  TfLiteEvalTensor* output) {
+  EvalUnaryLutImpl(lut, input, output);
+}
+
+void EvalUnaryLut(const int16_t* lut, const TfLiteEvalTensor* input,
+                  TfLiteEvalTensor* output) {
+  EvalUnaryLutImpl(lut, input, output);
+}
+
+}  // namespace tflite
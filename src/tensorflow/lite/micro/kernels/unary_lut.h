@@ -0,0 +1,80 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_KERNELS_UNARY_LUT_H_
+#define TENSORFLOW_LITE_MICRO_KERNELS_UNARY_LUT_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/kernels/internal/common.h"
+
+namespace tflite {
+
+// Lookup tables for quantized activations of a single input. Any function of
+// one int8 value is a table of 256 outputs. Int16 functions use a table of 513
+// samples that LUTLookup interpolates. The tables are built at Prepare into
+// persistent memory, from the quantization parameters of the tensors.
+
+// Allocates a table of LUTSize<T>() entries in persistent memory, or returns
+// nullptr if the arena is full.
+template <typename T>
+T* AllocateUnaryLut(TfLiteContext* context) {
+  TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
+  return static_cast<T*>(
+      context->AllocatePersistentBuffer(context, LUTSize<T>() * sizeof(T)));
+}
+
+// Allocates and fills the table of `transform`, a function of real values, for
+// the quantization parameters of `input` and `output`.
+template <typename T>
+T* BuildUnaryLut(TfLiteContext* context, const TfLiteTensor* input,
+                 const TfLiteTensor* output, float (*transform)(float)) {
+  T* lut = AllocateUnaryLut<T>(context);
+  if (lut != nullptr) {
+    LUTPopulate<T>(input->params.scale, input->params.zero_point,
+                   output->params.scale, output->params.zero_point, transform,
+                   lut);
+  }
+  return lut;
+}
+
+// Allocates and fills an int8 table with the outputs of an existing integer
+// kernel, so that looking it up is bit-exact with running the kernel. `kernel`
+// is called once as kernel(input, output, size) over all of the 256 inputs.
+template <typename Kernel>
+int8_t* BuildUnaryLutFromKernel(TfLiteContext* context, const Kernel& kernel) {
+  int8_t* lut = AllocateUnaryLut<int8_t>(context);
+  if (lut != nullptr) {
+    // Entry i of the table is the output of static_cast<int8_t>(i), the order
+    // that LUTLookup expects.
+    int8_t inputs[256];
+    for (int i = 0; i < 256; ++i) {
+      inputs[i] = static_cast<int8_t>(i);
+    }
+    kernel(inputs, lut, 256);
+  }
+  return lut;
+}
+
+// Maps every element of `input` through `lut` into `output`.
+void EvalUnaryLut(const int8_t* lut, const TfLiteEvalTensor* input,
+                  TfLiteEvalTensor* output);
+void EvalUnaryLut(const int16_t* lut, const TfLiteEvalTensor* input,
+                  TfLiteEvalTensor* output);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_KERNELS_UNARY_LUT_H_
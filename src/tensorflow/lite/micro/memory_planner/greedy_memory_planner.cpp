@@ -34,6 +34,11 @@ char GetOrdinalCharacter(int i) {
   return '*';
 }
 
+// Rounds an offset up to the next multiple of a power of two alignment.
+int AlignOffsetUp(int offset, int alignment) {
+  return (offset + alignment - 1) & ~(alignment - 1);
+}
+
 }  // namespace
 
 // Simple stable in-place sort function. Not time-efficient for large arrays.
@@ -63,6 +68,7 @@ TfLiteStatus GreedyMemoryPlanner::Init(unsigned char* scratch_buffer,
                                        int scratch_buffer_size) {
   // Reset internal states
   buffer_count_ = 0;
+  alignment_padding_bytes_ = 0;
   need_to_calculate_offsets_ = true;
 
   // Allocate the arrays we need within the scratch buffer arena.
@@ -100,6 +106,7 @@ TfLiteStatus GreedyMemoryPlanner::AddBuffer(int size, int first_time_used,
   current->first_time_used = first_time_used;
   current->last_time_used = last_time_used;
   current->offline_offset = kOnlinePlannedBuffer;
+  current->alignment = 1;
   ++buffer_count_;
   need_to_calculate_offsets_ = true;
   return kTfLiteOk;
@@ -116,6 +123,22 @@ TfLiteStatus GreedyMemoryPlanner::AddBuffer(int size, int first_time_used,
   return kTfLiteOk;
 }
 
+TfLiteStatus GreedyMemoryPlanner::AddAlignedBuffer(int size,
+                                                   int first_time_used,
+                                                   int last_time_used,
+                                                   int alignment) {
+  if ((alignment <= 0) || ((alignment & (alignment - 1)) != 0)) {
+    MicroPrintf("Buffer alignment %d is not a power of two", alignment);
+    return kTfLiteError;
+  }
+  BufferRequirements* current = &requirements_[buffer_count_];
+  if (AddBuffer(size, first_time_used, last_time_used) != kTfLiteOk) {
+    return kTfLiteError;
+  }
+  current->alignment = alignment;
+  return kTfLiteOk;
+}
+
 bool GreedyMemoryPlanner::DoesEntryOverlapInTime(
     const GreedyMemoryPlanner::ListEntry* entry, const int first_time_used,
     const int last_time_used) const {
@@ -164,6 +187,7 @@ void GreedyMemoryPlanner::CalculateOffsetsIfNeeded() {
     return;
   }
   need_to_calculate_offsets_ = false;
+  alignment_padding_bytes_ = 0;
 
   // Start off by ordering the buffers in descending order of size.
   // This helps find a more compact layout. Intuitively, you can think
@@ -217,6 +241,7 @@ void GreedyMemoryPlanner::CalculateOffsetsIfNeeded() {
     // Look at what size and time range the buffer needs to be active.
     BufferRequirements* wanted_requirements = &requirements_[buffer_id];
     const int wanted_size = wanted_requirements->size;
+    const int wanted_alignment = wanted_requirements->alignment;
     const int wanted_first_time_used = wanted_requirements->first_time_used;
     const int wanted_last_time_used = wanted_requirements->last_time_used;
 
@@ -230,6 +255,7 @@ void GreedyMemoryPlanner::CalculateOffsetsIfNeeded() {
     // Loop through the offset-ordered list of buffers, looking for gaps.
     if (wanted_requirements->offline_offset == kOnlinePlannedBuffer) {
       ListEntry* prior_entry = nullptr;
+      int aligned_offset = 0;
       while (true) {
         // Find out what the next active buffer is.
         ListEntry* next_entry = NextSimultaneouslyActiveBuffer(
@@ -244,13 +270,15 @@ void GreedyMemoryPlanner::CalculateOffsetsIfNeeded() {
             candidate_offset = prior_entry_offset;
           }
         }
+        // The buffer can only start at an offset matching its alignment.
+        aligned_offset = AlignOffsetUp(candidate_offset, wanted_alignment);
         if (next_entry == nullptr) {
           // We're at the end of the list, so we can always append the buffer
           // here.
           break;
         }
         // Find out how much space there is between us and the next buffer.
-        const int gap = next_entry->offset - candidate_offset;
+        const int gap = next_entry->offset - aligned_offset;
         if (gap >= wanted_size) {
           // This entry has a big enough gap between it and the next, so
           // use it!
@@ -259,6 +287,8 @@ void GreedyMemoryPlanner::CalculateOffsetsIfNeeded() {
         // The gap wasn't big enough, so move on to another candidate.
         prior_entry = next_entry;
       }
+      alignment_padding_bytes_ += aligned_offset - candidate_offset;
+      candidate_offset = aligned_offset;
     } else {
       // Offline planned offset are to be considered constant
       candidate_offset = wanted_requirements->offline_offset;
@@ -331,6 +361,11 @@ size_t GreedyMemoryPlanner::GetMaximumMemorySize() {
   return max_size;
 }
 
+size_t GreedyMemoryPlanner::GetAlignmentPaddingBytes() {
+  CalculateOffsetsIfNeeded();
+  return alignment_padding_bytes_;
+}
+
 void GreedyMemoryPlanner::PrintMemoryPlan() {
   CalculateOffsetsIfNeeded();
 
@@ -340,6 +375,9 @@ void GreedyMemoryPlanner::PrintMemoryPlan() {
                 buffer_offsets_[i], requirements_[i].first_time_used,
                 requirements_[i].last_time_used);
   }
+  if (alignment_padding_bytes_ > 0) {
+    MicroPrintf("Alignment padding: %d bytes", alignment_padding_bytes_);
+  }
 
   constexpr int kLineWidth = 80;
   int max_size = kLineWidth;
@@ -36,7 +36,8 @@ constexpr int kOnlinePlannedBuffer = -1;
 //  - The rest of the buffers are looped through in descending size order.
 //  - The other buffers that need to be in memory at the same time are found.
 //  - The first gap between simultaneously active buffers that the current
-//    buffer fits into will be used.
+//    buffer fits into will be used. Buffers added with AddAlignedBuffer()
+//    only fit into a gap once their offset is rounded up to their alignment.
 //  - If no large-enough gap is found, the current buffer is placed after the
 //    last buffer that's simultaneously active.
 //  - This continues until all buffers are placed, and the offsets stored.
@@ -56,7 +57,7 @@ class GreedyMemoryPlanner : public MicroMemoryPlanner {
   // planned for will depend on the size of this scratch memory, so you should
   // enlarge it if you see an error when calling AddBuffer(). The memory can be
   // reused once you're done with the planner, as long as you copy the
-  // calculated offsets to another location. Each buffer requires about 36 bytes
+  // calculated offsets to another location. Each buffer requires about 44 bytes
   // of scratch.
   TfLiteStatus Init(unsigned char* scratch_buffer,
                     int scratch_buffer_size) override;
@@ -70,6 +71,15 @@ class GreedyMemoryPlanner : public MicroMemoryPlanner {
   TfLiteStatus AddBuffer(int size, int first_time_used, int last_time_used,
                          int offline_offset) override;
 
+  // Record details of a buffer that has to be placed at a multiple of
+  // `alignment`. The buffer is put in the first gap that still fits it once
+  // its offset is aligned.
+  TfLiteStatus AddAlignedBuffer(int size, int first_time_used,
+                                int last_time_used, int alignment) override;
+
+  // Returns the number of bytes skipped in front of aligned buffers.
+  size_t GetAlignmentPaddingBytes() override;
+
   // Returns the high-water mark of used memory. This is the minimum size of a
   // memory arena you'd need to allocate to hold these buffers.
   size_t GetMaximumMemorySize() override;
@@ -139,6 +149,7 @@ class GreedyMemoryPlanner : public MicroMemoryPlanner {
     int offline_offset;
     int first_time_used;
     int last_time_used;
+    int alignment;
   };
 
   // Working arrays used during the layout algorithm.
@@ -159,6 +170,9 @@ class GreedyMemoryPlanner : public MicroMemoryPlanner {
   // Stores the outcome of the plan, the location of each buffer in the arena.
   int* buffer_offsets_;
 
+  // Bytes left unused in front of buffers to honor their alignment.
+  int alignment_padding_bytes_;
+
   // Whether buffers have been added since the last plan was calculated.
   bool need_to_calculate_offsets_;
 
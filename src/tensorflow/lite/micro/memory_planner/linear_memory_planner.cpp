@@ -23,7 +23,9 @@ namespace tflite {
 constexpr int tflite::LinearMemoryPlanner::kMaxBufferCount;
 
 LinearMemoryPlanner::LinearMemoryPlanner()
-    : current_buffer_count_(0), next_free_offset_(0) {}
+    : current_buffer_count_(0),
+      next_free_offset_(0),
+      alignment_padding_bytes_(0) {}
 LinearMemoryPlanner::~LinearMemoryPlanner() {}
 
 TfLiteStatus LinearMemoryPlanner::AddBuffer(int size, int first_time_used,
@@ -38,8 +40,27 @@ TfLiteStatus LinearMemoryPlanner::AddBuffer(int size, int first_time_used,
   return kTfLiteOk;
 }
 
+TfLiteStatus LinearMemoryPlanner::AddAlignedBuffer(int size,
+                                                   int first_time_used,
+                                                   int last_time_used,
+                                                   int alignment) {
+  if ((alignment <= 0) || ((alignment & (alignment - 1)) != 0)) {
+    MicroPrintf("Buffer alignment %d is not a power of two", alignment);
+    return kTfLiteError;
+  }
+  const size_t mask = static_cast<size_t>(alignment) - 1;
+  const size_t aligned_offset = (next_free_offset_ + mask) & ~mask;
+  alignment_padding_bytes_ += aligned_offset - next_free_offset_;
+  next_free_offset_ = aligned_offset;
+  return AddBuffer(size, first_time_used, last_time_used);
+}
+
 size_t LinearMemoryPlanner::GetMaximumMemorySize() { return next_free_offset_; }
 
+size_t LinearMemoryPlanner::GetAlignmentPaddingBytes() {
+  return alignment_padding_bytes_;
+}
+
 int LinearMemoryPlanner::GetBufferCount() { return current_buffer_count_; }
 
 TfLiteStatus LinearMemoryPlanner::GetOffsetForBuffer(int buffer_index,
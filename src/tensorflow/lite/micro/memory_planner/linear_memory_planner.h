@@ -30,8 +30,11 @@ class LinearMemoryPlanner : public MicroMemoryPlanner {
 
   TfLiteStatus AddBuffer(int size, int first_time_used,
                          int last_time_used) override;
+  TfLiteStatus AddAlignedBuffer(int size, int first_time_used,
+                                int last_time_used, int alignment) override;
 
   size_t GetMaximumMemorySize() override;
+  size_t GetAlignmentPaddingBytes() override;
   int GetBufferCount() override;
   TfLiteStatus GetOffsetForBuffer(int buffer_index, int* offset) override;
 
@@ -44,6 +47,7 @@ class LinearMemoryPlanner : public MicroMemoryPlanner {
   size_t buffer_offsets_[kMaxBufferCount];
   int current_buffer_count_;
   size_t next_free_offset_;
+  size_t alignment_padding_bytes_;
 
   TF_LITE_REMOVE_VIRTUAL_DELETE
 };
@@ -64,6 +64,19 @@ class MicroMemoryPlanner {
     return kTfLiteError;
   }
 
+  // Record details of a buffer whose offset must be a multiple of `alignment`.
+  // This is used for buffers that kernels need aligned beyond the default
+  // arena alignment, e.g. for wide SIMD loads or DMA transfers. `alignment`
+  // must be a power of two. By default, it returns an error.
+  virtual TfLiteStatus AddAlignedBuffer(int size, int first_time_used,
+                                        int last_time_used, int alignment) {
+    return kTfLiteError;
+  }
+
+  // Returns the number of bytes skipped in front of buffers to honor their
+  // alignment in the calculated layout.
+  virtual size_t GetAlignmentPaddingBytes() { return 0; }
+
   // The largest contiguous block of memory that's needed to hold the layout.
   virtual size_t GetMaximumMemorySize() = 0;
   // How many buffers have been added to the planner.
@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/memory_helpers.h"
 #include "tensorflow/lite/micro/memory_planner/greedy_memory_planner.h"
+#include "tensorflow/lite/micro/micro_arena_constants.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
 namespace tflite {
@@ -199,6 +200,7 @@ TfLiteStatus AllocationInfoBuilder::InitializeAllocationInfo(
 
       current->first_created = kUninitializedLifetime;
       current->last_used = kUninitializedLifetime;
+      current->alignment = MicroArenaBufferAlignment();
       current->needs_allocating =
           (eval_tensors[i].data.data == nullptr) &&
           (!subgraph->tensors()->Get(i)->is_variable()) &&
@@ -211,6 +213,7 @@ TfLiteStatus AllocationInfoBuilder::InitializeAllocationInfo(
         if (subgraph->tensors()->Get(i)->is_variable() &&
             current->offline_offset != kOnlinePlannedBuffer) {
           current->needs_allocating = true;
+          has_planned_variables_ = true;
         }
       } else {
         current->offline_offset = kOnlinePlannedBuffer;
@@ -224,12 +227,37 @@ TfLiteStatus AllocationInfoBuilder::InitializeAllocationInfo(
     AllocationInfo* current = &scratch_allocation_info[i];
     current->first_created = kUninitializedLifetime;
     current->last_used = kUninitializedLifetime;
+    current->alignment = MicroArenaBufferAlignment();
     current->needs_allocating = true;
     current->offline_offset = kOnlinePlannedBuffer;
   }
   return kTfLiteOk;
 }
 
+TfLiteStatus AllocationInfoBuilder::ApplyTensorAlignmentRequests(
+    const internal::TensorAlignmentRequest* requests) {
+  for (const internal::TensorAlignmentRequest* request = requests;
+       request != nullptr; request = request->next) {
+    AllocationInfo* current =
+        &info_.allocation_info[info_.subgraph_offsets[request->subgraph_idx] +
+                               request->tensor_idx];
+    if (current->needs_allocating) {
+      current->alignment = std::max(current->alignment, request->alignment);
+    } else if (*current->output_ptr != nullptr &&
+               reinterpret_cast<uintptr_t>(*current->output_ptr) %
+                       request->alignment !=
+                   0) {
+      // Weights and persistent variables are not moved, the kernel still has
+      // to handle them at the alignment they have.
+      MicroPrintf(
+          "Tensor %d in subgraph %d is not planned in the arena and is not "
+          "aligned to the %d bytes requested",
+          request->tensor_idx, request->subgraph_idx, request->alignment);
+    }
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus AllocationInfoBuilder::MarkAllocationLifetimes(
     int subgraph_idx, internal::ScratchBufferRequest* scratch_buffer_requests,
     ScratchBufferHandle* scratch_buffer_handles,
@@ -312,6 +340,7 @@ TfLiteStatus AllocationInfoBuilder::MarkAllocationLifetimes(
             &(scratch_buffer_handles[scratch_idx]);
         current->output_ptr = reinterpret_cast<void**>(&current_handle->data);
         current->bytes = request.bytes;
+        current->alignment = std::max(current->alignment, request.alignment);
         UpdateFirstCreated(current, start_allocation_scope_count);
         UpdateLastUsed(current, allocation_scope_count_);
       }
@@ -30,6 +30,8 @@ struct AllocationInfo {
   int first_created;
   int last_used;
   int32_t offline_offset;
+  // Alignment of the start of the buffer in bytes.
+  size_t alignment;
   bool needs_allocating;
 };
 
@@ -83,6 +85,11 @@ class AllocationInfoBuilder {
   TfLiteStatus InitializeAllocationInfo(const int32_t* offline_offsets,
                                         SubgraphAllocations* allocations);
 
+  // Raise the alignment of tensors to the one requested by kernels. Tensors
+  // that are not planned keep their placement, unmet requests are reported.
+  TfLiteStatus ApplyTensorAlignmentRequests(
+      const internal::TensorAlignmentRequest* requests);
+
   // Mark the scope of each tensor and scratch buffer across the graph. Enter
   // all possible subgraphs invoked by each control flow operator. This method
   // marks the maximum lifetime of each buffer so that tensors are correctly
@@ -110,6 +117,10 @@ class AllocationInfoBuilder {
   // Returns a pointer to the built AllocationInfo array.
   AllocationInfo* Finish() const { return info_.allocation_info; }
 
+  // Returns true if offline planned variable tensors are placed in the
+  // non-persistent section of the arena.
+  bool HasPlannedVariables() const { return has_planned_variables_; }
+
  private:
   // Mark the given Allocation info as first created at the specified allocation
   // scope count. Only the first creation must be recorded since the allocation
@@ -131,6 +142,7 @@ class AllocationInfoBuilder {
   INonPersistentBufferAllocator* non_persistent_allocator_ = nullptr;
   GraphAllocationInfo info_;
   int allocation_scope_count_ = 0;
+  bool has_planned_variables_ = false;
 };
 
 }  // namespace tflite
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/lite/micro/micro_allocator.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 
@@ -33,6 +34,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/micro_allocation_info.h"
 #include "tensorflow/lite/micro/micro_arena_constants.h"
 #include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_prepared_model.h"
 #include "tensorflow/lite/micro/tflite_bridge/flatbuffer_conversions_bridge.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
@@ -96,27 +98,64 @@ MicroMemoryPlanner* CreateMemoryPlanner(
 
 TfLiteStatus CreatePlan(MicroMemoryPlanner* planner,
                         const AllocationInfo* allocation_info,
-                        size_t allocation_info_size) {
+                        size_t allocation_info_size, size_t alignment_limit,
+                        size_t* max_alignment) {
+  const size_t default_alignment = MicroArenaBufferAlignment();
+  *max_alignment = default_alignment;
+  int unmet_alignment_count = 0;
+  size_t unmet_alignment = 0;
   // Add the tensors to our allocation plan.
   for (size_t i = 0; i < allocation_info_size; ++i) {
     const AllocationInfo* current = &allocation_info[i];
     if (current->needs_allocating) {
       size_t aligned_bytes_required =
           AlignSizeUp(current->bytes, MicroArenaBufferAlignment());
-      if (current->offline_offset == kOnlinePlannedBuffer) {
-        TF_LITE_ENSURE_STATUS(planner->AddBuffer(aligned_bytes_required,
-                                                 current->first_created,
-                                                 current->last_used));
-      } else {
+      size_t alignment = current->alignment;
+      if (current->offline_offset != kOnlinePlannedBuffer) {
+        // Offline planned offsets are kept, aligned or not.
+        if (current->offline_offset % alignment != 0) {
+          ++unmet_alignment_count;
+          unmet_alignment = std::max(unmet_alignment, alignment);
+          alignment = default_alignment;
+        }
         TF_LITE_ENSURE_STATUS(
             planner->AddBuffer(aligned_bytes_required, current->first_created,
                                current->last_used, current->offline_offset));
+      } else {
+        if (alignment > alignment_limit) {
+          ++unmet_alignment_count;
+          unmet_alignment = std::max(unmet_alignment, alignment);
+          alignment = alignment_limit;
+        }
+        if (alignment > default_alignment) {
+          TF_LITE_ENSURE_STATUS(planner->AddAlignedBuffer(
+              aligned_bytes_required, current->first_created,
+              current->last_used, alignment));
+        } else {
+          TF_LITE_ENSURE_STATUS(planner->AddBuffer(aligned_bytes_required,
+                                                   current->first_created,
+                                                   current->last_used));
+        }
+      }
+      if (alignment > *max_alignment) {
+        *max_alignment = alignment;
       }
     }
   }
+  if (unmet_alignment_count > 0) {
+    MicroPrintf(
+        "%d buffers are planned below their requested alignment of up to %d "
+        "bytes, since they are planned offline or the head of the shared "
+        "arena is only aligned to %d bytes",
+        unmet_alignment_count, unmet_alignment, alignment_limit);
+  }
   return kTfLiteOk;
 }
 
+bool IsPowerOfTwo(size_t value) {
+  return (value != 0) && ((value & (value - 1)) == 0);
+}
+
 TfLiteStatus CommitPlan(MicroMemoryPlanner* planner, uint8_t* starting_point,
                         const AllocationInfo* allocation_info,
                         size_t allocation_info_size) {
@@ -177,6 +216,12 @@ INonPersistentBufferAllocator* CreateNonPersistentArenaAllocator(
   return non_persistent_buffer_allocator;
 }
 
+// Returns true if `ptr` points into the `size` bytes starting at `overlay`.
+bool IsInOverlayMemory(const void* ptr, const uint8_t* overlay, size_t size) {
+  const uint8_t* byte_ptr = static_cast<const uint8_t*>(ptr);
+  return byte_ptr >= overlay && byte_ptr < overlay + size;
+}
+
 }  // namespace
 
 namespace internal {
@@ -361,6 +406,7 @@ size_t MicroAllocator::GetDefaultTailUsage(bool is_memory_planner_given) {
   size_t total_size = AlignSizeUp<SingleArenaBufferAllocator>() +
                       AlignSizeUp<MicroAllocator>() +
                       AlignSizeUp<MicroBuiltinDataAllocator>() +
+                      AlignSizeUp<internal::ModelAllocationRecord>() +
                       AlignSizeUp<SubgraphAllocations>();
   if (!is_memory_planner_given) {
     total_size += AlignSizeUp<GreedyMemoryPlanner>();
@@ -373,7 +419,8 @@ MicroAllocator::MicroAllocator(SingleArenaBufferAllocator* memory_allocator,
     : non_persistent_buffer_allocator_(memory_allocator),
       persistent_buffer_allocator_(memory_allocator),
       memory_planner_(memory_planner),
-      model_is_allocating_(false) {}
+      model_is_allocating_(false),
+      max_buffer_alignment_(MicroArenaBufferAlignment()) {}
 
 MicroAllocator::MicroAllocator(
     IPersistentBufferAllocator* persistent_buffer_allocator,
@@ -382,7 +429,8 @@ MicroAllocator::MicroAllocator(
     : non_persistent_buffer_allocator_(non_persistent_buffer_allocator),
       persistent_buffer_allocator_(persistent_buffer_allocator),
       memory_planner_(memory_planner),
-      model_is_allocating_(false) {}
+      model_is_allocating_(false),
+      max_buffer_alignment_(MicroArenaBufferAlignment()) {}
 
 MicroAllocator::~MicroAllocator() {}
 
@@ -479,8 +527,20 @@ SubgraphAllocations* MicroAllocator::StartModelAllocation(const Model* model) {
     return nullptr;
   }
 
+  if (non_persistent_memory_lent_) {
+    MicroPrintf(
+        "MicroAllocator: Model allocation started while the non-persistent "
+        "memory is lent");
+    return nullptr;
+  }
+
   model_is_allocating_ = true;
 
+  if (PushModelAllocationRecord() != kTfLiteOk) {
+    return nullptr;
+  }
+  tensor_alignment_requests_ = nullptr;
+
   uint8_t* data_allocator_buffer =
       persistent_buffer_allocator_->AllocatePersistentBuffer(
           sizeof(MicroBuiltinDataAllocator),
@@ -530,14 +590,265 @@ TfLiteStatus MicroAllocator::FinishModelAllocation(
   return kTfLiteOk;
 }
 
+TfLiteStatus MicroAllocator::ReleaseLastModelAllocation() {
+  if (model_is_allocating_) {
+    MicroPrintf(
+        "MicroAllocator: Model allocation released before finishing "
+        "allocating model");
+    return kTfLiteError;
+  }
+
+  if (last_model_allocation_ == nullptr) {
+    MicroPrintf("MicroAllocator: No model allocation to release");
+    return kTfLiteError;
+  }
+
+  // Copy the record since it lives in the memory being released.
+  const internal::ModelAllocationRecord record = *last_model_allocation_;
+  TF_LITE_ENSURE_STATUS(
+      persistent_buffer_allocator_->ReleasePersistentBuffersTo(
+          record.persistent_used_bytes));
+
+  last_model_allocation_ = record.previous;
+  builtin_data_allocator_ = record.builtin_data_allocator;
+  max_head_buffer_usage_ = record.max_head_buffer_usage;
+  max_buffer_alignment_ = record.max_buffer_alignment;
+  head_holds_variables_ = record.head_holds_variables;
+
+  // The head only needs to hold the largest plan of the remaining models.
+  return non_persistent_buffer_allocator_->ReserveNonPersistentOverlayMemory(
+      max_head_buffer_usage_, max_buffer_alignment_);
+}
+
+TfLiteStatus MicroAllocator::PushModelAllocationRecord() {
+  // Remember where the persistent allocations of this model start so that the
+  // model can be released later on.
+  const size_t persistent_used_bytes =
+      persistent_buffer_allocator_->GetPersistentUsedBytes();
+  internal::ModelAllocationRecord* record =
+      reinterpret_cast<internal::ModelAllocationRecord*>(
+          persistent_buffer_allocator_->AllocatePersistentBuffer(
+              sizeof(internal::ModelAllocationRecord),
+              alignof(internal::ModelAllocationRecord)));
+  if (record == nullptr) {
+    MicroPrintf("Failed to allocate memory for model allocation record.");
+    return kTfLiteError;
+  }
+  record->previous = last_model_allocation_;
+  record->persistent_used_bytes = persistent_used_bytes;
+  record->max_head_buffer_usage = max_head_buffer_usage_;
+  record->builtin_data_allocator = builtin_data_allocator_;
+  record->max_buffer_alignment = max_buffer_alignment_;
+  record->head_holds_variables = head_holds_variables_;
+  last_model_allocation_ = record;
+  return kTfLiteOk;
+}
+
+SubgraphAllocations* MicroAllocator::AllocateFromPreparedModel(
+    const MicroPreparedModel& prepared_model,
+    ScratchBufferHandle** scratch_buffer_handles) {
+  TFLITE_DCHECK(scratch_buffer_handles != nullptr);
+
+  if (model_is_allocating_) {
+    MicroPrintf(
+        "MicroAllocator: Prepared model allocation started before "
+        "finishing previously allocated model");
+    return nullptr;
+  }
+  if (non_persistent_memory_lent_) {
+    MicroPrintf(
+        "MicroAllocator: Prepared model allocation started while the "
+        "non-persistent memory is lent");
+    return nullptr;
+  }
+
+  const Model* model = prepared_model.model();
+  const SubgraphAllocations* shared_allocations =
+      prepared_model.subgraph_allocations();
+  const uint8_t* shared_overlay = prepared_model.overlay_memory_address();
+  const size_t overlay_size = prepared_model.overlay_memory_size();
+
+  // The instance is a tenant of the arena like any other model, so that it can
+  // be released with ReleaseLastModelAllocation().
+  if (PushModelAllocationRecord() != kTfLiteOk) {
+    return nullptr;
+  }
+
+  // The memory plan of the prepared model is reused as is, so the head only
+  // has to be as large and as aligned as that plan.
+  UpdateMaxBufferAlignment(prepared_model.overlay_memory_alignment());
+  if (max_head_buffer_usage_ < overlay_size) {
+    max_head_buffer_usage_ = overlay_size;
+  }
+  if (non_persistent_buffer_allocator_->ReserveNonPersistentOverlayMemory(
+          max_head_buffer_usage_, max_buffer_alignment_) != kTfLiteOk) {
+    return nullptr;
+  }
+  uint8_t* overlay =
+      non_persistent_buffer_allocator_->GetOverlayMemoryAddress();
+
+  const size_t subgraphs_size = model->subgraphs()->size();
+  SubgraphAllocations* output = reinterpret_cast<SubgraphAllocations*>(
+      persistent_buffer_allocator_->AllocatePersistentBuffer(
+          sizeof(SubgraphAllocations) * subgraphs_size,
+          alignof(SubgraphAllocations)));
+  if (output == nullptr) {
+    MicroPrintf("Failed to allocate memory for model metadata.");
+    return nullptr;
+  }
+
+  // Copy the TfLiteEvalTensors of all subgraphs into a single table.
+  size_t total_count = 0;
+  for (size_t subgraph_idx = 0; subgraph_idx < subgraphs_size;
+       subgraph_idx++) {
+    total_count += model->subgraphs()->Get(subgraph_idx)->tensors()->size();
+  }
+  TfLiteEvalTensor* tensors = reinterpret_cast<TfLiteEvalTensor*>(
+      persistent_buffer_allocator_->AllocatePersistentBuffer(
+          sizeof(TfLiteEvalTensor) * total_count, alignof(TfLiteEvalTensor)));
+  if (tensors == nullptr) {
+    MicroPrintf(
+        "Failed to allocate memory for context->eval_tensors, "
+        "%d bytes required",
+        sizeof(TfLiteEvalTensor) * total_count);
+    return nullptr;
+  }
+
+  for (size_t subgraph_idx = 0; subgraph_idx < subgraphs_size;
+       subgraph_idx++) {
+    const SubGraph* subgraph = model->subgraphs()->Get(subgraph_idx);
+    TFLITE_DCHECK(subgraph != nullptr);
+
+    size_t alloc_count = subgraph->tensors()->size();
+    for (size_t i = 0; i < alloc_count; ++i) {
+      tensors[i] = shared_allocations[subgraph_idx].tensors[i];
+      uint8_t* data = static_cast<uint8_t*>(tensors[i].data.data);
+      if (IsInOverlayMemory(data, shared_overlay, overlay_size)) {
+        // Activation tensors (and offline planned variables) keep their
+        // planned offset in the head of this arena. Variables there make the
+        // head unavailable for lending, as in CommitStaticMemoryPlan().
+        tensors[i].data.data = overlay + (data - shared_overlay);
+        if (subgraph->tensors()->Get(i)->is_variable()) {
+          head_holds_variables_ = true;
+        }
+      } else if (subgraph->tensors()->Get(i)->is_variable()) {
+        size_t buffer_size;
+        if (TfLiteEvalTensorByteLength(&tensors[i], &buffer_size) !=
+            kTfLiteOk) {
+          return nullptr;
+        }
+        tensors[i].data.data =
+            persistent_buffer_allocator_->AllocatePersistentBuffer(
+                buffer_size, MicroArenaBufferAlignment());
+        if (tensors[i].data.data == nullptr) {
+          MicroPrintf("Failed to allocate variable tensor of size %d",
+                      buffer_size);
+          return nullptr;
+        }
+      }
+    }
+    output[subgraph_idx].node_and_registrations =
+        shared_allocations[subgraph_idx].node_and_registrations;
+    output[subgraph_idx].tensors = tensors;
+    tensors += alloc_count;
+  }
+
+  const size_t handle_count = prepared_model.scratch_buffer_count();
+  if (handle_count > 0) {
+    *scratch_buffer_handles = reinterpret_cast<ScratchBufferHandle*>(
+        persistent_buffer_allocator_->AllocatePersistentBuffer(
+            sizeof(ScratchBufferHandle) * handle_count,
+            alignof(ScratchBufferHandle)));
+    if (*scratch_buffer_handles == nullptr) {
+      MicroPrintf("Failed to allocate memory for scratch buffer handles.");
+      return nullptr;
+    }
+    const ScratchBufferHandle* shared_handles =
+        prepared_model.scratch_buffer_handles();
+    for (size_t i = 0; i < handle_count; ++i) {
+      (*scratch_buffer_handles)[i].data =
+          overlay + (shared_handles[i].data - shared_overlay);
+    }
+  }
+  return output;
+}
+
+TfLiteStatus MicroAllocator::LendNonPersistentMemory(uint8_t** buffer,
+                                                     size_t* size) {
+  TFLITE_DCHECK(buffer != nullptr);
+  TFLITE_DCHECK(size != nullptr);
+
+  if (model_is_allocating_) {
+    MicroPrintf(
+        "MicroAllocator: Non-persistent memory lent while a model is "
+        "allocating");
+    return kTfLiteError;
+  }
+  if (non_persistent_memory_lent_) {
+    MicroPrintf("MicroAllocator: Non-persistent memory is already lent");
+    return kTfLiteError;
+  }
+  if (head_holds_variables_) {
+    MicroPrintf(
+        "MicroAllocator: Non-persistent memory holds offline planned variable "
+        "tensors and can not be lent");
+    return kTfLiteError;
+  }
+  if (!non_persistent_buffer_allocator_->IsAllTempDeallocated()) {
+    return kTfLiteError;
+  }
+
+  // The overlay is followed by the unused memory up to the tail, so both can
+  // be handed out as one buffer.
+  *buffer = non_persistent_buffer_allocator_->GetOverlayMemoryAddress();
+  *size = max_head_buffer_usage_ +
+          non_persistent_buffer_allocator_->GetAvailableMemory(1);
+  non_persistent_memory_lent_ = true;
+  return kTfLiteOk;
+}
+
+TfLiteStatus MicroAllocator::ReclaimNonPersistentMemory() {
+  if (!non_persistent_memory_lent_) {
+    MicroPrintf("MicroAllocator: Non-persistent memory is not lent");
+    return kTfLiteError;
+  }
+  non_persistent_memory_lent_ = false;
+  return kTfLiteOk;
+}
+
 void* MicroAllocator::AllocatePersistentBuffer(size_t bytes) {
+  // The tail would grow into the memory lent to the application.
+  if (non_persistent_memory_lent_) {
+    MicroPrintf(
+        "MicroAllocator: Persistent buffer allocated while the non-persistent "
+        "memory is lent");
+    return nullptr;
+  }
   return persistent_buffer_allocator_->AllocatePersistentBuffer(
       bytes, MicroArenaBufferAlignment());
 }
 
+void* MicroAllocator::AllocatePackedWeightBuffer(size_t bytes) {
+  return AllocatePersistentBuffer(bytes);
+}
+
+TfLiteStatus MicroAllocator::RequestScratchBufferInArena(size_t bytes,
+                                                         int subgraph_idx,
+                                                         int* buffer_idx) {
+  return RequestScratchBufferInArena(bytes, MicroArenaBufferAlignment(),
+                                     subgraph_idx, buffer_idx);
+}
+
 TfLiteStatus MicroAllocator::RequestScratchBufferInArena(size_t bytes,
+                                                         size_t alignment,
                                                          int subgraph_idx,
                                                          int* buffer_idx) {
+  if (!IsPowerOfTwo(alignment)) {
+    MicroPrintf("Scratch buffer alignment %d is not a power of two",
+                alignment);
+    return kTfLiteError;
+  }
+
   // All scratch buffer requests are stored in the head section of the arena
   // when a model is in the prepare phase. First align a scratch buffer request
   // pointer to the start of the head:
@@ -567,6 +878,7 @@ TfLiteStatus MicroAllocator::RequestScratchBufferInArena(size_t bytes,
   current_request->bytes = bytes;
   current_request->node_idx = kUnassignedScratchBufferRequestIndex;
   current_request->subgraph_idx = subgraph_idx;
+  current_request->alignment = alignment;
 
   // Assign the current request index to the out-param:
   *buffer_idx = scratch_buffer_request_count_;
@@ -576,6 +888,37 @@ TfLiteStatus MicroAllocator::RequestScratchBufferInArena(size_t bytes,
   return kTfLiteOk;
 }
 
+TfLiteStatus MicroAllocator::RequestTensorAlignment(int tensor_idx,
+                                                    int subgraph_idx,
+                                                    size_t alignment) {
+  if (!model_is_allocating_) {
+    MicroPrintf(
+        "MicroAllocator: Tensor alignment requested outside of model "
+        "allocation");
+    return kTfLiteError;
+  }
+  if (!IsPowerOfTwo(alignment)) {
+    MicroPrintf("Tensor alignment %d is not a power of two", alignment);
+    return kTfLiteError;
+  }
+
+  internal::TensorAlignmentRequest* request =
+      reinterpret_cast<internal::TensorAlignmentRequest*>(
+          persistent_buffer_allocator_->AllocatePersistentBuffer(
+              sizeof(internal::TensorAlignmentRequest),
+              alignof(internal::TensorAlignmentRequest)));
+  if (request == nullptr) {
+    MicroPrintf("Failed to allocate memory for tensor alignment request.");
+    return kTfLiteError;
+  }
+  request->next = tensor_alignment_requests_;
+  request->alignment = alignment;
+  request->tensor_idx = tensor_idx;
+  request->subgraph_idx = subgraph_idx;
+  tensor_alignment_requests_ = request;
+  return kTfLiteOk;
+}
+
 TfLiteStatus MicroAllocator::FinishPrepareNodeAllocations(int node_id) {
   // When a node has finished preparing, all temp allocations performed by the
   // kernel should be cleaned up:
@@ -611,6 +954,10 @@ size_t MicroAllocator::used_bytes() const {
          persistent_buffer_allocator_->GetPersistentUsedBytes();
 }
 
+uint8_t* MicroAllocator::overlay_memory_address() const {
+  return non_persistent_buffer_allocator_->GetOverlayMemoryAddress();
+}
+
 TfLiteStatus MicroAllocator::AllocateNodeAndRegistrations(
     const Model* model, SubgraphAllocations* subgraph_allocations) {
   TFLITE_DCHECK(subgraph_allocations != nullptr);
@@ -873,6 +1220,8 @@ TfLiteStatus MicroAllocator::CommitStaticMemoryPlan(
 
   TF_LITE_ENSURE_STATUS(
       builder.InitializeAllocationInfo(offline_planner_offsets, allocations));
+  TF_LITE_ENSURE_STATUS(
+      builder.ApplyTensorAlignmentRequests(tensor_alignment_requests_));
 
   internal::ScratchBufferRequest* scratch_buffer_requests =
       GetScratchBufferRequests();
@@ -893,14 +1242,21 @@ TfLiteStatus MicroAllocator::CommitStaticMemoryPlan(
   }
 
   memory_planner_->Init(planner_arena, remaining_arena_size);
-  TF_LITE_ENSURE_STATUS(
-      CreatePlan(memory_planner_, allocation_info, allocation_info_count));
+  size_t plan_alignment;
+  TF_LITE_ENSURE_STATUS(CreatePlan(memory_planner_, allocation_info,
+                                   allocation_info_count,
+                                   GetHeadAlignmentLimit(), &plan_alignment));
+
+  // Planned offsets are only aligned relative to the start of the head, so
+  // the start has to be aligned to the largest buffer alignment as well.
+  UpdateMaxBufferAlignment(plan_alignment);
 
   // Commit the plan.
-  TF_LITE_ENSURE_STATUS(
-      CommitPlan(memory_planner_,
-                 non_persistent_buffer_allocator_->GetOverlayMemoryAddress(),
-                 allocation_info, allocation_info_count));
+  uint8_t* overlay = AlignPointerUp(
+      non_persistent_buffer_allocator_->GetOverlayMemoryAddress(),
+      max_buffer_alignment_);
+  TF_LITE_ENSURE_STATUS(CommitPlan(memory_planner_, overlay, allocation_info,
+                                   allocation_info_count));
 
   // Reset all temp allocations used above:
   builder.FreeAllocationInfo();
@@ -915,6 +1271,9 @@ TfLiteStatus MicroAllocator::CommitStaticMemoryPlan(
   memory_planner_->PrintMemoryPlan();
 #endif
   head_usage = memory_planner_->GetMaximumMemorySize();
+  head_holds_variables_ |= builder.HasPlannedVariables();
+  alignment_padding_bytes_ = memory_planner_->GetAlignmentPaddingBytes();
+  tensor_alignment_requests_ = nullptr;
 
   // The head is used to store memory plans for one model at a time during the
   // model preparation stage, and is re-purposed to store scratch buffer handles
@@ -930,10 +1289,38 @@ TfLiteStatus MicroAllocator::CommitStaticMemoryPlan(
   // memory plan sent through the allocator:
   TF_LITE_ENSURE_STATUS(
       non_persistent_buffer_allocator_->ReserveNonPersistentOverlayMemory(
-          max_head_buffer_usage_, MicroArenaBufferAlignment()));
+          max_head_buffer_usage_, max_buffer_alignment_));
   return kTfLiteOk;
 }
 
+size_t MicroAllocator::GetHeadAlignmentLimit() const {
+  // The memory plans of models already placed in the head are relative to its
+  // current start, which must not move.
+  if (max_head_buffer_usage_ == 0) {
+    return SIZE_MAX;
+  }
+  const uintptr_t overlay = reinterpret_cast<uintptr_t>(
+      non_persistent_buffer_allocator_->GetOverlayMemoryAddress());
+  // Largest power of two that divides the address.
+  return overlay & (~overlay + 1);
+}
+
+void MicroAllocator::UpdateMaxBufferAlignment(size_t alignment) {
+  if (alignment <= max_buffer_alignment_) {
+    return;
+  }
+  const size_t limit = GetHeadAlignmentLimit();
+  if (alignment > limit) {
+    MicroPrintf(
+        "Buffers requested at %d-byte alignment are only aligned to %d bytes, "
+        "since the head of the shared arena does not move. Align the arena to "
+        "%d bytes to honor them.",
+        alignment, limit, alignment);
+    alignment = limit;
+  }
+  max_buffer_alignment_ = alignment;
+}
+
 TfLiteStatus MicroAllocator::AllocateScratchBufferHandles(
     ScratchBufferHandle** scratch_buffer_handles, size_t handle_count) {
   TFLITE_DCHECK(scratch_buffer_handles != nullptr);
@@ -28,6 +28,8 @@ limitations under the License.
 
 namespace tflite {
 
+class MicroPreparedModel;
+
 // TODO(b/199402574): rename to tflite_internal or just remove internal
 // namespace.
 namespace internal {
@@ -62,6 +64,40 @@ struct ScratchBufferRequest {
   // have `before` = node_idx and `after` = node_idx.
   int node_idx;
   int subgraph_idx;
+  // Alignment of the start of the buffer in bytes.
+  size_t alignment;
+};
+
+// Holds an alignment requirement declared by a kernel for a tensor during the
+// model prepare stage. Requests are allocated from the tail and form a list
+// that is applied to the tensors planned in the head when the memory plan is
+// committed.
+struct TensorAlignmentRequest {
+  TensorAlignmentRequest* next;
+  size_t alignment;
+  int tensor_idx;
+  int subgraph_idx;
+};
+
+// Holds the allocator state to restore when a model is released from a
+// multi-tenant arena. One record is allocated at the start of every model's
+// persistent allocations, and the records form a stack through the tail
+// section so that the most recently allocated model can be unloaded without
+// resetting the whole arena.
+struct ModelAllocationRecord {
+  ModelAllocationRecord* previous;
+  // Size of the persistent section before the model was allocated.
+  size_t persistent_used_bytes;
+  // Largest head usage of the models that were allocated before this one.
+  size_t max_head_buffer_usage;
+  // Builtin data allocator of the previously allocated model.
+  TfLiteBridgeBuiltinDataAllocator* builtin_data_allocator;
+  // Largest buffer alignment of the models that were allocated before this
+  // one.
+  size_t max_buffer_alignment;
+  // Whether models allocated before this one plan variable tensors in the
+  // head.
+  bool head_holds_variables;
 };
 
 }  // namespace internal
@@ -116,6 +152,15 @@ struct SubgraphAllocations {
 //                                               - ->GetDataSize()
 // persistent area (tail)
 // ************** .memory_allocator->GetBuffer() + ->GetMaxBufferSize()
+//
+// Several models can be co-resident in one arena by sharing a MicroAllocator
+// between their MicroInterpreter instances. The persistent allocations of each
+// model are stacked in the tail, while the head is time-shared and sized for
+// the largest memory plan since only one model is invoked at a time. The most
+// recently allocated model can be unloaded with ReleaseLastModelAllocation()
+// and another model allocated in its place. Since the head does not move once a
+// model is resident, buffers that request more alignment than it has are
+// planned at the alignment it has, and this is reported.
 class MicroAllocator {
  public:
   // Creates a MicroAllocator instance from a given tensor arena. This arena
@@ -187,6 +232,47 @@ class MicroAllocator {
       const Model* model, SubgraphAllocations* subgraph_allocations,
       ScratchBufferHandle** scratch_buffer_handles);
 
+  // Releases all persistent allocations of the most recently allocated model
+  // and shrinks the head back to the largest memory plan of the models that
+  // remain resident. Persistent buffers allocated through this allocator after
+  // that model (e.g. by another interpreter) are released as well, so models
+  // must be unloaded in the reverse order of their allocation. The
+  // MicroInterpreter that owns the model must be destroyed before calling this
+  // method and must not be used afterwards.
+  TfLiteStatus ReleaseLastModelAllocation();
+
+  // Allocates the per-instance state of a model that has already been
+  // allocated and prepared by a MicroPreparedModel. Node and registration
+  // tables, builtin data and kernel data are shared with the prepared model.
+  // Only the TfLiteEvalTensor table, variable tensor buffers and scratch buffer
+  // handles are allocated from the tail, and the head is reserved for the
+  // memory plan of the prepared model. The instance can be released with
+  // ReleaseLastModelAllocation() like any other model. Scratch buffer handles
+  // are stored in the out-param `scratch_buffer_handles`. Returns a pointer to
+  // an array of SubgraphAllocations or nullptr if the allocations failed.
+  SubgraphAllocations* AllocateFromPreparedModel(
+      const MicroPreparedModel& prepared_model,
+      ScratchBufferHandle** scratch_buffer_handles);
+
+  // Lends the non-persistent section of the arena, i.e. the head and the
+  // unused memory between the head and the tail, to the application while no
+  // model is invoked. Only activation tensors and scratch buffers live there,
+  // and their content is not needed across invocations. The content of input
+  // and output tensors is lost, so inputs must be written after the memory has
+  // been reclaimed. Fails if a model is allocating or if offline planned
+  // variable tensors are kept in the head. No model can be allocated or
+  // invoked with this allocator until ReclaimNonPersistentMemory() is called.
+  TfLiteStatus LendNonPersistentMemory(uint8_t** buffer, size_t* size);
+
+  // Takes back the memory handed out by LendNonPersistentMemory(). The
+  // application must not access it anymore.
+  TfLiteStatus ReclaimNonPersistentMemory();
+
+  // Returns true while the non-persistent section is lent to the application.
+  bool is_non_persistent_memory_lent() const {
+    return non_persistent_memory_lent_;
+  }
+
   // Allocates a TfLiteTensor struct and populates the returned value with
   // properties from the model flatbuffer. This struct is allocated from
   // persistent arena memory is only guaranteed for the lifetime of the
@@ -231,6 +317,10 @@ class MicroAllocator {
   // arena.
   virtual void* AllocatePersistentBuffer(size_t bytes);
 
+  // Same as AllocatePersistentBuffer, for weights that a kernel has repacked
+  // into its own layout. Kept apart so that subclasses can account for them.
+  virtual void* AllocatePackedWeightBuffer(size_t bytes);
+
   // Register a scratch buffer of size `bytes` for Node with `node_id`.
   // This method only requests a buffer with a given size to be used after a
   // model has finished allocation via FinishModelAllocation(). All requested
@@ -238,6 +328,18 @@ class MicroAllocator {
   TfLiteStatus RequestScratchBufferInArena(size_t bytes, int subgraph_idx,
                                            int* buffer_idx);
 
+  // Same as above, but the buffer will start at a multiple of `alignment`
+  // bytes. `alignment` must be a power of two.
+  TfLiteStatus RequestScratchBufferInArena(size_t bytes, size_t alignment,
+                                           int subgraph_idx, int* buffer_idx);
+
+  // Asks for the data of the tensor at `tensor_idx` to start at a multiple of
+  // `alignment` bytes once the model has finished allocation. Only tensors
+  // planned in the head are moved to honor the request, for any other tensor
+  // (e.g. weights in the flatbuffer) an unmet request is reported.
+  TfLiteStatus RequestTensorAlignment(int tensor_idx, int subgraph_idx,
+                                      size_t alignment);
+
   // Finish allocating a specific NodeAndRegistration prepare block (kernel
   // entry for a model) with a given node ID. This call ensures that any scratch
   // buffer requests and temporary allocations are handled and ready for the
@@ -248,6 +350,24 @@ class MicroAllocator {
   // `FinishModelAllocation`. Otherwise, it will return 0.
   size_t used_bytes() const;
 
+  // Returns the start of the head section used for activation tensors and
+  // scratch buffers, and the size of the largest memory plan placed there.
+  // Both are only meaningful after `FinishModelAllocation`.
+  uint8_t* overlay_memory_address() const;
+  size_t overlay_memory_size() const { return max_head_buffer_usage_; }
+
+  // Returns the largest alignment of the buffers planned in the head, which
+  // the overlay memory address is aligned to.
+  size_t overlay_memory_alignment() const { return max_buffer_alignment_; }
+
+  // Returns the number of bytes of the head left unused to honor buffer
+  // alignments in the memory plan of the model allocated last.
+  size_t alignment_padding_bytes() const { return alignment_padding_bytes_; }
+
+  // Returns the number of scratch buffers requested by the model allocated
+  // last.
+  size_t scratch_buffer_count() const { return scratch_buffer_request_count_; }
+
   TfLiteBridgeBuiltinDataAllocator* GetBuiltinDataAllocator();
 
  protected:
@@ -303,6 +423,19 @@ class MicroAllocator {
       const Model* model, SubgraphAllocations* allocations,
       ScratchBufferHandle* scratch_buffer_handles);
 
+  // Allocates a ModelAllocationRecord of the current allocator state and makes
+  // it the most recent one, so that the model allocated next can be released.
+  TfLiteStatus PushModelAllocationRecord();
+
+  // Returns the largest alignment the start of the head can be given: any
+  // alignment while it is unused, otherwise the alignment it already has.
+  size_t GetHeadAlignmentLimit() const;
+
+  // Raises the alignment of the start of the head to `alignment` if needed.
+  // An alignment that would move the memory plans of models already allocated
+  // is reported and lowered to GetHeadAlignmentLimit().
+  void UpdateMaxBufferAlignment(size_t alignment);
+
   // Allocates an array of ScratchBufferHandle structs in the tail section for a
   // given number of handles.
   virtual TfLiteStatus AllocateScratchBufferHandles(
@@ -322,7 +455,7 @@ class MicroAllocator {
   IPersistentBufferAllocator* persistent_buffer_allocator_;
 
   // Allocator used to allocate persistent builtin data.
-  TfLiteBridgeBuiltinDataAllocator* builtin_data_allocator_;
+  TfLiteBridgeBuiltinDataAllocator* builtin_data_allocator_ = nullptr;
 
   // Activation buffer memory planner.
   MicroMemoryPlanner* memory_planner_;
@@ -340,6 +473,27 @@ class MicroAllocator {
   // to ensure that multi-tenant allocations can share the head for buffers.
   size_t max_head_buffer_usage_ = 0;
 
+  // Record of the most recently allocated model, used to release it from the
+  // arena.
+  internal::ModelAllocationRecord* last_model_allocation_ = nullptr;
+
+  // Alignment requests of tensors of the model that is allocating.
+  internal::TensorAlignmentRequest* tensor_alignment_requests_ = nullptr;
+
+  // Holds the largest alignment of the buffers planned in the head. The start
+  // of the head is aligned to it, so that the planned offsets stay aligned.
+  size_t max_buffer_alignment_;
+
+  // Padding inserted by the memory planner to honor buffer alignments.
+  size_t alignment_padding_bytes_ = 0;
+
+  // Whether offline planned variable tensors are placed in the head, which
+  // then can not be lent to the application.
+  bool head_holds_variables_ = false;
+
+  // Whether the non-persistent section is lent to the application.
+  bool non_persistent_memory_lent_ = false;
+
   TF_LITE_REMOVE_VIRTUAL_DELETE
 };
 
@@ -23,6 +23,24 @@ namespace tflite {
 // requirement for SIMD extensions.
 constexpr int MicroArenaBufferAlignment() { return 16; }
 
+// The alignment vectorized float kernels ask for: the register width of x86
+// builds with AVX or AVX-512, and the default alignment elsewhere, so that
+// cacheless cores pay no padding. Targets that gain from more, e.g. cores with
+// a data cache or DMA engines, define TF_LITE_MICRO_VECTOR_BUFFER_ALIGNMENT.
+#if defined(TF_LITE_MICRO_VECTOR_BUFFER_ALIGNMENT)
+constexpr int MicroArenaVectorBufferAlignment() {
+  return TF_LITE_MICRO_VECTOR_BUFFER_ALIGNMENT;
+}
+#elif defined(__AVX512F__)
+constexpr int MicroArenaVectorBufferAlignment() { return 64; }
+#elif defined(__AVX__)
+constexpr int MicroArenaVectorBufferAlignment() { return 32; }
+#else
+constexpr int MicroArenaVectorBufferAlignment() {
+  return MicroArenaBufferAlignment();
+}
+#endif
+
 }  // namespace tflite
 
 #endif  // TENSORFLOW_LITE_MICRO_MICRO_ARENA_CONSTANTS_H_
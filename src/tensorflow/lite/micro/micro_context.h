@@ -18,8 +18,12 @@ limitations under the License.
 
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/micro/micro_graph.h"
+#include "tensorflow/lite/micro/micro_kernel_tuning.h"
 
 namespace tflite {
+struct QuantizationParameters;
+struct SparsityParameters;
+
 // TODO(b/149795762): kTfLiteAbort cannot be part of the tflite TfLiteStatus.
 const TfLiteStatus kTfLiteAbort = static_cast<TfLiteStatus>(15);
 
@@ -39,6 +43,15 @@ class MicroContext {
   // This method is only available in Init or Prepare stage.
   virtual void* AllocatePersistentBuffer(size_t bytes) = 0;
 
+  // Allocate a persistent buffer for a copy of constant weights that a kernel
+  // rearranges at Prepare into the layout its inner loops read, e.g. packed or
+  // transformed filters with precomputed sums. Same life time and availability
+  // as AllocatePersistentBuffer, but accounted separately so the cost of the
+  // copies shows up in arena audits. Returns nullptr on failure.
+  virtual void* AllocatePackedWeightBuffer(size_t bytes) {
+    return AllocatePersistentBuffer(bytes);
+  }
+
   // Request a scratch buffer in the arena through static memory planning.
   // This method is only available in Prepare stage and the buffer is allocated
   // by the interpreter between Prepare and Eval stage. In Eval stage,
@@ -46,6 +59,27 @@ class MicroContext {
   virtual TfLiteStatus RequestScratchBufferInArena(size_t bytes,
                                                    int* buffer_idx) = 0;
 
+  // Request a scratch buffer that starts at a multiple of `alignment` bytes,
+  // e.g. for SIMD loads or DMA transfers that need more than the default arena
+  // alignment. `alignment` must be a power of two. Same availability as
+  // RequestScratchBufferInArena. By default, it returns an error.
+  virtual TfLiteStatus RequestAlignedScratchBufferInArena(size_t bytes,
+                                                          size_t alignment,
+                                                          int* buffer_idx) {
+    return kTfLiteError;
+  }
+
+  // Asks for the data of the tensor at `tensor_idx` to start at a multiple of
+  // `alignment` bytes during Eval. Activation tensors are placed accordingly
+  // by the memory planner. Other tensors (e.g. weights) are not moved, and a
+  // request they do not meet is reported, so kernels must still handle any
+  // alignment. This method is only available in Prepare stage. By default, the
+  // request has no effect.
+  virtual TfLiteStatus RequestTensorAlignment(int tensor_idx,
+                                              size_t alignment) {
+    return kTfLiteOk;
+  }
+
   // Get the scratch buffer pointer.
   // This method is only available in Eval stage.
   virtual void* GetScratchBuffer(int buffer_idx) = 0;
@@ -86,6 +120,21 @@ class MicroContext {
   // Returns a TfLiteEvalTensor struct for a given index.
   virtual TfLiteEvalTensor* GetEvalTensor(int tensor_idx) = 0;
 
+  // Returns the sparsity parameters stored in the model for the tensor at
+  // `tensor_idx`, or nullptr if the tensor is dense. The data of a sparse
+  // tensor holds only its non-zero blocks, while its dims are those of the
+  // dense tensor. By default, all tensors are dense.
+  virtual const SparsityParameters* GetTensorSparsity(int tensor_idx) {
+    return nullptr;
+  }
+
+  // Returns the quantization parameters stored in the model for the tensor at
+  // `tensor_idx`, or nullptr if there are none. Unlike the quantization of a
+  // TfLiteTensor, these include the custom quantization details.
+  virtual const QuantizationParameters* GetTensorQuantization(int tensor_idx) {
+    return nullptr;
+  }
+
   // Does not take ownership of the pointer and the pointer must refer to valid
   // an object that outlive this class instance.
   // This can only be called once to set one external context.
@@ -93,6 +142,10 @@ class MicroContext {
 
   virtual void* external_context() = 0;
 
+  // Returns the table of kernel autotuning results set by the application, or
+  // nullptr if kernels should not autotune.
+  virtual MicroKernelTuningTable* kernel_tuning_table() { return nullptr; }
+
   virtual MicroGraph& graph() = 0;
 
  private:
@@ -27,6 +27,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/micro_interpreter_context.h"
 #include "tensorflow/lite/micro/micro_log.h"
 #include "tensorflow/lite/micro/micro_op_resolver.h"
+#include "tensorflow/lite/micro/micro_prepared_model.h"
 #include "tensorflow/lite/micro/micro_profiler_interface.h"
 #include "tensorflow/lite/micro/tflite_bridge/flatbuffer_conversions_bridge.h"
 #include "tensorflow/lite/schema/schema_generated.h"
@@ -81,8 +82,48 @@ MicroInterpreter::MicroInterpreter(const Model* model,
   Init(profiler);
 }
 
+MicroInterpreter::MicroInterpreter(const MicroPreparedModel& prepared_model,
+                                   uint8_t* tensor_arena,
+                                   size_t tensor_arena_size,
+                                   MicroProfilerInterface* profiler)
+    : model_(prepared_model.model()),
+      op_resolver_(prepared_model.op_resolver()),
+      allocator_(*MicroAllocator::Create(tensor_arena, tensor_arena_size)),
+      graph_(&context_, model_, &allocator_, nullptr),
+      tensors_allocated_(false),
+      initialization_status_(kTfLiteError),
+      input_tensors_(nullptr),
+      output_tensors_(nullptr),
+      micro_context_(&allocator_, model_, &graph_),
+      prepared_model_(&prepared_model) {
+  Init(profiler);
+  if (prepared_model.initialization_status() != kTfLiteOk) {
+    initialization_status_ = kTfLiteError;
+  }
+}
+
+MicroInterpreter::MicroInterpreter(const MicroPreparedModel& prepared_model,
+                                   MicroAllocator* allocator,
+                                   MicroProfilerInterface* profiler)
+    : model_(prepared_model.model()),
+      op_resolver_(prepared_model.op_resolver()),
+      allocator_(*allocator),
+      graph_(&context_, model_, allocator, nullptr),
+      tensors_allocated_(false),
+      initialization_status_(kTfLiteError),
+      input_tensors_(nullptr),
+      output_tensors_(nullptr),
+      micro_context_(&allocator_, model_, &graph_),
+      prepared_model_(&prepared_model) {
+  Init(profiler);
+  if (prepared_model.initialization_status() != kTfLiteOk) {
+    initialization_status_ = kTfLiteError;
+  }
+}
+
 MicroInterpreter::~MicroInterpreter() {
-  if (graph_.GetAllocations() != nullptr) {
+  // The kernel data of a prepared model is owned by the prepared model.
+  if (graph_.GetAllocations() != nullptr && prepared_model_ == nullptr) {
     graph_.FreeSubgraphs();
   }
 }
@@ -198,6 +239,10 @@ TfLiteStatus MicroInterpreter::PrepareNodeAndRegistrationDataFromFlatbuffer() {
 }
 
 TfLiteStatus MicroInterpreter::AllocateTensors() {
+  if (prepared_model_ != nullptr) {
+    return AllocateTensorsFromPreparedModel();
+  }
+
   SubgraphAllocations* allocations = allocator_.StartModelAllocation(model_);
 
   if (allocations == nullptr) {
@@ -228,6 +273,43 @@ TfLiteStatus MicroInterpreter::AllocateTensors() {
 
   micro_context_.SetScratchBufferHandles(scratch_buffer_handles_);
 
+  TF_LITE_ENSURE_STATUS(AllocateInputAndOutputTensors());
+
+  TF_LITE_ENSURE_STATUS(Reset());
+
+  tensors_allocated_ = true;
+  micro_context_.SetInterpreterState(
+      MicroInterpreterContext::InterpreterState::kInvoke);
+  return kTfLiteOk;
+}
+
+TfLiteStatus MicroInterpreter::AllocateTensorsFromPreparedModel() {
+  if (initialization_status_ != kTfLiteOk) {
+    MicroPrintf("Prepared model failed to initialize.\n");
+    return kTfLiteError;
+  }
+
+  SubgraphAllocations* allocations = allocator_.AllocateFromPreparedModel(
+      *prepared_model_, &scratch_buffer_handles_);
+  if (allocations == nullptr) {
+    MicroPrintf("Failed allocating prepared model.\n");
+    initialization_status_ = kTfLiteError;
+    return kTfLiteError;
+  }
+
+  graph_.SetSubgraphAllocations(allocations);
+  micro_context_.SetScratchBufferHandles(scratch_buffer_handles_);
+
+  TF_LITE_ENSURE_STATUS(AllocateInputAndOutputTensors());
+  TF_LITE_ENSURE_STATUS(Reset());
+
+  tensors_allocated_ = true;
+  micro_context_.SetInterpreterState(
+      MicroInterpreterContext::InterpreterState::kInvoke);
+  return kTfLiteOk;
+}
+
+TfLiteStatus MicroInterpreter::AllocateInputAndOutputTensors() {
   // TODO(b/162311891): Drop these allocations when the interpreter supports
   // handling buffers from TfLiteEvalTensor.
   input_tensors_ =
@@ -272,11 +354,6 @@ TfLiteStatus MicroInterpreter::AllocateTensors() {
     }
   }
 
-  TF_LITE_ENSURE_STATUS(Reset());
-
-  tensors_allocated_ = true;
-  micro_context_.SetInterpreterState(
-      MicroInterpreterContext::InterpreterState::kInvoke);
   return kTfLiteOk;
 }
 
@@ -286,6 +363,11 @@ TfLiteStatus MicroInterpreter::Invoke() {
     return kTfLiteError;
   }
 
+  if (allocator_.is_non_persistent_memory_lent()) {
+    MicroPrintf("Invoke() called while the arena is lent\n");
+    return kTfLiteError;
+  }
+
   // Ensure tensors are allocated before the interpreter is invoked to avoid
   // difficult to debug segfaults.
   if (!tensors_allocated_) {
@@ -294,6 +376,18 @@ TfLiteStatus MicroInterpreter::Invoke() {
   return graph_.InvokeSubgraph(0);
 }
 
+TfLiteStatus MicroInterpreter::LendArena(uint8_t** buffer, size_t* size) {
+  if (!tensors_allocated_) {
+    MicroPrintf("LendArena() called before AllocateTensors()");
+    return kTfLiteError;
+  }
+  return allocator_.LendNonPersistentMemory(buffer, size);
+}
+
+TfLiteStatus MicroInterpreter::ReclaimArena() {
+  return allocator_.ReclaimNonPersistentMemory();
+}
+
 TfLiteTensor* MicroInterpreter::input(size_t index) {
   const size_t length = inputs_size();
   if (index >= length) {
@@ -313,6 +407,11 @@ TfLiteTensor* MicroInterpreter::output(size_t index) {
 }
 
 TfLiteStatus MicroInterpreter::Reset() {
+  // Kernel data of a prepared model is shared with other interpreters and must
+  // not be reset from any of them.
+  if (prepared_model_ != nullptr) {
+    return graph_.ResetVariableTensors();
+  }
   TfLiteStatus status = graph_.ResetSubgraphs();
   if (status != kTfLiteOk) {
     return status;
@@ -334,4 +433,15 @@ TfLiteStatus MicroInterpreter::SetMicroExternalContext(
   return micro_context_.set_external_context(external_context_payload);
 }
 
+TfLiteStatus MicroInterpreter::SetKernelTuningTable(
+    MicroKernelTuningTable* table) {
+  if (tensors_allocated_) {
+    MicroPrintf(
+        "SetKernelTuningTable() must be called before AllocateTensors().");
+    return kTfLiteError;
+  }
+  micro_context_.set_kernel_tuning_table(table);
+  return kTfLiteOk;
+}
+
 }  // namespace tflite
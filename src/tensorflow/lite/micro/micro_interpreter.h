@@ -26,6 +26,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/micro_allocator.h"
 #include "tensorflow/lite/micro/micro_interpreter_context.h"
 #include "tensorflow/lite/micro/micro_interpreter_graph.h"
+#include "tensorflow/lite/micro/micro_kernel_tuning.h"
 #include "tensorflow/lite/micro/micro_op_resolver.h"
 #include "tensorflow/lite/micro/micro_profiler_interface.h"
 #include "tensorflow/lite/portable_type_to_tflitetype.h"
@@ -37,6 +38,8 @@ limitations under the License.
 
 namespace tflite {
 
+class MicroPreparedModel;
+
 class MicroInterpreter {
  public:
   // The lifetime of the model, op resolver, tensor arena, error reporter,
@@ -57,12 +60,33 @@ class MicroInterpreter {
   // This constructor should be used when creating an allocator that needs to
   // have allocation handled in more than one interpreter or for recording
   // allocations inside the interpreter. The lifetime of the allocator must be
-  // as long as that of the interpreter object.
+  // as long as that of the interpreter object. Once the interpreter has been
+  // destroyed, its model can be unloaded from a shared arena with
+  // MicroAllocator::ReleaseLastModelAllocation().
   MicroInterpreter(const Model* model, const MicroOpResolver& op_resolver,
                    MicroAllocator* allocator,
                    MicroResourceVariables* resource_variables = nullptr,
                    MicroProfilerInterface* profiler = nullptr);
 
+  // Create an interpreter instance that shares the node and registration
+  // tables, builtin data and kernel data of an already prepared model. Only
+  // activation tensors, scratch buffers, variable tensors and the input and
+  // output TfLiteTensor structs are allocated from the tensor arena, and
+  // AllocateTensors() does not run the Init and Prepare stages of the kernels.
+  // The lifetime of the prepared model and tensor arena must be at least as
+  // long as that of the interpreter object.
+  MicroInterpreter(const MicroPreparedModel& prepared_model,
+                   uint8_t* tensor_arena, size_t tensor_arena_size,
+                   MicroProfilerInterface* profiler = nullptr);
+
+  // Same as above, with the per-instance state allocated from an existing
+  // MicroAllocator so that the instance can share an arena with other models.
+  // Once the interpreter has been destroyed, the instance can be unloaded with
+  // MicroAllocator::ReleaseLastModelAllocation().
+  MicroInterpreter(const MicroPreparedModel& prepared_model,
+                   MicroAllocator* allocator,
+                   MicroProfilerInterface* profiler = nullptr);
+
   ~MicroInterpreter();
 
   // Runs through the model and allocates all necessary input, output and
@@ -80,6 +104,15 @@ class MicroInterpreter {
   // one external context.
   TfLiteStatus SetMicroExternalContext(void* external_context_payload);
 
+  // Lets kernels with several implementations of an operator pick the fastest
+  // one for each node: results found in `table` are reused, and the remaining
+  // configurations are microbenchmarked during the first Invoke() and added to
+  // the table. Without a table, kernels use their default implementation.
+  // Must be called before AllocateTensors(), and has no effect on interpreters
+  // created from a MicroPreparedModel, whose kernels are already prepared. The
+  // table is not owned and must outlive the interpreter.
+  TfLiteStatus SetKernelTuningTable(MicroKernelTuningTable* table);
+
   TfLiteTensor* input(size_t index);
   size_t inputs_size() const {
     return model_->subgraphs()->Get(0)->inputs()->size();
@@ -125,6 +158,20 @@ class MicroInterpreter {
 
   TfLiteStatus initialization_status() const { return initialization_status_; }
 
+  // Hands the part of the arena that only holds activation tensors and scratch
+  // buffers to the application while the interpreter is idle, e.g. to reuse it
+  // for audio or image buffers between inferences. Variable tensors, resource
+  // variables and kernel data stay in the persistent section and are not
+  // affected. The content of the input and output tensors is lost, so the
+  // outputs must be read before and the inputs written after the memory is
+  // lent. Invoke() fails until ReclaimArena() is called. When several
+  // interpreters share a MicroAllocator, none of them can be invoked while the
+  // memory is lent. Only available after `AllocateTensors` has been called.
+  TfLiteStatus LendArena(uint8_t** buffer, size_t* size);
+
+  // Takes back the memory handed out by LendArena() before the next Invoke().
+  TfLiteStatus ReclaimArena();
+
   // Populates node and registration pointers representing the inference graph
   // of the model from values inside the flatbuffer (loaded from the TfLiteModel
   // instance). Persistent data (e.g. operator data) is allocated from the
@@ -158,6 +205,13 @@ class MicroInterpreter {
   // Gets the current subgraph index used from within context methods.
   int get_subgraph_index() { return graph_.GetCurrentSubgraphIndex(); }
 
+  // Allocates the per-instance state of an interpreter created from a
+  // MicroPreparedModel.
+  TfLiteStatus AllocateTensorsFromPreparedModel();
+
+  // Allocates the input and output TfLiteTensor structs of the first subgraph.
+  TfLiteStatus AllocateInputAndOutputTensors();
+
   const Model* model_;
   const MicroOpResolver& op_resolver_;
   TfLiteContext context_ = {};
@@ -175,6 +229,11 @@ class MicroInterpreter {
   TfLiteTensor** output_tensors_;
 
   MicroInterpreterContext micro_context_;
+
+  // Set when the kernel state is shared with other interpreters.
+  const MicroPreparedModel* prepared_model_ = nullptr;
+
+  friend class MicroPreparedModel;
 };
 
 }  // namespace tflite
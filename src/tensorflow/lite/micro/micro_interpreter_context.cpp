@@ -36,6 +36,12 @@ void* MicroInterpreterContext::AllocatePersistentBuffer(size_t bytes) {
   return allocator_.AllocatePersistentBuffer(bytes);
 }
 
+void* MicroInterpreterContext::AllocatePackedWeightBuffer(size_t bytes) {
+  TFLITE_DCHECK(state_ == InterpreterState::kPrepare ||
+                state_ == InterpreterState::kInit);
+  return allocator_.AllocatePackedWeightBuffer(bytes);
+}
+
 TfLiteStatus MicroInterpreterContext::RequestScratchBufferInArena(
     size_t bytes, int* buffer_idx) {
   TFLITE_DCHECK(state_ == InterpreterState::kPrepare);
@@ -43,6 +49,20 @@ TfLiteStatus MicroInterpreterContext::RequestScratchBufferInArena(
       bytes, graph_.GetCurrentSubgraphIndex(), buffer_idx);
 }
 
+TfLiteStatus MicroInterpreterContext::RequestAlignedScratchBufferInArena(
+    size_t bytes, size_t alignment, int* buffer_idx) {
+  TFLITE_DCHECK(state_ == InterpreterState::kPrepare);
+  return allocator_.RequestScratchBufferInArena(
+      bytes, alignment, graph_.GetCurrentSubgraphIndex(), buffer_idx);
+}
+
+TfLiteStatus MicroInterpreterContext::RequestTensorAlignment(
+    int tensor_idx, size_t alignment) {
+  TFLITE_DCHECK(state_ == InterpreterState::kPrepare);
+  return allocator_.RequestTensorAlignment(
+      tensor_idx, graph_.GetCurrentSubgraphIndex(), alignment);
+}
+
 void* MicroInterpreterContext::GetScratchBuffer(int buffer_idx) {
   TFLITE_DCHECK(state_ == InterpreterState::kInvoke);
   ScratchBufferHandle* handle = scratch_buffer_handles_ + buffer_idx;
@@ -76,6 +96,20 @@ TfLiteEvalTensor* MicroInterpreterContext::GetEvalTensor(int tensor_idx) {
               .tensors[tensor_idx];
 }
 
+const SparsityParameters* MicroInterpreterContext::GetTensorSparsity(
+    int tensor_idx) {
+  const SubGraph* subgraph =
+      model_->subgraphs()->Get(graph_.GetCurrentSubgraphIndex());
+  return subgraph->tensors()->Get(tensor_idx)->sparsity();
+}
+
+const QuantizationParameters* MicroInterpreterContext::GetTensorQuantization(
+    int tensor_idx) {
+  const SubGraph* subgraph =
+      model_->subgraphs()->Get(graph_.GetCurrentSubgraphIndex());
+  return subgraph->tensors()->Get(tensor_idx)->quantization();
+}
+
 void MicroInterpreterContext::SetScratchBufferHandles(
     ScratchBufferHandle* scratch_buffer_handles) {
   scratch_buffer_handles_ = scratch_buffer_handles;
@@ -51,6 +51,11 @@ class MicroInterpreterContext : public MicroContext {
   // Virtual so that it can be faked for kernel tests.
   virtual void* AllocatePersistentBuffer(size_t bytes) override;
 
+  // Allocate persistent buffer for weights repacked by a kernel, accounted
+  // separately by the allocator.
+  // This method is only available in Init or Prepare stage.
+  virtual void* AllocatePackedWeightBuffer(size_t bytes) override;
+
   // Request a scratch buffer in the arena through static memory planning.
   // This method is only available in Prepare stage and the buffer is allocated
   // by the interpreter between Prepare and Eval stage. In Eval stage,
@@ -59,6 +64,18 @@ class MicroInterpreterContext : public MicroContext {
   virtual TfLiteStatus RequestScratchBufferInArena(size_t bytes,
                                                    int* buffer_idx) override;
 
+  // Request a scratch buffer that starts at a multiple of `alignment` bytes.
+  // This method is only available in Prepare stage.
+  // Virtual so that it can be faked for kernel tests.
+  virtual TfLiteStatus RequestAlignedScratchBufferInArena(
+      size_t bytes, size_t alignment, int* buffer_idx) override;
+
+  // Requires the data of a tensor to start at a multiple of `alignment` bytes.
+  // This method is only available in Prepare stage.
+  // Virtual so that it can be faked for kernel tests.
+  virtual TfLiteStatus RequestTensorAlignment(int tensor_idx,
+                                              size_t alignment) override;
+
   // Get the scratch buffer pointer.
   // This method is only available in Eval stage.
   // Virtual so that it can be faked for kernel tests.
@@ -86,6 +103,12 @@ class MicroInterpreterContext : public MicroContext {
   // Virtual so that it can be faked for kernel tests.
   virtual TfLiteEvalTensor* GetEvalTensor(int tensor_idx) override;
 
+  // Returns the sparsity parameters of a tensor in the current subgraph.
+  const SparsityParameters* GetTensorSparsity(int tensor_idx) override;
+
+  // Returns the quantization parameters of a tensor in the current subgraph.
+  const QuantizationParameters* GetTensorQuantization(int tensor_idx) override;
+
   // Sets the State of MemoryPlanning MicroInterpreterContext
   void SetInterpreterState(InterpreterState state);
 
@@ -99,6 +122,15 @@ class MicroInterpreterContext : public MicroContext {
 
   void* external_context() override { return external_context_payload_; }
 
+  MicroKernelTuningTable* kernel_tuning_table() override {
+    return kernel_tuning_table_;
+  }
+
+  // Sets the table of kernel autotuning results. Does not take ownership.
+  void set_kernel_tuning_table(MicroKernelTuningTable* kernel_tuning_table) {
+    kernel_tuning_table_ = kernel_tuning_table;
+  }
+
   MicroGraph& graph() override { return graph_; }
 
   // Sets the pointer to a list of ScratchBufferHandle instances.
@@ -114,6 +146,7 @@ class MicroInterpreterContext : public MicroContext {
 
   ScratchBufferHandle* scratch_buffer_handles_ = nullptr;
   void* external_context_payload_ = nullptr;
+  MicroKernelTuningTable* kernel_tuning_table_ = nullptr;
 
   TF_LITE_REMOVE_VIRTUAL_DELETE
 };
@@ -0,0 +1,55 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/micro_kernel_tuning.h"
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_types.h"
+
+namespace tflite {
+
+MicroKernelTuningTable::MicroKernelTuningTable(MicroKernelTuningEntry* entries,
+                                               int capacity, int size)
+    : entries_(entries),
+      capacity_(capacity),
+      size_(size < capacity ? size : capacity) {}
+
+int MicroKernelTuningTable::Lookup(uint32_t key) const {
+  for (int i = 0; i < size_; ++i) {
+    if (entries_[i].key == key) {
+      return static_cast<int>(entries_[i].backend);
+    }
+  }
+  return -1;
+}
+
+TfLiteStatus MicroKernelTuningTable::Insert(uint32_t key, int backend) {
+  for (int i = 0; i < size_; ++i) {
+    if (entries_[i].key == key) {
+      entries_[i].backend = static_cast<uint32_t>(backend);
+      return kTfLiteOk;
+    }
+  }
+  if (size_ >= capacity_) {
+    return kTfLiteError;
+  }
+  entries_[size_].key = key;
+  entries_[size_].backend = static_cast<uint32_t>(backend);
+  ++size_;
+  return kTfLiteOk;
+}
+
+}  // namespace tflite
@@ -0,0 +1,72 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_MICRO_KERNEL_TUNING_H_
+#define TENSORFLOW_LITE_MICRO_MICRO_KERNEL_TUNING_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_types.h"
+
+namespace tflite {
+
+// Autotuning result for one operator configuration. `key` identifies the
+// operator, its shapes and parameters, and `backend` is the index of the
+// fastest implementation in the kernel's list of backends.
+struct MicroKernelTuningEntry {
+  uint32_t key;
+  uint32_t backend;
+};
+
+// Fixed-capacity table of kernel autotuning results. Kernels that ship more
+// than one implementation of an operator (see kernels/kernel_backend.h) look
+// up their configuration here in Prepare. On a miss, they time every eligible
+// implementation during the first Invoke and record the fastest one.
+//
+// The entries are plain data owned by the application. They can be saved
+// after a run and passed back to a later run of the same binary, so that the
+// microbenchmarks are skipped. Backend indices are only meaningful for the
+// binary that produced them.
+class MicroKernelTuningTable {
+ public:
+  // Does not take ownership of `entries`, which must hold `capacity` entries
+  // and outlive the table. The first `size` entries are valid, e.g. restored
+  // from a previous run.
+  MicroKernelTuningTable(MicroKernelTuningEntry* entries, int capacity,
+                         int size = 0);
+
+  // Returns the recorded backend for `key`, or -1 if there is none.
+  int Lookup(uint32_t key) const;
+
+  // Records `backend` as the result for `key`, replacing any previous result.
+  // Returns kTfLiteError if the table is full.
+  TfLiteStatus Insert(uint32_t key, int backend);
+
+  // Forgets all results.
+  void Clear() { size_ = 0; }
+
+  const MicroKernelTuningEntry* entries() const { return entries_; }
+  int size() const { return size_; }
+  int capacity() const { return capacity_; }
+
+ private:
+  MicroKernelTuningEntry* entries_;
+  int capacity_;
+  int size_;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_MICRO_KERNEL_TUNING_H_
@@ -0,0 +1,46 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/micro_prepared_model.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_types.h"
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_log.h"
+
+namespace tflite {
+
+MicroPreparedModel::MicroPreparedModel(const Model* model,
+                                       const MicroOpResolver& op_resolver,
+                                       uint8_t* tensor_arena,
+                                       size_t tensor_arena_size)
+    : model_(model),
+      op_resolver_(op_resolver),
+      allocator_(MicroAllocator::Create(tensor_arena, tensor_arena_size)),
+      interpreter_(model, op_resolver, allocator_),
+      initialization_status_(kTfLiteError) {
+  if (interpreter_.AllocateTensors() != kTfLiteOk) {
+    MicroPrintf("Failed to prepare model.");
+    return;
+  }
+  subgraph_allocations_ = interpreter_.graph_.GetAllocations();
+  scratch_buffer_handles_ = interpreter_.scratch_buffer_handles_;
+  initialization_status_ = kTfLiteOk;
+}
+
+}  // namespace tflite
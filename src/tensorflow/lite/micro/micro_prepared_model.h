@@ -0,0 +1,100 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MICRO_MICRO_PREPARED_MODEL_H_
+#define TENSORFLOW_LITE_MICRO_MICRO_PREPARED_MODEL_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_types.h"
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_op_resolver.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+
+// Holds the immutable state of a model that has been allocated and prepared
+// once: node and registration tables, parsed builtin data, kernel data (e.g.
+// per-channel multipliers) and the memory plan. Any number of MicroInterpreter
+// instances can be created from the same MicroPreparedModel, each one only
+// owning its activation tensors, scratch buffers and variable tensors.
+//
+// A MicroPreparedModel is not modified after its construction, so it can be
+// shared between interpreters running concurrently on different threads. The
+// lifetime of the model, op resolver and tensor arena must be at least as long
+// as that of the MicroPreparedModel, which in turn must outlive all the
+// interpreters created from it.
+//
+// Models using resource variables are not supported, and kernels that keep
+// per-invocation state in their kernel data (e.g. CIRCULAR_BUFFER) can not be
+// shared between interpreters.
+class MicroPreparedModel {
+ public:
+  // Allocates and prepares `model` in `tensor_arena`. The tail of the arena
+  // holds the shared state, while the head is only used to compute the memory
+  // plan.
+  MicroPreparedModel(const Model* model, const MicroOpResolver& op_resolver,
+                     uint8_t* tensor_arena, size_t tensor_arena_size);
+
+  TfLiteStatus initialization_status() const { return initialization_status_; }
+
+  const Model* model() const { return model_; }
+  const MicroOpResolver& op_resolver() const { return op_resolver_; }
+
+  // Returns the list of per-subgraph allocations of the prepared model. The
+  // TfLiteEvalTensor lists are templates for the per-instance copies.
+  const SubgraphAllocations* subgraph_allocations() const {
+    return subgraph_allocations_;
+  }
+
+  // Returns the scratch buffer handles of the prepared model. These point into
+  // the overlay memory of the prepared model.
+  const ScratchBufferHandle* scratch_buffer_handles() const {
+    return scratch_buffer_handles_;
+  }
+  size_t scratch_buffer_count() const {
+    return allocator_->scratch_buffer_count();
+  }
+
+  // Returns the overlay memory the memory plan was computed for. Every
+  // interpreter instance reserves the same amount of memory in the head of its
+  // own arena, with the same alignment unless a shared arena is less aligned.
+  const uint8_t* overlay_memory_address() const {
+    return allocator_->overlay_memory_address();
+  }
+  size_t overlay_memory_size() const {
+    return allocator_->overlay_memory_size();
+  }
+  size_t overlay_memory_alignment() const {
+    return allocator_->overlay_memory_alignment();
+  }
+
+  // Returns the number of bytes of `tensor_arena` in use.
+  size_t arena_used_bytes() const { return allocator_->used_bytes(); }
+
+ private:
+  const Model* model_;
+  const MicroOpResolver& op_resolver_;
+  MicroAllocator* allocator_;
+  MicroInterpreter interpreter_;
+  TfLiteStatus initialization_status_;
+  const SubgraphAllocations* subgraph_allocations_ = nullptr;
+  const ScratchBufferHandle* scratch_buffer_handles_ = nullptr;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_MICRO_PREPARED_MODEL_H_
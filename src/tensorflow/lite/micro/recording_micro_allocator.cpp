@@ -78,6 +78,8 @@ RecordedAllocation RecordingMicroAllocator::GetRecordedAllocation(
       return recorded_node_and_registration_array_data_;
     case RecordedAllocationType::kOpData:
       return recorded_op_data_;
+    case RecordedAllocationType::kPackedWeightData:
+      return recorded_packed_weight_data_;
   }
   MicroPrintf("Invalid allocation type supplied: %d", allocation_type);
   return RecordedAllocation();
@@ -95,6 +97,9 @@ void RecordingMicroAllocator::PrintAllocations() const {
               recording_memory_allocator_->GetNonPersistentUsedBytes());
   MicroPrintf("[RecordingMicroAllocator] Arena allocation tail %d bytes",
               recording_memory_allocator_->GetPersistentUsedBytes());
+  MicroPrintf(
+      "[RecordingMicroAllocator] Arena alignment padding %d bytes in the head",
+      alignment_padding_bytes());
   PrintRecordedAllocation(RecordedAllocationType::kTfLiteEvalTensorData,
                           "TfLiteEvalTensor data", "allocations");
   PrintRecordedAllocation(RecordedAllocationType::kPersistentTfLiteTensorData,
@@ -112,6 +117,8 @@ void RecordingMicroAllocator::PrintAllocations() const {
                           "NodeAndRegistration structs");
   PrintRecordedAllocation(RecordedAllocationType::kOpData,
                           "Operator runtime data", "OpData structs");
+  PrintRecordedAllocation(RecordedAllocationType::kPackedWeightData,
+                          "Packed weight data", "allocations");
 }
 
 void* RecordingMicroAllocator::AllocatePersistentBuffer(size_t bytes) {
@@ -122,6 +129,16 @@ void* RecordingMicroAllocator::AllocatePersistentBuffer(size_t bytes) {
   return buffer;
 }
 
+void* RecordingMicroAllocator::AllocatePackedWeightBuffer(size_t bytes) {
+  RecordedAllocation allocations = SnapshotAllocationUsage();
+  // Not through the overridden AllocatePersistentBuffer, which would record
+  // the buffer as persistent buffer data as well.
+  void* buffer = MicroAllocator::AllocatePersistentBuffer(bytes);
+  RecordAllocationUsage(allocations, recorded_packed_weight_data_);
+
+  return buffer;
+}
+
 void RecordingMicroAllocator::PrintRecordedAllocation(
     RecordedAllocationType allocation_type, const char* allocation_name,
     const char* allocation_description) const {
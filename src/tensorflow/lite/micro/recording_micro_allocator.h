@@ -33,6 +33,7 @@ enum class RecordedAllocationType {
   kTfLiteTensorVariableBufferData,
   kNodeAndRegistrationArray,
   kOpData,
+  kPackedWeightData,
 };
 
 // Container for holding information about allocation recordings by a given
@@ -71,6 +72,7 @@ class RecordingMicroAllocator : public MicroAllocator {
   void PrintAllocations() const;
 
   void* AllocatePersistentBuffer(size_t bytes) override;
+  void* AllocatePackedWeightBuffer(size_t bytes) override;
 
  protected:
   TfLiteStatus AllocateNodeAndRegistrations(
@@ -116,6 +118,7 @@ class RecordingMicroAllocator : public MicroAllocator {
 
   // TODO(b/187993291): Re-enable OpData allocating tracking.
   RecordedAllocation recorded_op_data_ = {};
+  RecordedAllocation recorded_packed_weight_data_ = {};
 
   TF_LITE_REMOVE_VIRTUAL_DELETE
 };
@@ -58,6 +58,21 @@ extern "C" {
     #endif
 #endif
 
+// x86 hosts have neither extension. Unless ARM_NN_NO_X86_SIMD is defined, the pure C paths of the int8 matrix
+// multiplication kernels then call the AVX2/AVX-512 dot products in arm_nn_dot_prod_x86.c, selected at runtime.
+#if !defined(ARM_MATH_DSP) && !defined(ARM_MATH_MVEI) && !defined(ARM_NN_NO_X86_SIMD) && defined(__GNUC__) &&          \
+    (defined(__x86_64__) || defined(__i386__))
+    #ifndef ARM_NN_X86_SIMD
+        #define ARM_NN_X86_SIMD 1
+    #endif
+    // AVX-VNNI intrinsics need GCC 11 or Clang 12
+    #if (defined(__clang__) && __clang_major__ >= 12) || (!defined(__clang__) && __GNUC__ >= 11)
+        #ifndef ARM_NN_X86_VNNI
+            #define ARM_NN_X86_VNNI 1
+        #endif
+    #endif
+#endif
+
 /**
  *
  * @brief Limits macros
@@ -742,6 +742,96 @@ arm_cmsis_nn_status arm_convolve_1x1_s8(const cmsis_nn_context *ctx,
                                         const cmsis_nn_dims *output_dims,
                                         int8_t *output_data);
 
+/**
+ * @brief s8 version for 1x1 convolution using 2:4 structured-sparse weights, with support for non-unity stride values
+ *
+ * @param[in]      conv_params   Convolution parameters (e.g. strides, dilations, pads,...).
+ *                               Range of conv_params->input_offset  : [-127, 128]
+ *                               Range of conv_params->output_offset : [-128, 127]
+ * @param[in]      quant_params  Per-channel quantization info.
+ *                               It contains the multiplier and shift values to be applied to each output channel
+ * @param[in]      input_dims    Input (activation) tensor dimensions. Format: [N, H, W, C_IN]
+ * @param[in]      input_data    Input (activation) data pointer. Data type: int8
+ * @param[in]      packed_data   [C_OUT, 1, 1, C_IN] filter packed by arm_fully_connected_s8_sparse_2_4_pack_weights()
+ * @param[in]      bias_data     Optional bias data pointer. Data type: int32
+ * @param[in]      output_dims   Output tensor dimensions. Format: [N, H, W, C_OUT]
+ * @param[out]     output_data   Output data pointer. Data type: int8
+ *
+ * @return     The function returns either
+ *                  <code>ARM_CMSIS_NN_ARG_ERROR</code> if argument constraints fail. or,
+ *                  <code>ARM_CMSIS_NN_SUCCESS</code> on successful completion.
+ * @details
+ *   - Supported framework : TensorFlow Lite Micro
+ *   - Results are identical to arm_convolve_1x1_s8() on the unpacked weights, with half the multiplications.
+ *   - The following constrains on the arguments apply
+ *      -# conv_params->padding.w = conv_params->padding.h = 0
+ *      -# input_dims->c is a multiple of ARM_NN_SPARSE_2_4_GROUP
+ *
+ */
+arm_cmsis_nn_status arm_convolve_1x1_s8_sparse_2_4(const cmsis_nn_conv_params *conv_params,
+                                                   const cmsis_nn_per_channel_quant_params *quant_params,
+                                                   const cmsis_nn_dims *input_dims,
+                                                   const int8_t *input_data,
+                                                   const int8_t *packed_data,
+                                                   const int32_t *bias_data,
+                                                   const cmsis_nn_dims *output_dims,
+                                                   int8_t *output_data);
+
+/**
+ * @brief s8 version for 1x1 convolution that skips the input channels equal to the input zero point, with support
+ *        for non-unity stride values
+ *
+ * @param[in, out] ctx           Function context that contains the additional buffer if required by the function.
+ *                               arm_convolve_1x1_s8_sparse_input_get_buffer_size will return the buffer_size if
+ *                               required.
+ *                               The caller is expected to clear the buffer, if applicable, for security reasons.
+ * @param[in]      conv_params   Convolution parameters (e.g. strides, dilations, pads,...).
+ *                               Range of conv_params->input_offset  : [-127, 128]
+ *                               Range of conv_params->output_offset : [-128, 127]
+ * @param[in]      quant_params  Per-channel quantization info.
+ *                               It contains the multiplier and shift values to be applied to each output channel
+ * @param[in]      input_dims    Input (activation) tensor dimensions. Format: [N, H, W, C_IN]
+ * @param[in]      input_data    Input (activation) data pointer. Data type: int8
+ * @param[in]      filter_dims   Filter tensor dimensions. Format: [C_OUT, 1, 1, C_IN]
+ * @param[in]      filter_data   Filter data pointer. Data type: int8
+ * @param[in]      bias_data     Optional bias data pointer. Data type: int32
+ * @param[in]      output_dims   Output tensor dimensions. Format: [N, H, W, C_OUT]
+ * @param[out]     output_data   Output data pointer. Data type: int8
+ *
+ * @return     The function returns either
+ *                  <code>ARM_CMSIS_NN_ARG_ERROR</code> if argument constraints fail. or,
+ *                  <code>ARM_CMSIS_NN_SUCCESS</code> on successful completion.
+ * @details
+ *   - Supported framework : TensorFlow Lite Micro
+ *   - Results are identical to arm_convolve_1x1_s8().
+ *   - Input pixels with at most ARM_NN_SPARSE_LHS_MAX_COUNT(C_IN) channels differing from the input zero point, as is
+ *     common after a ReLU, only read the filter columns of these channels. The other pixels run on
+ *     arm_nn_mat_mult_nt_t_s8(), in runs of consecutive pixels of an output row.
+ *   - The following constrains on the arguments apply
+ *      -# conv_params->padding.w = conv_params->padding.h = 0
+ *      -# input_dims->c <= ARM_NN_SPARSE_LHS_MAX_COLS
+ *
+ */
+arm_cmsis_nn_status arm_convolve_1x1_s8_sparse_input(const cmsis_nn_context *ctx,
+                                                     const cmsis_nn_conv_params *conv_params,
+                                                     const cmsis_nn_per_channel_quant_params *quant_params,
+                                                     const cmsis_nn_dims *input_dims,
+                                                     const int8_t *input_data,
+                                                     const cmsis_nn_dims *filter_dims,
+                                                     const int8_t *filter_data,
+                                                     const int32_t *bias_data,
+                                                     const cmsis_nn_dims *output_dims,
+                                                     int8_t *output_data);
+
+/**
+ * @brief Get the required buffer size for arm_convolve_1x1_s8_sparse_input
+ *
+ * @param[in]       input_dims            Input (activation) dimensions
+ * @return          The function returns the required buffer size in bytes
+ *
+ */
+int32_t arm_convolve_1x1_s8_sparse_input_get_buffer_size(const cmsis_nn_dims *input_dims);
+
 /**
  * @brief 1xn convolution
  *
@@ -1607,6 +1697,215 @@ int32_t arm_fully_connected_s8_get_buffer_size_dsp(const cmsis_nn_dims *filter_d
  */
 int32_t arm_fully_connected_s8_get_buffer_size_mve(const cmsis_nn_dims *filter_dims);
 
+/**
+ * @brief Get size of the buffer holding the weights packed by arm_fully_connected_s8_pack_weights().
+ * @param[in]      filter_dims             dimension of filter
+ * @return         The function returns    required buffer size in bytes
+ *
+ */
+int32_t arm_fully_connected_s8_packed_get_buffer_size(const cmsis_nn_dims *filter_dims);
+
+/**
+ * @brief Packs s8 Fully Connected weights for arm_fully_connected_s8_packed().
+ *
+ * @param[in]      filter_dims   Two dimensional filter dimensions. Format: [N, C]
+ *                               N : accumulation depth
+ *                               C : output depth
+ * @param[in]      filter_data   Filter data pointer. Data type: int8
+ * @param[out]     packed_data   Buffer of arm_fully_connected_s8_packed_get_buffer_size() bytes, aligned to 4 bytes
+ *
+ * @return     The function returns <code>ARM_CMSIS_NN_SUCCESS</code>
+ *
+ * @details
+ *    - The buffer starts with the sum of each filter row, followed by the rows in blocks of ARM_NN_PACKED_ROWS.
+ *      Each block interleaves its rows in groups of ARM_NN_PACKED_COLS columns, so that the dot products of a
+ *      block read the weights sequentially. Missing rows and columns are zero.
+ *    - Intended to be called once, e.g. when the layer is prepared, as it reads every weight.
+ */
+arm_cmsis_nn_status arm_fully_connected_s8_pack_weights(const cmsis_nn_dims *filter_dims,
+                                                        const int8_t *filter_data,
+                                                        int8_t *packed_data);
+
+/**
+ * @brief s8 Fully Connected function using weights packed by arm_fully_connected_s8_pack_weights().
+ *
+ * @param[in]      fc_params     Fully Connected layer parameters.
+ *                               Range of fc_params->input_offset  : [-127, 128]
+ *                               fc_params->filter_offset : 0
+ *                               Range of fc_params->output_offset : [-128, 127]
+ * @param[in]      quant_params  Per-tensor quantization info.
+ *                               It contains the multiplier and shift values to be applied to the output tensor.
+ * @param[in]      input_dims    Input (activation) tensor dimensions. Format: [N, H, W, C_IN]
+ *                               Input dimension is taken as Nx(H * W * C_IN)
+ * @param[in]      input_data    Input (activation) data pointer. Data type: int8
+ * @param[in]      filter_dims   Two dimensional filter dimensions. Format: [N, C]
+ *                               N : accumulation depth and equals (H * W * C_IN) from input_dims
+ *                               C : output depth and equals C_OUT in output_dims
+ *                               H & W : Not used
+ * @param[in]      packed_data   Weights packed by arm_fully_connected_s8_pack_weights()
+ * @param[in]      bias_data     Bias data pointer. Data type: int32
+ * @param[in]      output_dims   Output tensor dimensions. Format: [N, C_OUT]
+ *                               N : Batches
+ *                               C_OUT : Output depth
+ *                               H & W : Not used.
+ * @param[in, out] output_data    Output data pointer. Data type: int8
+ *
+ * @return     The function returns either
+ *                  <code>ARM_CMSIS_NN_ARG_ERROR</code> if argument constraints fail. or,
+ *                  <code>ARM_CMSIS_NN_SUCCESS</code> on successful completion.
+ *
+ * @details
+ *    - Supported framework: TensorFlow Lite
+ *    - Results are identical to arm_fully_connected_s8().
+ */
+arm_cmsis_nn_status arm_fully_connected_s8_packed(const cmsis_nn_fc_params *fc_params,
+                                                  const cmsis_nn_per_tensor_quant_params *quant_params,
+                                                  const cmsis_nn_dims *input_dims,
+                                                  const int8_t *input_data,
+                                                  const cmsis_nn_dims *filter_dims,
+                                                  const int8_t *packed_data,
+                                                  const int32_t *bias_data,
+                                                  const cmsis_nn_dims *output_dims,
+                                                  int8_t *output_data);
+
+/**
+ * @brief Get size of the buffer holding the weights packed by arm_fully_connected_s8_sparse_2_4_pack_weights().
+ * @param[in]      filter_dims             dimension of filter
+ * @return         The function returns    required buffer size in bytes
+ *
+ */
+int32_t arm_fully_connected_s8_sparse_2_4_get_buffer_size(const cmsis_nn_dims *filter_dims);
+
+/**
+ * @brief Packs 2:4 structured-sparse s8 Fully Connected weights for arm_fully_connected_s8_sparse_2_4().
+ *
+ * @param[in]      filter_dims   Two dimensional filter dimensions. Format: [N, C]
+ *                               N : accumulation depth, a multiple of ARM_NN_SPARSE_2_4_GROUP
+ *                               C : output depth
+ * @param[in]      filter_data   Filter data pointer. Data type: int8
+ * @param[out]     packed_data   Buffer of arm_fully_connected_s8_sparse_2_4_get_buffer_size() bytes, aligned to 4
+ *                               bytes
+ *
+ * @return     The function returns either
+ *                  <code>ARM_CMSIS_NN_ARG_ERROR</code> if a group of ARM_NN_SPARSE_2_4_GROUP consecutive weights of
+ *                  a row has more than 2 non-zero values, or N is not a multiple of ARM_NN_SPARSE_2_4_GROUP. or,
+ *                  <code>ARM_CMSIS_NN_SUCCESS</code> on successful completion.
+ *
+ * @details
+ *    - The buffer starts with the sum of each filter row, followed by 2 values per group of each row, and then by the
+ *      2-bit column indices of these values within their group, ARM_NN_SPARSE_2_4_INDEX_BYTES(N) bytes per row.
+ *      Groups with fewer than 2 non-zero values are padded with zero values.
+ *    - Intended to be called once, e.g. when the layer is prepared, as it reads every weight.
+ *    - Also packs the [C_OUT, 1, 1, C_IN] weights of arm_convolve_1x1_s8_sparse_2_4(), with N = C_IN and C = C_OUT.
+ */
+arm_cmsis_nn_status arm_fully_connected_s8_sparse_2_4_pack_weights(const cmsis_nn_dims *filter_dims,
+                                                                   const int8_t *filter_data,
+                                                                   int8_t *packed_data);
+
+/**
+ * @brief s8 Fully Connected function using 2:4 structured-sparse weights packed by
+ *        arm_fully_connected_s8_sparse_2_4_pack_weights().
+ *
+ * @param[in]      fc_params     Fully Connected layer parameters.
+ *                               Range of fc_params->input_offset  : [-127, 128]
+ *                               fc_params->filter_offset : 0
+ *                               Range of fc_params->output_offset : [-128, 127]
+ * @param[in]      quant_params  Per-tensor quantization info.
+ *                               It contains the multiplier and shift values to be applied to the output tensor.
+ * @param[in]      input_dims    Input (activation) tensor dimensions. Format: [N, H, W, C_IN]
+ *                               Input dimension is taken as Nx(H * W * C_IN)
+ * @param[in]      input_data    Input (activation) data pointer. Data type: int8
+ * @param[in]      filter_dims   Two dimensional filter dimensions. Format: [N, C]
+ *                               N : accumulation depth and equals (H * W * C_IN) from input_dims
+ *                               C : output depth and equals C_OUT in output_dims
+ *                               H & W : Not used
+ * @param[in]      packed_data   Weights packed by arm_fully_connected_s8_sparse_2_4_pack_weights()
+ * @param[in]      bias_data     Bias data pointer. Data type: int32
+ * @param[in]      output_dims   Output tensor dimensions. Format: [N, C_OUT]
+ *                               N : Batches
+ *                               C_OUT : Output depth
+ *                               H & W : Not used.
+ * @param[in, out] output_data    Output data pointer. Data type: int8
+ *
+ * @return     The function returns either
+ *                  <code>ARM_CMSIS_NN_ARG_ERROR</code> if argument constraints fail. or,
+ *                  <code>ARM_CMSIS_NN_SUCCESS</code> on successful completion.
+ *
+ * @details
+ *    - Supported framework: TensorFlow Lite
+ *    - Results are identical to arm_fully_connected_s8() on the unpacked weights, with half the multiplications.
+ */
+arm_cmsis_nn_status arm_fully_connected_s8_sparse_2_4(const cmsis_nn_fc_params *fc_params,
+                                                      const cmsis_nn_per_tensor_quant_params *quant_params,
+                                                      const cmsis_nn_dims *input_dims,
+                                                      const int8_t *input_data,
+                                                      const cmsis_nn_dims *filter_dims,
+                                                      const int8_t *packed_data,
+                                                      const int32_t *bias_data,
+                                                      const cmsis_nn_dims *output_dims,
+                                                      int8_t *output_data);
+
+/**
+ * @brief Get size of additional buffer required by arm_fully_connected_s8_sparse_input().
+ * @param[in]      filter_dims             dimension of filter
+ * @return         The function returns    required buffer size in bytes
+ *
+ */
+int32_t arm_fully_connected_s8_sparse_input_get_buffer_size(const cmsis_nn_dims *filter_dims);
+
+/**
+ * @brief s8 Fully Connected function that skips the filter columns of input values equal to the input zero point.
+ *
+ * @param[in, out] ctx           Function context that contains the additional buffer of
+ *                               arm_fully_connected_s8_sparse_input_get_buffer_size() bytes.
+ *                               The caller is expected to clear the buffer, if applicable, for security reasons.
+ * @param[in]      fc_params     Fully Connected layer parameters.
+ *                               Range of fc_params->input_offset  : [-127, 128]
+ *                               fc_params->filter_offset : 0
+ *                               Range of fc_params->output_offset : [-128, 127]
+ * @param[in]      quant_params  Per-tensor quantization info.
+ *                               It contains the multiplier and shift values to be applied to the output tensor.
+ * @param[in]      input_dims    Input (activation) tensor dimensions. Format: [N, H, W, C_IN]
+ *                               Input dimension is taken as Nx(H * W * C_IN)
+ * @param[in]      input_data    Input (activation) data pointer. Data type: int8
+ * @param[in]      filter_dims   Two dimensional filter dimensions. Format: [N, C]
+ *                               N : accumulation depth and equals (H * W * C_IN) from input_dims
+ *                               C : output depth and equals C_OUT in output_dims
+ *                               H & W : Not used
+ * @param[in]      filter_data   Filter data pointer. Data type: int8
+ * @param[in]      kernel_sum    Sums of the filter rows for the dense batches, as in the buffer of
+ *                               arm_fully_connected_s8(). Required with MVE, unused otherwise.
+ * @param[in]      bias_data     Bias data pointer. Data type: int32
+ * @param[in]      output_dims   Output tensor dimensions. Format: [N, C_OUT]
+ *                               N : Batches
+ *                               C_OUT : Output depth
+ *                               H & W : Not used.
+ * @param[in, out] output_data    Output data pointer. Data type: int8
+ *
+ * @return     The function returns either
+ *                  <code>ARM_CMSIS_NN_ARG_ERROR</code> if argument constraints fail. or,
+ *                  <code>ARM_CMSIS_NN_SUCCESS</code> on successful completion.
+ *
+ * @details
+ *    - Supported framework: TensorFlow Lite
+ *    - Results are identical to arm_fully_connected_s8().
+ *    - Batches with at most ARM_NN_SPARSE_LHS_MAX_COUNT(N) values differing from the input zero point, as is common
+ *      after a ReLU, only read the filter columns of these values. The other batches run on
+ *      arm_nn_vec_mat_mult_t_s8().
+ *    - N must not exceed ARM_NN_SPARSE_LHS_MAX_COLS.
+ */
+arm_cmsis_nn_status arm_fully_connected_s8_sparse_input(const cmsis_nn_context *ctx,
+                                                        const cmsis_nn_fc_params *fc_params,
+                                                        const cmsis_nn_per_tensor_quant_params *quant_params,
+                                                        const cmsis_nn_dims *input_dims,
+                                                        const int8_t *input_data,
+                                                        const cmsis_nn_dims *filter_dims,
+                                                        const int8_t *filter_data,
+                                                        const int32_t *kernel_sum,
+                                                        const int32_t *bias_data,
+                                                        const cmsis_nn_dims *output_dims,
+                                                        int8_t *output_data);
+
 /**
  * @brief Basic s16 Fully Connected function.
  *
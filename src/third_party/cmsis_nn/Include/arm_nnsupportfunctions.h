@@ -72,6 +72,29 @@ extern "C" {
 // to not loose precision.
 #define MAX_COL_COUNT (512)
 
+// Block size of the weights packed by arm_fully_connected_s8_pack_weights(). Rows are packed in blocks of
+// ARM_NN_PACKED_ROWS, and each block interleaves the rows in groups of ARM_NN_PACKED_COLS columns.
+#define ARM_NN_PACKED_ROWS (4)
+#define ARM_NN_PACKED_COLS (4)
+
+// 2:4 structured-sparse weights have at most 2 non-zero values in each group of ARM_NN_SPARSE_2_4_GROUP consecutive
+// columns. Their packed rows hold 2 values per group, and the 2-bit column indices of the values, 2 groups per byte.
+#define ARM_NN_SPARSE_2_4_GROUP (4)
+#define ARM_NN_SPARSE_2_4_INDEX_BYTES(cols) (((cols) / ARM_NN_SPARSE_2_4_GROUP + 1) / 2)
+
+// Vector by matrix multiplications skip the columns where the lhs vector equals its zero point if at most
+// ARM_NN_SPARSE_LHS_MAX_COUNT(cols) of its values differ from it. The sparse loop does one multiply-accumulate at a
+// time, so targets whose dense loops do several at a time use it on sparser vectors only. Column indices are 16-bit,
+// so the vectors have at most ARM_NN_SPARSE_LHS_MAX_COLS columns.
+#if defined(ARM_MATH_MVEI) || defined(ARM_NN_X86_SIMD)
+    #define ARM_NN_SPARSE_LHS_MAX_COUNT(cols) ((cols) / 16)
+#elif defined(ARM_MATH_DSP)
+    #define ARM_NN_SPARSE_LHS_MAX_COUNT(cols) ((cols) / 4)
+#else
+    #define ARM_NN_SPARSE_LHS_MAX_COUNT(cols) ((cols) / 2)
+#endif
+#define ARM_NN_SPARSE_LHS_MAX_COLS (65536)
+
 /**
  * @brief definition to pack four 8 bit values.
  */
@@ -654,6 +677,146 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                                              const int32_t address_offset,
                                              const int32_t rhs_offset);
 
+/**
+ * @brief s8 Vector by Matrix (transposed) multiplication with weights packed by arm_fully_connected_s8_pack_weights()
+ *
+ * @param[in]      lhs             Input left-hand side vector
+ * @param[in]      packed_rhs      Right-hand side matrix (transposed) packed by arm_fully_connected_s8_pack_weights(),
+ *                                 starting with its kernel sums
+ * @param[in]      bias            Input bias
+ * @param[out]     dst             Output vector
+ * @param[in]      lhs_offset      Offset to be added to the input values of the left-hand side vector.
+ *                                 Range: -127 to 128
+ * @param[in]      dst_offset      Offset to be added to the output values. Range: -127 to 128
+ * @param[in]      dst_multiplier  Output multiplier
+ * @param[in]      dst_shift       Output shift
+ * @param[in]      rhs_cols        Number of columns in the right-hand side input matrix
+ * @param[in]      rhs_rows        Number of rows in the right-hand side input matrix
+ * @param[in]      activation_min  Minimum value to clamp the output to. Range: int8
+ * @param[in]      activation_max  Maximum value to clamp the output to. Range: int8
+ *
+ * @return         The function returns <code>ARM_CMSIS_NN_SUCCESS</code>
+ *
+ */
+arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8_packed(const int8_t *lhs,
+                                                    const int8_t *packed_rhs,
+                                                    const int32_t *bias,
+                                                    int8_t *dst,
+                                                    const int32_t lhs_offset,
+                                                    const int32_t dst_offset,
+                                                    const int32_t dst_multiplier,
+                                                    const int32_t dst_shift,
+                                                    const int32_t rhs_cols,
+                                                    const int32_t rhs_rows,
+                                                    const int32_t activation_min,
+                                                    const int32_t activation_max);
+
+/**
+ * @brief s8 Vector by 2:4 structured-sparse Matrix (transposed) multiplication
+ *
+ * @param[in]      lhs             Input left-hand side vector
+ * @param[in]      packed_rhs      Right-hand side matrix (transposed) packed by
+ *                                 arm_fully_connected_s8_sparse_2_4_pack_weights(), starting with its kernel sums
+ * @param[in]      bias            Input bias
+ * @param[out]     dst             Output vector
+ * @param[in]      lhs_offset      Offset to be added to the input values of the left-hand side vector.
+ *                                 Range: -127 to 128
+ * @param[in]      dst_offset      Offset to be added to the output values. Range: -127 to 128
+ * @param[in]      dst_multipliers Output multipliers
+ * @param[in]      dst_shifts      Output shifts
+ * @param[in]      per_channel     Non-zero if dst_multipliers and dst_shifts hold one value per row, zero if their
+ *                                 first value applies to all rows
+ * @param[in]      rhs_cols        Number of columns in the right-hand side input matrix. Must be a multiple of
+ *                                 ARM_NN_SPARSE_2_4_GROUP
+ * @param[in]      rhs_rows        Number of rows in the right-hand side input matrix
+ * @param[in]      activation_min  Minimum value to clamp the output to. Range: int8
+ * @param[in]      activation_max  Maximum value to clamp the output to. Range: int8
+ *
+ * @return         The function returns <code>ARM_CMSIS_NN_SUCCESS</code>
+ *
+ * @details        Only the two stored values of each group of columns are multiplied, each with the lhs value that
+ *                 its index selects.
+ *
+ */
+arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8_sparse_2_4(const int8_t *lhs,
+                                                        const int8_t *packed_rhs,
+                                                        const int32_t *bias,
+                                                        int8_t *dst,
+                                                        const int32_t lhs_offset,
+                                                        const int32_t dst_offset,
+                                                        const int32_t *dst_multipliers,
+                                                        const int32_t *dst_shifts,
+                                                        const int32_t per_channel,
+                                                        const int32_t rhs_cols,
+                                                        const int32_t rhs_rows,
+                                                        const int32_t activation_min,
+                                                        const int32_t activation_max);
+
+/**
+ * @brief Gathers the values of an s8 vector that differ from its zero point
+ *
+ * @param[in]      lhs             Input vector
+ * @param[in]      lhs_offset      Offset to be added to the input values, i.e. the negated zero point.
+ *                                 Range: -127 to 128
+ * @param[in]      lhs_cols        Number of values in the input vector. Range: 0 to ARM_NN_SPARSE_LHS_MAX_COLS
+ * @param[in]      max_count       Maximum number of values to gather
+ * @param[out]     indices         Column indices of the gathered values, in ascending order. Size: max_count
+ * @param[out]     values          Gathered values with lhs_offset added. Size: max_count
+ *
+ * @return         The number of gathered values, or -1 if more than max_count values differ from the zero point
+ *
+ * @details        Stops reading the input as soon as max_count is exceeded, so that dense vectors cost little more
+ *                 than the values up to that point.
+ *
+ */
+int32_t arm_nn_sparse_lhs_gather_s8(const int8_t *lhs,
+                                    const int32_t lhs_offset,
+                                    const int32_t lhs_cols,
+                                    const int32_t max_count,
+                                    uint16_t *indices,
+                                    int16_t *values);
+
+/**
+ * @brief s8 sparse Vector by Matrix (transposed) multiplication
+ *
+ * @param[in]      lhs_indices     Column indices of the lhs values, from arm_nn_sparse_lhs_gather_s8()
+ * @param[in]      lhs_values      Values of the lhs vector with the lhs offset added, from
+ *                                 arm_nn_sparse_lhs_gather_s8()
+ * @param[in]      lhs_count       Number of lhs values
+ * @param[in]      rhs             Input right-hand side matrix (transposed)
+ * @param[in]      bias            Input bias
+ * @param[out]     dst             Output vector
+ * @param[in]      dst_offset      Offset to be added to the output values. Range: -127 to 128
+ * @param[in]      dst_multipliers Output multipliers
+ * @param[in]      dst_shifts      Output shifts
+ * @param[in]      per_channel     Non-zero if dst_multipliers and dst_shifts hold one value per row, zero if their
+ *                                 first value applies to all rows
+ * @param[in]      rhs_cols        Number of columns in the right-hand side input matrix
+ * @param[in]      rhs_rows        Number of rows in the right-hand side input matrix
+ * @param[in]      activation_min  Minimum value to clamp the output to. Range: int8
+ * @param[in]      activation_max  Maximum value to clamp the output to. Range: int8
+ *
+ * @return         The function returns <code>ARM_CMSIS_NN_SUCCESS</code>
+ *
+ * @details        Only the rhs columns of the gathered lhs values are read. The rhs offset must be zero, so that the
+ *                 skipped lhs values contribute nothing to the result.
+ *
+ */
+arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8_sparse_lhs(const uint16_t *lhs_indices,
+                                                        const int16_t *lhs_values,
+                                                        const int32_t lhs_count,
+                                                        const int8_t *rhs,
+                                                        const int32_t *bias,
+                                                        int8_t *dst,
+                                                        const int32_t dst_offset,
+                                                        const int32_t *dst_multipliers,
+                                                        const int32_t *dst_shifts,
+                                                        const int32_t per_channel,
+                                                        const int32_t rhs_cols,
+                                                        const int32_t rhs_rows,
+                                                        const int32_t activation_min,
+                                                        const int32_t activation_max);
+
 /**
  * @brief s16 Vector by Matrix (transposed) multiplication
  *
@@ -1955,6 +2118,51 @@ arm_cmsis_nn_status arm_elementwise_mul_acc_s16(const int16_t *input_1_vect,
                                                 const int32_t out_activation_max,
                                                 const int32_t block_size);
 
+#if defined(ARM_NN_X86_SIMD)
+/**
+ * @brief s8 dot product with offsets for x86 hosts. Uses AVX-512 VNNI, AVX-VNNI, AVX-512 BW or AVX2 depending on what
+ * the CPU reports at runtime, and plain C otherwise. The result is exact, i.e. identical to a scalar accumulation.
+ *
+ * @param[in]   lhs         Pointer to the first vector
+ * @param[in]   rhs         Pointer to the second vector
+ * @param[in]   len         Number of elements
+ * @param[in]   lhs_offset  Offset added to every element of lhs
+ * @param[in]   rhs_offset  Offset added to every element of rhs
+ * @return                  sum((lhs[i] + lhs_offset) * (rhs[i] + rhs_offset))
+ */
+int32_t arm_nn_x86_dot_s8(const int8_t *lhs,
+                          const int8_t *rhs,
+                          const int32_t len,
+                          const int32_t lhs_offset,
+                          const int32_t rhs_offset);
+
+/**
+ * @brief s8 by s16 dot product for x86 hosts, with the same runtime selection as arm_nn_x86_dot_s8.
+ *
+ * @param[in]   lhs   Pointer to the s8 vector
+ * @param[in]   rhs   Pointer to the s16 vector
+ * @param[in]   len   Number of elements
+ * @return            sum(lhs[i] * rhs[i])
+ */
+int32_t arm_nn_x86_dot_s8_s16(const int8_t *lhs, const int16_t *rhs, const int32_t len);
+
+/**
+ * @brief Dot products of an s8 vector with one block of ARM_NN_PACKED_ROWS rows packed by
+ * arm_fully_connected_s8_pack_weights(), for x86 hosts, with the same runtime selection as arm_nn_x86_dot_s8.
+ *
+ * @param[in]   lhs         Pointer to the s8 vector
+ * @param[in]   packed_rhs  Pointer to the packed block
+ * @param[in]   len         Number of elements of lhs
+ * @param[in]   rhs_sums    Sums of the rows of the block
+ * @param[out]  dst         sum(lhs[i] * rhs[r][i]) for each row r of the block
+ */
+void arm_nn_x86_dot_s8_packed(const int8_t *lhs,
+                              const int8_t *packed_rhs,
+                              const int32_t len,
+                              const int32_t *rhs_sums,
+                              int32_t *dst);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_convolve_1x1_s8_sparse_2_4.c
+ * Description:  s8 version of 1x1 convolution using 2:4 structured-sparse weights
+ *
+ * $Date:        19 October 2024
+ * $Revision:    V.1.0.0
+ *
+ * Target :  Arm(R) M-Profile Architecture
+ *
+ * -------------------------------------------------------------------- */
+
+#include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+
+/**
+ *  @ingroup Public
+ */
+
+/**
+ * @addtogroup NNConv
+ * @{
+ */
+
+/*
+ * s8 1x1 convolution with 2:4 structured-sparse weights, for any stride.
+ *
+ * Refer header file for details.
+ *
+ */
+arm_cmsis_nn_status arm_convolve_1x1_s8_sparse_2_4(const cmsis_nn_conv_params *conv_params,
+                                                   const cmsis_nn_per_channel_quant_params *quant_params,
+                                                   const cmsis_nn_dims *input_dims,
+                                                   const int8_t *input_data,
+                                                   const int8_t *packed_data,
+                                                   const int32_t *bias_data,
+                                                   const cmsis_nn_dims *output_dims,
+                                                   int8_t *output_data)
+{
+    if (conv_params->padding.w != 0 || conv_params->padding.h != 0 || input_dims->c % ARM_NN_SPARSE_2_4_GROUP != 0)
+    {
+        return ARM_CMSIS_NN_ARG_ERROR;
+    }
+
+    const int32_t rhs_rows = output_dims->c;
+    const int32_t rhs_cols = input_dims->c;
+    const int32_t stride_w = conv_params->stride.w;
+    const int32_t stride_h = conv_params->stride.h;
+
+    for (int32_t i_batch = 0; i_batch < input_dims->n; i_batch++)
+    {
+        const int8_t *input_batch = input_data + i_batch * input_dims->h * input_dims->w * rhs_cols;
+        for (int32_t i_out_y = 0; i_out_y < output_dims->h; i_out_y++)
+        {
+            const int8_t *input_row = input_batch + i_out_y * stride_h * input_dims->w * rhs_cols;
+            for (int32_t i_out_x = 0; i_out_x < output_dims->w; i_out_x++)
+            {
+                arm_nn_vec_mat_mult_t_s8_sparse_2_4(input_row + i_out_x * stride_w * rhs_cols,
+                                                    packed_data,
+                                                    bias_data,
+                                                    output_data,
+                                                    conv_params->input_offset,
+                                                    conv_params->output_offset,
+                                                    quant_params->multiplier,
+                                                    quant_params->shift,
+                                                    1, /* per_channel */
+                                                    rhs_cols,
+                                                    rhs_rows,
+                                                    conv_params->activation.min,
+                                                    conv_params->activation.max);
+                output_data += rhs_rows;
+            }
+        }
+    }
+
+    /* Return to application */
+    return ARM_CMSIS_NN_SUCCESS;
+}
+
+/**
+ * @} end of NNConv group
+ */
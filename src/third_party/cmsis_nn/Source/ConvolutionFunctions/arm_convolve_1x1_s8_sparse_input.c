@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_convolve_1x1_s8_sparse_input.c
+ * Description:  s8 version of 1x1 convolution skipping zero-point input channels
+ *
+ * $Date:        19 October 2024
+ * $Revision:    V.1.0.0
+ *
+ * Target :  Arm(R) M-Profile Architecture
+ *
+ * -------------------------------------------------------------------- */
+
+#include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+
+/**
+ *  @ingroup Public
+ */
+
+/**
+ * @addtogroup NNConv
+ * @{
+ */
+
+/*
+ * s8 1x1 convolution skipping the filter columns of zero-point input channels, for any stride.
+ *
+ * Refer header file for details.
+ *
+ */
+arm_cmsis_nn_status arm_convolve_1x1_s8_sparse_input(const cmsis_nn_context *ctx,
+                                                     const cmsis_nn_conv_params *conv_params,
+                                                     const cmsis_nn_per_channel_quant_params *quant_params,
+                                                     const cmsis_nn_dims *input_dims,
+                                                     const int8_t *input_data,
+                                                     const cmsis_nn_dims *filter_dims,
+                                                     const int8_t *filter_data,
+                                                     const int32_t *bias_data,
+                                                     const cmsis_nn_dims *output_dims,
+                                                     int8_t *output_data)
+{
+    if (conv_params->padding.w != 0 || conv_params->padding.h != 0 || input_dims->c > ARM_NN_SPARSE_LHS_MAX_COLS)
+    {
+        return ARM_CMSIS_NN_ARG_ERROR;
+    }
+
+    (void)filter_dims;
+
+    const int32_t rhs_rows = output_dims->c;
+    const int32_t rhs_cols = input_dims->c;
+    const int32_t pixel_offset = conv_params->stride.w * rhs_cols;
+    const int32_t max_count = ARM_NN_SPARSE_LHS_MAX_COUNT(rhs_cols);
+    uint16_t *indices = (uint16_t *)ctx->buf;
+    int16_t *values = (int16_t *)(indices + max_count);
+
+    for (int32_t i_batch = 0; i_batch < input_dims->n; i_batch++)
+    {
+        const int8_t *input_batch = input_data + i_batch * input_dims->h * input_dims->w * rhs_cols;
+        for (int32_t i_out_y = 0; i_out_y < output_dims->h; i_out_y++)
+        {
+            const int8_t *input_row = input_batch + i_out_y * conv_params->stride.h * input_dims->w * rhs_cols;
+            int32_t dense_start = 0;
+            for (int32_t i_out_x = 0; i_out_x <= output_dims->w; i_out_x++)
+            {
+                int32_t count = -1;
+                if (i_out_x < output_dims->w)
+                {
+                    count = arm_nn_sparse_lhs_gather_s8(input_row + i_out_x * pixel_offset,
+                                                        conv_params->input_offset,
+                                                        rhs_cols,
+                                                        max_count,
+                                                        indices,
+                                                        values);
+                    if (count < 0)
+                    {
+                        continue;
+                    }
+                }
+
+                // Flush the run of dense pixels before this one, or before the end of the row.
+                if (i_out_x > dense_start)
+                {
+                    arm_nn_mat_mult_nt_t_s8(input_row + dense_start * pixel_offset,
+                                            filter_data,
+                                            bias_data,
+                                            output_data + dense_start * rhs_rows,
+                                            quant_params->multiplier,
+                                            quant_params->shift,
+                                            i_out_x - dense_start,
+                                            rhs_rows,
+                                            rhs_cols,
+                                            conv_params->input_offset,
+                                            conv_params->output_offset,
+                                            conv_params->activation.min,
+                                            conv_params->activation.max,
+                                            rhs_rows,
+                                            pixel_offset);
+                }
+                dense_start = i_out_x + 1;
+
+                if (count >= 0)
+                {
+                    arm_nn_vec_mat_mult_t_s8_sparse_lhs(indices,
+                                                        values,
+                                                        count,
+                                                        filter_data,
+                                                        bias_data,
+                                                        output_data + i_out_x * rhs_rows,
+                                                        conv_params->output_offset,
+                                                        quant_params->multiplier,
+                                                        quant_params->shift,
+                                                        1, /* per_channel */
+                                                        rhs_cols,
+                                                        rhs_rows,
+                                                        conv_params->activation.min,
+                                                        conv_params->activation.max);
+                }
+            }
+            output_data += output_dims->w * rhs_rows;
+        }
+    }
+
+    /* Return to application */
+    return ARM_CMSIS_NN_SUCCESS;
+}
+
+/**
+ * @} end of NNConv group
+ */
@@ -21,8 +21,8 @@
  * Title:        arm_convolve_get_buffer_sizes_s8.c
  * Description:  Collection of get buffer size functions for the various s8 convolution layer functions.
  *
- * $Date:        28 March 2024
- * $Revision:    V.2.1.1
+ * $Date:        19 October 2024
+ * $Revision:    V.2.2.0
  *
  * Target :  Arm(R) M-Profile Architecture
  *
@@ -116,6 +116,11 @@ int32_t arm_convolve_1x1_s8_fast_get_buffer_size(const cmsis_nn_dims *input_dims
     return 0;
 }
 
+int32_t arm_convolve_1x1_s8_sparse_input_get_buffer_size(const cmsis_nn_dims *input_dims)
+{
+    return ARM_NN_SPARSE_LHS_MAX_COUNT(input_dims->c) * (int32_t)(sizeof(uint16_t) + sizeof(int16_t));
+}
+
 /*
  * Get the required buffer size for arm_convolve_wrapper_s8. This is the recommended function convolve wrapper s8
  * function.
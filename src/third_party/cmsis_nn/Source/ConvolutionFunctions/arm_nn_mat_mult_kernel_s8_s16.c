@@ -108,6 +108,13 @@ int8_t *arm_nn_mat_mult_kernel_s8_s16(const int8_t *input_a,
             col_count--;
         } /* while over col_count */
         col_count = num_col_a & 0x3;
+    #elif defined(ARM_NN_X86_SIMD)
+        ch_0_out_0 += arm_nn_x86_dot_s8_s16(ip_a0, ip_b0, num_col_a);
+        ch_0_out_1 += arm_nn_x86_dot_s8_s16(ip_a0, ip_b1, num_col_a);
+        ch_1_out_0 += arm_nn_x86_dot_s8_s16(ip_a1, ip_b0, num_col_a);
+        ch_1_out_1 += arm_nn_x86_dot_s8_s16(ip_a1, ip_b1, num_col_a);
+        ip_a0 += num_col_a;
+        int32_t col_count = 0;
     #else
         int32_t col_count = num_col_a;
     #endif
@@ -196,6 +203,11 @@ int8_t *arm_nn_mat_mult_kernel_s8_s16(const int8_t *input_a,
             col_count--;
         }
         col_count = num_col_a & 0x3;
+    #elif defined(ARM_NN_X86_SIMD)
+        ch_0_out_0 += arm_nn_x86_dot_s8_s16(ip_a0, ip_b0, num_col_a);
+        ch_0_out_1 += arm_nn_x86_dot_s8_s16(ip_a0, ip_b1, num_col_a);
+        ip_a0 += num_col_a;
+        int32_t col_count = 0;
     #else
         int32_t col_count = num_col_a;
     #endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright 2023 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ * SPDX-FileCopyrightText: Copyright 2023-2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -21,14 +21,15 @@
  * Title:        arm_fully_connected_get_buffer_sizes_s8.c
  * Description:  Collection of get buffer size functions for fully connected s8 layer function.
  *
- * $Date:        15 August 2023
- * $Revision:    V.1.1.0
+ * $Date:        19 October 2024
+ * $Revision:    V.1.3.0
  *
  * Target :  Arm(R) M-Profile Architecture
  *
  * -------------------------------------------------------------------- */
 
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
 
 /**
  *  @ingroup FC
@@ -59,6 +60,25 @@ int32_t arm_fully_connected_s8_get_buffer_size(const cmsis_nn_dims *filter_dims)
 #endif
 }
 
+int32_t arm_fully_connected_s8_packed_get_buffer_size(const cmsis_nn_dims *filter_dims)
+{
+    const int32_t rows = (filter_dims->c + ARM_NN_PACKED_ROWS - 1) / ARM_NN_PACKED_ROWS * ARM_NN_PACKED_ROWS;
+    const int32_t cols = (filter_dims->n + ARM_NN_PACKED_COLS - 1) / ARM_NN_PACKED_COLS * ARM_NN_PACKED_COLS;
+    return rows * (int32_t)sizeof(int32_t) + rows * cols;
+}
+
+int32_t arm_fully_connected_s8_sparse_2_4_get_buffer_size(const cmsis_nn_dims *filter_dims)
+{
+    const int32_t rows = filter_dims->c;
+    const int32_t cols = filter_dims->n;
+    return rows * ((int32_t)sizeof(int32_t) + cols / 2 + ARM_NN_SPARSE_2_4_INDEX_BYTES(cols));
+}
+
+int32_t arm_fully_connected_s8_sparse_input_get_buffer_size(const cmsis_nn_dims *filter_dims)
+{
+    return ARM_NN_SPARSE_LHS_MAX_COUNT(filter_dims->n) * (int32_t)(sizeof(uint16_t) + sizeof(int16_t));
+}
+
 /**
  * @} end of GetBufferSizeFC group
  */
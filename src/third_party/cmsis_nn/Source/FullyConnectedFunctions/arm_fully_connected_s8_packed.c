@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_fully_connected_s8_packed
+ * Description:  Fully connected function compatible with TF Lite, using weights packed ahead of time.
+ *
+ * $Date:        19 October 2024
+ * $Revision:    V.1.0.0
+ *
+ * Target :  Arm(R) M-Profile Architecture
+ *
+ * -------------------------------------------------------------------- */
+
+#include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+
+/**
+ *  @ingroup Public
+ */
+
+/**
+ * @addtogroup FC
+ * @{
+ */
+
+/*
+ * Packs the weights of the S8 fully-connected layer function.
+ *
+ * Refer header file for details.
+ *
+ */
+arm_cmsis_nn_status arm_fully_connected_s8_pack_weights(const cmsis_nn_dims *filter_dims,
+                                                        const int8_t *filter_data,
+                                                        int8_t *packed_data)
+{
+    const int32_t rows = filter_dims->c;
+    const int32_t cols = filter_dims->n;
+    const int32_t row_blocks = (rows + ARM_NN_PACKED_ROWS - 1) / ARM_NN_PACKED_ROWS;
+    const int32_t col_groups = (cols + ARM_NN_PACKED_COLS - 1) / ARM_NN_PACKED_COLS;
+    int32_t *kernel_sum = (int32_t *)packed_data;
+    int8_t *dst = packed_data + row_blocks * ARM_NN_PACKED_ROWS * sizeof(int32_t);
+
+    for (int32_t block = 0; block < row_blocks; block++)
+    {
+        for (int32_t i = 0; i < ARM_NN_PACKED_ROWS; i++)
+        {
+            const int32_t row = block * ARM_NN_PACKED_ROWS + i;
+            int32_t sum = 0;
+            if (row < rows)
+            {
+                for (int32_t col = 0; col < cols; col++)
+                {
+                    sum += filter_data[row * cols + col];
+                }
+            }
+            kernel_sum[row] = sum;
+        }
+
+        for (int32_t group = 0; group < col_groups; group++)
+        {
+            for (int32_t i = 0; i < ARM_NN_PACKED_ROWS; i++)
+            {
+                const int32_t row = block * ARM_NN_PACKED_ROWS + i;
+                for (int32_t j = 0; j < ARM_NN_PACKED_COLS; j++)
+                {
+                    const int32_t col = group * ARM_NN_PACKED_COLS + j;
+                    *dst++ = (row < rows && col < cols) ? filter_data[row * cols + col] : 0;
+                }
+            }
+        }
+    }
+
+    return ARM_CMSIS_NN_SUCCESS;
+}
+
+/*
+ * S8 fully-connected layer function using packed weights.
+ *
+ * Refer header file for details.
+ *
+ */
+arm_cmsis_nn_status arm_fully_connected_s8_packed(const cmsis_nn_fc_params *fc_params,
+                                                  const cmsis_nn_per_tensor_quant_params *quant_params,
+                                                  const cmsis_nn_dims *input_dims,
+                                                  const int8_t *input,
+                                                  const cmsis_nn_dims *filter_dims,
+                                                  const int8_t *packed_data,
+                                                  const int32_t *bias,
+                                                  const cmsis_nn_dims *output_dims,
+                                                  int8_t *output)
+{
+    if (fc_params->filter_offset != 0)
+    {
+        return ARM_CMSIS_NN_ARG_ERROR;
+    }
+
+    int32_t batch_cnt = input_dims->n;
+
+    while (batch_cnt)
+    {
+        arm_nn_vec_mat_mult_t_s8_packed(input,
+                                        packed_data,
+                                        bias,
+                                        output,
+                                        fc_params->input_offset,
+                                        fc_params->output_offset,
+                                        quant_params->multiplier,
+                                        quant_params->shift,
+                                        filter_dims->n, /* col_dim or accum_depth */
+                                        output_dims->c, /* row_dim or output_depth */
+                                        fc_params->activation.min,
+                                        fc_params->activation.max);
+
+        input += filter_dims->n;
+        output += output_dims->c;
+        batch_cnt--;
+    }
+    return ARM_CMSIS_NN_SUCCESS;
+}
+
+/**
+ * @} end of FC group
+ */
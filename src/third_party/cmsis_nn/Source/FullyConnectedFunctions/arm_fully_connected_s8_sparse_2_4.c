@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_fully_connected_s8_sparse_2_4
+ * Description:  Fully connected function compatible with TF Lite, using 2:4 structured-sparse weights.
+ *
+ * $Date:        19 October 2024
+ * $Revision:    V.1.0.0
+ *
+ * Target :  Arm(R) M-Profile Architecture
+ *
+ * -------------------------------------------------------------------- */
+
+#include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+
+/**
+ *  @ingroup Public
+ */
+
+/**
+ * @addtogroup FC
+ * @{
+ */
+
+/*
+ * Packs 2:4 structured-sparse weights of the S8 fully-connected layer function.
+ *
+ * Refer header file for details.
+ *
+ */
+arm_cmsis_nn_status arm_fully_connected_s8_sparse_2_4_pack_weights(const cmsis_nn_dims *filter_dims,
+                                                                   const int8_t *filter_data,
+                                                                   int8_t *packed_data)
+{
+    const int32_t rows = filter_dims->c;
+    const int32_t cols = filter_dims->n;
+    if (cols % ARM_NN_SPARSE_2_4_GROUP != 0)
+    {
+        return ARM_CMSIS_NN_ARG_ERROR;
+    }
+    const int32_t groups = cols / ARM_NN_SPARSE_2_4_GROUP;
+    const int32_t index_bytes = ARM_NN_SPARSE_2_4_INDEX_BYTES(cols);
+    int32_t *kernel_sum = (int32_t *)packed_data;
+    int8_t *values = packed_data + rows * (int32_t)sizeof(int32_t);
+    uint8_t *indices = (uint8_t *)(values + rows * (cols / 2));
+
+    for (int32_t row = 0; row < rows; row++)
+    {
+        const int8_t *src = filter_data + row * cols;
+        int32_t sum = 0;
+        for (int32_t group = 0; group < groups; group++)
+        {
+            // Keep the non-zero columns, then pad with zero columns, in ascending order.
+            int32_t kept[2];
+            int32_t kept_count = 0;
+            for (int32_t i = 0; i < ARM_NN_SPARSE_2_4_GROUP; i++)
+            {
+                if (src[i] != 0)
+                {
+                    if (kept_count == 2)
+                    {
+                        return ARM_CMSIS_NN_ARG_ERROR;
+                    }
+                    kept[kept_count++] = i;
+                }
+            }
+            for (int32_t i = 0; kept_count < 2; i++)
+            {
+                if (kept_count == 0 || kept[0] != i)
+                {
+                    kept[kept_count++] = i;
+                }
+            }
+            if (kept[0] > kept[1])
+            {
+                const int32_t tmp = kept[0];
+                kept[0] = kept[1];
+                kept[1] = tmp;
+            }
+
+            *values++ = src[kept[0]];
+            *values++ = src[kept[1]];
+            sum += src[kept[0]] + src[kept[1]];
+
+            const int32_t shift = (group % 2) * 4;
+            if (shift == 0)
+            {
+                indices[group / 2] = 0;
+            }
+            indices[group / 2] |= (uint8_t)((kept[0] | (kept[1] << 2)) << shift);
+            src += ARM_NN_SPARSE_2_4_GROUP;
+        }
+        kernel_sum[row] = sum;
+        indices += index_bytes;
+    }
+
+    return ARM_CMSIS_NN_SUCCESS;
+}
+
+/*
+ * S8 fully-connected layer function using 2:4 structured-sparse weights.
+ *
+ * Refer header file for details.
+ *
+ */
+arm_cmsis_nn_status arm_fully_connected_s8_sparse_2_4(const cmsis_nn_fc_params *fc_params,
+                                                      const cmsis_nn_per_tensor_quant_params *quant_params,
+                                                      const cmsis_nn_dims *input_dims,
+                                                      const int8_t *input,
+                                                      const cmsis_nn_dims *filter_dims,
+                                                      const int8_t *packed_data,
+                                                      const int32_t *bias,
+                                                      const cmsis_nn_dims *output_dims,
+                                                      int8_t *output)
+{
+    if (fc_params->filter_offset != 0 || filter_dims->n % ARM_NN_SPARSE_2_4_GROUP != 0)
+    {
+        return ARM_CMSIS_NN_ARG_ERROR;
+    }
+
+    int32_t batch_cnt = input_dims->n;
+
+    while (batch_cnt)
+    {
+        arm_nn_vec_mat_mult_t_s8_sparse_2_4(input,
+                                            packed_data,
+                                            bias,
+                                            output,
+                                            fc_params->input_offset,
+                                            fc_params->output_offset,
+                                            &quant_params->multiplier,
+                                            &quant_params->shift,
+                                            0,              /* per_channel */
+                                            filter_dims->n, /* col_dim or accum_depth */
+                                            output_dims->c, /* row_dim or output_depth */
+                                            fc_params->activation.min,
+                                            fc_params->activation.max);
+
+        input += filter_dims->n;
+        output += output_dims->c;
+        batch_cnt--;
+    }
+    return ARM_CMSIS_NN_SUCCESS;
+}
+
+/**
+ * @} end of FC group
+ */
@@ -0,0 +1,551 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_dot_prod_x86.c
+ * Description:  s8 dot products for x86 hosts using AVX2, AVX-VNNI and AVX-512
+ *
+ * $Date:        19 October 2024
+ * $Revision:    V.1.0.0
+ *
+ * Target :  x86 hosts without Arm(R) DSP or MVE extensions
+ *
+ * -------------------------------------------------------------------- */
+
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+
+#if defined(ARM_NN_X86_SIMD)
+
+    #include <immintrin.h>
+    #include <string.h>
+
+    #define ARM_NN_X86_AVX2 __attribute__((target("avx2")))
+    #define ARM_NN_X86_AVXVNNI __attribute__((target("avx2,avxvnni")))
+    #define ARM_NN_X86_AVX512BW __attribute__((target("avx512f,avx512bw")))
+    #define ARM_NN_X86_AVX512VNNI __attribute__((target("avx512f,avx512bw,avx512vnni")))
+
+/**
+ * @ingroup groupSupport
+ */
+
+/**
+ * @addtogroup supportFC
+ * @{
+ */
+
+typedef int32_t (*arm_nn_x86_dot_s8_fn)(const int8_t *, const int8_t *, int32_t, int32_t, int32_t);
+typedef int32_t (*arm_nn_x86_dot_s8_s16_fn)(const int8_t *, const int16_t *, int32_t);
+typedef void (*arm_nn_x86_dot_s8_packed_fn)(const int8_t *, const int8_t *, int32_t, const int32_t *, int32_t *);
+
+static arm_nn_x86_dot_s8_fn dot_s8_impl = NULL;
+static arm_nn_x86_dot_s8_s16_fn dot_s8_s16_impl = NULL;
+static arm_nn_x86_dot_s8_packed_fn dot_s8_packed_impl = NULL;
+
+/* Bytes of one group of ARM_NN_PACKED_COLS columns of a packed block. */
+    #define PACKED_GROUP_SIZE (ARM_NN_PACKED_ROWS * ARM_NN_PACKED_COLS)
+
+/* The widening kernels hold (value + offset) in int16 lanes, which is exact as long as the offsets stay in the range
+ * used by quantized int8 tensors. */
+static int offsets_fit_s16(const int32_t lhs_offset, const int32_t rhs_offset)
+{
+    return lhs_offset >= -256 && lhs_offset <= 256 && rhs_offset >= -256 && rhs_offset <= 256;
+}
+
+static int32_t dot_s8_c(const int8_t *lhs,
+                        const int8_t *rhs,
+                        const int32_t len,
+                        const int32_t lhs_offset,
+                        const int32_t rhs_offset)
+{
+    int32_t sum = 0;
+    for (int32_t i = 0; i < len; ++i)
+    {
+        sum += (lhs[i] + lhs_offset) * (rhs[i] + rhs_offset);
+    }
+    return sum;
+}
+
+static int32_t dot_s8_s16_c(const int8_t *lhs, const int16_t *rhs, const int32_t len)
+{
+    int32_t sum = 0;
+    for (int32_t i = 0; i < len; ++i)
+    {
+        sum += lhs[i] * rhs[i];
+    }
+    return sum;
+}
+
+/* Adds sum((lhs[i] + lhs_offset) * rhs[r][i]) for the columns from col, a multiple of ARM_NN_PACKED_COLS, to len of a
+ * packed block to dst[r]. */
+static void dot_s8_packed_add_c(const int8_t *lhs,
+                                const int8_t *packed_rhs,
+                                int32_t col,
+                                const int32_t len,
+                                const int32_t lhs_offset,
+                                int32_t *dst)
+{
+    const int8_t *rhs = packed_rhs + col * ARM_NN_PACKED_ROWS;
+    for (; col < len; col += ARM_NN_PACKED_COLS)
+    {
+        const int32_t cols_left = MIN(ARM_NN_PACKED_COLS, len - col);
+        for (int32_t r = 0; r < ARM_NN_PACKED_ROWS; ++r)
+        {
+            for (int32_t j = 0; j < cols_left; ++j)
+            {
+                dst[r] += (lhs[col + j] + lhs_offset) * rhs[j];
+            }
+            rhs += ARM_NN_PACKED_COLS;
+        }
+    }
+}
+
+static void dot_s8_packed_c(const int8_t *lhs,
+                            const int8_t *packed_rhs,
+                            const int32_t len,
+                            const int32_t *rhs_sums,
+                            int32_t *dst)
+{
+    (void)rhs_sums;
+    for (int32_t r = 0; r < ARM_NN_PACKED_ROWS; ++r)
+    {
+        dst[r] = 0;
+    }
+    dot_s8_packed_add_c(lhs, packed_rhs, 0, len, 0, dst);
+}
+
+/* Converts packed block sums taken over (lhs + 128), the unsigned operand of dpbusd, to sums over lhs. */
+static void unbias_packed_sums(int32_t *dst, const int32_t *rhs_sums)
+{
+    for (int32_t r = 0; r < ARM_NN_PACKED_ROWS; ++r)
+    {
+        dst[r] = (int32_t)((uint32_t)dst[r] - 128u * (uint32_t)rhs_sums[r]);
+    }
+}
+
+ARM_NN_X86_AVX2 static int32_t hsum_epi32_256(const __m256i v)
+{
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+/* Combines the dpbusd accumulators into sum((lhs + lhs_offset) * (rhs + rhs_offset)). lhs_u8_sum and lhs_rhs_sum are
+ * taken over (lhs + 128), the unsigned operand of dpbusd. Evaluated modulo 2^32 so the result matches the scalar
+ * accumulation bit for bit. */
+static int32_t combine_vnni_sums(const int32_t lhs_rhs_sum,
+                                 const int32_t lhs_u8_sum,
+                                 const int32_t rhs_sum,
+                                 const int32_t count,
+                                 const int32_t lhs_offset,
+                                 const int32_t rhs_offset)
+{
+    const uint32_t lhs_sum = (uint32_t)lhs_u8_sum - 128u * (uint32_t)count;
+    uint32_t sum = (uint32_t)lhs_rhs_sum - 128u * (uint32_t)rhs_sum;
+    sum += (uint32_t)lhs_offset * (uint32_t)rhs_sum;
+    sum += (uint32_t)rhs_offset * lhs_sum;
+    sum += (uint32_t)count * (uint32_t)lhs_offset * (uint32_t)rhs_offset;
+    return (int32_t)sum;
+}
+
+ARM_NN_X86_AVX2 static int32_t dot_s8_avx2(const int8_t *lhs,
+                                           const int8_t *rhs,
+                                           const int32_t len,
+                                           const int32_t lhs_offset,
+                                           const int32_t rhs_offset)
+{
+    if (!offsets_fit_s16(lhs_offset, rhs_offset))
+    {
+        return dot_s8_c(lhs, rhs, len, lhs_offset, rhs_offset);
+    }
+    const __m256i lhs_offset_s16 = _mm256_set1_epi16((int16_t)lhs_offset);
+    const __m256i rhs_offset_s16 = _mm256_set1_epi16((int16_t)rhs_offset);
+    __m256i acc_0 = _mm256_setzero_si256();
+    __m256i acc_1 = _mm256_setzero_si256();
+
+    int32_t i = 0;
+    for (; i <= len - 32; i += 32)
+    {
+        __m256i lhs_0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i)));
+        __m256i lhs_1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i + 16)));
+        __m256i rhs_0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(rhs + i)));
+        __m256i rhs_1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(rhs + i + 16)));
+        lhs_0 = _mm256_add_epi16(lhs_0, lhs_offset_s16);
+        lhs_1 = _mm256_add_epi16(lhs_1, lhs_offset_s16);
+        rhs_0 = _mm256_add_epi16(rhs_0, rhs_offset_s16);
+        rhs_1 = _mm256_add_epi16(rhs_1, rhs_offset_s16);
+        acc_0 = _mm256_add_epi32(acc_0, _mm256_madd_epi16(lhs_0, rhs_0));
+        acc_1 = _mm256_add_epi32(acc_1, _mm256_madd_epi16(lhs_1, rhs_1));
+    }
+    if (i <= len - 16)
+    {
+        __m256i lhs_0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i)));
+        __m256i rhs_0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(rhs + i)));
+        lhs_0 = _mm256_add_epi16(lhs_0, lhs_offset_s16);
+        rhs_0 = _mm256_add_epi16(rhs_0, rhs_offset_s16);
+        acc_0 = _mm256_add_epi32(acc_0, _mm256_madd_epi16(lhs_0, rhs_0));
+        i += 16;
+    }
+    return hsum_epi32_256(_mm256_add_epi32(acc_0, acc_1)) +
+        dot_s8_c(lhs + i, rhs + i, len - i, lhs_offset, rhs_offset);
+}
+
+ARM_NN_X86_AVX2 static int32_t dot_s8_s16_avx2(const int8_t *lhs, const int16_t *rhs, const int32_t len)
+{
+    __m256i acc_0 = _mm256_setzero_si256();
+    __m256i acc_1 = _mm256_setzero_si256();
+
+    int32_t i = 0;
+    for (; i <= len - 32; i += 32)
+    {
+        const __m256i lhs_0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i)));
+        const __m256i lhs_1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i + 16)));
+        const __m256i rhs_0 = _mm256_loadu_si256((const __m256i *)(rhs + i));
+        const __m256i rhs_1 = _mm256_loadu_si256((const __m256i *)(rhs + i + 16));
+        acc_0 = _mm256_add_epi32(acc_0, _mm256_madd_epi16(lhs_0, rhs_0));
+        acc_1 = _mm256_add_epi32(acc_1, _mm256_madd_epi16(lhs_1, rhs_1));
+    }
+    if (i <= len - 16)
+    {
+        const __m256i lhs_0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i)));
+        const __m256i rhs_0 = _mm256_loadu_si256((const __m256i *)(rhs + i));
+        acc_0 = _mm256_add_epi32(acc_0, _mm256_madd_epi16(lhs_0, rhs_0));
+        i += 16;
+    }
+    return hsum_epi32_256(_mm256_add_epi32(acc_0, acc_1)) + dot_s8_s16_c(lhs + i, rhs + i, len - i);
+}
+
+/* One group of a packed block widens to a full register: rows 0 to 3 with two pairs of columns each. The four
+ * columns of lhs are broadcast to every row. */
+ARM_NN_X86_AVX2 static void dot_s8_packed_avx2(const int8_t *lhs,
+                                               const int8_t *packed_rhs,
+                                               const int32_t len,
+                                               const int32_t *rhs_sums,
+                                               int32_t *dst)
+{
+    (void)rhs_sums;
+    __m256i acc_0 = _mm256_setzero_si256();
+    __m256i acc_1 = _mm256_setzero_si256();
+
+    int32_t col = 0;
+    for (; col <= len - 2 * ARM_NN_PACKED_COLS; col += 2 * ARM_NN_PACKED_COLS)
+    {
+        int32_t lhs_0;
+        int32_t lhs_1;
+        memcpy(&lhs_0, lhs + col, sizeof(lhs_0));
+        memcpy(&lhs_1, lhs + col + ARM_NN_PACKED_COLS, sizeof(lhs_1));
+        const int8_t *rhs = packed_rhs + col * ARM_NN_PACKED_ROWS;
+        const __m256i lhs_0_s16 = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(lhs_0)));
+        const __m256i lhs_1_s16 = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(lhs_1)));
+        const __m256i rhs_0_s16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)rhs));
+        const __m256i rhs_1_s16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(rhs + PACKED_GROUP_SIZE)));
+        acc_0 = _mm256_add_epi32(acc_0, _mm256_madd_epi16(lhs_0_s16, rhs_0_s16));
+        acc_1 = _mm256_add_epi32(acc_1, _mm256_madd_epi16(lhs_1_s16, rhs_1_s16));
+    }
+    const __m256i acc = _mm256_add_epi32(acc_0, acc_1);
+    const __m128i sums = _mm_hadd_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    _mm_storeu_si128((__m128i *)dst, sums);
+    dot_s8_packed_add_c(lhs, packed_rhs, col, len, 0, dst);
+}
+
+    #if defined(ARM_NN_X86_VNNI)
+/* Each 128-bit lane takes one group of a packed block, with the four columns of lhs of that group broadcast to every
+ * row. The sums over (lhs + 128) are corrected with the precomputed row sums. */
+ARM_NN_X86_AVXVNNI static void dot_s8_packed_avxvnni(const int8_t *lhs,
+                                                     const int8_t *packed_rhs,
+                                                     const int32_t len,
+                                                     const int32_t *rhs_sums,
+                                                     int32_t *dst)
+{
+    const __m256i sign_flip = _mm256_set1_epi8((char)0x80);
+    const __m256i lhs_index = _mm256_set_epi32(1, 1, 1, 1, 0, 0, 0, 0);
+    __m256i acc = _mm256_setzero_si256();
+
+    int32_t col = 0;
+    for (; col <= len - 2 * ARM_NN_PACKED_COLS; col += 2 * ARM_NN_PACKED_COLS)
+    {
+        const __m256i lhs_s8 = _mm256_castsi128_si256(_mm_loadl_epi64((const __m128i *)(lhs + col)));
+        const __m256i lhs_u8 = _mm256_xor_si256(_mm256_permutevar8x32_epi32(lhs_s8, lhs_index), sign_flip);
+        const __m256i rhs_s8 = _mm256_loadu_si256((const __m256i *)(packed_rhs + col * ARM_NN_PACKED_ROWS));
+        acc = _mm256_dpbusd_avx_epi32(acc, lhs_u8, rhs_s8);
+    }
+    _mm_storeu_si128((__m128i *)dst, _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+    dot_s8_packed_add_c(lhs, packed_rhs, col, len, 128, dst);
+    unbias_packed_sums(dst, rhs_sums);
+}
+
+ARM_NN_X86_AVXVNNI static int32_t dot_s8_avxvnni(const int8_t *lhs,
+                                                 const int8_t *rhs,
+                                                 const int32_t len,
+                                                 const int32_t lhs_offset,
+                                                 const int32_t rhs_offset)
+{
+    const __m256i sign_flip = _mm256_set1_epi8((char)0x80);
+    const __m256i ones = _mm256_set1_epi8(1);
+    __m256i lhs_rhs_acc = _mm256_setzero_si256();
+    __m256i lhs_acc = _mm256_setzero_si256();
+    __m256i rhs_acc = _mm256_setzero_si256();
+
+    int32_t i = 0;
+    for (; i <= len - 32; i += 32)
+    {
+        const __m256i lhs_u8 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(lhs + i)), sign_flip);
+        const __m256i rhs_s8 = _mm256_loadu_si256((const __m256i *)(rhs + i));
+        lhs_rhs_acc = _mm256_dpbusd_avx_epi32(lhs_rhs_acc, lhs_u8, rhs_s8);
+        lhs_acc = _mm256_dpbusd_avx_epi32(lhs_acc, lhs_u8, ones);
+        rhs_acc = _mm256_dpbusd_avx_epi32(rhs_acc, ones, rhs_s8);
+    }
+    const int32_t sum = combine_vnni_sums(hsum_epi32_256(lhs_rhs_acc),
+                                          hsum_epi32_256(lhs_acc),
+                                          hsum_epi32_256(rhs_acc),
+                                          i,
+                                          lhs_offset,
+                                          rhs_offset);
+    return sum + dot_s8_c(lhs + i, rhs + i, len - i, lhs_offset, rhs_offset);
+}
+
+ARM_NN_X86_AVXVNNI static int32_t dot_s8_s16_avxvnni(const int8_t *lhs, const int16_t *rhs, const int32_t len)
+{
+    __m256i acc_0 = _mm256_setzero_si256();
+    __m256i acc_1 = _mm256_setzero_si256();
+
+    int32_t i = 0;
+    for (; i <= len - 32; i += 32)
+    {
+        const __m256i lhs_0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i)));
+        const __m256i lhs_1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i + 16)));
+        acc_0 = _mm256_dpwssd_avx_epi32(acc_0, lhs_0, _mm256_loadu_si256((const __m256i *)(rhs + i)));
+        acc_1 = _mm256_dpwssd_avx_epi32(acc_1, lhs_1, _mm256_loadu_si256((const __m256i *)(rhs + i + 16)));
+    }
+    return hsum_epi32_256(_mm256_add_epi32(acc_0, acc_1)) + dot_s8_s16_c(lhs + i, rhs + i, len - i);
+}
+    #endif /* ARM_NN_X86_VNNI */
+
+ARM_NN_X86_AVX512BW static int32_t hsum_epi32_512(const __m512i v)
+{
+    const __m256i sum = _mm256_add_epi32(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64(v, 1));
+    return hsum_epi32_256(sum);
+}
+
+ARM_NN_X86_AVX512BW static int32_t dot_s8_avx512bw(const int8_t *lhs,
+                                                   const int8_t *rhs,
+                                                   const int32_t len,
+                                                   const int32_t lhs_offset,
+                                                   const int32_t rhs_offset)
+{
+    if (!offsets_fit_s16(lhs_offset, rhs_offset))
+    {
+        return dot_s8_c(lhs, rhs, len, lhs_offset, rhs_offset);
+    }
+    const __m512i lhs_offset_s16 = _mm512_set1_epi16((int16_t)lhs_offset);
+    const __m512i rhs_offset_s16 = _mm512_set1_epi16((int16_t)rhs_offset);
+    __m512i acc = _mm512_setzero_si512();
+
+    int32_t i = 0;
+    for (; i <= len - 32; i += 32)
+    {
+        __m512i lhs_s16 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(lhs + i)));
+        __m512i rhs_s16 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(rhs + i)));
+        lhs_s16 = _mm512_add_epi16(lhs_s16, lhs_offset_s16);
+        rhs_s16 = _mm512_add_epi16(rhs_s16, rhs_offset_s16);
+        acc = _mm512_add_epi32(acc, _mm512_madd_epi16(lhs_s16, rhs_s16));
+    }
+    return hsum_epi32_512(acc) + dot_s8_c(lhs + i, rhs + i, len - i, lhs_offset, rhs_offset);
+}
+
+ARM_NN_X86_AVX512BW static int32_t dot_s8_s16_avx512bw(const int8_t *lhs, const int16_t *rhs, const int32_t len)
+{
+    __m512i acc = _mm512_setzero_si512();
+
+    int32_t i = 0;
+    for (; i <= len - 32; i += 32)
+    {
+        const __m512i lhs_s16 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(lhs + i)));
+        acc = _mm512_add_epi32(acc, _mm512_madd_epi16(lhs_s16, _mm512_loadu_si512((const void *)(rhs + i))));
+    }
+    return hsum_epi32_512(acc) + dot_s8_s16_c(lhs + i, rhs + i, len - i);
+}
+
+ARM_NN_X86_AVX512VNNI static int32_t dot_s8_avx512vnni(const int8_t *lhs,
+                                                       const int8_t *rhs,
+                                                       const int32_t len,
+                                                       const int32_t lhs_offset,
+                                                       const int32_t rhs_offset)
+{
+    const __m512i sign_flip = _mm512_set1_epi8((char)0x80);
+    const __m512i ones = _mm512_set1_epi8(1);
+    __m512i lhs_rhs_acc = _mm512_setzero_si512();
+    __m512i lhs_acc = _mm512_setzero_si512();
+    __m512i rhs_acc = _mm512_setzero_si512();
+
+    int32_t i = 0;
+    for (; i <= len - 64; i += 64)
+    {
+        const __m512i lhs_u8 = _mm512_xor_si512(_mm512_loadu_si512((const void *)(lhs + i)), sign_flip);
+        const __m512i rhs_s8 = _mm512_loadu_si512((const void *)(rhs + i));
+        lhs_rhs_acc = _mm512_dpbusd_epi32(lhs_rhs_acc, lhs_u8, rhs_s8);
+        lhs_acc = _mm512_dpbusd_epi32(lhs_acc, lhs_u8, ones);
+        rhs_acc = _mm512_dpbusd_epi32(rhs_acc, ones, rhs_s8);
+    }
+    const int32_t sum = combine_vnni_sums(hsum_epi32_512(lhs_rhs_acc),
+                                          hsum_epi32_512(lhs_acc),
+                                          hsum_epi32_512(rhs_acc),
+                                          i,
+                                          lhs_offset,
+                                          rhs_offset);
+    return sum + dot_s8_avx512bw(lhs + i, rhs + i, len - i, lhs_offset, rhs_offset);
+}
+
+ARM_NN_X86_AVX512VNNI static int32_t dot_s8_s16_avx512vnni(const int8_t *lhs, const int16_t *rhs, const int32_t len)
+{
+    __m512i acc = _mm512_setzero_si512();
+
+    int32_t i = 0;
+    for (; i <= len - 32; i += 32)
+    {
+        const __m512i lhs_s16 = _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(lhs + i)));
+        acc = _mm512_dpwssd_epi32(acc, lhs_s16, _mm512_loadu_si512((const void *)(rhs + i)));
+    }
+    return hsum_epi32_512(acc) + dot_s8_s16_c(lhs + i, rhs + i, len - i);
+}
+
+ARM_NN_X86_AVX512VNNI static void dot_s8_packed_avx512vnni(const int8_t *lhs,
+                                                          const int8_t *packed_rhs,
+                                                          const int32_t len,
+                                                          const int32_t *rhs_sums,
+                                                          int32_t *dst)
+{
+    const __m512i sign_flip = _mm512_set1_epi8((char)0x80);
+    const __m512i lhs_index = _mm512_set_epi32(3, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0);
+    __m512i acc = _mm512_setzero_si512();
+
+    int32_t col = 0;
+    for (; col <= len - 4 * ARM_NN_PACKED_COLS; col += 4 * ARM_NN_PACKED_COLS)
+    {
+        const __m512i lhs_s8 = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *)(lhs + col)));
+        const __m512i lhs_u8 = _mm512_xor_si512(_mm512_permutexvar_epi32(lhs_index, lhs_s8), sign_flip);
+        const __m512i rhs_s8 = _mm512_loadu_si512((const void *)(packed_rhs + col * ARM_NN_PACKED_ROWS));
+        acc = _mm512_dpbusd_epi32(acc, lhs_u8, rhs_s8);
+    }
+    const __m256i acc_256 = _mm256_add_epi32(_mm512_castsi512_si256(acc), _mm512_extracti64x4_epi64(acc, 1));
+    _mm_storeu_si128((__m128i *)dst,
+                     _mm_add_epi32(_mm256_castsi256_si128(acc_256), _mm256_extracti128_si256(acc_256, 1)));
+    dot_s8_packed_add_c(lhs, packed_rhs, col, len, 128, dst);
+    unbias_packed_sums(dst, rhs_sums);
+}
+
+/* Picks the widest kernels the CPU supports. The pointers are written with the same values by every caller, so a
+ * race between threads doing the first call is harmless. */
+static void select_impl(void)
+{
+    arm_nn_x86_dot_s8_fn dot_s8 = dot_s8_c;
+    arm_nn_x86_dot_s8_s16_fn dot_s8_s16 = dot_s8_s16_c;
+    arm_nn_x86_dot_s8_packed_fn dot_s8_packed = dot_s8_packed_c;
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vnni"))
+    {
+        dot_s8 = dot_s8_avx512vnni;
+        dot_s8_s16 = dot_s8_s16_avx512vnni;
+        dot_s8_packed = dot_s8_packed_avx512vnni;
+    }
+    #if defined(ARM_NN_X86_VNNI)
+    else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("avxvnni"))
+    {
+        dot_s8 = dot_s8_avxvnni;
+        dot_s8_s16 = dot_s8_s16_avxvnni;
+        dot_s8_packed = dot_s8_packed_avxvnni;
+    }
+    #endif
+    else if (__builtin_cpu_supports("avx512bw"))
+    {
+        dot_s8 = dot_s8_avx512bw;
+        dot_s8_s16 = dot_s8_s16_avx512bw;
+        dot_s8_packed = dot_s8_packed_avx2;
+    }
+    else if (__builtin_cpu_supports("avx2"))
+    {
+        dot_s8 = dot_s8_avx2;
+        dot_s8_s16 = dot_s8_s16_avx2;
+        dot_s8_packed = dot_s8_packed_avx2;
+    }
+
+    dot_s8_packed_impl = dot_s8_packed;
+    dot_s8_s16_impl = dot_s8_s16;
+    dot_s8_impl = dot_s8;
+}
+
+/*
+ * s8 dot product with offsets for x86 hosts.
+ *
+ * Refer header file for details.
+ *
+ */
+int32_t arm_nn_x86_dot_s8(const int8_t *lhs,
+                          const int8_t *rhs,
+                          const int32_t len,
+                          const int32_t lhs_offset,
+                          const int32_t rhs_offset)
+{
+    if (dot_s8_impl == NULL)
+    {
+        select_impl();
+    }
+    return dot_s8_impl(lhs, rhs, len, lhs_offset, rhs_offset);
+}
+
+/*
+ * s8 by s16 dot product for x86 hosts.
+ *
+ * Refer header file for details.
+ *
+ */
+int32_t arm_nn_x86_dot_s8_s16(const int8_t *lhs, const int16_t *rhs, const int32_t len)
+{
+    if (dot_s8_s16_impl == NULL)
+    {
+        select_impl();
+    }
+    return dot_s8_s16_impl(lhs, rhs, len);
+}
+
+/*
+ * s8 dot products with a packed block for x86 hosts.
+ *
+ * Refer header file for details.
+ *
+ */
+void arm_nn_x86_dot_s8_packed(const int8_t *lhs,
+                              const int8_t *packed_rhs,
+                              const int32_t len,
+                              const int32_t *rhs_sums,
+                              int32_t *dst)
+{
+    if (dot_s8_packed_impl == NULL)
+    {
+        select_impl();
+    }
+    dot_s8_packed_impl(lhs, packed_rhs, len, rhs_sums, dst);
+}
+
+/**
+ * @} end of Doxygen group
+ */
+
+#endif /* ARM_NN_X86_SIMD */
@@ -656,6 +656,13 @@ arm_cmsis_nn_status arm_nn_mat_mult_nt_t_s8(const int8_t *lhs,
             int32_t res10 = lhs_offset_contribution0;
             int32_t res11 = lhs_offset_contribution1;
 
+    #if defined(ARM_NN_X86_SIMD)
+            res00 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr, rhs_cols, 0, 0);
+            res01 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr + rhs_cols, rhs_cols, 0, 0);
+            res10 += arm_nn_x86_dot_s8(lhs_ptr + lhs_cols_offset, rhs_ptr, rhs_cols, 0, 0);
+            res11 += arm_nn_x86_dot_s8(lhs_ptr + lhs_cols_offset, rhs_ptr + rhs_cols, rhs_cols, 0, 0);
+            lhs_ptr += rhs_cols;
+    #else
             for (int32_t rhs_cols_idx = rhs_cols; rhs_cols_idx != 0; rhs_cols_idx--)
             {
                 int8_t rhs_value0 = rhs_ptr[0];
@@ -672,6 +679,7 @@ arm_cmsis_nn_status arm_nn_mat_mult_nt_t_s8(const int8_t *lhs,
                 ++rhs_ptr;
                 ++lhs_ptr;
             }
+    #endif
 
             // Quantize down
             res00 = arm_nn_requantize(res00, dst_multipliers[rhs_rows_idx], dst_shifts[rhs_rows_idx]);
@@ -716,6 +724,10 @@ arm_cmsis_nn_status arm_nn_mat_mult_nt_t_s8(const int8_t *lhs,
             int32_t res00 = lhs_offset_contribution0;
             int32_t res01 = lhs_offset_contribution1;
 
+    #if defined(ARM_NN_X86_SIMD)
+            res00 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr, rhs_cols, 0, 0);
+            res01 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr + rhs_cols, rhs_cols, 0, 0);
+    #else
             for (int32_t rhs_cols_idx = rhs_cols; rhs_cols_idx != 0; rhs_cols_idx--)
             {
                 int8_t rhs_value0 = rhs_ptr[0];
@@ -728,6 +740,7 @@ arm_cmsis_nn_status arm_nn_mat_mult_nt_t_s8(const int8_t *lhs,
                 ++rhs_ptr;
                 ++lhs_ptr;
             }
+    #endif
 
             // Quantize down
             res00 = arm_nn_requantize(res00, dst_multipliers[rhs_rows_idx], dst_shifts[rhs_rows_idx]);
@@ -765,6 +778,10 @@ arm_cmsis_nn_status arm_nn_mat_mult_nt_t_s8(const int8_t *lhs,
                 res00 = bias[rhs_rows - 1];
             }
 
+    #if defined(ARM_NN_X86_SIMD)
+            res00 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr, rhs_cols, lhs_offset, 0);
+            lhs_ptr += rhs_cols;
+    #else
             for (int32_t rhs_cols_idx = rhs_cols; rhs_cols_idx != 0; rhs_cols_idx--)
             {
                 int32_t rhs_value = rhs_ptr[0];
@@ -775,6 +792,7 @@ arm_cmsis_nn_status arm_nn_mat_mult_nt_t_s8(const int8_t *lhs,
                 ++rhs_ptr;
                 ++lhs_ptr;
             }
+    #endif
             lhs_ptr -= rhs_cols;
             lhs_ptr += lhs_cols_offset;
 
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_sparse_lhs_gather_s8
+ * Description:  Gathers the values of an s8 vector that differ from its zero point
+ *
+ * $Date:        19 October 2024
+ * $Revision:    V.1.0.0
+ *
+ * Target :  Arm(R) M-Profile Architecture
+ *
+ * -------------------------------------------------------------------- */
+
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+
+/**
+ * @ingroup groupSupport
+ */
+
+/**
+ * @addtogroup supportFC
+ * @{
+ */
+
+/*
+ * Gathers the values of an s8 vector that differ from its zero point
+ *
+ * Refer header file for details.
+ *
+ */
+int32_t arm_nn_sparse_lhs_gather_s8(const int8_t *lhs,
+                                    const int32_t lhs_offset,
+                                    const int32_t lhs_cols,
+                                    const int32_t max_count,
+                                    uint16_t *indices,
+                                    int16_t *values)
+{
+    const int8_t zero_point = (int8_t)(-lhs_offset);
+    int32_t count = 0;
+
+    for (int32_t col = 0; col < lhs_cols; col++)
+    {
+        if (lhs[col] != zero_point)
+        {
+            if (count == max_count)
+            {
+                return -1;
+            }
+            indices[count] = (uint16_t)col;
+            values[count] = (int16_t)(lhs[col] + lhs_offset);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @} end of Doxygen group
+ */
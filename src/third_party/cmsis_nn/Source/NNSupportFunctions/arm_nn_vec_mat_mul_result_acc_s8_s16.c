@@ -271,6 +271,11 @@ arm_cmsis_nn_status arm_nn_vec_mat_mul_result_acc_s8_s16(const int8_t *lhs,
             int32_t res01 = *effective_bias_ptr++;
             int32_t res02 = *effective_bias_ptr++;
 
+    #if defined(ARM_NN_X86_SIMD)
+            res00 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_0, rhs_cols, 0, 0);
+            res01 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_1, rhs_cols, 0, 0);
+            res02 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_2, rhs_cols, 0, 0);
+    #else
             for (int32_t rhs_cols_idx = 0; rhs_cols_idx < rhs_cols; ++rhs_cols_idx)
             {
                 const int32_t rhs_value0 = (int8_t)*rhs_ptr_0;
@@ -287,6 +292,7 @@ arm_cmsis_nn_status arm_nn_vec_mat_mul_result_acc_s8_s16(const int8_t *lhs,
                 ++rhs_ptr_2;
                 ++lhs_ptr;
             }
+    #endif
             // Quantize down
             res00 = arm_nn_requantize(res00, dst_multiplier, dst_shift);
             res01 = arm_nn_requantize(res01, dst_multiplier, dst_shift);
@@ -315,6 +321,9 @@ arm_cmsis_nn_status arm_nn_vec_mat_mul_result_acc_s8_s16(const int8_t *lhs,
 
             int32_t res00 = *effective_bias_ptr++;
 
+    #if defined(ARM_NN_X86_SIMD)
+            res00 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_0, rhs_cols, 0, 0);
+    #else
             for (int32_t rhs_cols_idx = 0; rhs_cols_idx < rhs_cols; ++rhs_cols_idx)
             {
                 int32_t rhs_value0 = (int8_t)rhs_ptr_0[0];
@@ -325,6 +334,7 @@ arm_cmsis_nn_status arm_nn_vec_mat_mul_result_acc_s8_s16(const int8_t *lhs,
                 ++rhs_ptr_0;
                 ++lhs_ptr;
             }
+    #endif
 
             // Quantize down
             res00 = arm_nn_requantize(res00, dst_multiplier, dst_shift);
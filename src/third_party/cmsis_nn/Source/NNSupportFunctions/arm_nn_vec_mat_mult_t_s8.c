@@ -336,6 +336,11 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                 res01 = *bias++;
                 res02 = *bias++;
             }
+    #if defined(ARM_NN_X86_SIMD)
+            res00 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_0, rhs_cols, lhs_offset, rhs_offset);
+            res01 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_1, rhs_cols, lhs_offset, rhs_offset);
+            res02 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_2, rhs_cols, lhs_offset, rhs_offset);
+    #else
             for (int32_t rhs_cols_idx = 0; rhs_cols_idx < rhs_cols; ++rhs_cols_idx)
             {
                 const int32_t rhs_value0 = (int8_t)*rhs_ptr_0 + rhs_offset;
@@ -352,6 +357,7 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                 ++rhs_ptr_2;
                 ++lhs_ptr;
             }
+    #endif
 
             // Quantize down
             res00 = arm_nn_requantize(res00, dst_multiplier, dst_shift);
@@ -392,6 +398,9 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                 res00 = *bias++;
             }
 
+    #if defined(ARM_NN_X86_SIMD)
+            res00 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr, rhs_cols, lhs_offset, rhs_offset);
+    #else
             for (int32_t rhs_cols_idx = 0; rhs_cols_idx < rhs_cols; ++rhs_cols_idx)
             {
                 int32_t rhs_value0 = (int8_t)rhs_ptr[0] + rhs_offset;
@@ -402,6 +411,7 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                 ++rhs_ptr;
                 ++lhs_ptr;
             }
+    #endif
 
             // Quantize down
             res00 = arm_nn_requantize(res00, dst_multiplier, dst_shift);
@@ -673,6 +683,11 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                 res01 = *bias++;
                 res02 = *bias++;
             }
+    #if defined(ARM_NN_X86_SIMD)
+            res00 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_0, rhs_cols, lhs_offset, 0);
+            res01 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_1, rhs_cols, lhs_offset, 0);
+            res02 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr_2, rhs_cols, lhs_offset, 0);
+    #else
             for (int32_t rhs_cols_idx = 0; rhs_cols_idx < rhs_cols; ++rhs_cols_idx)
             {
                 const int32_t rhs_value0 = (int8_t)*rhs_ptr_0;
@@ -689,6 +704,7 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                 ++rhs_ptr_2;
                 ++lhs_ptr;
             }
+    #endif
             // Quantize down
             res00 = arm_nn_requantize(res00, dst_multiplier, dst_shift);
             res01 = arm_nn_requantize(res01, dst_multiplier, dst_shift);
@@ -728,6 +744,9 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                 res00 = *bias++;
             }
 
+    #if defined(ARM_NN_X86_SIMD)
+            res00 += arm_nn_x86_dot_s8(lhs_ptr, rhs_ptr, rhs_cols, lhs_offset, 0);
+    #else
             for (int32_t rhs_cols_idx = 0; rhs_cols_idx < rhs_cols; ++rhs_cols_idx)
             {
                 int32_t rhs_value0 = (int8_t)rhs_ptr[0];
@@ -738,6 +757,7 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                 ++rhs_ptr;
                 ++lhs_ptr;
             }
+    #endif
 
             // Quantize down
             res00 = arm_nn_requantize(res00, dst_multiplier, dst_shift);
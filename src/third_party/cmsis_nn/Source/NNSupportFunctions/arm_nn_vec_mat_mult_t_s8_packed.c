@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_vec_mat_mult_t_s8_packed
+ * Description:  s8 vector by packed matrix (transposed) multiplication
+ *
+ * $Date:        19 October 2024
+ * $Revision:    V.1.0.0
+ *
+ * Target :  Arm(R) M-Profile Architecture
+ *
+ * -------------------------------------------------------------------- */
+
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+
+/**
+ * @ingroup groupSupport
+ */
+
+/**
+ * @addtogroup supportFC
+ * @{
+ */
+
+/*
+ * s8 vector(lhs) by packed matrix (transposed) multiplication
+ *
+ * Refer header file for details.
+ *
+ */
+arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8_packed(const int8_t *lhs,
+                                                    const int8_t *packed_rhs,
+                                                    const int32_t *bias,
+                                                    int8_t *dst,
+                                                    const int32_t lhs_offset,
+                                                    const int32_t dst_offset,
+                                                    const int32_t dst_multiplier,
+                                                    const int32_t dst_shift,
+                                                    const int32_t rhs_cols,
+                                                    const int32_t rhs_rows,
+                                                    const int32_t activation_min,
+                                                    const int32_t activation_max)
+{
+    const int32_t row_blocks = (rhs_rows + ARM_NN_PACKED_ROWS - 1) / ARM_NN_PACKED_ROWS;
+    const int32_t col_groups = (rhs_cols + ARM_NN_PACKED_COLS - 1) / ARM_NN_PACKED_COLS;
+    const int32_t *kernel_sum = (const int32_t *)packed_rhs;
+    const int8_t *rhs = packed_rhs + row_blocks * ARM_NN_PACKED_ROWS * sizeof(int32_t);
+
+    for (int32_t row = 0; row < rhs_rows; row += ARM_NN_PACKED_ROWS)
+    {
+        int32_t sums[ARM_NN_PACKED_ROWS];
+
+#if defined(ARM_NN_X86_SIMD)
+        arm_nn_x86_dot_s8_packed(lhs, rhs, rhs_cols, kernel_sum + row, sums);
+#else
+        for (int32_t i = 0; i < ARM_NN_PACKED_ROWS; i++)
+        {
+            sums[i] = 0;
+        }
+        const int8_t *rhs_ptr = rhs;
+        for (int32_t col = 0; col < rhs_cols; col += ARM_NN_PACKED_COLS)
+        {
+            const int32_t cols_left = MIN(ARM_NN_PACKED_COLS, rhs_cols - col);
+            for (int32_t i = 0; i < ARM_NN_PACKED_ROWS; i++)
+            {
+                int32_t sum = sums[i];
+                for (int32_t j = 0; j < cols_left; j++)
+                {
+                    sum += lhs[col + j] * rhs_ptr[j];
+                }
+                sums[i] = sum;
+                rhs_ptr += ARM_NN_PACKED_COLS;
+            }
+        }
+#endif
+
+        const int32_t rows_left = MIN(ARM_NN_PACKED_ROWS, rhs_rows - row);
+        for (int32_t i = 0; i < rows_left; i++)
+        {
+            int32_t res = sums[i] + kernel_sum[row + i] * lhs_offset;
+            if (bias)
+            {
+                res += bias[row + i];
+            }
+
+            // Quantize down
+            res = arm_nn_requantize(res, dst_multiplier, dst_shift);
+
+            // Add offset
+            res += dst_offset;
+
+            // Clamp the result
+            res = MAX(res, activation_min);
+            res = MIN(res, activation_max);
+
+            dst[row + i] = (int8_t)res;
+        }
+
+        rhs += col_groups * ARM_NN_PACKED_ROWS * ARM_NN_PACKED_COLS;
+    }
+
+    return ARM_CMSIS_NN_SUCCESS;
+}
+
+/**
+ * @} end of Doxygen group
+ */
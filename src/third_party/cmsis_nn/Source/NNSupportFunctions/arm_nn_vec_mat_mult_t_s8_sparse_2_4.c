@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_vec_mat_mult_t_s8_sparse_2_4
+ * Description:  s8 vector by 2:4 structured-sparse matrix (transposed) multiplication
+ *
+ * $Date:        19 October 2024
+ * $Revision:    V.1.0.0
+ *
+ * Target :  Arm(R) M-Profile Architecture
+ *
+ * -------------------------------------------------------------------- */
+
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+
+/**
+ * @ingroup groupSupport
+ */
+
+/**
+ * @addtogroup supportFC
+ * @{
+ */
+
+/*
+ * s8 vector(lhs) by 2:4 structured-sparse matrix (transposed) multiplication
+ *
+ * Refer header file for details.
+ *
+ */
+arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8_sparse_2_4(const int8_t *lhs,
+                                                        const int8_t *packed_rhs,
+                                                        const int32_t *bias,
+                                                        int8_t *dst,
+                                                        const int32_t lhs_offset,
+                                                        const int32_t dst_offset,
+                                                        const int32_t *dst_multipliers,
+                                                        const int32_t *dst_shifts,
+                                                        const int32_t per_channel,
+                                                        const int32_t rhs_cols,
+                                                        const int32_t rhs_rows,
+                                                        const int32_t activation_min,
+                                                        const int32_t activation_max)
+{
+    const int32_t groups = rhs_cols / ARM_NN_SPARSE_2_4_GROUP;
+    const int32_t index_bytes = ARM_NN_SPARSE_2_4_INDEX_BYTES(rhs_cols);
+    const int32_t *kernel_sum = (const int32_t *)packed_rhs;
+    const int8_t *values = packed_rhs + rhs_rows * (int32_t)sizeof(int32_t);
+    const uint8_t *indices = (const uint8_t *)(values + rhs_rows * (rhs_cols / 2));
+
+    for (int32_t row = 0; row < rhs_rows; row++)
+    {
+        const int8_t *lhs_ptr = lhs;
+        const uint8_t *index_ptr = indices;
+        int32_t acc = 0;
+        int32_t group = 0;
+
+        // Each index byte selects the two non-zero columns of two consecutive groups.
+        for (; group < groups - 1; group += 2)
+        {
+            const int32_t index = *index_ptr++;
+            acc += values[0] * lhs_ptr[index & 0x3];
+            acc += values[1] * lhs_ptr[(index >> 2) & 0x3];
+            acc += values[2] * lhs_ptr[ARM_NN_SPARSE_2_4_GROUP + ((index >> 4) & 0x3)];
+            acc += values[3] * lhs_ptr[ARM_NN_SPARSE_2_4_GROUP + ((index >> 6) & 0x3)];
+            values += 4;
+            lhs_ptr += 2 * ARM_NN_SPARSE_2_4_GROUP;
+        }
+        if (group < groups)
+        {
+            const int32_t index = *index_ptr;
+            acc += values[0] * lhs_ptr[index & 0x3];
+            acc += values[1] * lhs_ptr[(index >> 2) & 0x3];
+            values += 2;
+        }
+        indices += index_bytes;
+
+        acc += kernel_sum[row] * lhs_offset;
+        if (bias)
+        {
+            acc += bias[row];
+        }
+
+        // Quantize down
+        const int32_t quant_row = per_channel ? row : 0;
+        acc = arm_nn_requantize(acc, dst_multipliers[quant_row], dst_shifts[quant_row]);
+
+        // Add offset
+        acc += dst_offset;
+
+        // Clamp the result
+        acc = MAX(acc, activation_min);
+        acc = MIN(acc, activation_max);
+
+        dst[row] = (int8_t)acc;
+    }
+
+    return ARM_CMSIS_NN_SUCCESS;
+}
+
+/**
+ * @} end of Doxygen group
+ */
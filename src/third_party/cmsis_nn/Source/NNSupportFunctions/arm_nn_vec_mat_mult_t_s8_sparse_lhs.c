@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ----------------------------------------------------------------------
+ * Project:      CMSIS NN Library
+ * Title:        arm_nn_vec_mat_mult_t_s8_sparse_lhs
+ * Description:  s8 sparse vector by matrix (transposed) multiplication
+ *
+ * $Date:        19 October 2024
+ * $Revision:    V.1.0.0
+ *
+ * Target :  Arm(R) M-Profile Architecture
+ *
+ * -------------------------------------------------------------------- */
+
+#include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+
+/**
+ * @ingroup groupSupport
+ */
+
+/**
+ * @addtogroup supportFC
+ * @{
+ */
+
+__STATIC_FORCEINLINE int8_t arm_nn_sparse_lhs_requantize(int32_t acc,
+                                                         const int32_t *bias,
+                                                         const int32_t row,
+                                                         const int32_t dst_offset,
+                                                         const int32_t *dst_multipliers,
+                                                         const int32_t *dst_shifts,
+                                                         const int32_t per_channel,
+                                                         const int32_t activation_min,
+                                                         const int32_t activation_max)
+{
+    if (bias)
+    {
+        acc += bias[row];
+    }
+
+    // Quantize down
+    const int32_t quant_row = per_channel ? row : 0;
+    acc = arm_nn_requantize(acc, dst_multipliers[quant_row], dst_shifts[quant_row]);
+
+    // Add offset
+    acc += dst_offset;
+
+    // Clamp the result
+    acc = MAX(acc, activation_min);
+    acc = MIN(acc, activation_max);
+
+    return (int8_t)acc;
+}
+
+/*
+ * s8 sparse vector(lhs) by matrix (transposed) multiplication
+ *
+ * Refer header file for details.
+ *
+ */
+arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8_sparse_lhs(const uint16_t *lhs_indices,
+                                                        const int16_t *lhs_values,
+                                                        const int32_t lhs_count,
+                                                        const int8_t *rhs,
+                                                        const int32_t *bias,
+                                                        int8_t *dst,
+                                                        const int32_t dst_offset,
+                                                        const int32_t *dst_multipliers,
+                                                        const int32_t *dst_shifts,
+                                                        const int32_t per_channel,
+                                                        const int32_t rhs_cols,
+                                                        const int32_t rhs_rows,
+                                                        const int32_t activation_min,
+                                                        const int32_t activation_max)
+{
+    int32_t row = 0;
+
+    // Four rows share each load of an lhs index and value.
+    for (; row <= rhs_rows - 4; row += 4)
+    {
+        const int8_t *rhs_0 = rhs + row * rhs_cols;
+        const int8_t *rhs_1 = rhs_0 + rhs_cols;
+        const int8_t *rhs_2 = rhs_1 + rhs_cols;
+        const int8_t *rhs_3 = rhs_2 + rhs_cols;
+        int32_t acc_0 = 0;
+        int32_t acc_1 = 0;
+        int32_t acc_2 = 0;
+        int32_t acc_3 = 0;
+
+        for (int32_t i = 0; i < lhs_count; i++)
+        {
+            const int32_t col = lhs_indices[i];
+            const int32_t lhs_value = lhs_values[i];
+            acc_0 += rhs_0[col] * lhs_value;
+            acc_1 += rhs_1[col] * lhs_value;
+            acc_2 += rhs_2[col] * lhs_value;
+            acc_3 += rhs_3[col] * lhs_value;
+        }
+
+        dst[row] = arm_nn_sparse_lhs_requantize(
+            acc_0, bias, row, dst_offset, dst_multipliers, dst_shifts, per_channel, activation_min, activation_max);
+        dst[row + 1] = arm_nn_sparse_lhs_requantize(
+            acc_1, bias, row + 1, dst_offset, dst_multipliers, dst_shifts, per_channel, activation_min, activation_max);
+        dst[row + 2] = arm_nn_sparse_lhs_requantize(
+            acc_2, bias, row + 2, dst_offset, dst_multipliers, dst_shifts, per_channel, activation_min, activation_max);
+        dst[row + 3] = arm_nn_sparse_lhs_requantize(
+            acc_3, bias, row + 3, dst_offset, dst_multipliers, dst_shifts, per_channel, activation_min, activation_max);
+    }
+
+    for (; row < rhs_rows; row++)
+    {
+        const int8_t *rhs_0 = rhs + row * rhs_cols;
+        int32_t acc_0 = 0;
+
+        for (int32_t i = 0; i < lhs_count; i++)
+        {
+            acc_0 += rhs_0[lhs_indices[i]] * lhs_values[i];
+        }
+
+        dst[row] = arm_nn_sparse_lhs_requantize(
+            acc_0, bias, row, dst_offset, dst_multipliers, dst_shifts, per_channel, activation_min, activation_max);
+    }
+
+    return ARM_CMSIS_NN_SUCCESS;
+}
+
+/**
+ * @} end of Doxygen group
+ */